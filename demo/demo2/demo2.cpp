@@ -134,6 +134,9 @@ void prepareExtractor()
           ex =  new MT_LocalExtractorClass(mt);
 //          sprintf(msg,"%s","LOCAL EXTRACTOR");
           break;
+     case LOCDYN_EXTR:
+          ex =  new MT_LocalDynamicExtractorClass(mt);
+          break;
   }
 //  printf("==== %s ====\n",msg);
   if (!vn) vn = new ExtraVertexNormalClass(mt);
@@ -290,7 +293,8 @@ void changeExtractor(void)
   {
     case STATIC_EXTR:  extractor_type = DYNAMIC_EXTR; break;
     case DYNAMIC_EXTR: extractor_type = LOCAL_EXTR; break;
-    case LOCAL_EXTR:   extractor_type = STATIC_EXTR; break;
+    case LOCAL_EXTR:   extractor_type = LOCDYN_EXTR; break;
+    case LOCDYN_EXTR:  extractor_type = STATIC_EXTR; break;
   }
   prepareExtractor();
   ex->MT_SetFocus( focus );
@@ -51,6 +51,7 @@ Written JANUARY 1999, revised OCTOBER 1999
 #define STATIC_EXTR  1
 #define DYNAMIC_EXTR 2
 #define LOCAL_EXTR   3
+#define LOCDYN_EXTR  4
 
 /* ------------------------------------------------------------------------- */
 /*                           global variables                                */
@@ -61,7 +62,8 @@ extern FieldWithError mt;
 
 /* Extractor. */
 extern MT_Extractor ex;
-extern int extractor_type; /* one of STATIC_EXTR, DYNAMIC_EXTR, LOCAL_EXTR */
+extern int extractor_type; /* one of STATIC_EXTR, DYNAMIC_EXTR, LOCAL_EXTR,
+                              LOCDYN_EXTR */
 
 /* Wedge focus. */
 extern Wedge2FocusOnTrianglesClass * focus;
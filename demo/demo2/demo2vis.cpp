@@ -671,6 +671,7 @@ void dialogCallBack(void)
   switch ( getExtractor() )
   {  case DYNAMIC_EXTR: sprintf(aux,"EXTRACTOR: dynamic"); break;
      case LOCAL_EXTR: sprintf(aux,"EXTRACTOR: local"); break;
+     case LOCDYN_EXTR: sprintf(aux,"EXTRACTOR: local dynamic"); break;
      case STATIC_EXTR: sprintf(aux,"EXTRACTOR: static"); break;
   }
   displayString( 3.0,299.0,aux);
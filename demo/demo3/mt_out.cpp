@@ -23,6 +23,49 @@ Such vertices are the only ones to be reported.
 /*                           Auxiliary functions                           */
 /* ----------------------------------------------------------------------- */
 
+/*
+Positions of the extracted tiles, used for writing adjacent tiles.
+Instead of an array over all the tiles of the MT, the pairs (tile,
+position+1) of the extracted tiles are sorted on the tile and searched.
+*/
+
+static int MT_ComparePairs(const void * a, const void * b)
+{
+   MT_INDEX t1 = ((MT_INDEX *)a)[0];
+   MT_INDEX t2 = ((MT_INDEX *)b)[0];
+   return ( (t1<t2) ? -1 : ( (t1>t2) ? 1 : 0 ) );
+}
+
+static MT_INDEX * MT_SortTiles(MT_INDEX * tiles, MT_INDEX count)
+{
+   MT_INDEX * pairs;
+   MT_INDEX j;
+
+   /* no tiles, nothing to sort (malloc(0) may return NULL) */
+   if (!count) return ( (MT_INDEX *) calloc (2, sizeof(MT_INDEX)) );
+   pairs = (MT_INDEX *) malloc (2*count*sizeof(MT_INDEX));
+   if (!pairs) return NULL;
+   for (j=0;j<count;j++)
+   {  pairs[2*j] = tiles[j];  pairs[2*j+1] = j+1;  }
+   qsort(pairs, count, 2*sizeof(MT_INDEX), MT_ComparePairs);
+   return pairs;
+}
+
+/* return the position+1 of tile t, IS_NOT_USED if t is not extracted */
+static int MT_TilePosition(MT_INDEX * pairs, MT_INDEX count, MT_INDEX t)
+{
+   MT_INDEX lo = 0, hi = count, mid;
+
+   while (lo<hi)
+   {
+     mid = (lo+hi)/2;
+     if (pairs[2*mid]<t) lo = mid+1;
+     else hi = mid;
+   }
+   if ( (lo<count) && (pairs[2*lo]==t) )  return ( (int)pairs[2*lo+1] );
+   return IS_NOT_USED;
+}
+
 static int MT_WriteRawAux(FILE *fd, MT_Extractor e, int flags,
                           MT_INDEX * tiles, MT_INDEX count)
 {
@@ -33,7 +76,8 @@ static int MT_WriteRawAux(FILE *fd, MT_Extractor e, int flags,
    int i1;
    int t_dim, v_dim;    /* number of vertices per tile and
                            number of coordinates per vertex */
-   int * Tbit_vector;   /* for the extracted tiles */
+   MT_INDEX * Tpairs;   /* positions of the extracted tiles */
+   int pos;             /* position+1 of an adjacent tile */
    MT_INDEX t1, v1;
    int is_adj;
 
@@ -42,17 +86,12 @@ static int MT_WriteRawAux(FILE *fd, MT_Extractor e, int flags,
 
    if (flags & MT_ADJ_FLAG)
    {
-     Tbit_vector = (int *)
-     calloc (e->MT_TheMT()->MT_TileNum()+1, sizeof(int));
-     if (!Tbit_vector)
+     Tpairs = MT_SortTiles(tiles,count);
+     if (!Tpairs)
      {
         MT_Warning("Allocation failed","MT_WriteIndexed");
         return 0;
      }
-     for (j=0;j<count;j++)
-     {
-        Tbit_vector[tiles[j]] = j+1;
-     }
    }
     
    fprintf(fd,"%d\n",count);
@@ -74,20 +113,19 @@ static int MT_WriteRawAux(FILE *fd, MT_Extractor e, int flags,
       {
 #ifdef VERSIONE_FEB11
           is_adj = e->MT_TileAdj(t,t,v[i],&t1,&i1);
-          if ( (!is_adj) ||
-               (Tbit_vector[t1] == IS_NOT_USED) ) fprintf(fd,"%d ",-1);
-          else fprintf(fd,"%d ",Tbit_vector[t1]-1);
+          pos = ( is_adj ? MT_TilePosition(Tpairs,count,t1) : IS_NOT_USED );
 #else
           t1 = e->MT_TileAdj(t,i);
-          if ( (t1==MT_NULL_INDEX) ||
-               (Tbit_vector[t1] == IS_NOT_USED) ) fprintf(fd,"%d ",-1);
-          else fprintf(fd,"%d ",Tbit_vector[t1]-1);
+          pos = ( (t1!=MT_NULL_INDEX) ? 
+                  MT_TilePosition(Tpairs,count,t1) : IS_NOT_USED );
 #endif
+          if (pos == IS_NOT_USED) fprintf(fd,"%d ",-1);
+          else fprintf(fd,"%d ",pos-1);
       }
       fprintf(fd,"\n");
    }
 
-   if (flags & MT_ADJ_FLAG) free(Tbit_vector);
+   if (flags & MT_ADJ_FLAG) free(Tpairs);
 
    return 1;
 }
@@ -104,8 +142,11 @@ static int MT_WriteIndexedAux(FILE * fd, MT_Extractor e, int flags,
    int t_dim, v_dim;    /* number of vertices per tile and
                            number of coordinates per vertex */
    int * Vbit_vector;   /* for the vertices of the extracted tiles */
+   int stars;           /* if vertex stars are enabled in e */
+   MT_INDEX w;          /* position of v[i] in Vbit_vector */
 
-   int * Tbit_vector;   /* for the extracted tiles */
+   MT_INDEX * Tpairs;   /* positions of the extracted tiles */
+   int pos;             /* position+1 of an adjacent tile */
    MT_INDEX t1, v1;
    int is_adj;
    int i1;
@@ -113,24 +154,36 @@ static int MT_WriteIndexedAux(FILE * fd, MT_Extractor e, int flags,
    MT_INDEX v_count = 0; /* counter of extracted vertices */
    MT_INDEX ind = 0;     /* progressive number given to vertices */
    
+   t_dim = e->MT_TheMT()->MT_TileDim()+1;
+   v_dim = e->MT_TheMT()->MT_VertexDim();
+
+   /* with vertex stars, the vertices of the extracted tiles are numbered
+      in the current front, and Vbit_vector is indexed on such numbers
+      instead of on all the vertices of the MT; a vertex not in the front
+      has no number (0), and then all the vertices of the MT are used */
+   stars = e->MT_VertexStarsEnabled();
+   for (j=0; stars && (j<count); j++)
+   {
+      e->MT_TheMT()->MT_TileVertices(tiles[j],&v);
+      for (i=0;i<t_dim;i++)
+      {  if (!e->MT_StarPosition(v[i])) stars = 0;  }
+   }
    Vbit_vector = (int *) 
-            calloc (e->MT_TheMT()->MT_VertexNum()+1, sizeof(int));
+            calloc ( (stars ? e->MT_StarVertexNum() : 
+                              e->MT_TheMT()->MT_VertexNum())+1, sizeof(int) );
    if (!Vbit_vector)
    {
       MT_Warning("Allocation failed","MT_WriteIndexed");
       return 0;
    }
 
-   t_dim = e->MT_TheMT()->MT_TileDim()+1;
-   v_dim = e->MT_TheMT()->MT_VertexDim();
-
    if (flags & MT_ADJ_FLAG)
    {
-     Tbit_vector = (int *)
-     calloc (e->MT_TheMT()->MT_TileNum()+1, sizeof(int));
-     if (!Tbit_vector)
+     Tpairs = MT_SortTiles(tiles,count);
+     if (!Tpairs)
      {
         MT_Warning("Allocation failed","MT_WriteIndexed");
+        free(Vbit_vector);
         return 0;
      }
    }
@@ -143,10 +196,10 @@ static int MT_WriteIndexedAux(FILE * fd, MT_Extractor e, int flags,
       e->MT_TheMT()->MT_TileVertices(t,&v);
       for (i=0;i<t_dim;i++)
       {
-        if (!Vbit_vector[v[i]]) 
-        {  Vbit_vector[v[i]] = IS_USED; v_count++;  }
+        w = (stars ? e->MT_StarPosition(v[i]) : v[i]);
+        if (!Vbit_vector[w]) 
+        {  Vbit_vector[w] = IS_USED; v_count++;  }
       }
-     if (flags & MT_ADJ_FLAG)  {  Tbit_vector[t] = j+1;  }
    }
 
    fprintf(fd,"OFF\n");
@@ -159,9 +212,10 @@ static int MT_WriteIndexedAux(FILE * fd, MT_Extractor e, int flags,
       e->MT_TheMT()->MT_TileVertices(t,&v);
       for (i=0;i<t_dim;i++)
       {
-        if (Vbit_vector[v[i]]==IS_USED)
+        w = (stars ? e->MT_StarPosition(v[i]) : v[i]);
+        if (Vbit_vector[w]==IS_USED)
         {
-           Vbit_vector[v[i]] = ++ind;
+           Vbit_vector[w] = ++ind;
            e->MT_TheMT()->MT_VertexCoords(v[i],&f);
            for (k=0;k<v_dim;k++)
            {
@@ -180,10 +234,11 @@ static int MT_WriteIndexedAux(FILE * fd, MT_Extractor e, int flags,
       e->MT_TheMT()->MT_TileVertices(t,&v);
       fprintf(fd,"%d  ",t_dim);
       for (i=0;i<t_dim;i++)
-      {  if (i<t_dim-1) 
-             fprintf(fd,"%d ", Vbit_vector[v[i]]-1);
+      {  w = (stars ? e->MT_StarPosition(v[i]) : v[i]);
+         if (i<t_dim-1) 
+             fprintf(fd,"%d ", Vbit_vector[w]-1);
          else
-             fprintf(fd,"%d\n", Vbit_vector[v[i]]-1);
+             fprintf(fd,"%d\n", Vbit_vector[w]-1);
       }
       /* write adjacent tiles if required */
       if (flags & MT_ADJ_FLAG)
@@ -191,15 +246,16 @@ static int MT_WriteIndexedAux(FILE * fd, MT_Extractor e, int flags,
          for (i=0;i<t_dim;i++)
          {
            t1 = e->MT_TileAdj(t,i);
-           if ( (t1==MT_NULL_INDEX) ||
-                (Tbit_vector[t1] == IS_NOT_USED) ) fprintf(fd,"%d ",-1);
-           else fprintf(fd,"%d ",Tbit_vector[t1]-1);
+           pos = ( (t1!=MT_NULL_INDEX) ? 
+                   MT_TilePosition(Tpairs,count,t1) : IS_NOT_USED );
+           if (pos == IS_NOT_USED) fprintf(fd,"%d ",-1);
+           else fprintf(fd,"%d ",pos-1);
          }
          fprintf(fd,"\n");
       }
    }
    free(Vbit_vector);
-   if (flags & MT_ADJ_FLAG) free(Tbit_vector);
+   if (flags & MT_ADJ_FLAG) free(Tpairs);
 
    return 1;
 }
@@ -53,6 +53,8 @@ int main(int argc, char * argv[]) {
   printf("...MT loaded\n");
 
   ex = new MT_StaticExtractorClass(mt);
+  /* vertex stars give the numbering of vertices used by MT_WriteAllIndexed */
+  ex->MT_SetVertexStars(1);
   unif_thr = new UnifThresholdClass(area_factor);
   filter = new TriangleArea3FilterClass( unif_thr );
   filter->MT_MinMax(mt, &minArea, &maxArea);
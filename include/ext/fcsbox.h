@@ -138,6 +138,19 @@ class BoxClass
    void TheBox (float *x1, float *y1, float *x2, float *y2);   
    void TheBox (float *x1, float *y1, float *z1,
                 float *x2, float *y2, float *z2);
+
+/* ------------------------------------------------------------------------ */
+/*                       Relation with another box                          */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Return the relation between this box and the box with corners 
+   min_coord and max_coord, on the first BoxDim() coordinates:
+   MT_BOX_OUT if they are disjoint even after this box is expanded of
+   an amount e, MT_BOX_IN if the other box is contained in this one,
+   MT_BOX_CROSS otherwise (see MT_EvalBox in mt_cond.h).
+   */
+   int BoxRelation(float * min_coord, float * max_coord, float e = 0.0);
    
 /* ------------------------------------------------------------------------ */
 /*                          Creation of the box                             */
@@ -196,6 +209,13 @@ class Box2FocusOnTrianglesClass : public BoxClass, public MT_CondClass
    Implementation of abstract function from superclass MT_CondClass.
    */
    int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
+
+   /*
+   Evaluation on the tiles inside a box, through BoxRelation.
+   */
+   int MT_EvalBox(MT_MultiTesselation m, 
+                  float * min_coord, float * max_coord, 
+                  float max_err, int flag);
    
    /*
    This condition is good only for MTs with triangular tiles.
@@ -255,6 +275,23 @@ class Box3FocusOnTrianglesClass : public BoxClass, public MT_CondClass
    Implementation of abstract function from superclass MT_CondClass.
    */
    int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
+
+   /*
+   Evaluation on a range of tiles, reading the errors of all tiles 
+   together.
+   */
+   int MT_EvalCondRange(MT_MultiTesselation m, 
+                        MT_INDEX t1, MT_INDEX t2, int flag,
+                        unsigned char * res);
+
+   /*
+   Evaluation on the tiles inside a box. In loose mode, the box of the 
+   focus is expanded of the maximum error of such tiles (of the maximum
+   error over all tiles if it is not known).
+   */
+   int MT_EvalBox(MT_MultiTesselation m, 
+                  float * min_coord, float * max_coord, 
+                  float max_err, int flag);
               
    /*
    This condition is good only for MTs with triangular tiles embedded
@@ -295,6 +332,13 @@ class Box3FocusOnTetrahedraClass : public BoxClass, public MT_CondClass
    */
    int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+   /*
+   Evaluation on the tiles inside a box, through BoxRelation.
+   */
+   int MT_EvalBox(MT_MultiTesselation m, 
+                  float * min_coord, float * max_coord, 
+                  float max_err, int flag);
+
    /*
    This condition is good only for MTs with tetrahedral tiles.
    */
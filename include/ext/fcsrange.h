@@ -104,6 +104,15 @@ class RangeClass : public PointDistClass
   */
   inline float SetRadius(float r)  {  return (radius = r);  }
   inline float TheRadius(void)  {  return (radius);  }
+
+  /*
+  Return the relation between this range and the box with corners
+  min_coord and max_coord, on the first PointDim() coordinates:
+  MT_BOX_OUT if no point of the box is closer than radius+e to the 
+  center, MT_BOX_IN if all points of the box are closer than radius,
+  MT_BOX_CROSS otherwise (see MT_EvalBox in mt_cond.h).
+  */
+  int BoxRelation(float * min_coord, float * max_coord, float e = 0.0);
   
   /*
   Create a range of dimension d, centered at the origin, with radius r.
@@ -140,6 +149,20 @@ class Range2FocusOnTrianglesClass : public RangeClass, public MT_CondClass
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on a range of tiles.
+  */
+  int MT_EvalCondRange(MT_MultiTesselation m, 
+                       MT_INDEX t1, MT_INDEX t2, int flag,
+                       unsigned char * res);
+
+  /*
+  Evaluation on the tiles inside a box, through BoxRelation.
+  */
+  int MT_EvalBox(MT_MultiTesselation m, 
+                 float * min_coord, float * max_coord, 
+                 float max_err, int flag);
+
   /*
   This condition is good only for MTs with triangular tiles.
   */
@@ -197,6 +220,23 @@ class Range3FocusOnTrianglesClass : public RangeClass, public MT_CondClass
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on a range of tiles, reading the errors of all tiles 
+  together.
+  */
+  int MT_EvalCondRange(MT_MultiTesselation m, 
+                       MT_INDEX t1, MT_INDEX t2, int flag,
+                       unsigned char * res);
+
+  /*
+  Evaluation on the tiles inside a box. In loose mode, the radius is
+  increased of the maximum error of such tiles (of the maximum error 
+  over all tiles if it is not known).
+  */
+  int MT_EvalBox(MT_MultiTesselation m, 
+                 float * min_coord, float * max_coord, 
+                 float max_err, int flag);
+
   /*
   This condition is good only for MTs with triangular tiles embedded in
   at least three dimensions.
@@ -235,6 +275,20 @@ class Range3FocusOnTetrahedraClass : public RangeClass, public MT_CondClass
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on a range of tiles.
+  */
+  int MT_EvalCondRange(MT_MultiTesselation m, 
+                       MT_INDEX t1, MT_INDEX t2, int flag,
+                       unsigned char * res);
+
+  /*
+  Evaluation on the tiles inside a box, through BoxRelation.
+  */
+  int MT_EvalBox(MT_MultiTesselation m, 
+                 float * min_coord, float * max_coord, 
+                 float max_err, int flag);
+
   /*
   This condition is good only for MTs with tetrahedral tiles.
   */
@@ -85,6 +85,16 @@ class SegmentClass
                    float x2, float y2, float z2);
    void TheSegment(float * x1, float * y1, float * z1,
                    float * x2, float * y2, float * z2);
+
+   /*
+   Return the relation between the projections on the x-y plane of this 
+   segment and of the box with corners min_coord and max_coord: 
+   MT_BOX_OUT if they are disjoint, i.e., if the box is outside the 
+   bounding box of the segment, or it lies strictly on one side of the 
+   line through the segment; MT_BOX_CROSS otherwise (see MT_EvalBox in
+   mt_cond.h).
+   */
+   int BoxRelation(float * min_coord, float * max_coord);
    /* 
    Create a segment with the given number of coordinates, both
    endpoints are at the origin (the segment degenerates into a point).
@@ -126,6 +136,13 @@ class Segment2FocusOnTrianglesClass : public SegmentClass,
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on the tiles inside a box, through BoxRelation.
+  */
+  int MT_EvalBox(MT_MultiTesselation m, 
+                 float * min_coord, float * max_coord, 
+                 float max_err, int flag);
+
   /*
   This condition is good only for MTs with triangular tiles.
   */
@@ -189,6 +206,15 @@ class Segment3FocusOnTriFieldClass : public SegmentClass, public MT_CondClass
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on the tiles inside a box, through BoxRelation: a tile
+  whose projection does not intersect the one of the segment does not 
+  lie above it. The field values are not considered.
+  */
+  int MT_EvalBox(MT_MultiTesselation m, 
+                 float * min_coord, float * max_coord, 
+                 float max_err, int flag);
+
   /*
   This condition is good only for MTs with triangular tiles embedded in
   at least three dimensions.
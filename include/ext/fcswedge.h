@@ -151,6 +151,16 @@ class WedgeClass
    */
    void TheLeftPoint(float * x, float * y, float dist = 1.0);
    void TheRightPoint(float * x, float * y, float dist = 1.0);
+
+   /*
+   For wedges in 2D. Return the relation between this wedge and the 
+   box with corners min_coord and max_coord, on the first two 
+   coordinates: MT_BOX_OUT if the box lies outside one of the two 
+   half-planes bounding the wedge, MT_BOX_IN if all box corners are 
+   inside the wedge, MT_BOX_CROSS otherwise (see MT_EvalBox in 
+   mt_cond.h).
+   */
+   int BoxRelation(float * min_coord, float * max_coord);
   
    /*
    Create a wedge in a d-dimensional space. The vertex is the origin,
@@ -184,6 +194,13 @@ class Wedge2FocusOnTrianglesClass : public WedgeClass, public MT_CondClass
    */
    int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+   /*
+   Evaluation on the tiles inside a box, through BoxRelation.
+   */
+   int MT_EvalBox(MT_MultiTesselation m, 
+                  float * min_coord, float * max_coord, 
+                  float max_err, int flag);
+
    /* 
    Create a sector with vertex in (xv,yv), medial axis the line joining
    (xv,yv) to (xr,yr), and opening angle equal to a.
@@ -78,7 +78,16 @@ class TileErrFilterClass : public MT_CondClass
   Return 1 if the error of the tile is <= the threshold value for 
   that tile. Return 0 otherwise.
   */
-  int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
+  inline int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+  {  return ( my_mt->TileError(t) < my_thr->ThresholdValue(m,t) );  }
+
+  /*
+  Evaluation on a range of tiles, comparing the arrays of tile errors
+  and of threshold values.
+  */
+  int MT_EvalCondRange(MT_MultiTesselation m, 
+                       MT_INDEX t1, MT_INDEX t2, int flag,
+                       unsigned char * res);
 
   /*
   Create a condition given the reference MT m and the threshold tr to
@@ -87,6 +96,57 @@ class TileErrFilterClass : public MT_CondClass
   TileErrFilterClass(WithTileErrorClass * m, Threshold tr);
 };
 
+/* ------------------------------------------------------------------------ */
+/*                      PRIORITY GIVEN BY TILE ERRORS                       */
+/* ------------------------------------------------------------------------ */
+
+/*
+Priority for the budgeted extractor (see MT_BudgetExtractorClass in 
+mt_extra.h), that refines first the tiles with the largest error.
+If a threshold is given, the priority of a tile is the ratio between 
+its error and the threshold value for that tile, thus the tiles whose
+error exceeds the threshold by the largest factor are refined first.
+The same restrictions as for TileErrFilterClass apply.
+*/
+
+typedef class TileErrPriorityClass * TileErrPriority;
+
+class TileErrPriorityClass : public MT_PriorityClass
+{
+  protected:
+
+  /*
+  Explicit reference to the MT in order to access tile errors.
+  */
+  WithTileErrorClass * my_mt;
+
+  /*
+  The threshold dividing tile errors (NULL if none).
+  */
+  Threshold my_thr;
+
+  public:
+  
+  /*
+  Return the error of the tile, divided by the threshold value for that
+  tile if a threshold is given.
+  */
+  float MT_EvalPriority(MT_MultiTesselation m, MT_INDEX t);
+
+  /*
+  Evaluation on a range of tiles, using the arrays of tile errors
+  and of threshold values.
+  */
+  void MT_EvalPriorityRange(MT_MultiTesselation m, 
+                            MT_INDEX t1, MT_INDEX t2, float * res);
+
+  /*
+  Create a priority given the reference MT m and, optionally, the 
+  threshold tr.
+  */
+  TileErrPriorityClass(WithTileErrorClass * m, Threshold tr = NULL);
+};
+
 /* ------------------------------------------------------------------------ */
 /*                   TESTING THE THRESHOLD ON TILE AREAS                    */
 /* ------------------------------------------------------------------------ */
@@ -118,6 +178,14 @@ class TriangleArea2FilterClass : public MT_CondClass
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on a range of tiles, computing the areas of all tiles
+  together.
+  */
+  int MT_EvalCondRange(MT_MultiTesselation m, 
+                       MT_INDEX t1, MT_INDEX t2, int flag,
+                       unsigned char * res);
+
   /*
   Create a condition given the threshold to be imposed on tile areas.
   */
@@ -158,6 +226,14 @@ class TriangleArea3FilterClass : public MT_CondClass
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on a range of tiles, computing the areas of all tiles
+  together.
+  */
+  int MT_EvalCondRange(MT_MultiTesselation m, 
+                       MT_INDEX t1, MT_INDEX t2, int flag,
+                       unsigned char * res);
+
   /*
   Create a condition given the threshold to be imposed on tile areas.
   */
@@ -61,6 +61,17 @@ class ThresholdClass
   */
   virtual float ThresholdValue(MT_MultiTesselation m, MT_INDEX t) = 0;
   
+  /*
+  Set res[i-t1] to the value of the threshold on tile i, for all tiles
+  i from t1 to t2 (included). Used by conditions evaluated on ranges of
+  tiles. By default, it calls ThresholdValue on each tile.
+  */
+  virtual inline void ThresholdValues(MT_MultiTesselation m, 
+                                      MT_INDEX t1, MT_INDEX t2, float * res)
+  {  MT_INDEX t;
+     for (t=t1;t<=t2;t++)  res[t-t1] = ThresholdValue(m,t);
+  }
+
   /*
   Return 1 if this threshold can be evaluated on the given MT.
   Some subclasses of thresholds may require tiles and/or embedding space
@@ -104,6 +115,12 @@ class UnifThresholdClass : public ThresholdClass
   */
   inline float ThresholdValue(MT_MultiTesselation m, MT_INDEX t)
   {  return ( TheThreshold() );  }
+
+  inline void ThresholdValues(MT_MultiTesselation m, 
+                              MT_INDEX t1, MT_INDEX t2, float * res)
+  {  MT_INDEX t;
+     for (t=t1;t<=t2;t++)  res[t-t1] = unif_value;
+  }
     
 };
 
@@ -52,6 +52,15 @@ class WithTileErrorClass
   */
   virtual float TileError(MT_INDEX t) = 0;
 
+  /*
+  Set res[i-t1] to the error of tile i, for all tiles i from t1 to t2 
+  (included). By default, it calls TileError on each tile.
+  */
+  virtual inline void TileErrors(MT_INDEX t1, MT_INDEX t2, float * res)
+  {  MT_INDEX t;
+     for (t=t1;t<=t2;t++)  res[t-t1] = TileError(t);
+  }
+
   /*
   Return the maximum and minimum error over all tiles.
   */
@@ -86,6 +95,10 @@ class WithTileErrorTableClass : public WithTileErrorClass
   */
   inline float TileError(MT_INDEX t)
   {  return my_error->MT_AttrValue(t);  }
+  inline void TileErrors(MT_INDEX t1, MT_INDEX t2, float * res)
+  {  MT_INDEX t;
+     for (t=t1;t<=t2;t++)  res[t-t1] = my_error->MT_AttrValue(t);
+  }
   inline float MaxError(void)  {  return my_error->MT_MaxValue();  }
   inline float MinError(void)  {  return my_error->MT_MinValue();  }
 
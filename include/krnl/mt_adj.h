@@ -0,0 +1,197 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_adj.h ------------------------------- */
+
+#ifndef MT_ADJ_TABLE_INCLUDED
+#define MT_ADJ_TABLE_INCLUDED
+
+#include "mt_multi.h"
+#include "mt_attr.h"
+
+/* ------------------------------------------------------------------------ */
+/*              CANDIDATE ADJACENT TILES FOR THE FACETS OF AN MT            */
+/* ------------------------------------------------------------------------ */
+
+/*
+This file defines an attribute table, called MT_AdjTableClass, storing
+for each facet of each tile of an MT the list of candidate adjacent 
+tiles, i.e., all the other tiles of the MT having the same facet (in 
+the same arc, in sibling arcs, or anywhere else in the DAG). 
+
+Since an extracted tesselation is conforming, a facet of one of its 
+tiles is shared by at most another tile of the tesselation, which must
+be one of its candidates. Thus an extractor with adjacency generation 
+enabled (see mt_extra.h) can find the adjacent tiles by looking for an
+extracted tile in the short lists of candidates, instead of matching the
+facets of the tiles through a hash table. 
+
+The table is computed once from an MT (function MT_BuildAdjTable), and
+saved in an attribute file. The entries are the tiles. Each candidate
+of facet i of tile t is coded as the number t1*k+i1, where k is the
+number of vertices of a tile, t1 is the candidate tile, and i1 is the
+index of its facet (i.e., of its vertex opposite to the facet) shared 
+with t.
+*/
+
+/* ------------------------------------------------------------------------ */
+/*                         THE CANDIDATE TABLE                              */
+/* ------------------------------------------------------------------------ */
+
+typedef class MT_AdjTableClass * MT_AdjTable;
+
+class MT_AdjTableClass : public MT_AttrTableClass
+{
+
+/* ------------------------------------------------------------------------ */
+/*                            Internal structure                            */
+/* ------------------------------------------------------------------------ */
+
+  protected:
+
+  /*
+  Number of vertices (and of facets) of a tile.
+  */
+  int fac_num;
+
+  /*
+  Total number of candidates.
+  */
+  MT_INDEX cand_num;
+
+  /*
+  Array of (my_num+1)*fac_num+1 positions: the candidates of facet i of 
+  tile t are in cand_Arr from position first_Arr[t*fac_num+i] to 
+  first_Arr[t*fac_num+i+1]-1. The first fac_num positions (tile 0)
+  are unused.
+  */
+  MT_INDEX * first_Arr;
+
+  /*
+  Array of the coded candidates of all facets.
+  */
+  MT_INDEX * cand_Arr;
+
+  /*
+  Allocate cand_Arr to n candidates.
+  Return 1 on success, 0 on failure.
+  */
+  int MT_SetCandNum(MT_INDEX n);
+
+/* ------------------------------------------------------------------------ */
+/*                            Access primitives                             */
+/* ------------------------------------------------------------------------ */
+
+  public:
+
+  inline char * MT_ClassKeyword()  {  return (char *)"MT_AdjTable";  }
+
+  /*
+  Number of vertices of a tile, and total number of candidates.
+  */
+  inline int MT_AdjFacetNum(void)  {  return (fac_num);  }
+  inline MT_INDEX MT_CandNum(void)  {  return (cand_num);  }
+
+  /*
+  Return the number of candidates of facet i of tile t, and a pointer
+  to the array of such candidates, coded as explained above.
+  The array must not be allocated nor freed by the caller.
+  */
+  inline int MT_FacetCandNum(MT_INDEX t, int i)
+  {  return ( first_Arr[t*fac_num+i+1] - first_Arr[t*fac_num+i] );  }
+  inline MT_INDEX * MT_FacetCands(MT_INDEX t, int i)
+  {  return ( cand_Arr + first_Arr[t*fac_num+i] );  }
+
+  /*
+  Return the tile and the facet index of a coded candidate c.
+  */
+  inline MT_INDEX MT_CandTile(MT_INDEX c)  {  return ( c / fac_num );  }
+  inline int MT_CandFacet(MT_INDEX c)  {  return ( (int)(c % fac_num) );  }
+
+  /*
+  Return 1 if this table has been computed for an MT with the same
+  numbers of tiles and of tile vertices as m.
+  */
+  int MT_IsGood(MT_MultiTesselation m);
+
+/* ------------------------------------------------------------------------ */
+/*                        Computing the candidates                          */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Compute the candidates for the facets of the tiles of MT m.
+  The MT must be completely loaded.
+  Return 1 on success, 0 on failure.
+  */
+  int MT_BuildAdjTable(MT_MultiTesselation m);
+
+/* ------------------------------------------------------------------------ */
+/*                            Reading and writing                           */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Allocate the table to n tiles, all facets without candidates.
+  Return 1 on success, 0 on failure.
+  */
+  int MT_SetAttrNum(MT_INDEX n);
+
+  /*
+  Read / write the candidates of tile i, as the number of candidates 
+  of each facet followed by the tiles and facet indexes of such 
+  candidates. Functions redefined from superclass MT_AttrTableClass.
+  Tiles must be read in increasing order, after all candidates have 
+  been allocated.
+  */
+  int MT_ReadAttr(FILE * fd, MT_INDEX i, int file_encoding);
+  void MT_WriteAttr(FILE * fd, MT_INDEX i, int file_encoding);
+
+  /*
+  Functions redefined from superclass MT_PersistentClass.
+  The class parameter is the number of vertices of a tile, the object 
+  parameters are the numbers of tiles and of candidates.
+  */
+  int MT_ReadClassAndParams(FILE * fd);
+  int MT_ReadObjParams(FILE * fd);
+  int MT_ReadBody(FILE * fd, int file_encoding);
+  void MT_WriteClassAndParams(FILE * fd);
+  void MT_WriteObjParams(FILE * fd);
+  void MT_WriteBody(FILE * fd, int file_encoding);
+
+/* ------------------------------------------------------------------------ */
+/*                         Creation and deletion                            */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Create an empty table for tiles with k vertices. It must be computed
+  with MT_BuildAdjTable, or read from a file.
+  */
+  MT_AdjTableClass(int k);
+  ~MT_AdjTableClass(void);
+
+};
+
+/* ------------------------------------------------------------------------ */
+
+#endif /* MT_ADJ_TABLE_INCLUDED */
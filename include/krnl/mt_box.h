@@ -0,0 +1,207 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_box.h ------------------------------- */
+
+#ifndef MT_BOX_TABLE_INCLUDED
+#define MT_BOX_TABLE_INCLUDED
+
+#include "mt_multi.h"
+#include "mt_attr.h"
+#include "mt_float.h"
+
+/* ------------------------------------------------------------------------ */
+/*                  BOUNDING BOXES OF THE ARCS AND NODES OF AN MT           */
+/* ------------------------------------------------------------------------ */
+
+/*
+This file defines an attribute table, called MT_BoxTableClass, storing
+an axis-parallel box for each arc and for each node of an MT:
+- the box of an arc a bounds the tiles labelling a;
+- the box of a node n bounds the tiles created by n and by all the 
+  descendants of n, i.e., all the tiles that can appear in a tesselation
+  extracted beyond n.
+Together with each box, the table stores the maximum error of the tiles
+bounded by it, if tile errors were given when computing the boxes, or 
+a negative value otherwise.
+
+The boxes are computed once from an MT (function MT_BuildBoxes), and
+saved in an attribute file. Local extractors (see mt_extra.h) use them 
+to test a whole arc, or a whole sub-DAG, against the focus set with a 
+single box test (see MT_EvalBox in mt_cond.h), instead of testing the 
+tiles one by one.
+
+The entries of the table from 1 to the number of arcs are the arcs, 
+the following ones are the nodes. Each entry contains 2d+1 floats, 
+where d is the number of vertex coordinates: the minimum coordinates, 
+the maximum coordinates, and the error. Arcs without tiles, and nodes
+with no tile beyond them (e.g., the drain), have an empty box where the
+minimum coordinates are greater than the maximum ones.
+*/
+
+/* ------------------------------------------------------------------------ */
+/*                            THE BOX TABLE                                 */
+/* ------------------------------------------------------------------------ */
+
+typedef class MT_BoxTableClass * MT_BoxTable;
+
+class MT_BoxTableClass : public MT_AttrTableClass
+{
+
+/* ------------------------------------------------------------------------ */
+/*                            Internal structure                            */
+/* ------------------------------------------------------------------------ */
+
+  protected:
+
+  /*
+  Number of coordinates of the boxes.
+  */
+  int box_dim;
+
+  /*
+  Number of floats in each entry, equal to 2*box_dim+1.
+  */
+  int entry_size;
+
+  /*
+  Number of arcs, the entry of node n is arc_num+n.
+  */
+  MT_INDEX arc_num;
+
+  /* 
+  Array of entries, one after the other, starting from entry 0 
+  (unused). 
+  */
+  float * box_Arr;
+
+/* ------------------------------------------------------------------------ */
+/*                            Access primitives                             */
+/* ------------------------------------------------------------------------ */
+
+  public:
+
+  inline char * MT_ClassKeyword()  {  return (char *)"MT_BoxTable";  }
+
+  /*
+  Number of coordinates of the boxes, and number of arcs and nodes.
+  */
+  inline int MT_BoxDim(void)  {  return (box_dim);  }
+  inline MT_INDEX MT_BoxArcNum(void)  {  return (arc_num);  }
+  inline MT_INDEX MT_BoxNodeNum(void)  {  return (my_num-arc_num);  }
+
+  /*
+  Return the min and max coordinates of the box of an arc a, and the 
+  maximum error of its tiles (negative if not known).
+  The arrays must not be allocated nor freed by the caller.
+  */
+  inline float * MT_ArcMin(MT_INDEX a)
+  {  return ( box_Arr + a*entry_size );  }
+  inline float * MT_ArcMax(MT_INDEX a)
+  {  return ( box_Arr + a*entry_size + box_dim );  }
+  inline float MT_ArcError(MT_INDEX a)
+  {  return ( box_Arr[a*entry_size + 2*box_dim] );  }
+
+  /*
+  The same for the box of a node n, covering n and its descendants.
+  */
+  inline float * MT_NodeMin(MT_INDEX n)
+  {  return ( box_Arr + (arc_num+n)*entry_size );  }
+  inline float * MT_NodeMax(MT_INDEX n)
+  {  return ( box_Arr + (arc_num+n)*entry_size + box_dim );  }
+  inline float MT_NodeError(MT_INDEX n)
+  {  return ( box_Arr[(arc_num+n)*entry_size + 2*box_dim] );  }
+
+  /*
+  Return 1 if the box of arc a / of node n is empty.
+  */
+  inline int MT_EmptyArcBox(MT_INDEX a)
+  {  return ( MT_ArcMin(a)[0] > MT_ArcMax(a)[0] );  }
+  inline int MT_EmptyNodeBox(MT_INDEX n)
+  {  return ( MT_NodeMin(n)[0] > MT_NodeMax(n)[0] );  }
+
+  /*
+  Return 1 if this table has been computed for an MT with the same
+  numbers of arcs, nodes and vertex coordinates as m.
+  */
+  int MT_IsGood(MT_MultiTesselation m);
+
+/* ------------------------------------------------------------------------ */
+/*                        Computing the boxes                               */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Compute the boxes of the arcs and nodes of MT m. If err is not NULL,
+  it contains the errors of the tiles of m, and the maximum error within 
+  each box is recorded. The MT must be completely loaded.
+  Return 1 on success, 0 on failure.
+  */
+  int MT_BuildBoxes(MT_MultiTesselation m, MT_FloatTable err = NULL);
+
+/* ------------------------------------------------------------------------ */
+/*                            Reading and writing                           */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Allocate the array to n entries, all empty boxes.
+  Return 1 on success, 0 on failure.
+  */
+  int MT_SetAttrNum(MT_INDEX n);
+
+  /*
+  Read / write the entry i. Functions redefined from superclass 
+  MT_AttrTableClass.
+  */
+  int MT_ReadAttr(FILE * fd, MT_INDEX i, int file_encoding);
+  void MT_WriteAttr(FILE * fd, MT_INDEX i, int file_encoding);
+
+  /*
+  Functions redefined from superclass MT_PersistentClass.
+  The class parameter is the number of coordinates, the object 
+  parameters are the numbers of arcs and of nodes.
+  */
+  int MT_ReadClassAndParams(FILE * fd);
+  int MT_ReadObjParams(FILE * fd);
+  int MT_ReadBody(FILE * fd, int file_encoding);
+  void MT_WriteClassAndParams(FILE * fd);
+  void MT_WriteObjParams(FILE * fd);
+  void MT_WriteBody(FILE * fd, int file_encoding);
+
+/* ------------------------------------------------------------------------ */
+/*                         Creation and deletion                            */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Create an empty table for boxes with d coordinates. It must be 
+  computed with MT_BuildBoxes, or read from a file.
+  */
+  MT_BoxTableClass(int d);
+  ~MT_BoxTableClass(void);
+
+};
+
+/* ------------------------------------------------------------------------ */
+
+#endif /* MT_BOX_TABLE_INCLUDED */
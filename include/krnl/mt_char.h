@@ -97,6 +97,13 @@ class MT_CharTableClass : public MT_AttrTableClass
   int MT_ReadObjParams(FILE * fd);
   int MT_ReadBody(FILE * fd, int file_encoding);
   void MT_WriteObjParams(FILE * fd);
+  void MT_WriteBody(FILE * fd, int file_encoding);
+
+  /*
+  Update the minimum and maximum value with the values in the array.
+  Used after the body has been read as a whole.
+  */
+  void MT_UpdateBound(void);
 
   /*
   Set the value of the attribute for MT entity i. 
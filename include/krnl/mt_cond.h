@@ -53,6 +53,24 @@ evaluation:
    from the extracted tesselation
 
 The loose and strict versions may be equal in some subclasses.
+
+Extraction algorithms test all the tiles of an arc together, and the
+tiles of an arc are numbered consecutively. Class MT_CondClass also
+exports MT_EvalCondRange, which evaluates the condition on a range of
+consecutive tiles and stores the results in an array. By default, it
+calls MT_EvalCond on each tile. Subclasses may redefine it in order 
+to evaluate many tiles together with tight loops on arrays, that the
+compiler can vectorize, and without a virtual call for each tile.
+A redefined MT_EvalCondRange must give the same results as MT_EvalCond.
+
+Class MT_CondClass also exports MT_EvalBox, which tells whether the
+tiles lying inside an axis-parallel box may satisfy the condition. It
+is used by local extractors to reject a whole arc, or a whole sub-DAG, 
+with a single test, based on the boxes stored in a box table (see 
+mt_box.h). By default, it cannot decide. Subclasses may redefine it,
+and the result must be conservative: MT_BOX_OUT only if no tile inside
+the box satisfies the condition, and MT_BOX_IN only if every tile inside
+the box satisfies it.
 */
 
 /* ------------------------------------------------------------------------ */
@@ -65,6 +83,20 @@ Flag for mode of evaluating the condition.
 #define MT_LOOSE 0
 #define MT_STRICT 1
 
+/*
+Maximum number of tiles evaluated together inside functions that
+call MT_EvalCondRange on a buffer allocated on the stack.
+*/
+#define MT_TILE_BATCH 64
+
+/*
+Results of MT_EvalBox: no tile inside the box satisfies the condition,
+some tiles may satisfy it, all tiles satisfy it.
+*/
+#define MT_BOX_OUT 0
+#define MT_BOX_CROSS 1
+#define MT_BOX_IN 2
+
 /* ------------------------------------------------------------------------ */
 /*                      A GENERIC TILE CONDITION                            */
 /* ------------------------------------------------------------------------ */
@@ -82,6 +114,28 @@ class MT_CondClass
    */
    virtual int MT_EvalCond(MT_MultiTesselation m, 
                            MT_INDEX t, int flag) = 0;
+
+   /*
+   Evaluate the condition on all tiles from t1 to t2 (included), and
+   set res[i-t1] to 1 if tile i satisfies the condition, to 0 otherwise.
+   Return the number of tiles that satisfy the condition. 
+   */
+   virtual int MT_EvalCondRange(MT_MultiTesselation m, 
+                                MT_INDEX t1, MT_INDEX t2, int flag,
+                                unsigned char * res);
+
+   /*
+   Evaluate the condition on all tiles lying inside the box with
+   corners min_coord and max_coord (arrays of as many coordinates as
+   the vertices of m). Parameter max_err is the maximum error of such
+   tiles, or a negative value if it is not known.
+   Return MT_BOX_OUT, MT_BOX_CROSS or MT_BOX_IN as explained above.
+   By default, it returns MT_BOX_CROSS.
+   */
+   virtual int MT_EvalBox(MT_MultiTesselation m, 
+                          float * min_coord, float * max_coord, 
+                          float max_err, int flag);
+
    /*
    Return 1 if this condition is good for the given MT.
    By default, it is always good. Specific conditions may be good 
@@ -116,6 +170,16 @@ class MT_TrueCondClass : public MT_CondClass
    inline int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
    {   return 1;   }
 
+   inline int MT_EvalCondRange(MT_MultiTesselation m, 
+                               MT_INDEX t1, MT_INDEX t2, int flag,
+                               unsigned char * res)
+   {   memset(res, 1, t2-t1+1);  return (t2-t1+1);   }
+
+   inline int MT_EvalBox(MT_MultiTesselation m, 
+                         float * min_coord, float * max_coord, 
+                         float max_err, int flag)
+   {   return MT_BOX_IN;   }
+
    inline  MT_TrueCondClass(void)  { }
 
 };
@@ -127,6 +191,16 @@ class MT_FalseCondClass : public MT_CondClass
    inline int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
    {   return 0;   }
 
+   inline int MT_EvalCondRange(MT_MultiTesselation m, 
+                               MT_INDEX t1, MT_INDEX t2, int flag,
+                               unsigned char * res)
+   {   memset(res, 0, t2-t1+1);  return 0;   }
+
+   inline int MT_EvalBox(MT_MultiTesselation m, 
+                         float * min_coord, float * max_coord, 
+                         float max_err, int flag)
+   {   return MT_BOX_OUT;   }
+
    inline  MT_FalseCondClass(void)  { }
 
 };
@@ -168,6 +242,22 @@ class MT_CompoundCondClass : public MT_CondClass
   */
   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag);
 
+  /*
+  Evaluation on a range of tiles, combining the results of the two
+  argument conditions on the same range.
+  */
+  int MT_EvalCondRange(MT_MultiTesselation m, 
+                       MT_INDEX t1, MT_INDEX t2, int flag,
+                       unsigned char * res);
+
+  /*
+  Evaluation on a box, combining the results of the two argument 
+  conditions on the same box.
+  */
+  int MT_EvalBox(MT_MultiTesselation m, 
+                 float * min_coord, float * max_coord, 
+                 float max_err, int flag);
+
   /*
   Constructor given the operator and the two argument conditions.
   */
@@ -175,6 +265,43 @@ class MT_CompoundCondClass : public MT_CondClass
         
 };
   
+/* ------------------------------------------------------------------------ */
+/*                        PRIORITIES OF MT TILES                            */
+/* ------------------------------------------------------------------------ */
+
+/*
+A priority is a real value associated with MT tiles, that measures how 
+much a tile needs to be refined (the higher, the more urgent). 
+It is used by the budgeted extractor (see MT_BudgetExtractorClass in 
+mt_extra.h), which refines first the tiles with the highest priority.
+For instance, the priority of a tile may be its approximation error.
+*/
+
+typedef class MT_PriorityClass *  MT_Priority;
+
+class MT_PriorityClass
+{
+  public:
+
+   /*
+   Return the priority of a tile.
+   */
+   virtual float MT_EvalPriority(MT_MultiTesselation m, MT_INDEX t) = 0;
+
+   /*
+   Set res[i-t1] to the priority of tile i, for all tiles i from t1 to
+   t2 (included). By default, it calls MT_EvalPriority on each tile.
+   */
+   virtual void MT_EvalPriorityRange(MT_MultiTesselation m, 
+                                     MT_INDEX t1, MT_INDEX t2,
+                                     float * res);
+
+   /*
+   Return 1 if this priority is good for the given MT.
+   By default, it is always good. 
+   */
+   virtual inline int MT_IsGood(MT_MultiTesselation m)  {  return 1;  }
+};
   
 /* ------------------------------------------------------------------------ */
 
@@ -32,6 +32,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "mt_list.h"
 #include "mt_hash.h"
 #include "mt_cond.h"
+#include "mt_thrd.h"
+#include "mt_box.h"
+#include "mt_adj.h"
 
 /* ------------------------------------------------------------------------ */
 /*               EXTRACTION  OF TESSELATIONS FROM AN MT                     */
@@ -43,13 +46,17 @@ extract tesselations at a certain resolution form an MT.
 The interface of a generic extractor is provided by the abstract class
 MT_ExtractorClass.
 
-Three types of extractor are available, which correspond to three subclasses
-of MT_ExtractorClass:
+The following types of extractor are available, which correspond to 
+subclasses of MT_ExtractorClass:
 
 - Global static extractor (class MT_StaticExtractorClass): extract tesselations
   covering the whole geometric object encoded in the MT, using an algorithm
   that always starts traversing the MT from scratch.
 
+- Global parallel static extractor (class MT_ParallelExtractorClass): 
+  extract the same tesselations as the global static extractor, by
+  traversing the MT with several threads (see mt_thrd.h).
+
 - Global Dynamic extractor (class MT_DynamicExtractorClass): extract tesselations
   covering the whole geometric object encoded in the MT, using an algorithm
   that updates the previously extracted tesselation.
@@ -64,6 +71,24 @@ of MT_ExtractorClass:
   Only the parts of the MT which interfere with the focus set are traversed,
   thus the algorithm is faster than the global static one (especially for
   small focus sets).
+
+- Local dynamic extractor (class MT_LocalDynamicExtractorClass): extract
+  the same tesselations as the local static extractor, using an algorithm
+  that updates the previously extracted tesselation, and looks only at
+  the parts of the MT which interfere with the focus set (e.g., for a 
+  small focus set moving over a large terrain).
+
+- Budgeted extractor (class MT_BudgetExtractorClass): extract tesselations
+  with at most a given number of tiles, refining first the tiles with the
+  highest priority (e.g., the largest error), and possibly updating the 
+  previously extracted tesselation (e.g., for rendering at constant
+  frame rate).
+
+- Sparse local extractor (class MT_SparseExtractorClass): extract the
+  same tesselations as the local static extractor, keeping its state
+  only for the nodes and arcs of the MT it visits. It is intended for
+  servers running many extractions at the same time on one MT, with
+  extractors taken from a pool (class MT_ExtractorPoolClass).
 */
 
 /* ------------------------------------------------------------------------ */
@@ -78,41 +103,28 @@ extractor is created).
 #define MT_ADJ_DISABLE 0
 #define MT_ADJ_ENABLE  1
 
-/* ------------------------------------------------------------------------ */
-/*                        AUXILIARY DATA STRUCTURES                         */
-/* ------------------------------------------------------------------------ */
-
 /*
-Structure to keep the topology of the extracted tesselation.
+Stages of a time-sliced extraction (see MT_DynamicExtractorClass).
 */
+#define MT_SLICE_DONE     0
+#define MT_SLICE_EXPAND   1
+#define MT_SLICE_CONTRACT 2
 
-typedef class MT_TopoClass * MT_Topo;
-
-class MT_TopoClass
-{
-  protected:
-
-  /*
-  Array containing the indexes of adjacent tiles. The i-th position 
-  stores the adiacent tile along the facet opposite to the i-th vertex.
-  */
-  MT_INDEX * T_adj;  
+/*
+Number of steps of a slice between two checks of the elapsed time.
+*/
+#define MT_SLICE_CHECK 16
 
-  /*
-  Create an instance where array T_adj contains dim positions
-  */
-  MT_TopoClass (int dim);
+/*
+Initial number of adjacency slots of an extractor (see adj_Arr below).
+*/
+#define MT_ADJ_SLOTS 1024
 
-  ~MT_TopoClass(void);
-  
-  friend class MT_ExtractorClass;
-};
-                                                      
 /*
-An array of elements of type MT_Topo will be used to store, for each tile, 
-a pointer to the MT_TopoClass structure that contains the indexes of 
-its adjacent tiles.
+Initial number of vertices in the vertex stars of an extractor (see 
+V_list below).
 */
+#define MT_STAR_VERTICES 1024
 
 /* ------------------------------------------------------------------------ */
 /*                         GENERIC EXTRACTOR                                */
@@ -155,6 +167,13 @@ class MT_ExtractorClass
    */  
    MT_Cond place_cnd;
 
+   /*
+   Boxes of the arcs and nodes of the MT (see mt_box.h), used by local
+   extractors to test whole arcs and sub-DAGs against the focus set.
+   NULL if not set.
+   */
+   MT_BoxTable box_tbl;
+
 /* ------------------------------------------------------------------------ */
 /*                 Current state of the MT traversal                        */
 /* ------------------------------------------------------------------------ */
@@ -180,6 +199,15 @@ class MT_ExtractorClass
    */
    MT_List A_front; 
 
+   /*
+   Work stack used by MT_IncludeNode in place of recursion. Entry i 
+   contains a node whose parents are being included, and the next arc 
+   entering it to be examined. Each node is in the stack at most once
+   (the DAG has no cycles), thus the stack has MT_NodeNum()+1 entries.
+   */
+   MT_INDEX * W_node;
+   MT_INDEX * W_arc;
+
 /* ------------------------------------------------------------------------ */
 /*                Information about the current tesselation                 */
 /* ------------------------------------------------------------------------ */
@@ -208,7 +236,9 @@ class MT_ExtractorClass
    
    /* 
    Flag ==1 if the tile array is up-to-date, 0 otherwise. 
-   The array is updated at the end of extraction.
+   The array is updated at the end of extraction, or when it is first
+   requested if the extraction does not update it (see the delta mode
+   of MT_DynamicExtractorClass).
    */
    short int tiles_ok;
 
@@ -222,19 +252,72 @@ class MT_ExtractorClass
    int topo_enabled;
    
    /*
-   Array indexed on tiles, where each tile t points to the object of type
-   MT_TopoClass storing its adjacent tiles (if t belongs to the current 
-   tesselation), or points to NULL (otherwise). If topology is enabled,
-   such array is updated during extraction and maintains the adjacency 
-   information for the extracted tesselation. Otherwise, it is not used.
+   Adjacency records of the tiles of the current tesselation. Each 
+   record is a slot of mt_dim positions in array adj_Arr, where the 
+   i-th position stores the tile adjacent along the facet opposite to 
+   the i-th vertex. Array adj_slot, indexed on tiles, gives the slot of
+   each tile t (if t belongs to the current tesselation), or 0 
+   (otherwise). Free slots are linked in a list through their first
+   position, and adj_Arr is enlarged when all slots are in use.
+   If topology is enabled, such arrays are updated during extraction 
+   and maintain the adjacency information for the extracted tesselation.
+   Otherwise, they are not used.
    */
-   MT_Topo * topo; 
+   MT_INDEX * adj_slot;
+   MT_INDEX * adj_Arr;
+   MT_INDEX slot_max;   /* number of slots allocated in adj_Arr */
+   MT_INDEX slot_top;   /* slots from 1 to slot_top have been used */
+   MT_INDEX slot_free;  /* first free slot among them, 0 if none */
+   MT_INDEX slot_used;  /* number of slots in use */
 
    /*
    Hash table used for adjacency reconstruction.
    */
    MT_HashTable hash_table; 
 
+   /*
+   Candidate adjacent tiles of the facets of the MT (see mt_adj.h), used
+   for adjacency reconstruction in place of the hash table. NULL if not
+   set. In this case, a tile belongs to the current tesselation if and 
+   only if it has an adjacency slot.
+   */
+   MT_AdjTable adj_tbl;
+
+/* ------------------------------------------------------------------------ */
+/*                     Information about vertex stars                       */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Flag if vertex stars are enabled.
+   */
+   int star_enabled;
+
+   /*
+   Vertices of the tiles of the current front, in V_list[1..V_num], and 
+   number of such tiles incident at each of them, in V_count[1..V_num].
+   Array V_pos, indexed on the vertices of the MT, gives the position of
+   each vertex in V_list, or 0. Arrays V_list and V_count have V_max+1 
+   elements, and are enlarged when needed. If vertex stars are enabled,
+   such arrays are updated as tiles enter and leave the current front.
+   Otherwise, they are not used.
+   */
+   MT_INDEX * V_pos;
+   MT_INDEX * V_list;
+   MT_INDEX * V_count;
+   MT_INDEX V_num, V_max;
+
+   /*
+   Vertex stars in compressed row form: the tiles incident at V_list[k]
+   are V_star[V_first[k]] .. V_star[V_first[k+1]-1]. Array V_first has 
+   V_max+2 elements, array V_star star_size elements. They are filled
+   when first requested after a change of the current front, flag 
+   star_ok is 1 if they are up-to-date.
+   */
+   MT_INDEX * V_first;
+   MT_INDEX * V_star;
+   MT_INDEX star_size;
+   short int star_ok;
+
 /* ----------------------------------------------------------------------- */
 /*                          Statistical information                        */
 /* ----------------------------------------------------------------------- */
@@ -260,6 +343,10 @@ class MT_ExtractorClass
                          and swept across the front */
   MT_INDEX t_tested;  /* number of tiles tested against the extraction
                          conditions */
+  unsigned long p_hits;   /* number of page hits of the MT when 
+                             statistics were last reset (paged MT) */
+  unsigned long p_misses; /* number of page misses of the MT when 
+                             statistics were last reset (paged MT) */
 
 /* ------------------------------------------------------------------------ */
 /*                           EXPORTED FUNCTIONS                             */
@@ -298,6 +385,19 @@ class MT_ExtractorClass
    */
    inline MT_Cond MT_TheFilter (void)   {  return (resol_cnd);  }
    inline MT_Cond MT_TheFocus(void)   {  return (place_cnd);  }
+
+   /*
+   Associate a box table with this extractor (see mt_box.h), that must 
+   have been computed for the same MT. If b==NULL, no box table is
+   associated. The box table is used by local extractors (local static, 
+   local dynamic and sparse), which then test an arc against the focus 
+   set through its box, and skip the out-arcs of a node whose box 
+   (covering all its descendants) is outside the focus set. The other
+   extractors ignore it. The extracted tesselation does not change.
+   Return 1 if successful, 0 otherwise.
+   */
+   int MT_SetBoxTable(MT_BoxTable b);
+   inline MT_BoxTable MT_TheBoxTable(void)  {  return (box_tbl);  }
    
 /* ------------------------------------------------------------------------ */
 /*                       Extraction of a tesselation                        */
@@ -323,7 +423,10 @@ class MT_ExtractorClass
    /*
    Return the number of extracted active tiles.
    */
-   inline MT_INDEX MT_ExtractedTilesNum(void) { return ( num_good ); }
+   inline MT_INDEX MT_ExtractedTilesNum(void) 
+   {  if (!tiles_ok) MT_ExtractionCompleted();
+      return ( num_good );
+   }
 
    /*
    Return two arrays containing the extracted active and non-active 
@@ -352,17 +455,34 @@ class MT_ExtractorClass
   */
   inline int MT_AdjGenerationEnabled(void)  {  return (topo_enabled);  }
 
+  /*
+  Associate a candidate table with this extractor (see mt_adj.h), that 
+  must have been computed for the same MT. If c==NULL, no candidate 
+  table is associated. If topology generation is enabled, the adjacent
+  tiles of a tile entering the current tesselation are then searched
+  among the candidates of its facets, instead of through a hash table.
+  The adjacency links do not change.
+  Return 1 if successful, 0 otherwise.
+  */
+  int MT_SetAdjTable(MT_AdjTable c);
+  inline MT_AdjTable MT_TheAdjTable(void)  {  return (adj_tbl);  }
+
   /* 
   Return the i-th tile adjacent to tile t, i.e., the one adjacent to t along 
   the facet opposite to the i-th vertex of t. It must be 0<=0<mt_dim.
   Return MT_NULL_INDEX if the adjacent tile does not exist, or if topology
   generation is disabled.
   */
-  MT_INDEX MT_TileAdj(MT_INDEX t, int i);
+  inline MT_INDEX MT_TileAdj(MT_INDEX t, int i)
+  {  if ( (!topo_enabled) || (t == MT_NULL_INDEX) || (!adj_slot[t]) ) 
+        return MT_NULL_INDEX;
+     return ( adj_Arr[adj_slot[t]*mt_dim+i] );
+  }
 
   /*
   Return the array of tiles adjacent to tile t. Return NULL if topology
-  generation is disabled.
+  generation is disabled. The array is valid until the current
+  tesselation changes.
   */
   MT_INDEX * MT_TileAdjs(MT_INDEX t);
 
@@ -372,6 +492,49 @@ class MT_ExtractorClass
   */
   void MT_CopyTileAdjs(MT_INDEX t, MT_INDEX * ta);
 
+/* ------------------------------------------------------------------------ */
+/*                Vertex stars of the extracted tesselation                 */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Enable (flag==1) or disable (flag==0) the index of the tiles incident
+  at each vertex (the star of the vertex), for the tiles of the current
+  front. The front contains the extracted tiles, and, for the local 
+  dynamic extractor, also the tiles outside the focus set. The index is
+  kept up-to-date by the extraction, and it is disabled if it cannot be
+  enlarged (check with MT_VertexStarsEnabled). It is not available for 
+  the sparse extractor. Return 1 if successful, 0 otherwise.
+  */
+  int MT_SetVertexStars(int flag);
+  inline int MT_VertexStarsEnabled(void)  {  return (star_enabled);  }
+
+  /*
+  Return the number of vertices of the current front. Such vertices are
+  numbered from 1 to MT_StarVertexNum(): return the vertex with number 
+  k, and the number of vertex v (0 if v is not in the current front).
+  The numbers are valid until the current front changes, and may be
+  used to index arrays of size MT_StarVertexNum()+1 instead of arrays
+  indexed on all the vertices of the MT.
+  */
+  inline MT_INDEX MT_StarVertexNum(void)  {  return (V_num);  }
+  inline MT_INDEX MT_StarVertex(MT_INDEX k)  {  return (V_list[k]);  }
+  inline MT_INDEX MT_StarPosition(MT_INDEX v)
+  {  return ( star_enabled ? V_pos[v] : MT_NULL_INDEX );  }
+
+  /*
+  Return the number of tiles incident at vertex v (0 if v is not in
+  the current front, or if vertex stars are disabled).
+  */
+  inline int MT_VertexStarSize(MT_INDEX v)
+  {  return ( (star_enabled && V_pos[v]) ? (int)V_count[V_pos[v]] : 0 );  }
+
+  /*
+  Return the array of the tiles incident at vertex v. Return NULL if v
+  is not in the current front, or if vertex stars are disabled. 
+  The array is valid until the current front changes.
+  */
+  MT_INDEX * MT_VertexStar(MT_INDEX v);
+
 /* ----------------------------------------------------------------------- */
 /*                         Statistical information                         */
 /* ----------------------------------------------------------------------- */
@@ -416,6 +579,16 @@ class MT_ExtractorClass
   inline MT_INDEX MT_VisitedTiles(void) {  return (t_visited);  }
   inline MT_INDEX MT_TestedTiles(void)  {  return (t_tested);  }
 
+  /*
+  Return the number of hits and misses in the page cache of the MT
+  since the statistics were last reset (if enabled, and if the MT is a
+  paged MT). Otherwise return 0.
+  */
+  inline unsigned long MT_PageHits(void)
+  {  return ( stat_enabled ? mt->MT_PageHits() - p_hits : 0 );  }
+  inline unsigned long MT_PageMisses(void)
+  {  return ( stat_enabled ? mt->MT_PageMisses() - p_misses : 0 );  }
+
 /***************************** TAPULLO PER LAVORO CAD ***********************/
 
   protected:  
@@ -457,7 +630,55 @@ class MT_ExtractorClass
                (!resol_cnd) || resol_cnd->MT_EvalCond(mt,t,flag) );
    }            
 
+   /*
+   Test the consecutive tiles from t1 to t2 against the focus set, 
+   as MT_FocusTile, and store the results in res. Return the number 
+   of tiles in the focus set.
+   */
+   inline int MT_FocusTiles(MT_INDEX t1, MT_INDEX t2, int flag,
+                            unsigned char * res)
+   {
+      if (t1==t2) return ( res[0] = (MT_FocusTile(t1,flag) != 0) );
+      if (place_cnd) 
+         return ( place_cnd->MT_EvalCondRange(mt,t1,t2,flag,res) );
+      memset(res, 1, t2-t1+1);
+      return (t2-t1+1);
+   }
+
+   /*
+   Test the box of arc a / of node n against the focus set, in loose
+   mode, and return MT_BOX_OUT, MT_BOX_CROSS or MT_BOX_IN (see 
+   MT_EvalBox in mt_cond.h). Return MT_BOX_CROSS if there is no box 
+   table, and MT_BOX_IN if there is no focus set.
+   */
+   inline int MT_FocusArcBox(MT_INDEX a)
+   {
+      if (!place_cnd) return MT_BOX_IN;
+      if (!box_tbl) return MT_BOX_CROSS;
+      return ( place_cnd->MT_EvalBox(mt, box_tbl->MT_ArcMin(a), 
+                                     box_tbl->MT_ArcMax(a), 
+                                     box_tbl->MT_ArcError(a), MT_LOOSE) );
+   }
+   inline int MT_FocusNodeBox(MT_INDEX n)
+   {
+      if (!box_tbl) return MT_BOX_CROSS;
+      if (box_tbl->MT_EmptyNodeBox(n)) return MT_BOX_OUT;
+      if (!place_cnd) return MT_BOX_IN;
+      return ( place_cnd->MT_EvalBox(mt, box_tbl->MT_NodeMin(n), 
+                                     box_tbl->MT_NodeMax(n), 
+                                     box_tbl->MT_NodeError(n), MT_LOOSE) );
+   }
+
    protected:
+
+   /*
+   Return 1 if some tile of arc a is in the focus set and is not 
+   feasible for the resolution filter (evaluated in loose mode), 
+   i.e., if the extracted tesselation must be refined beyond arc a.
+   The tiles of a are evaluated in groups of MT_TILE_BATCH, and the
+   number of tested tiles is added to tested.
+   */
+   int MT_RefineArc(MT_INDEX a, MT_INDEX * tested);
    
    /* 
    Test whether a node is in the set of nodes before the current front.
@@ -477,6 +698,102 @@ class MT_ExtractorClass
    */
    virtual int MT_AddTiles(MT_INDEX a);
    virtual int MT_RemTiles(MT_INDEX a);
+
+   /*
+   Body of MT_AddTiles and MT_RemTiles, where dim is the number of 
+   vertices of a tile (i.e., mt_dim). They are defined here in order
+   to be expanded with a constant dim by MT_FixedExtractorClass.
+   */
+   inline int MT_AddArcTiles(MT_INDEX a, int dim)
+   {
+     MT_INDEX t, t1; /* variables for tiles */
+     int i, i1;
+
+     if (stat_enabled)
+     {  a_infront++;
+        a_visited++;
+        t_visited += mt->MT_NumArcTiles(a);
+     }
+     tiles_ok = 0;
+     if (topo_enabled && adj_tbl)
+     {
+       /* look for the adjacent tiles among the candidates */
+       t = mt->MT_FirstArcTile(a);
+       while (t != MT_NULL_INDEX)
+       {  MT_LinkCandTile(t);
+          t = mt->MT_NextArcTile(a,t);
+       }
+     }
+     else if (topo_enabled)
+     {
+       /* set adjacency links for the tiles of a, 
+          since they are now inserted in the current tesselation */
+       t = mt->MT_FirstArcTile(a);
+       while (t != MT_NULL_INDEX)
+       {  
+         for (i=0; i<dim; i++)
+         {  
+           if (hash_table->MT_HashGet(i,t,&i1,&t1))
+              MT_SetAdjLink(t,t1,i,i1);
+           else
+              hash_table->MT_HashPut(i,t);
+         }
+         t = mt->MT_NextArcTile(a,t);
+       }
+     }
+     /* on failure the vertex counts are not consistent, thus vertex 
+        stars are disabled */
+     if ( star_enabled && (!MT_AddStarTiles(a)) )  MT_SetVertexStars(0);
+     num_tiles += mt->MT_NumArcTiles(a);
+     return 1;
+   }
+
+   inline int MT_RemArcTiles(MT_INDEX a, int dim)
+   {
+     MT_INDEX t, t1, t2; /* variables for tiles */
+     int i, i1, i2;
+
+     if (stat_enabled)
+     {  a_infront--;
+        a_visited++;
+        t_visited += mt->MT_NumArcTiles(a);
+     }
+     tiles_ok = 0;
+     if (topo_enabled && adj_tbl)
+     {
+       /* unlink the tiles of a, and link again their adjacent tiles */
+       t = mt->MT_FirstArcTile(a);
+       while (t != MT_NULL_INDEX)
+       {  MT_UnlinkCandTile(t);
+          t = mt->MT_NextArcTile(a,t);
+       }
+     }
+     else if (topo_enabled)
+     {
+       /* collect the surviving adjacent tiles of the tiles of a, which
+          are now removed from the current tesselation */
+       t = mt->MT_FirstArcTile(a);
+       while (t != MT_NULL_INDEX)
+       {  
+         for (i=0; i<dim; i++)
+         {  
+           if (!hash_table->MT_HashGet(i,t,&i2,&t2))
+           {
+             if ( (t1 = MT_TileAdj(t,i)) != MT_NULL_INDEX )
+             {
+               i1 = mt->MT_OppositeVertexPosition(t1, t, i);
+               hash_table->MT_HashPut(i1,t1);
+             }
+           }
+         }
+         MT_RemAdjLinks(t);
+         t = mt->MT_NextArcTile(a,t);
+       }
+     }
+     if (star_enabled)  MT_RemStarTiles(a);
+     num_tiles -= mt->MT_NumArcTiles(a);
+     return 1;
+   }
  
    /*
    Set t2 as the j-th adjacent tile to t1. Auxiliary function used 
@@ -497,6 +814,51 @@ class MT_ExtractorClass
    */
    int MT_RemAdjLinks(MT_INDEX t);
 
+   /*
+   Give an adjacency slot, with all positions set to MT_NULL_INDEX, to 
+   tile t. Return the slot, 0 on failure.
+   */
+   MT_INDEX MT_NewAdjSlot(MT_INDEX t);
+
+   /*
+   Enlarge array adj_Arr, if needed, to contain at least n slots.
+   Return 1 on success, 0 on failure.
+   */
+   int MT_GrowAdjSlots(MT_INDEX n);
+
+   /*
+   Update the vertex counts of the vertex stars when the tiles of arc a
+   enter / leave the current front. Return 1 on success, 0 on failure.
+   */
+   int MT_AddStarTiles(MT_INDEX a);
+   void MT_RemStarTiles(MT_INDEX a);
+
+   /*
+   Double the size of arrays V_list, V_count, V_first. 
+   Return 1 on success, 0 on failure.
+   */
+   int MT_GrowStarVertices(void);
+
+   /*
+   Fill the vertex stars of the current front (arrays V_first, V_star).
+   Return 1 on success, 0 on failure.
+   */
+   int MT_BuildStars(void);
+
+   /*
+   Functions used in place of the hash table if a candidate table is 
+   set. MT_FindCandAdj returns the candidate of the i-th facet of t
+   that belongs to the current tesselation, and sets ii to the index of
+   its facet; it returns MT_NULL_INDEX if there is no such candidate.
+   MT_LinkCandTile sets the adjacency links of a tile t entering the
+   current tesselation. MT_UnlinkCandTile deletes the adjacency record
+   of a tile t leaving it, and links again the tiles that were adjacent
+   to t with their other candidates.
+   */
+   MT_INDEX MT_FindCandAdj(MT_INDEX t, int i, int * ii);
+   int MT_LinkCandTile(MT_INDEX t);
+   int MT_UnlinkCandTile(MT_INDEX t);
+
    /*
    Mark node n as belonging to the set of nodes before the front.
    */
@@ -506,6 +868,8 @@ class MT_ExtractorClass
    Sweep the front after a node (and after all its parents that are not yet
    above the front). Add such nodes to the set of nodes above the front, 
    update the current front and tesselation.
+   The ancestors of the node are visited depth-first by using the work
+   stack, thus any number of them can be swept in a single call.
    Return 1 if OK, 0 if some error has occurred.
    */
    virtual int MT_IncludeNode (MT_INDEX n);
@@ -514,8 +878,24 @@ class MT_ExtractorClass
    Advance the current front (and expand the set of nodes above the 
    front, and update the current tesselation) in order to satisfy
    the extraction parameters (resolution filter and focus set).
+   The front is not advanced after the nodes of the MT not yet loaded
+   from a file in the stream encoding (see MT_MultiTesselationClass).
    */
    int MT_ExpandExtractor (void);
+
+   /*
+   Advance the current front as MT_ExpandExtractor, testing just the 
+   front arcs from the one at cursor 0 of A_front to the end of the 
+   list (including the arcs added meanwhile).
+   */
+   int MT_AdvanceFront (void);
+
+   /*
+   Test the front arc at cursor 0 of A_front and advance the cursor,
+   one step of MT_AdvanceFront. Return 0 if the cursor was already at
+   the end of the list, 1 otherwise.
+   */
+   int MT_AdvanceFrontArc (void);
    
    /* 
    Put the extractor in the initial state (current front just below
@@ -523,16 +903,34 @@ class MT_ExtractorClass
    */
    int MT_ResetExtractor (void);
 
+   /*
+   Empty the set of nodes above the front, the front and the current
+   tesselation. Used by MT_ResetExtractor before sweeping the root.
+   */
+   void MT_ClearExtractor (void);
+
    /*
    Update the array of extracted tiles at the end of DAG traversal.
    */
    virtual int MT_ExtractionCompleted(void);
+
+   /*
+   Put the tiles of arc a into the array of extracted tiles, the
+   active ones at position i (moving forward), the non-active ones
+   at position j (moving backward). Auxiliary function used inside
+   MT_ExtractionCompleted.
+   */
+   void MT_PutArcTiles(MT_INDEX a, int * i, int * j);
   
    /*
    Create an extractor, allocate the internal structures.
    If topo_flag == 1, enable generation of topological information.
+   If dense_flag == 0, arrays N_set, W_node, W_arc and list A_front
+   are not allocated (for subclasses keeping the state of the traversal
+   in other structures).
    */
-   MT_ExtractorClass(MT_MultiTesselation m, int topo_flag = MT_ADJ_DISABLE);
+   MT_ExtractorClass(MT_MultiTesselation m, int topo_flag = MT_ADJ_DISABLE,
+                     int dense_flag = 1);
 
    public:
 
@@ -572,157 +970,545 @@ class MT_StaticExtractorClass : public MT_ExtractorClass
 };
 
 /* ------------------------------------------------------------------------ */
-/*                       GLOBAL DYNAMIC EXTRACTOR                           */
+/*                     GLOBAL PARALLEL STATIC EXTRACTOR                     */
 /* ------------------------------------------------------------------------ */
 
-typedef class MT_DynamicExtractorClass * MT_DynamicExtractor;
+/*
+Number of jobs per thread into which the scans of the nodes and of the
+front are split.
+*/
+#define MT_JOBS_PER_THREAD 4
 
-class MT_DynamicExtractorClass : public MT_ExtractorClass
+/*
+The parallel extractor finds the set of nodes above the front with a
+visit of the DAG where several threads sweep nodes at the same time.
+Sweeping a node adds its parents to the set, and tests the tiles of
+the arcs leaving it against the extraction conditions: if some tile
+must be refined, the destination of the arc is added to the set.
+A node is added by setting its marker in N_set as an atomic operation,
+and the thread that has added it sweeps it, or leaves it to another
+thread (see MT_RunTasks).
+
+The resulting set of nodes, thus the front and the extracted tiles, are
+the same as for the global static extractor, because both contain
+just the nodes that must be swept because of the extraction conditions.
+The front arcs are ordered by source node (then by arc), instead of 
+the order in which they are reached, thus the extracted tiles may be in
+a different order.
+
+If adjacency generation is enabled, the adjacency links are not set 
+while the front is built, but at the end, for all extracted tiles 
+together (see MT_ParallelAdjLinks). Each facet of each tile gets a key
+computed from its vertices, the keys are sorted with a parallel radix
+sort, and tiles whose facets have equal keys and the same vertices
+are linked. A tile in position k in the array of extracted tiles gets
+adjacency slot k+1.
+
+The extraction conditions must be safe to evaluate in several threads
+at the same time (those of the library are). The extraction is done by
+the serial algorithm of the global static extractor if the MT is paged,
+if an upper bound to the number of tiles has been set, or if a single
+thread is used (see MT_SetThreadNum).
+*/
+
+/*
+Number of bits of the digits of the radix sort of facet keys.
+*/
+#define MT_RADIX_BITS 8
+#define MT_RADIX_SIZE (1<<MT_RADIX_BITS)
+
+/*
+Facet key: hash code of the vertices of a facet, and the facet coded
+as (k+1)*mt_dim+i, i.e., its position in the array of adjacency slots, 
+where k is the position of the tile in the array of extracted tiles 
+and i is the vertex opposite to the facet.
+*/
+typedef struct MT_FacetKeyStruct
+{
+  MT_INDEX my_key;
+  MT_INDEX my_code;
+} MT_FacetKey;
+
+typedef class MT_ParallelExtractorClass * MT_ParallelExtractor;
+
+class MT_ParallelExtractorClass : public MT_StaticExtractorClass
 {
    protected:
+
+   /*
+   Front arcs found by the scan of the nodes, where job j of the scan 
+   has found arcs P_first[j] .. P_first[j+1]-1. Array P_tile contains 
+   the position of the first tile of such arcs in the extracted 
+   tesselation, array P_good the number of active tiles among them.
+   */
+   MT_INDEX * P_arc;
+   MT_INDEX P_first[MT_MAX_THREADS*MT_JOBS_PER_THREAD+1];
+   MT_INDEX P_tile[MT_MAX_THREADS*MT_JOBS_PER_THREAD+1];
+   MT_INDEX P_good[MT_MAX_THREADS*MT_JOBS_PER_THREAD+1];
    
-/*------------------------------------------------------------------------ */
-/*      Additional information on the current state of DAG traversal       */
-/*------------------------------------------------------------------------ */
+   /*
+   Number of jobs, and current pass of the jobs (one of the values 
+   MT_COUNT_PASS, MT_FILL_PASS, MT_FOCUS_PASS, MT_TILE_PASS, and, for
+   adjacency links, MT_SLOT_PASS, MT_DIGIT_PASS, MT_SORT_PASS, 
+   MT_LINK_PASS defined in mt_extra.c).
+   */
+   int P_job_num;
+   int P_pass;
 
    /*
-   Array N_set stores a counter used to detect whether a node is in the
-   set of nodes before the front and whether it is a free node (a leaf).
-   For nodes not in the set, the counter is == 0.
-   For nodes in the set, it is == 1 plus the number of children in the set.
-   Note that a node not in the set cannot have children in the set.
+   For each position in the extracted tesselation, 1 if the tile in
+   such position is active.
    */
+   unsigned char * P_active;
+   MT_INDEX P_active_size;
 
    /*
-   List of leaves (free nodes) of the current sub-DAG. A node is a leaf
-   if its counter in N_set is == 1.
+   Statistics collected by each thread: nodes swept, arcs tested and
+   tiles tested.
    */
-   MT_List N_free;
+   MT_INDEX P_stat[MT_MAX_THREADS][3];
 
-   public:
+   /*
+   Keys of the facets of the extracted tiles, and auxiliary array for
+   the radix sort, each of P_key_size elements. Allocated only if 
+   adjacency generation is enabled.
+   */
+   MT_FacetKey * P_key;
+   MT_FacetKey * P_key_aux;
+   MT_INDEX P_key_size;
+
+   /*
+   For the radix sort, bit shift of the current digit, and, for each
+   job, number of keys with each value of the digit (then position in
+   P_key_aux of the next such key), in P_digit[job*MT_RADIX_SIZE+value].
+   */
+   int P_shift;
+   MT_INDEX * P_digit;
 
 /* ------------------------------------------------------------------------ */
-/*                         creation and deletion                            */
+/*                        creation and deletion                             */
 /* ------------------------------------------------------------------------ */
 
+   public:
+
    /*
    Create extractor for a given MT and put it in initial state:
    the current front is the one formed by the out-arcs of the root.
    */
-   MT_DynamicExtractorClass (MT_MultiTesselation m, 
-                             int topo_flag = MT_ADJ_DISABLE);
+   MT_ParallelExtractorClass (MT_MultiTesselation m,
+                              int topo_flag = MT_ADJ_DISABLE);
 
    /* 
    Destroy extractor, deallocate its internal variables.
    */
-   ~MT_DynamicExtractorClass (void);
+   ~MT_ParallelExtractorClass (void);
 
 /* ------------------------------------------------------------------------ */
-/*                Update of the extracted tesselation                       */
+/*                       Extraction of a tesselation                        */
 /* ------------------------------------------------------------------------ */
 
-   MT_INDEX MT_ExtractTesselation( void ); 
-   
+   /*
+   Function redefined from superclass MT_ExtractorClass.
+   */
+   MT_INDEX MT_ExtractTesselation( void );
+
 /* ------------------------------------------------------------------------ */
 /*                          Auxiliary functions                             */
 /* ------------------------------------------------------------------------ */
 
    protected:
- 
-   /*
-   Increment the counter of n in N_set and return the incremented counter.
-   */
-   inline int MT_IncrCount(MT_INDEX n)  { return ( ++N_set[n] ); }
 
-   /* 
-   Decrement the counter of n in N_set and return the decremented counter.
+   /*
+   Find the set of nodes above the front with several threads, and 
+   build the front and the current tesselation from it.
+   Return 1 if OK, 0 if some error has occurred.
    */
-   inline int MT_DecrCount(MT_INDEX n)  { return ( --N_set[n] ); }
+   int MT_ParallelExpand (void);
 
    /*
-   Sweep the current front before a node (which must be a leaf), remove
-   the leaf from the set of nodes above the front, update the front
-   and the extracted tesselation, update the set of leaves.
+   Fill the array of extracted tiles with several threads. 
    Return 1 if OK, 0 if some error has occurred.
    */
-   virtual int MT_ExcludeNode (MT_INDEX n);
+   int MT_ParallelCompleted (void);
 
    /*
-   Move the current front backwards (shrink the set of nodes above the
-   front and coarsen the current tesselation) as long as the
-   extraction parameters allow it.
+   Set the adjacency links of the extracted tiles with several threads.
+   Return 1 if OK, 0 if some error has occurred.
    */
-   int MT_ContractExtractor (void);
+   int MT_ParallelAdjLinks (void);
 
    /*
-   Redefined functions on the set of nodes before the front.
-   A node is in the set if its counter in N_set is != 0.
+   Sweep a node which has been added to the set (task of MT_RunTasks).
    */
-   int MT_IsInSet(MT_INDEX n);
+   void MT_SweepNode (MT_TaskPool pool, int worker, MT_INDEX n);
 
    /*
-   Mark a node as inserted in / removed from the set of nodes above the
-   current front. Update the list of leaves accordingly.
+   Execute a job of the current pass.
    */
-   void MT_AddToSet(MT_INDEX n);
-   void MT_RemFromSet(MT_INDEX n);
-         
+   void MT_ParallelJob (int job);
+
+   friend void MT_ParallelSweepTask (void * data, MT_TaskPool pool,
+                                     int worker, MT_INDEX n);
+   friend void MT_ParallelJobTask (void * data, int job);
 };
 
 /* ------------------------------------------------------------------------ */
-/*                       LOCAL STATIC EXTRACTOR                             */
+/*                       GLOBAL DYNAMIC EXTRACTOR                           */
 /* ------------------------------------------------------------------------ */
 
-typedef class MT_LocalExtractorClass * MT_LocalExtractor;
+typedef class MT_DynamicExtractorClass * MT_DynamicExtractor;
 
-class MT_LocalExtractorClass : public MT_ExtractorClass
+class MT_DynamicExtractorClass : public MT_ExtractorClass
 {
-
    protected:
    
+/*------------------------------------------------------------------------ */
+/*      Additional information on the current state of DAG traversal       */
+/*------------------------------------------------------------------------ */
+
    /*
-   The following two arrays are used to speed-up the algorithm:
-   they store results of tests MT_FocusArc(a) already performed.
-   Both arrays are indexed on arcs. For each arc they store a marker 
-   whether MT_FocusArc(a) has been evaluated with a positive / negative
-   result, respectively.
-   A_pos e A_neg use for arcs the same marking value (extr_count) used for 
-   nodes in N_set.
+   Array N_set stores a counter used to detect whether a node is in the
+   set of nodes before the front and whether it is a free node (a leaf).
+   For nodes not in the set, the counter is == 0.
+   For nodes in the set, it is == 1 plus the number of children in the set.
+   Note that a node not in the set cannot have children in the set.
    */
-   unsigned int * A_pos;
-   unsigned int * A_neg;
 
-   public:
-   
-/* ------------------------------------------------------------------------ */
-/*                        creation and deletion                             */
-/* ------------------------------------------------------------------------ */
+   /*
+   List of leaves (free nodes) of the current sub-DAG. A node is a leaf
+   if its counter in N_set is == 1.
+   */
+   MT_List N_free;
+
+/*------------------------------------------------------------------------ */
+/*          Changes of the extracted tesselation (delta mode)              */
+/*------------------------------------------------------------------------ */
 
    /*
-   Create extractor for a given MT and put it in initial state:
-   the current front is the one formed by the out-arcs of the root.
+   Flag if the delta mode is enabled.
    */
-   MT_LocalExtractorClass (MT_MultiTesselation m,
-                           int topo_flag = MT_ADJ_DISABLE);
+   int delta_enabled;
 
-   /* 
-   Destroy extractor, deallocate its internal variables.
+   /*
+   Buffer of the extracted tiles, updated in place: D_tiles contains the 
+   D_num extracted tiles, in no particular order, and D_pos[t] is the 
+   position of tile t in D_tiles (if t is extracted).
    */
-   ~MT_LocalExtractorClass (void);
+   MT_INDEX * D_tiles;
+   MT_INDEX * D_pos;
+   MT_INDEX D_num;
 
-/* ------------------------------------------------------------------------ */
-/*                          Auxiliary functions                             */
-/* ------------------------------------------------------------------------ */
-   
-   protected:
+   /*
+   Tiles added to / removed from D_tiles by the last extraction. 
+   One array contains first the D_added added tiles and then, from the
+   end of the array backwards, the D_removed removed tiles.
+   */
+   MT_INDEX * D_change;
+   MT_INDEX D_added;
+   MT_INDEX D_removed;
 
    /*
-   Function redefined from superclass MT_ExtractorClass.
+   Arcs that entered or left the front during the current extraction, 
+   and their number. Arrays indexed on arcs: A_moved[a] == 1 if a is
+   in D_arcs, A_inbuf[a] == 1 if the tiles of a are in D_tiles.
    */
-   virtual int MT_IncludeNode (MT_INDEX n);
-   
-   /* 
-   Test whether at least one tile labelling the arc is active.
+   MT_INDEX * D_arcs;
+   MT_INDEX D_arcnum;
+   unsigned char * A_moved;
+   unsigned char * A_inbuf;
+
+/*------------------------------------------------------------------------ */
+/*                     Time-sliced extraction                              */
+/*------------------------------------------------------------------------ */
+
+   /*
+   Stage of the current sliced extraction: MT_SLICE_DONE if no extraction
+   is in progress, MT_SLICE_EXPAND / MT_SLICE_CONTRACT if it has been
+   interrupted in the expansion / contraction stage.
+   */
+   int slice_stage;
+
+   /*
+   Maximum number of steps (front arcs or leaves tested) and maximum
+   time in seconds of a slice (0 = no limit).
+   */
+   MT_INDEX slice_steps;
+   double slice_time;
+
+   /*
+   Number of front arcs and of leaves tested by the current sliced 
+   extraction.
+   */
+   MT_INDEX slice_arcs;
+   MT_INDEX slice_leaves;
+
+   public:
+
+/* ------------------------------------------------------------------------ */
+/*                         creation and deletion                            */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Create extractor for a given MT and put it in initial state:
+   the current front is the one formed by the out-arcs of the root.
+   */
+   MT_DynamicExtractorClass (MT_MultiTesselation m, 
+                             int topo_flag = MT_ADJ_DISABLE);
+
+   /* 
+   Destroy extractor, deallocate its internal variables.
+   */
+   ~MT_DynamicExtractorClass (void);
+
+/* ------------------------------------------------------------------------ */
+/*                Update of the extracted tesselation                       */
+/* ------------------------------------------------------------------------ */
+
+   MT_INDEX MT_ExtractTesselation( void ); 
+
+/* ------------------------------------------------------------------------ */
+/*          Changes of the extracted tesselation (delta mode)              */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   In delta mode, the extractor keeps a buffer containing all extracted
+   tiles (active and non-active), and updates it in place at each 
+   extraction, by adding and removing just the tiles which have changed.
+   The added and the removed tiles are also available. Thus, the cost 
+   of an extraction depends on the changes and not on the size of the 
+   extracted tesselation. 
+   In delta mode, MT_ExtractTesselation does not fill the arrays of 
+   active and non-active tiles, and returns the total number of 
+   extracted tiles. Such arrays are filled (by testing all extracted 
+   tiles against the focus condition) only if they are requested 
+   (e.g., through MT_ExtractedTiles).
+   */
+
+   /*
+   Enable delta mode. The buffer is filled with the current extracted 
+   tesselation, and the lists of added and removed tiles are empty.
+   Return 1 if successful, 0 otherwise.
+   */
+   virtual int MT_EnableDelta(void);
+
+   /*
+   Disable delta mode, deallocate the buffers.
+   */
+   void MT_DisableDelta(void);
+
+   /*
+   Check if delta mode is enabled.
+   */
+   inline int MT_DeltaEnabled(void)  {  return (delta_enabled);  }
+
+   /*
+   Return the buffer containing all extracted tiles, and its size.
+   The buffer belongs to the extractor, and it is valid until the next
+   extraction. Tiles are in no particular order, and their position
+   changes only if some tile is removed.
+   */
+   inline MT_INDEX MT_CurrentTiles(MT_INDEX ** t_arr)
+   {  (*t_arr) = D_tiles;  return (D_num);  }
+
+   /*
+   Return an array containing the tiles added to / removed from the 
+   extracted tesselation by the last extraction, and its size.
+   Such arrays belong to the extractor, and are valid until the next 
+   extraction. 
+   */
+   inline MT_INDEX MT_AddedTiles(MT_INDEX ** t_arr)
+   {  (*t_arr) = D_change;  return (D_added);  }
+   inline MT_INDEX MT_RemovedTiles(MT_INDEX ** t_arr)
+   {  (*t_arr) = D_change + (mt->MT_TileNum() - D_removed);  
+      return (D_removed);
+   }
+
+/* ------------------------------------------------------------------------ */
+/*                     Time-sliced extraction                               */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   An extraction may be split into slices, each one doing a limited 
+   amount of work (e.g., one slice per frame of an animation), through
+   MT_ExtractSlice. The front is moved node by node, thus after each
+   slice the extracted tesselation is a valid one (with no cracks),
+   which is intermediate between the one before the extraction and the
+   one satisfying the current conditions. The next slice continues the
+   extraction from where the previous one stopped, using the conditions 
+   current at that time; when the extraction is completed, the next 
+   slice starts a new one.
+   */
+
+   /*
+   Set and return the maximum number of steps of a slice, where a step
+   is the test of a front arc or of a leaf (0 = no limit).
+   */
+   inline void MT_SetSliceSteps(MT_INDEX n)  {  slice_steps = n;  }
+   inline MT_INDEX MT_TheSliceSteps(void)  {  return (slice_steps);  }
+
+   /*
+   Set and return the maximum time of a slice, in seconds (0 = no limit).
+   The time is checked every MT_SLICE_CHECK steps.
+   */
+   inline void MT_SetSliceTime(double sec)  {  slice_time = sec;  }
+   inline double MT_TheSliceTime(void)  {  return (slice_time);  }
+
+   /*
+   Perform one slice of the extraction, update the extracted tiles and 
+   return their number as MT_ExtractTesselation.
+   */
+   virtual MT_INDEX MT_ExtractSlice(void);
+
+   /*
+   Return 1 if the last slice has completed the extraction, 0 if the
+   extraction is in progress.
+   */
+   inline int MT_SliceConverged(void)  
+   {  return ( slice_stage == MT_SLICE_DONE );  }
+
+   /*
+   Return an estimate of the fraction of the current extraction which 
+   has been done (1 if completed), based on the front arcs and leaves 
+   tested so far and on those still to be tested. It takes time 
+   proportional to the number of the latter ones.
+   */
+   float MT_SliceProgress(void);
+   
+/* ------------------------------------------------------------------------ */
+/*                          Auxiliary functions                             */
+/* ------------------------------------------------------------------------ */
+
+   protected:
+ 
+   /*
+   Increment the counter of n in N_set and return the incremented counter.
+   */
+   inline int MT_IncrCount(MT_INDEX n)  { return ( ++N_set[n] ); }
+
+   /* 
+   Decrement the counter of n in N_set and return the decremented counter.
+   */
+   inline int MT_DecrCount(MT_INDEX n)  { return ( --N_set[n] ); }
+
+   /*
+   Sweep the current front before a node (which must be a leaf), remove
+   the leaf from the set of nodes above the front, update the front
+   and the extracted tesselation, update the set of leaves.
+   Return 1 if OK, 0 if some error has occurred.
+   */
+   virtual int MT_ExcludeNode (MT_INDEX n);
+
+   /*
+   Move the current front backwards (shrink the set of nodes above the
+   front and coarsen the current tesselation) as long as the
+   extraction parameters allow it.
+   */
+   int MT_ContractExtractor (void);
+
+   /*
+   The two parts of MT_ContractExtractor: put cursor 0 of N_free on the
+   first leaf to be tested, and test the leaf at cursor 0 and advance 
+   the cursor. MT_ContractLeaf returns 0 if there is no leaf to be 
+   tested, 1 otherwise.
+   */
+   void MT_ContractInit (void);
+   int MT_ContractLeaf (void);
+
+   /*
+   Return 1 if leaf n must be kept, i.e., if some arc entering n must
+   be refined (see MT_RefineArc). The number of tested tiles is added 
+   to tested.
+   */
+   virtual int MT_KeepLeaf (MT_INDEX n, MT_INDEX * tested);
+
+   /*
+   Redefined functions on the set of nodes before the front.
+   A node is in the set if its counter in N_set is != 0.
+   */
+   int MT_IsInSet(MT_INDEX n);
+
+   /*
+   Mark a node as inserted in / removed from the set of nodes above the
+   current front. Update the list of leaves accordingly.
+   */
+   void MT_AddToSet(MT_INDEX n);
+   void MT_RemFromSet(MT_INDEX n);
+
+   /*
+   Functions redefined from superclass MT_ExtractorClass, recording
+   the arcs that enter / leave the front in delta mode.
+   */
+   int MT_AddTiles(MT_INDEX a);
+   int MT_RemTiles(MT_INDEX a);
+
+   /*
+   Record arc a in D_arcs (if not already there).
+   */
+   inline void MT_MoveArc(MT_INDEX a)
+   {  if (!A_moved[a])  {  A_moved[a] = 1;  D_arcs[D_arcnum++] = a;  }  }
+
+   /*
+   Update D_tiles, and the added and removed tiles, at the end of an 
+   extraction in delta mode, based on the arcs in D_arcs.
+   */
+   void MT_DeltaCompleted(void);
+         
+};
+
+/* ------------------------------------------------------------------------ */
+/*                       LOCAL STATIC EXTRACTOR                             */
+/* ------------------------------------------------------------------------ */
+
+typedef class MT_LocalExtractorClass * MT_LocalExtractor;
+
+class MT_LocalExtractorClass : public MT_ExtractorClass
+{
+
+   protected:
+   
+   /*
+   The following two arrays are used to speed-up the algorithm:
+   they store results of tests MT_FocusArc(a) already performed.
+   Both arrays are indexed on arcs. For each arc they store a marker 
+   whether MT_FocusArc(a) has been evaluated with a positive / negative
+   result, respectively.
+   A_pos e A_neg use for arcs the same marking value (extr_count) used for 
+   nodes in N_set.
+   */
+   unsigned int * A_pos;
+   unsigned int * A_neg;
+
+   public:
+   
+/* ------------------------------------------------------------------------ */
+/*                        creation and deletion                             */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Create extractor for a given MT and put it in initial state:
+   the current front is the one formed by the out-arcs of the root.
+   */
+   MT_LocalExtractorClass (MT_MultiTesselation m,
+                           int topo_flag = MT_ADJ_DISABLE);
+
+   /* 
+   Destroy extractor, deallocate its internal variables.
+   */
+   ~MT_LocalExtractorClass (void);
+
+/* ------------------------------------------------------------------------ */
+/*                          Auxiliary functions                             */
+/* ------------------------------------------------------------------------ */
+   
+   protected:
+
+   /*
+   Function redefined from superclass MT_ExtractorClass.
+   */
+   virtual int MT_IncludeNode (MT_INDEX n);
+   
+   /* 
+   Test whether at least one tile labelling the arc is active.
    */
    int MT_FocusArc(MT_INDEX a);
    
@@ -735,6 +1521,889 @@ class MT_LocalExtractorClass : public MT_ExtractorClass
    
 };
 
+/* ------------------------------------------------------------------------ */
+/*                       LOCAL DYNAMIC EXTRACTOR                            */
+/* ------------------------------------------------------------------------ */
+
+/*
+The local dynamic extractor keeps the set of nodes before the front, and
+updates it as the global dynamic extractor. The whole front is kept,
+but only its arcs interfering with the focus set are considered:
+
+- the front arcs interfering with the focus set are found by a visit of 
+  the nodes before the front, starting from the root and following the
+  arcs interfering with the focus set (as in the local static extractor);
+  the expansion tests such arcs, and the arcs which enter the front
+  meanwhile;
+- the contraction tests the leaves of the set of nodes (as in the global
+  dynamic extractor), which are near the previous focus set, since 
+  all other leaves have been removed by the previous extraction; the
+  arcs entering a leaf are tested on their tiles only if they may 
+  interfere with the current focus set, thus a leaf which has left
+  the focus set is removed without testing its tiles;
+- the extracted tiles are those of the front arcs interfering with the 
+  focus set, as for the local static extractor; they are found among
+  the arcs of the visit done before the expansion and the arcs which 
+  have entered the front after it, without visiting the set again.
+
+Thus, the cost of an extraction depends on the portion of the MT which
+interferes with the current focus set and on the change of the focus
+set, and not on the size of the whole front. If adjacency generation
+is enabled, the adjacency links refer to the whole front, thus a tile
+adjacent to an extracted tile may be not extracted. Delta mode is not
+available.
+*/
+
+typedef class MT_LocalDynamicExtractorClass * MT_LocalDynamicExtractor;
+
+class MT_LocalDynamicExtractorClass : public MT_DynamicExtractorClass
+{
+
+   protected:
+
+   /*
+   Results of tests MT_FocusArc(a) already performed in the current 
+   extraction, as in MT_LocalExtractorClass.
+   */
+   unsigned int * A_pos;
+   unsigned int * A_neg;
+
+   /*
+   Array indexed on nodes, marking the nodes reached by the current visit 
+   of MT_CollectFocusArcs with value visit_count.
+   */
+   unsigned int * N_visit;
+   unsigned int visit_count;
+
+   /*
+   Front arcs interfering with the focus set, as found by the last call 
+   of MT_CollectFocusArcs. During an extraction, the F_num entries of 
+   F_arc are followed by the arcs entering the front, which are marked
+   in A_cand with value extr_count so that each one is added once.
+   If F_update is set, MT_ExtractionCompleted takes the extracted tiles
+   from such arcs instead of visiting the set of nodes again.
+   */
+   MT_INDEX * F_arc;
+   MT_INDEX F_num;
+   unsigned int * A_cand;
+   int F_update;
+
+   /*
+   Number of tiles of the whole front. During the update of the front,
+   it is kept in num_tiles, which then becomes the number of extracted 
+   tiles.
+   */
+   MT_INDEX front_tiles;
+
+   public:
+   
+/* ------------------------------------------------------------------------ */
+/*                        creation and deletion                             */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Create extractor for a given MT and put it in initial state:
+   the current front is the one formed by the out-arcs of the root.
+   */
+   MT_LocalDynamicExtractorClass (MT_MultiTesselation m,
+                                  int topo_flag = MT_ADJ_DISABLE);
+
+   /* 
+   Destroy extractor, deallocate its internal variables.
+   */
+   ~MT_LocalDynamicExtractorClass (void);
+
+/* ------------------------------------------------------------------------ */
+/*                Update of the extracted tesselation                       */
+/* ------------------------------------------------------------------------ */
+
+   MT_INDEX MT_ExtractTesselation( void ); 
+
+   /*
+   Delta mode is not available, return 0.
+   */
+   int MT_EnableDelta(void);
+
+   /*
+   Time-sliced extraction is not available, each slice performs a 
+   whole extraction.
+   */
+   inline MT_INDEX MT_ExtractSlice(void)  {  return MT_ExtractTesselation();  }
+
+/* ------------------------------------------------------------------------ */
+/*                          Auxiliary functions                             */
+/* ------------------------------------------------------------------------ */
+   
+   protected:
+
+   /* 
+   Test whether at least one tile labelling the arc is active, as in
+   MT_LocalExtractorClass.
+   */
+   int MT_FocusArc(MT_INDEX a);
+   inline int MT_HintYes(MT_INDEX a) {  return ( A_pos[a] == extr_count );  }
+   inline int MT_HintNot(MT_INDEX a) {  return ( A_neg[a] == extr_count );  }
+
+   /*
+   Store into F_arc the front arcs interfering with the focus set, 
+   return their number.
+   */
+   MT_INDEX MT_CollectFocusArcs(void);
+
+   /*
+   Advance the front, testing the front arcs interfering with the focus 
+   set and those entering the front meanwhile.
+   */
+   int MT_LocalExpand(void);
+
+   /*
+   Function redefined from superclass MT_ExtractorClass: the extracted
+   tiles are those of the front arcs interfering with the focus set.
+   */
+   int MT_ExtractionCompleted(void);
+
+   /*
+   Functions redefined from superclass MT_DynamicExtractorClass: during
+   an extraction, a node added to the set is marked in N_visit if the
+   visit of MT_CollectFocusArcs would reach it, and an arc entering the
+   front is added to F_arc.
+   */
+   void MT_AddToSet(MT_INDEX n);
+   int MT_AddTiles(MT_INDEX a);
+
+   /*
+   Function redefined from superclass MT_DynamicExtractorClass: the arcs
+   entering n which do not interfere with the focus set, as told by their
+   box or by MT_FocusArc in the current extraction, are not tested.
+   */
+   int MT_KeepLeaf (MT_INDEX n, MT_INDEX * tested);
+};
+
+/* ------------------------------------------------------------------------ */
+/*                          BUDGETED EXTRACTOR                              */
+/* ------------------------------------------------------------------------ */
+
+/*
+The budgeted extractor extracts tesselations with at most a given number
+of tiles (the budget), spending the tiles where they are most needed. 
+A tile needs refinement if it is in the focus set and not feasible for 
+the resolution filter (if there is no filter, every tile in the focus
+set needs refinement, and only the budget limits the extraction).
+Among the front arcs containing such tiles, the one with the highest
+priority is refined first, where the priority of an arc is the highest
+priority (see MT_PriorityClass in mt_cond.h) of such tiles. An arc is 
+refined only if this does not make the extracted tiles more than the 
+budget, otherwise it is skipped and the next one is considered.
+The extraction stops when no front arc needing refinement can be 
+refined within the budget.
+If no priority is set, all tiles have the same priority, and arcs are
+refined in an unspecified order.
+
+The extractor keeps the set of nodes before the front as the global 
+dynamic extractor. At each extraction, it either starts from the
+coarsest tesselation (default), or it starts from the previously
+extracted tesselation (incremental mode). In incremental mode, first 
+the front is moved back before all nodes that are not needed by the
+current conditions (as in the contraction of the dynamic extractor);
+then, if the extracted tiles are more than the budget, the front is 
+moved back before the nodes whose removal re-introduces the tiles with
+the lowest priority, until the budget is satisfied; then the front is 
+advanced as above. Thus, the result may be different from the one of 
+a non-incremental extraction with the same conditions, but the cost of 
+an extraction depends on the changes from the previous one.
+*/
+
+typedef class MT_BudgetExtractorClass * MT_BudgetExtractor;
+
+class MT_BudgetExtractorClass : public MT_DynamicExtractorClass
+{
+
+   protected:
+
+   /*
+   Priority of tiles, and maximum number of extracted tiles.
+   */
+   MT_Priority prio_fun;
+   MT_INDEX tile_budget;
+
+   /*
+   Flag if the incremental mode is enabled.
+   */
+   int incr_enabled;
+
+   /*
+   Front arcs to be refined (highest priority first), and those skipped
+   because the budget was exceeded. 
+   */
+   MT_Heap Q_split;
+   MT_Heap Q_wait;
+
+   /*
+   Leaves of the set of nodes before the front to be removed from the 
+   set (lowest priority first, i.e., with the opposite of their
+   priority).
+   */
+   MT_Heap Q_merge;
+
+   /*
+   Flags set while arcs entering the front must be put in Q_split, and
+   while nodes becoming leaves must be put in Q_merge.
+   */
+   int splitting;
+   int merging;
+
+   /*
+   Array indexed on nodes, marking the nodes reached by the current call
+   of MT_IncludeCost with value cost_count.
+   */
+   unsigned int * N_cost;
+   unsigned int cost_count;
+
+   /*
+   Minimum change in the number of tiles caused by sweeping a node 
+   (other than the root). If it is positive, the refinement stops as
+   soon as the budget leaves less tiles than that.
+   */
+   long min_cost;
+
+   public:
+
+/* ------------------------------------------------------------------------ */
+/*                        creation and deletion                             */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Create extractor for a given MT and budget, and put it in initial 
+   state: the current front is the one formed by the out-arcs of the root.
+   */
+   MT_BudgetExtractorClass (MT_MultiTesselation m, MT_INDEX budget,
+                            int topo_flag = MT_ADJ_DISABLE);
+
+   /* 
+   Destroy extractor, deallocate its internal variables.
+   */
+   ~MT_BudgetExtractorClass (void);
+
+/* ------------------------------------------------------------------------ */
+/*                  Setting the budget and the priority                     */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Set and return the maximum number of extracted tiles.
+   */
+   inline void MT_SetBudget(MT_INDEX n)  {  tile_budget = n;  }
+   inline MT_INDEX MT_TheBudget(void)  {  return (tile_budget);  }
+
+   /*
+   Associate a priority with this extractor. If p==NULL, then all tiles 
+   have the same priority. Return 1 if successful, 0 otherwise.
+   */
+   int MT_SetPriority(MT_Priority p);
+   inline MT_Priority MT_ThePriority(void)  {  return (prio_fun);  }
+
+   /*
+   Enable and disable the incremental mode, check if it is enabled.
+   */
+   inline void MT_EnableIncremental(void)  {  incr_enabled = 1;  }
+   inline void MT_DisableIncremental(void)  {  incr_enabled = 0;  }
+   inline int MT_IncrementalEnabled(void)  {  return (incr_enabled);  }
+
+/* ------------------------------------------------------------------------ */
+/*                Update of the extracted tesselation                       */
+/* ------------------------------------------------------------------------ */
+
+   MT_INDEX MT_ExtractTesselation( void ); 
+
+   /*
+   Time-sliced extraction is not available (the budget already bounds 
+   the size of the extracted tesselation), each slice performs a whole
+   extraction.
+   */
+   inline MT_INDEX MT_ExtractSlice(void)  {  return MT_ExtractTesselation();  }
+
+/* ------------------------------------------------------------------------ */
+/*                          Auxiliary functions                             */
+/* ------------------------------------------------------------------------ */
+   
+   protected:
+
+   /*
+   Return 1 if arc a contains some tile that needs refinement, and the
+   node beyond a has been loaded, and store in p the highest priority
+   of such tiles. Return 0 otherwise.
+   */
+   int MT_SplitPriority(MT_INDEX a, float * p);
+
+   /*
+   Return the highest priority of the arcs entering node n which
+   contain tiles that need refinement (i.e., the priority of the tiles 
+   that removing n from the set of nodes re-introduces in the extracted
+   tesselation).
+   */
+   float MT_MergePriority(MT_INDEX n);
+
+   /*
+   Return the change in the number of extracted tiles which would be 
+   caused by MT_IncludeNode(n).
+   */
+   long MT_IncludeCost(MT_INDEX n);
+
+   /*
+   Remove from the set of nodes before the front all the leaves not 
+   needed by the current conditions, and so on for the new leaves.
+   If all == 1, remove all nodes except the root.
+   */
+   void MT_BudgetContract(int all);
+
+   /*
+   Remove the leaves with the lowest priority from the set of nodes 
+   before the front, until the extracted tiles are within the budget.
+   */
+   void MT_BudgetCoarsen(void);
+
+   /*
+   Advance the front, refining the front arcs in order of priority
+   within the budget.
+   */
+   void MT_BudgetRefine(void);
+
+   /*
+   Functions redefined from superclass MT_DynamicExtractorClass,
+   which also put the new front arcs in Q_split, and the new leaves
+   in Q_merge, when required.
+   */
+   int MT_AddTiles(MT_INDEX a);
+   int MT_ExcludeNode(MT_INDEX n);
+};
+
+/* ------------------------------------------------------------------------ */
+/*                        SPARSE LOCAL EXTRACTOR                            */
+/* ------------------------------------------------------------------------ */
+
+/*
+The sparse local extractor extracts the same tesselations as the local
+static extractor, with the same algorithm. The other extractors keep 
+arrays indexed on all the nodes, arcs and tiles of the MT, thus each 
+of them needs memory proportional to the size of the MT, even if it 
+visits a small part of it. The sparse extractor keeps the nodes before 
+the front, and the arcs tested against the focus set, in tables of 
+class MT_MarkTableClass, and the front in an array, which grow with 
+the number of nodes and arcs visited. Such structures are emptied, not 
+released, at each extraction, thus an extractor used again needs no
+allocation unless it visits more nodes than before.
+As the global extractors, it stops including nodes when the upper 
+bound set by MT_SetUpperBound is reached.
+Adjacency generation is not available.
+*/
+
+typedef class MT_SparseExtractorClass * MT_SparseExtractor;
+
+class MT_SparseExtractorClass : public MT_ExtractorClass
+{
+
+   protected:
+
+   /*
+   Nodes in the set of nodes before the current front (with mark 1).
+   */
+   MT_MarkTable N_mark;
+
+   /*
+   Arcs on which MT_FocusArc has been evaluated, or which are in the 
+   current front. The mark of an arc contains the result of MT_FocusArc
+   in the lowest two bits (see mt_extra.c), and its position in F_arc 
+   plus one in the other bits (0 if the arc is not in the front).
+   */
+   MT_MarkTable A_mark;
+
+   /*
+   Arcs of the current front, in the order in which they have been 
+   added, with MT_NULL_INDEX in place of the arcs removed meanwhile.
+   Number of used positions and size of the array.
+   */
+   MT_INDEX * F_arc;
+   MT_INDEX F_num;
+   MT_INDEX F_size;
+
+   /*
+   Size of the work stack (arrays W_node and W_arc), and of the array
+   of extracted tiles (T_good), which are enlarged when needed.
+   */
+   MT_INDEX W_size;
+   MT_INDEX T_size;
+
+   public:
+   
+/* ------------------------------------------------------------------------ */
+/*                        creation and deletion                             */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Create extractor for a given MT and put it in initial state:
+   the current front is the one formed by the out-arcs of the root.
+   */
+   MT_SparseExtractorClass (MT_MultiTesselation m);
+
+   /* 
+   Destroy extractor, deallocate its internal variables.
+   */
+   ~MT_SparseExtractorClass (void);
+
+/* ------------------------------------------------------------------------ */
+/*                       Extraction of a tesselation                        */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Function redefined from superclass MT_ExtractorClass.
+   Return 0 also if some structure could not be enlarged.
+   */
+   MT_INDEX MT_ExtractTesselation( void ); 
+
+   /*
+   Return the memory used by the state of this extractor, in bytes.
+   */
+   long MT_StateMemory(void);
+
+/* ------------------------------------------------------------------------ */
+/*                          Auxiliary functions                             */
+/* ------------------------------------------------------------------------ */
+   
+   protected:
+
+   /*
+   Functions redefined from superclass MT_ExtractorClass.
+   */
+   int MT_IsInSet(MT_INDEX n);
+   void MT_AddToSet(MT_INDEX n);
+   int MT_IncludeNode (MT_INDEX n);
+   int MT_ExtractionCompleted(void);
+
+   /* 
+   Test whether at least one tile labelling the arc is active, as in
+   the local static extractor.
+   */
+   int MT_FocusArc(MT_INDEX a);
+
+   /*
+   Add arc a to the front and remove it from the front. Return 1 if 
+   successful, 0 if some structure could not be enlarged.
+   */
+   int MT_AddFrontArc(MT_INDEX a);
+   int MT_RemFrontArc(MT_INDEX a);
+
+   /*
+   Enlarge the work stack. Return 1 if successful, 0 otherwise.
+   */
+   int MT_GrowWork(void);
+};
+
+/* ------------------------------------------------------------------------ */
+/*                           POOL OF EXTRACTORS                             */
+/* ------------------------------------------------------------------------ */
+
+/*
+A pool of extractors shares one MT among several threads, each one 
+running its own extractions (e.g., the requests of the clients of a 
+tile server). The MT is frozen by the pool (see MT_Freeze), so that
+it cannot be modified while shared. A thread takes a sparse local 
+extractor from the pool with MT_Acquire, sets its conditions, extracts 
+and reads the tiles, and gives it back with MT_Release. Extractors 
+given back are kept in the pool and used again, thus after the first
+requests no extractor is created, and each one keeps only the memory 
+needed by the largest extraction it has done.
+The conditions must not be shared among threads, unless their 
+evaluation does not change them.
+*/
+
+typedef class MT_ExtractorPoolClass * MT_ExtractorPool;
+
+class MT_ExtractorPoolClass
+{
+
+   protected:
+
+   /*
+   The shared MT, and 1 if the pool has frozen it.
+   */
+   MT_MultiTesselation mt;
+   int my_freeze;
+
+   /*
+   Extractors not in use, their number and the size of the array.
+   Number of extractors created by the pool.
+   */
+   MT_SparseExtractor * P_idle;
+   int idle_num;
+   int idle_size;
+   int created_num;
+
+   /*
+   Mutex protecting the fields above.
+   */
+   MT_Mutex lock;
+
+   public:
+
+/* ------------------------------------------------------------------------ */
+/*                        creation and deletion                             */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Create an empty pool for a given MT, and freeze the MT.
+   */
+   MT_ExtractorPoolClass (MT_MultiTesselation m);
+
+   /* 
+   Destroy the pool and the extractors in it, and unfreeze the MT once
+   (it stays frozen if it has been frozen by others as well). All 
+   extractors must have been released.
+   */
+   ~MT_ExtractorPoolClass (void);
+
+   /*
+   Return 1 if the pool can be used, 0 if the MT could not be frozen.
+   */
+   inline int MT_IsGood(void)  {  return ( lock && my_freeze );  }
+
+   inline MT_MultiTesselation MT_TheMT(void)  {  return (mt);  }
+
+/* ------------------------------------------------------------------------ */
+/*                      Taking and giving back extractors                   */
+/* ------------------------------------------------------------------------ */
+
+   /*
+   Return an extractor not used by other threads, without conditions
+   and in an unspecified state. Return NULL on failure.
+   Can be called by several threads at the same time.
+   */
+   MT_SparseExtractor MT_Acquire(void);
+
+   /*
+   Give back an extractor taken with MT_Acquire. Its conditions are
+   removed, and it must not be used any more by the caller.
+   Can be called by several threads at the same time.
+   */
+   void MT_Release(MT_SparseExtractor e);
+
+   /*
+   Return the number of extractors created by the pool, and the number
+   of those not in use.
+   */
+   inline int MT_CreatedNum(void)  {  return (created_num);  }
+   inline int MT_IdleNum(void)  {  return (idle_num);  }
+};
+
+/* ------------------------------------------------------------------------ */
+/*               EXTRACTORS WITH CONDITIONS FIXED AT COMPILE TIME           */
+/* ------------------------------------------------------------------------ */
+
+/*
+Applications that always use the same classes of resolution filter and 
+focus condition may use the following templates in place of 
+MT_StaticExtractorClass and MT_LocalExtractorClass:
+
+  MT_FixedStaticExtractorClass<FILTER,FOCUS,DIM>
+  MT_FixedLocalExtractorClass<FILTER,FOCUS,DIM>
+
+FILTER and FOCUS are the classes of the resolution filter and of the 
+focus condition (subclasses of MT_CondClass), DIM is the number of 
+vertices of a tile (3 for triangles, 4 for tetrahedra).
+Such extractors extract the same tiles as the corresponding ones, but 
+conditions are evaluated through calls to FILTER::MT_EvalCond and 
+FOCUS::MT_EvalCond, which are resolved at compile time (and expanded 
+inline if such functions are defined inline in the class), instead of 
+virtual calls. Loops on the vertices of a tile have a constant length.
+
+The conditions must be objects of classes FILTER and FOCUS, not of 
+subclasses redefining MT_EvalCond. They are set with MT_SetFilter / 
+MT_SetFocus of the template, or in the constructor. If different 
+conditions are set through the functions of MT_ExtractorClass, the 
+extraction is done by the algorithm of the corresponding extractor.
+The MT must have tiles with DIM vertices.
+
+Example:
+  MT_FixedStaticExtractorClass<TileErrFilterClass,
+                               Box3FocusOnTrianglesClass, 3> * e =
+      new MT_FixedStaticExtractorClass<TileErrFilterClass,
+                                       Box3FocusOnTrianglesClass, 3>
+          (m, new TileErrFilterClass(m,thr), new Box3FocusOnTrianglesClass(...));
+  e->MT_ExtractTesselation();
+*/
+
+/*
+Common part of the two templates. EXTR is the extractor class 
+providing the algorithm (MT_StaticExtractorClass or 
+MT_LocalExtractorClass).
+*/
+
+template <class FILTER, class FOCUS, int DIM, class EXTR>
+class MT_FixedExtractorClass : public EXTR
+{
+   protected:
+
+   using EXTR::mt;
+   using EXTR::resol_cnd;
+   using EXTR::place_cnd;
+   using EXTR::A_front;
+   using EXTR::stat_enabled;
+   using EXTR::a_tested;
+   using EXTR::t_tested;
+
+   /*
+   The conditions, with their actual classes.
+   */
+   FILTER * my_filter;
+   FOCUS * my_focus;
+
+   /*
+   Return 1 if the conditions set in the extractor are my_filter and
+   my_focus.
+   */
+   inline int MT_IsFixed(void)
+   {  return ( (resol_cnd == my_filter) && (place_cnd == my_focus) );  }
+
+   /*
+   As MT_FocusTile and MT_FilterTile, with no virtual calls.
+   */
+   inline int MT_FixedFocusTile(MT_INDEX t, int flag)
+   {  return ( (!my_focus) || my_focus->FOCUS::MT_EvalCond(mt,t,flag) );  }
+   inline int MT_FixedFilterTile(MT_INDEX t, int flag)
+   {  return ( (!my_filter) || my_filter->FILTER::MT_EvalCond(mt,t,flag) );  }
+
+   /*
+   As MT_RefineArc, testing the tiles of a one by one.
+   */
+   inline int MT_FixedRefineArc(MT_INDEX a)
+   {
+     MT_INDEX t, t2;  /* range of tiles */
+
+     t = mt->MT_FirstArcTile(a);
+     if ( (!my_filter) || (t == MT_NULL_INDEX) || 
+          (mt->MT_ArcDest(a) == mt->MT_Drain()) )
+        return 0;
+     t2 = mt->MT_LastArcTile(a);
+     for ( ; t<=t2; t++)
+     {
+       if (stat_enabled)  t_tested++;
+       if ( MT_FixedFocusTile(t,MT_LOOSE) && !MT_FixedFilterTile(t,MT_LOOSE) )
+          return 1;
+     }
+     return 0;
+   }
+
+   /*
+   As MT_ExpandExtractor, refining the front through MT_FixedRefineArc.
+   */
+   int MT_FixedExpand(void)
+   {
+     MT_INDEX a;    /* variable for arc */ 
+
+     A_front->MT_CurrInit(0);
+     while ( (a = A_front->MT_CurrElem(0)) != MT_NULL_INDEX )
+     {
+       if (stat_enabled)  a_tested++;
+       A_front->MT_CurrAdvance(0);
+       if ( MT_FixedRefineArc(a) && mt->MT_IsLoaded(mt->MT_ArcDest(a)) )
+          this->MT_IncludeNode(mt->MT_ArcDest(a));
+     }
+     return 1;
+   }
+
+   /*
+   Functions redefined from superclass MT_ExtractorClass.
+   */
+   int MT_AddTiles(MT_INDEX a)  {  return ( this->MT_AddArcTiles(a,DIM) );  }
+   int MT_RemTiles(MT_INDEX a)  {  return ( this->MT_RemArcTiles(a,DIM) );  }
+
+   /*
+   Create an extractor, and set its conditions.
+   */
+   MT_FixedExtractorClass(MT_MultiTesselation m, FILTER * flt, FOCUS * fcs,
+                          int topo_flag)
+   : EXTR(m,topo_flag)
+   {
+     if (m->MT_NumTileVertices() != DIM)
+        MT_FatalError((char *)"Wrong number of tile vertices",
+                      (char *)"MT_FixedExtractor Constructor");
+     my_filter = NULL;  my_focus = NULL;
+     MT_SetFilter(flt);
+     MT_SetFocus(fcs);
+   }
+
+   public:
+
+   /*
+   Set the conditions, as for MT_ExtractorClass.
+   Return 1 if successful, 0 otherwise.
+   */
+   int MT_SetFilter(FILTER * flt)
+   {
+     if (!EXTR::MT_SetFilter(flt)) return 0;
+     my_filter = flt;
+     return 1;
+   }
+   int MT_SetFocus(FOCUS * fcs)
+   {
+     if (!EXTR::MT_SetFocus(fcs)) return 0;
+     my_focus = fcs;
+     return 1;
+   }
+
+   /*
+   Function redefined from superclass MT_ExtractorClass.
+   */
+   MT_INDEX MT_ExtractTesselation(void)
+   {
+     if (!MT_IsFixed())  return ( EXTR::MT_ExtractTesselation() );
+     this->MT_ResetExtractor();
+     MT_FixedExpand();
+     this->MT_ExtractionCompleted();
+     return ( this->MT_ExtractedTilesNum() );
+   }
+};
+
+/*
+Global static extractor with fixed conditions.
+*/
+
+template <class FILTER, class FOCUS, int DIM>
+class MT_FixedStaticExtractorClass 
+: public MT_FixedExtractorClass<FILTER,FOCUS,DIM,MT_StaticExtractorClass>
+{
+   public:
+
+   /*
+   Create extractor for a given MT and conditions, as 
+   MT_StaticExtractorClass.
+   */
+   MT_FixedStaticExtractorClass(MT_MultiTesselation m, 
+                                FILTER * flt = NULL, FOCUS * fcs = NULL,
+                                int topo_flag = MT_ADJ_DISABLE)
+   : MT_FixedExtractorClass<FILTER,FOCUS,DIM,MT_StaticExtractorClass>
+     (m,flt,fcs,topo_flag)
+   {  }
+};
+
+/*
+Local static extractor with fixed conditions.
+*/
+
+template <class FILTER, class FOCUS, int DIM>
+class MT_FixedLocalExtractorClass 
+: public MT_FixedExtractorClass<FILTER,FOCUS,DIM,MT_LocalExtractorClass>
+{
+   protected:
+
+   typedef MT_FixedExtractorClass<FILTER,FOCUS,DIM,MT_LocalExtractorClass>
+           MT_FixedBase;
+
+   using MT_FixedBase::mt;
+   using MT_FixedBase::stat_enabled;
+   using MT_FixedBase::n_visited;
+   using MT_FixedBase::a_tested;
+   using MT_FixedBase::t_tested;
+   using MT_FixedBase::extr_count;
+   using MT_FixedBase::A_front;
+   using MT_FixedBase::A_pos;
+   using MT_FixedBase::A_neg;
+   using MT_FixedBase::W_node;
+   using MT_FixedBase::W_arc;
+
+   /*
+   As MT_FocusArc, testing the tiles of a one by one.
+   */
+   inline int MT_FixedFocusArc(MT_INDEX a)
+   {
+     MT_INDEX t, t2;  /* range of tiles */
+     int flag = 0;
+
+     if (this->MT_HintYes(a)) return 1;
+     if (this->MT_HintNot(a)) return 0;
+     t = mt->MT_FirstArcTile(a);
+     if (t == MT_NULL_INDEX) return 0;
+     t2 = mt->MT_LastArcTile(a);
+     for ( ; (t<=t2) && !flag; t++)
+     {
+       if (stat_enabled)  t_tested++;
+       flag = this->MT_FixedFocusTile(t,MT_LOOSE);
+     }
+     if (flag) A_pos[a] = extr_count; else A_neg[a] = extr_count;
+     return flag;
+   }
+
+   /*
+   Function redefined from superclass MT_LocalExtractorClass, 
+   testing arcs through MT_FixedFocusArc.
+   */
+   int MT_IncludeNode(MT_INDEX n)
+   {
+     MT_INDEX a;   /* variable for arc */
+     MT_INDEX p;   /* variable for parent node */
+     MT_INDEX top; /* top of the work stack */
+
+     if (!this->MT_IsFixed())  
+        return ( MT_LocalExtractorClass::MT_IncludeNode(n) );
+
+     if (stat_enabled)  n_visited++;
+     top = 0;
+     W_node[0] = n;
+     W_arc[0] = mt->MT_FirstInArc(n);
+     while (1)
+     {
+       n = W_node[top];
+       a = W_arc[top];
+       if (a != MT_NULL_INDEX)
+       {
+         if (stat_enabled)  a_tested++;
+         p = mt->MT_ArcSource(a);
+         W_arc[top] = mt->MT_NextInArc(n,a);
+         if ((!this->MT_IsInSet(p)) && MT_FixedFocusArc(a))
+         {
+           if (stat_enabled)  n_visited++;
+           top++;
+           W_node[top] = p;
+           W_arc[top] = mt->MT_FirstInArc(p);
+         }
+         continue;
+       }
+       this->MT_AddToSet(n);
+       for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX; 
+            a = mt->MT_NextInArc(n,a))
+       {
+         if ( A_front->MT_IsInList(a) )
+         {
+           A_front->MT_RemElem(a);
+           this->MT_RemTiles(a);
+         }
+       }
+       for (a = mt->MT_FirstOutArc(n); a != MT_NULL_INDEX; 
+            a = mt->MT_NextOutArc(n,a))
+       {
+         if (MT_FixedFocusArc(a))
+         {
+           A_front->MT_AddElem(a);
+           this->MT_AddTiles(a);
+         }
+       }
+       if (top==0) return 1;
+       top--;
+     }
+   }
+
+   public:
+
+   /*
+   Create extractor for a given MT and conditions, as 
+   MT_LocalExtractorClass.
+   */
+   MT_FixedLocalExtractorClass(MT_MultiTesselation m, 
+                               FILTER * flt = NULL, FOCUS * fcs = NULL,
+                               int topo_flag = MT_ADJ_DISABLE)
+   : MT_FixedExtractorClass<FILTER,FOCUS,DIM,MT_LocalExtractorClass>
+     (m,flt,fcs,topo_flag)
+   {  }
+};
+
 /* ------------------------------------------------------------------------ */
 
 #endif   /* MT_EXTRA_INCLUDED */
@@ -58,6 +58,16 @@ Null index. When the result of an operation that should retrn an MT entity
 */
 #define MT_NULL_INDEX 0
 
+/*
+Type of the offsets in a file. It has 64 bits also on systems where 
+long has 32 bits, so that files larger than 2 GB can be read.
+*/
+#ifdef _WIN32
+#define MT_OFFSET __int64
+#else
+#define MT_OFFSET long long
+#endif
+
 /*
 Maximum length of a string (used for filenames and keywords).
 */
@@ -86,6 +96,27 @@ extern void MT_WarningC(char * msg, char * cls, char * fun);
 extern void MT_ErrorC(char * msg, char * cls, char * fun);
 extern void MT_FatalErrorC(char * msg, char * cls, char * fun);
 
+/* ------------------------------------------------------------------------ */
+/*                              TIME UTILITIES                              */
+/* ------------------------------------------------------------------------ */
+
+/*
+Return the elapsed time in seconds from some fixed instant (on systems 
+without gettimeofday, the processor time is returned).
+*/
+extern double MT_WallTime(void);
+
+/* ------------------------------------------------------------------------ */
+/*                              FILE UTILITIES                              */
+/* ------------------------------------------------------------------------ */
+
+/*
+As fseek and ftell, with offsets of type MT_OFFSET (through fseeko /
+ftello, or _fseeki64 / _ftelli64 on Windows).
+*/
+extern int MT_SeekFile(FILE * fd, MT_OFFSET pos, int whence);
+extern MT_OFFSET MT_TellFile(FILE * fd);
+
 /* ------------------------------------------------------------------------ */
 /*                           DEBUGGING UTILITIES                            */
 /* ------------------------------------------------------------------------ */
@@ -35,13 +35,21 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 /* ------------------------------------------------------------------------- */
 
 /*
-This file defines class MT_FacetTileClass, which implememts
+This file defines class MT_HashTableClass, which implememts
 a hash table for facet-tile association.
 A facet is specified by giving the opposite vertex to it in the tile.
+
+The table uses open addressing with linear probing: the entries are
+stored directly in one array, whose size is a power of two, and which 
+is doubled when it becomes half full (i.e., it grows with the front of
+the extraction). The position of a facet depends on the minimum, 
+maximum and sum of its vertices, mixed together. An entry is removed
+by moving back the following entries of the same cluster, thus no
+deleted marks are left in the array.
 */
 
 /* ------------------------------------------------------------------------- */
-/*                      CLASS FOR THE BUCKET LISTS                           */
+/*                      CLASS FOR THE TABLE ENTRIES                          */
 /* ------------------------------------------------------------------------- */
 
 typedef class MT_FacetTileClass * MT_FacetTile;
@@ -51,11 +59,10 @@ class MT_FacetTileClass
    protected:
    
    /*
-   Basic information.
+   Basic information, an entry is empty if my_t is MT_NULL_INDEX.
    */
    MT_INDEX my_t;    /* the tile */
    int my_i;         /* index in my_t of the vertex opposite to the facet */
-   MT_FacetTile my_next;
    
    /*
    Hints for comparison of two facets.
@@ -64,9 +71,6 @@ class MT_FacetTileClass
    MT_INDEX my_max;  /* maximum vertex of the facet */
    MT_INDEX my_min;  /* minimum vertex of the facet */
    
-   MT_FacetTileClass (int ind, MT_INDEX t,
-                      MT_INDEX sum_v, MT_INDEX min_v, MT_INDEX max_v);
-   
    friend class MT_HashTableClass;
 };
 
@@ -81,8 +85,10 @@ class MT_HashTableClass
    protected:
 
    MT_MultiTesselation my_mt;
-   int my_size;             /* table size */
-   MT_FacetTile * my_table; /* table to be allocated of size my_size */
+   int my_size;             /* table size, a power of two */
+   int my_num;              /* number of entries in the table */
+   int my_scan;             /* position where MT_HashPop starts scanning */
+   MT_FacetTile my_table;   /* array of my_size entries */
 
 /* ------------------------------------------------------------------------- */
 /*                          Auxiliary functions                              */
@@ -92,7 +98,23 @@ class MT_HashTableClass
    Hash code for a given facet of a given tile.
    */
    inline int MT_HashIndex(MT_INDEX sum_v, MT_INDEX min_v, MT_INDEX max_v)
-   {  return ( (max_v - min_v) % my_size );  }
+   {  unsigned long h = (unsigned long)min_v * 0x9E3779B1UL
+                      ^ (unsigned long)max_v * 0x85EBCA77UL
+                      ^ (unsigned long)sum_v * 0xC2B2AE3DUL;
+      h ^= (h >> 16);
+      return ( (int)(h & (unsigned long)(my_size-1)) );
+   }
+
+   /*
+   Remove the entry in position i, moving back the following entries
+   of the same cluster.
+   */
+   void MT_HashRemove(int i);
+
+   /*
+   Double the size of the table. Return 1 on success, 0 on failure.
+   */
+   int MT_HashGrow(void);
 
    /*
    Test whether the facet of an element is the same as the given facet.
@@ -113,7 +135,7 @@ class MT_HashTableClass
    public:
 
    /*
-   Creation and deletion.
+   Creation and deletion. The initial size is rounded to a power of two.
    */
    MT_HashTableClass(int table_size, MT_MultiTesselation m);
    ~MT_HashTableClass(void);
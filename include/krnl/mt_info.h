@@ -0,0 +1,226 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_info.h ------------------------------- */
+
+#ifndef MT_INFO_INCLUDED
+#define MT_INFO_INCLUDED
+
+#include "mt_multi.h"
+
+/* ------------------------------------------------------------------------ */
+/*                 INFORMATION ON AN MT FILE WITHOUT READING IT             */
+/* ------------------------------------------------------------------------ */
+
+/*
+This file defines a class, called MT_FileInfoClass, which gives the 
+information summarizing a tile set or an MT stored in a file (dimensions,
+numbers of elements, encoding, bounding box, numbers of tiles at minimum 
+and maximum resolution, offsets of the sections of the body), without 
+reading the body of the file.
+
+Such information is taken from the footer written at the end of the file
+(see mt_prst.h and mt_tile.h): the last bytes of the file give the
+offset of the footer, thus only the beginning and the end of the file are 
+read, whatever its size.
+For files written without a footer, only the information in the header
+(dimensions, numbers of elements and encoding) is available.
+*/
+
+/* ------------------------------------------------------------------------ */
+/*                          THE FILE INFO CLASS                             */
+/* ------------------------------------------------------------------------ */
+
+typedef class MT_FileInfoClass * MT_FileInfo;
+
+class MT_FileInfoClass : public MT_PersistentClass
+{
+
+/* ------------------------------------------------------------------------ */
+/*                       Internal structure                                 */
+/* ------------------------------------------------------------------------ */
+
+  protected:
+
+  /*
+  Class keyword of the object stored in the file.
+  */
+  char my_class[MT_MAX_STRLEN];
+
+  /*
+  Class parameters: number of coordinates of each vertex, and number 
+  of vertices of each tile.
+  */
+  int V_Dim, T_Dim;
+
+  /*
+  Object parameters: number of vertices, tiles, nodes and arcs
+  (nodes and arcs are 0 for a tile set).
+  */
+  MT_INDEX V_Num, T_Num, N_Num, A_Num;
+
+  /*
+  Encoding of the file.
+  */
+  int my_encoding;
+
+  /*
+  1 if the footer has been read, 0 if only the header has been read.
+  */
+  int my_footer;
+
+  /*
+  Bounding box, numbers of tiles at minimum and maximum resolution,
+  and offsets of the sections of the body (taken from the footer).
+  */
+  float F_min[MT_MAX_DIM], F_max[MT_MAX_DIM];
+  MT_INDEX min_res, max_res;
+  int s_num;
+  long s_pos[MT_MAX_SECTIONS];
+
+/* ------------------------------------------------------------------------ */
+/*                                Reading                                   */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Clear all information.
+  */
+  void MT_Reset(void);
+
+  /*
+  Read the summary common to the header and to the footer: class and its 
+  parameters, object parameters, encoding. The file must be positioned 
+  just after MT_FILE_KW or MT_FOOTER_KW. Return 1 on success, 0 on failure.
+  */
+  int MT_ReadSummary(FILE * fd);
+
+  /*
+  Locate the footer of the object starting at offset start, going back
+  from the end of the file through the last MT_FOOTER_TAIL bytes of 
+  each object written after it, and read it. Return 1 on success, and
+  leave the file at the end of the object, 0 if it has no valid footer.
+  */
+  int MT_ReadFooter(FILE * fd, long start);
+
+  public:
+
+  /*
+  Create an object containing no information.
+  */
+  MT_FileInfoClass(void);
+
+  /*
+  Read the information on the object stored in a file, starting at the
+  current position of fd, or in the file with the given name. The file 
+  may contain other objects after this one. If the object has a footer,
+  fd is left at the end of the object, otherwise after its header.
+  Return 1 on success, 0 on failure.
+  Functions redefined from superclass MT_PersistentClass.
+  */
+  int MT_Read(FILE * fd);
+  int MT_Read(char * fname);
+
+  /*
+  Functions redefined from superclass MT_PersistentClass, never used.
+  This object is not meant to be written on a file.
+  */
+  inline int MT_ReadBody(FILE * fd, int file_encoding)  {  return 1;  }
+  inline void MT_WriteBody(FILE * fd, int file_encoding)  {  }
+
+/* ------------------------------------------------------------------------ */
+/*                             Information                                  */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Keyword of the class of the object stored in the file (e.g., 
+  "MT_MultiTesselation").
+  */
+  inline char * MT_ClassKeyword(void)  {  return (my_class);  }
+
+  /*
+  Dimensions of the embedding space and of the tiles, as for 
+  MT_TileSetClass.
+  */
+  inline int MT_VertexDim(void)       { return (V_Dim); }
+  inline int MT_TileDim(void)         { return (T_Dim-1); }
+  inline int MT_NumTileVertices(void) { return (T_Dim); }
+
+  /*
+  Number of vertices, tiles, nodes and arcs.
+  */
+  inline MT_INDEX MT_VertexNum(void)   { return (V_Num); }
+  inline MT_INDEX MT_TileNum(void)     { return (T_Num); }
+  inline MT_INDEX MT_NodeNum(void)     { return (N_Num); }
+  inline MT_INDEX MT_ArcNum(void)      { return (A_Num); }
+
+  /*
+  Encoding of the file (MT_ASCII_ENCODING etc.). Whether the file has
+  the opposite byte order of this machine is given by MT_SwapBytes.
+  */
+  inline int MT_TheEncoding(void)  {  return (my_encoding);  }
+
+  /*
+  Return 1 if the file has a footer, i.e., if the following information
+  is available. Otherwise, the following functions return zeroes.
+  */
+  inline int MT_HasFooter(void)  {  return (my_footer);  }
+
+  /*
+  Minimum and maximum value of the i-th coordinate among all vertices.
+  */
+  inline float MT_MinCoord(int i) { return ( F_min[i] ); }
+  inline float MT_MaxCoord(int i) { return ( F_max[i] ); }
+
+  /*
+  Number of tiles of the tesselations at minimum and maximum resolution.
+  */
+  inline MT_INDEX MT_MinResolutionTileNum(void) { return (min_res); }
+  inline MT_INDEX MT_MaxResolutionTileNum(void) { return (max_res); }
+
+  /*
+  Offset in the file of section s (MT_COORD_SECTION, MT_VERTEX_SECTION,
+  MT_TILEARC_SECTION, MT_ARC_SECTION, MT_NODE_SECTION), 0 if such
+  section is not present in the encoding of the file.
+  In the ascii and binary encodings, the coordinate, vertex and arc
+  sections start with the first vertex, tile and arc, respectively. 
+  In the mapped encoding, each section is an image of the corresponding
+  array. In the compressed encoding, each section starts with the size
+  of its first block.
+  */
+  inline long MT_SectionOffset(int s)
+  {  return ( ((s>=0) && (s<s_num)) ? s_pos[s] : 0 );  }
+
+  /*
+  Move file fd (the same file from which this object has been read)
+  at the beginning of section s. Return 1 on success, 0 if the section
+  is not present.
+  */
+  int MT_SeekSection(FILE * fd, int s);
+
+};
+
+/* ------------------------------------------------------------------------ */
+
+#endif  /* MT_INFO_INCLUDED */
@@ -134,6 +134,193 @@ scanning the list through a cursor.
    int MT_IsInList(MT_INDEX i);
 };
 
+/* ---------------------------------------------------------------------- */
+/*                    PRIORITY QUEUES OF MT INDEXES                       */
+/* ---------------------------------------------------------------------- */
+
+/*
+Class for a priority queue of elements of type MT_INDEX, each one with
+a priority value. The element with the highest priority is extracted
+first (use opposite values to extract the lowest first).
+Used to implement queues of MT arcs and of MT nodes.
+The implementation is a binary heap stored in arrays, which are 
+enlarged when needed. The same element may be inserted several times.
+*/
+
+typedef class MT_HeapClass * MT_Heap;
+
+class MT_HeapClass
+{
+   private:
+
+   /*
+   Arrays containing the elements and their priorities, in heap order.
+   */
+   MT_INDEX * elem;
+   float * prio;
+
+   /*
+   Number of elements in the queue, and size of the arrays.
+   */
+   int num;
+   int size;
+
+/* ---------------------------------------------------------------------- */
+/*                         Creation and deletion                          */
+/* ---------------------------------------------------------------------- */
+
+   public:
+
+   /*
+   Create an empty queue that can initially contain size elements.
+   */
+   MT_HeapClass(int size);
+
+   /* 
+   Delete queue and release memory.
+   */
+   ~MT_HeapClass(void);
+
+   /* 
+   Empty the queue without releasing it.
+   */
+   inline void MT_EmptyHeap(void)  {  num = 0;  }
+
+/* ---------------------------------------------------------------------- */
+/*                    Functions for using the queue                       */
+/* ---------------------------------------------------------------------- */
+
+   /*
+   Return the number of elements in the queue.
+   */
+   inline int MT_HeapNum(void)  {  return (num);  }
+
+   /*
+   Insert element i with priority p. Return 1 if successful, 0 if the
+   queue could not be enlarged.
+   */
+   int MT_HeapPush(MT_INDEX i, float p);
+
+   /*
+   Extract the element with the highest priority, and its priority.
+   Return 0 if the queue is empty, 1 otherwise.
+   */
+   int MT_HeapPop(MT_INDEX * i, float * p);
+};
+
+/* ---------------------------------------------------------------------- */
+/*                     SPARSE TABLES OF MT INDEXES                        */
+/* ---------------------------------------------------------------------- */
+
+/*
+Class for a table associating an unsigned value (a mark) with elements
+of type MT_INDEX. Elements without a mark have value 0.
+Used in place of an array indexed on MT entities (e.g., on nodes or 
+arcs) when only a few of them are marked: the memory is proportional
+to the number of marked elements, not to the number of entities.
+The implementation is a hash table with open addressing, which is 
+enlarged when more than half full. Elements are never removed (setting
+the mark of an element to 0 keeps it in the table), the whole table
+is emptied by MT_EmptyTable.
+*/
+
+/*
+Entry of the table: an element (MT_NULL_INDEX if the entry is free) 
+and its mark, kept together so that a lookup reads one memory location.
+*/
+typedef struct MT_MarkEntryStruct
+{
+   MT_INDEX my_key;
+   unsigned int my_mark;
+} MT_MarkEntry;
+
+typedef class MT_MarkTableClass * MT_MarkTable;
+
+class MT_MarkTableClass
+{
+   private:
+
+   /*
+   Array of entries, number of elements in the table, and size of the
+   array (a power of two).
+   */
+   MT_MarkEntry * entry;
+   int num;
+   int size;
+
+   /*
+   Position of element i in the table, or the free position where it
+   should be added.
+   */
+   inline int MT_TablePos(MT_INDEX i)
+   {  int h = (int) ( ( (unsigned long) i * 2654435761UL ) & (size-1) );
+      while ( entry[h].my_key && (entry[h].my_key!=i) )  
+         h = (h+1) & (size-1);
+      return h;
+   }
+
+   /*
+   Double the size of the array. Return 1 if successful, 0 otherwise.
+   */
+   int MT_GrowTable(void);
+
+/* ---------------------------------------------------------------------- */
+/*                         Creation and deletion                          */
+/* ---------------------------------------------------------------------- */
+
+   public:
+
+   /*
+   Create an empty table that can initially contain size/2 elements.
+   */
+   MT_MarkTableClass(int size);
+
+   /* 
+   Delete table and release memory.
+   */
+   ~MT_MarkTableClass(void);
+
+   /* 
+   Empty the table without releasing it. The time is proportional to
+   the size of the arrays.
+   */
+   void MT_EmptyTable(void);
+
+/* ---------------------------------------------------------------------- */
+/*                    Functions for using the table                       */
+/* ---------------------------------------------------------------------- */
+
+   /*
+   Return the number of elements in the table, and the memory used
+   by it, in bytes.
+   */
+   inline int MT_TableNum(void)  {  return (num);  }
+   inline long MT_TableMemory(void)
+   {  return ( (long)size * (long)sizeof(MT_MarkEntry) );  }
+
+   /*
+   Return the mark of element i.
+   */
+   inline unsigned int MT_GetMark(MT_INDEX i)
+   {  return ( entry[MT_TablePos(i)].my_mark );  }
+
+   /*
+   Return a pointer to the mark of element i, through which it can be
+   changed, or NULL if i is not in the table. The pointer is valid 
+   until the next call of MT_SetMark.
+   */
+   inline unsigned int * MT_FindMark(MT_INDEX i)
+   {  int h = MT_TablePos(i);
+      return ( entry[h].my_key ? &entry[h].my_mark : NULL );
+   }
+
+   /*
+   Set the mark of element i to v. Return 1 if successful, 0 if the
+   table could not be enlarged.
+   */
+   int MT_SetMark(MT_INDEX i, unsigned int v);
+};
+
 /* ---------------------------------------------------------------------- */
   
 #endif /* MT_LIST_INCLUDED */
@@ -51,6 +51,15 @@ Filename extension for files containing Multi-Tesselations
 */
 #define MT_MULTI_TESSELATION_EXT ".mtf"
 
+/*
+Sections of the mapped encoding containing the tile-to-arc references,
+the arcs and the nodes, as numbered in the page cache of a paged MT
+(they follow the sections of MT_TileSetClass).
+*/
+#define MT_TILEARC_SECTION 2
+#define MT_ARC_SECTION     3
+#define MT_NODE_SECTION    4
+
 /* ------------------------------------------------------------------------ */
 /*              Data structures for the entities of an MT                   */ 
 /* ------------------------------------------------------------------------ */
@@ -135,6 +144,41 @@ class MT_MultiTesselationClass : public MT_TileSetClass
   MT_INDEX N_Num;      
   MT_Node * N_Arr; 
 
+  /*
+  State of the progressive loading from a file in the stream encoding
+  (see MT_OpenStream): the file being read (NULL if none) and 1 if it 
+  has been opened by this object, the number of nodes loaded so far, 
+  and an array of N_Num+1 flags telling which nodes are loaded. 
+  N_Loaded is NULL if all nodes are loaded.
+  */
+  FILE * stream_fd;
+  int stream_own;
+  MT_INDEX N_Read;
+  char * N_Loaded;
+
+  /*
+  Number of times this MT has been frozen and not yet unfrozen
+  (see MT_Freeze), 0 if it is not frozen.
+  */
+  int frozen;
+
+  /*
+  Return a pointer to arc a and to node n, taken from the arrays or,
+  for a paged MT (whose arrays are NULL), from the page cache.
+  */
+  inline MT_Arc * MT_ArcRecord(MT_INDEX a)
+  {  return ( A_Arr ? &A_Arr[a] : MT_PagedArcRecord(a) );  }
+  inline MT_Node * MT_NodeRecord(MT_INDEX n)
+  {  return ( N_Arr ? &N_Arr[n] : MT_PagedNodeRecord(n) );  }
+
+  /*
+  Take arc a, node n, the arc of tile t from the page cache. 
+  Not inline, the accessors call them only for a paged MT.
+  */
+  MT_Arc * MT_PagedArcRecord(MT_INDEX a);
+  MT_Node * MT_PagedNodeRecord(MT_INDEX n);
+  MT_INDEX MT_PagedTileArc(MT_INDEX t);
+
 /* ------------------------------------------------------------------------ */
 /*                            Class keyword                                 */
 /* ------------------------------------------------------------------------ */
@@ -157,6 +201,17 @@ class MT_MultiTesselationClass : public MT_TileSetClass
   inline MT_INDEX MT_ArcNum()      { return (A_Num); }
   inline MT_INDEX MT_NodeNum()     { return (N_Num); }
 
+  /*
+  Functions redefined from superclass MT_TileSetClass.
+  Number of tiles of the tesselations at minimum resolution (tiles of
+  the arcs leaving the root) and at maximum resolution (tiles of the
+  arcs entering the drain).
+  */
+  inline MT_INDEX MT_MinResolutionTileNum(void)
+  {  return ( N_Num ? MT_NumCreatedTiles(MT_Root()) : 0 );  }
+  inline MT_INDEX MT_MaxResolutionTileNum(void)
+  {  return ( N_Num ? MT_NumRemovedTiles(MT_Drain()) : 0 );  }
+
 /* ------------------------------------------------------------------------ */
 /*                       Information on DAG structure                       */
 /* ------------------------------------------------------------------------ */
@@ -171,26 +226,27 @@ class MT_MultiTesselationClass : public MT_TileSetClass
   Number of arcs entering and leaving a node.
   */
   inline int MT_NumInArcs(MT_INDEX n)
-  {  return ( N_Arr[n].my_in[1] );  }
+  {  return ( MT_NodeRecord(n)->my_in[1] );  }
   
   inline int MT_NumOutArcs(MT_INDEX n)
-  {  return ( 1 + N_Arr[n].my_out[1] - N_Arr[n].my_out[0]);  }
+  {  MT_Node * p = MT_NodeRecord(n);
+     return ( 1 + p->my_out[1] - p->my_out[0]);  }
 
   /*
   Arcs entering and leaving a node.
   */
   inline MT_INDEX MT_FirstInArc(MT_INDEX n)   
-  { return ( N_Arr[n].my_in[0] ); }
+  { return ( MT_NodeRecord(n)->my_in[0] ); }
 
   inline MT_INDEX MT_NextInArc(MT_INDEX n, MT_INDEX a)
-  { return ( A_Arr[a].my_next ); }
+  { return ( MT_ArcRecord(a)->my_next ); }
 
   inline MT_INDEX MT_FirstOutArc(MT_INDEX n)  
-  { return ( N_Arr[n].my_out[0] ); }
+  { return ( MT_NodeRecord(n)->my_out[0] ); }
 
   inline MT_INDEX MT_NextOutArc(MT_INDEX n, MT_INDEX a) 
   { 
-    return ( ((a<=A_Num) && (MT_ArcSource(a+1)==n)) ? 
+    return ( ((a<A_Num) && (MT_ArcSource(a+1)==n)) ? 
                   a+1 : MT_NULL_INDEX ); 
   }
 
@@ -198,31 +254,39 @@ class MT_MultiTesselationClass : public MT_TileSetClass
   Number of tiles labelling an arc.
   */
   inline int MT_NumArcTiles(MT_INDEX a) 
-  {  return ( 1 + A_Arr[a].my_tile[1] - A_Arr[a].my_tile[0] );  }
+  {  MT_Arc * p = MT_ArcRecord(a);
+     return ( 1 + p->my_tile[1] - p->my_tile[0] );  }
 
   /*
   Tiles labelling an arc.
   */
   inline MT_INDEX MT_FirstArcTile(MT_INDEX a) 
-  { return ( A_Arr[a].my_tile[0] ); }
+  { return ( MT_ArcRecord(a)->my_tile[0] ); }
   
   inline MT_INDEX MT_NextArcTile(MT_INDEX a, MT_INDEX t)
-  { return ( (t<A_Arr[a].my_tile[1]) ? t+1 : MT_NULL_INDEX ); }
+  { return ( (t<MT_ArcRecord(a)->my_tile[1]) ? t+1 : MT_NULL_INDEX ); }
+
+  /*
+  Last tile labelling an arc. The tiles of an arc are numbered
+  consecutively from MT_FirstArcTile to MT_LastArcTile.
+  */
+  inline MT_INDEX MT_LastArcTile(MT_INDEX a) 
+  { return ( MT_ArcRecord(a)->my_tile[1] ); }
 
   /*
   Source and destination of an arc.
   */
   inline MT_INDEX MT_ArcSource(MT_INDEX a)
-  { return ( A_Arr[a].my_node[0] ); }
+  { return ( MT_ArcRecord(a)->my_node[0] ); }
 
   inline MT_INDEX MT_ArcDest(MT_INDEX a)
-  { return ( A_Arr[a].my_node[1] ); }
+  { return ( MT_ArcRecord(a)->my_node[1] ); }
 
   /*
   Arc containing a tile in its label.
   */
   inline MT_INDEX MT_TileArc(MT_INDEX t) 
-  { return ( TA_Arr[t].my_arc ); }
+  { return ( TA_Arr ? TA_Arr[t].my_arc : MT_PagedTileArc(t) ); }
 
 /* ------------------------------------------------------------------------ */
 /*                          Derived DAG operations                          */
@@ -289,9 +353,11 @@ class MT_MultiTesselationClass : public MT_TileSetClass
   /*
   Set the dimensions of the arrays.
   Function MT_SetTileNum is redefined from superclass MT_TileSetClass
-  in order to allocate the tile-to-arc array as well.
+  in order to allocate the tile-to-arc array as well, and both
+  MT_SetVertexNum and MT_SetTileNum fail if this MT is frozen.
   Return 1 on success, 0 on failure.
   */
+  int MT_SetVertexNum (MT_INDEX i);
   int MT_SetTileNum (MT_INDEX i);
   int MT_SetArcNum (MT_INDEX i);
   int MT_SetNodeNum (MT_INDEX i);
@@ -327,7 +393,11 @@ class MT_MultiTesselationClass : public MT_TileSetClass
 
   /*
   Functions redefined from superclass MT_TileSetClass.
+  The stream encoding has a specific layout as well.
+  In the mapped encoding, MT_ReadBody points also the tile-to-arc, 
+  arc and node arrays inside the file mapping.
   */
+  int MT_HasBodyLayout(int file_encoding);
   int MT_ReadObjParams(FILE * fd);
   int MT_ReadBody(FILE * fd, int file_encoding);
 
@@ -347,10 +417,156 @@ class MT_MultiTesselationClass : public MT_TileSetClass
    
   /*
   Functions redefined from superclass MT_TileSetClass.
+  In the mapped encoding, the sections of MT_TileSetClass are followed
+  by three sections containing arrays TA_Arr, A_Arr and N_Arr, 
+  including position 0.
+  In the compressed encoding, they are followed by the blocks of arcs.
+  Inside a block, each arc is coded as: its source (difference from 
+  the source of the previous arc), its destination (difference from its 
+  source), the number of tiles in its label and, if not zero, its first 
+  tile (difference from the tile following the last tile of the previous
+  arc, usually zero). Nodes are rebuilt from the arcs.
+  In the stream encoding, the body is written by MT_WriteStream.
   */
   void MT_WriteObjParams(FILE * fd);
   void MT_WriteBody(FILE * fd, int file_encoding);
 
+/* ------------------------------------------------------------------------ */
+/*                       Stream encoding and loading                        */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  In the stream encoding, the body contains the bounding box, followed 
+  by one record for each node, in a topological order of the DAG 
+  starting from the root (every node comes after all its parents). 
+  The record of node n contains: its index; the number of vertices 
+  used for the first time by the tiles of n, followed by the index and 
+  the coordinates of each of them; the number of arcs leaving n and, 
+  if not zero, the first of them; then, for each such arc, its 
+  destination, the number of tiles in its label and, if not zero, the
+  first of them, followed by the vertex indexes of each tile.
+  The vertices never used by a tile are in the record of the last node.
+  Entities keep their indexes, thus attribute tables remain valid.
+  When a node has been read, its parents, the arcs entering it, the 
+  arcs leaving it and the tiles of such arcs are all known, thus an
+  extractor can already sweep its front through it (see MT_IsLoaded).
+  */
+
+  public:
+
+  /*
+  Start loading this MT from a file in the stream encoding, without
+  reading the whole body: read the header, the bounding box and the
+  record of the root, so that extractors can be created on this MT.
+  The other nodes are loaded by MT_ReadStream. The file must not be 
+  used by the caller until loading is completed or MT_CloseStream is 
+  called, and the one given by name is closed by this object.
+  Return 1 on success, 0 on failure.
+  */
+  int MT_OpenStream(FILE * fd);
+  int MT_OpenStream(char * fname);
+
+  /*
+  Load the next node_num nodes from the file opened with MT_OpenStream 
+  (all the remaining ones if node_num is 0). The file is closed when
+  all nodes are loaded, or on failure.
+  Between two calls, extractors can be used on this MT: their front
+  does not pass the nodes not yet loaded, thus they extract a 
+  tesselation approximating the one they would extract from the whole
+  MT, and refine it at the next extraction after more nodes are 
+  loaded (MT_ReadStream must not be called while extracting).
+  Until loading is completed, only the loaded vertices, tiles, arcs 
+  and nodes are valid, and this MT must not be written.
+  Return 1 on success (or if all nodes are already loaded), 0 on failure.
+  */
+  int MT_ReadStream(MT_INDEX node_num = 0);
+
+  /*
+  Stop loading from the file opened with MT_OpenStream. The nodes 
+  loaded so far remain usable.
+  */
+  void MT_CloseStream(void);
+
+  /*
+  Number of nodes loaded, and whether node n is loaded (always N_Num
+  and 1, respectively, if this MT has been read with MT_Read).
+  */
+  inline MT_INDEX MT_LoadedNodeNum(void)
+  {  return ( N_Loaded ? N_Read : N_Num );  }
+  inline int MT_IsLoaded(MT_INDEX n)
+  {  return ( (!N_Loaded) || N_Loaded[n] );  }
+
+  protected:
+
+  /*
+  Allocate the arrays, read the bounding box, and mark all nodes as
+  not loaded. Return 1 on success, 0 on failure.
+  */
+  int MT_StartStream(FILE * fd);
+
+  /*
+  Read the record of the next node. Return 1 on success, 0 on failure.
+  */
+  int MT_ReadStreamNode(FILE * fd);
+
+  /*
+  Write the body in the stream encoding.
+  */
+  void MT_WriteStream(FILE * fd);
+
+/* ------------------------------------------------------------------------ */
+/*                           Compressed encoding                            */
+/* ------------------------------------------------------------------------ */
+
+  public:
+
+  /*
+  Functions redefined from superclass MT_TileSetClass, in order to
+  encode and decode also the blocks of arcs.
+  */
+  int MT_DecodeBlock(MT_Block * b);
+
+  protected:
+
+  size_t MT_BlockBound(int s, MT_INDEX num);
+  size_t MT_EncodeBlock(int s, MT_INDEX first, MT_INDEX num,
+                        unsigned char * buf);
+
+/* ------------------------------------------------------------------------ */
+/*                          Sharing among threads                           */
+/* ------------------------------------------------------------------------ */
+
+  public:
+
+  /*
+  The functions reading an MT do not change it, thus an MT can be 
+  read by several extractors at the same time, each one used by a 
+  different thread. This does not hold for a paged MT, whose page 
+  cache changes at every access, and for an MT being loaded from a 
+  file in the stream encoding.
+  MT_Freeze makes this MT immutable, so that it can be safely shared:
+  until MT_Unfreeze is called, the functions modifying it (setting the 
+  number of its elements, reading it, opening a stream) fail. 
+  Freezing is counted: each successful MT_Freeze must be matched by 
+  one MT_Unfreeze, and the MT is unfrozen by the last one. Thus several 
+  users (e.g., pools of extractors) can share it independently.
+  The extraction conditions used by the threads must be safe as well: 
+  a condition whose evaluation changes its state must not be shared.
+  See also class MT_ExtractorPoolClass.
+  Return 1 on success, 0 if this MT is paged or is being loaded.
+  */
+  int MT_Freeze(void);
+  inline void MT_Unfreeze(void)  {  if (frozen) frozen--;  }
+  inline int MT_IsFrozen(void)  {  return (frozen>0);  }
+
+  protected:
+
+  /*
+  Return 1 if this MT is frozen, after reporting an error in function
+  fun, 0 otherwise.
+  */
+  int MT_FrozenError(char * fun);
+
 /* ------------------------------------------------------------------------ */
 /*                                 Friends                                  */
 /* ------------------------------------------------------------------------ */
@@ -359,6 +575,106 @@ class MT_MultiTesselationClass : public MT_TileSetClass
 
 };
 
+/* ------------------------------------------------------------------------ */
+/*                       THE PAGED MULTI-TESSELATION                        */
+/* ------------------------------------------------------------------------ */
+
+/*
+A paged MT is an MT whose vertices, tiles, tile-to-arc references, arcs 
+and nodes are not loaded in memory, but are taken from the file through
+a page cache (see class MT_PageCacheClass) using at most a given amount 
+of memory. It is intended for MTs too large to fit in memory.
+
+A paged MT must be read from a file in the mapped encoding, written on
+a machine with the same byte order (files can be converted by reading
+them as an ordinary MT and writing them again). The page
+cache keeps its own descriptor of the file, which remains open as long
+as the MT is in use.
+The sections of the file are split into chunks, and only the chunks 
+accessed by the extractor are loaded. In a file written by the library,
+tiles are sorted by arc, and arcs by source node, so the chunks follow 
+the order of the DAG nodes: a local extractor loads only the chunks 
+of the nodes that it visits, i.e., those interfering with its focus set.
+
+A paged MT is read-only: it cannot be modified, or used for building.
+It can be written in any encoding.
+Pointers returned by the functions accessing vertices and tiles remain 
+valid for a limited number of accesses (see class MT_PageCacheClass).
+*/
+
+typedef class MT_PagedMultiTesselationClass * MT_PagedMultiTesselation;
+
+class MT_PagedMultiTesselationClass : public MT_MultiTesselationClass
+{
+
+/* ------------------------------------------------------------------------ */
+/*                         Internal structure                               */
+/* ------------------------------------------------------------------------ */
+
+  protected:
+
+  /*
+  Memory budget for the page cache, in bytes.
+  */
+  long page_budget;
+
+  /*
+  Release the page cache, if any.
+  */
+  void MT_ClosePages(void);
+
+  /*
+  Write the whole section s from the page cache, as in the mapped 
+  encoding.
+  */
+  void MT_WritePagedSection(FILE * fd, int s);
+
+/* ------------------------------------------------------------------------ */
+/*                          Creation and deletion                           */
+/* ------------------------------------------------------------------------ */
+
+  public:
+
+  /*
+  Create a paged MT given the dimensions of the embedding space and of
+  the tiles, and the memory budget for the page cache, in bytes.
+  The MT contains no elements.
+  */
+  MT_PagedMultiTesselationClass ( int vert_dim, int tile_dim, 
+                                  long budget = MT_PAGE_BUDGET );
+
+  /*
+  Destroy a paged MT, and close its file.
+  */
+  ~MT_PagedMultiTesselationClass ();
+
+  /*
+  Functions redefined from superclasses, always failing
+  since a paged MT cannot be modified.
+  */
+  int MT_SetVertexNum (MT_INDEX i);
+  int MT_SetTileNum (MT_INDEX i);
+
+  /*
+  Return the number of frames currently used by the page cache.
+  */
+  inline int MT_PageFrameNum(void)
+  {  return ( pages ? pages->MT_FrameNum() : 0 );  }
+
+/* ------------------------------------------------------------------------ */
+/*                         Reading and writing                              */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Functions redefined from superclass MT_MultiTesselationClass.
+  MT_ReadBody only accepts the mapped encoding: it reads the bounding box 
+  and sets up the page cache on the sections of the file.
+  */
+  int MT_ReadBody(FILE * fd, int file_encoding);
+  void MT_WriteBody(FILE * fd, int file_encoding);
+
+};
+
 /* ------------------------------------------------------------------------ */
 
 #endif  /* MT_MULTI_INCLUDED */
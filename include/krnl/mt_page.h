@@ -0,0 +1,240 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_page.h ------------------------------- */
+
+#ifndef MT_PAGE_INCLUDED
+#define MT_PAGE_INCLUDED
+
+#include "mt_glob.h"
+
+/* ------------------------------------------------------------------------ */
+/*                 PAGE CACHE FOR OUT-OF-CORE ARRAYS                        */
+/* ------------------------------------------------------------------------ */
+
+/*
+This file defines a class, called MT_PageCacheClass, which gives access
+to arrays of fixed-size records stored in a file, without loading them
+in memory. It is used by the paged Multi-Tesselation 
+(class MT_PagedMultiTesselationClass), whose arrays are the sections
+of a file in the mapped encoding.
+
+Each array (section) is split into chunks of MT_PAGE_SIZE bytes at most, 
+containing a whole number of records. A chunk is loaded from the file 
+into a frame when one of its records is accessed, frames are reused in 
+least recently used order. The number of frames is given by a memory
+budget, but it is never less than MT_PAGE_MIN_FRAMES.
+
+A pointer to a record remains valid until its frame is reused. Since a
+frame is reused only when all other frames have been accessed more 
+recently, a pointer remains valid while at most MT_PAGE_MIN_FRAMES-1
+other chunks are accessed. This is enough for the accesses made by the 
+MT library, which never keeps more than one tile and its vertices 
+at the same time.
+*/
+
+/* ------------------------------------------------------------------------ */
+/*                                  MACROS                                  */
+/* ------------------------------------------------------------------------ */
+
+/*
+Maximum size of a chunk, in bytes.
+*/
+#define MT_PAGE_SIZE 32768
+
+/*
+Minimum number of frames, and default memory budget in bytes.
+*/
+#define MT_PAGE_MIN_FRAMES (2*(MT_MAX_DIM+2))
+#define MT_PAGE_BUDGET 67108864L
+
+/* ------------------------------------------------------------------------ */
+/*                      AUXILIARY DATA STRUCTURES                           */
+/* ------------------------------------------------------------------------ */
+
+/*
+Data structure for a section (array) of the file.
+*/
+typedef struct MT_PageSectionStruct
+{
+  MT_OFFSET my_offset; /* file offset of the first record */
+  size_t my_size;      /* size of a record, in bytes */
+  MT_INDEX my_num;     /* number of records */
+  MT_INDEX my_recs;    /* number of records in a chunk */
+  MT_INDEX my_chunks;  /* number of chunks */
+  int * my_frame;      /* frame containing each chunk, -1 if not loaded */
+} MT_PageSection;
+
+/* ------------------------------------------------------------------------ */
+/*                          THE PAGE CACHE CLASS                            */
+/* ------------------------------------------------------------------------ */
+
+typedef class MT_PageCacheClass * MT_PageCache;
+
+class MT_PageCacheClass
+{
+
+/* ------------------------------------------------------------------------ */
+/*                       Internal structure                                 */
+/* ------------------------------------------------------------------------ */
+
+  protected:
+
+  /*
+  The file, owned by this object.
+  */
+  FILE * my_file;
+
+  /*
+  Number of sections, and array of sections.
+  */
+  int S_Num;
+  MT_PageSection * S_Arr;
+
+  /*
+  Maximum number of frames, and number of frames allocated so far.
+  */
+  int F_Max;
+  int F_Num;
+
+  /*
+  For each frame: its data, the section and the chunk loaded into it,
+  the previous and the next frame in the list of frames ordered from 
+  the most recently to the least recently used.
+  */
+  char ** F_data;
+  int * F_sect;
+  MT_INDEX * F_chunk;
+  int * F_prev;
+  int * F_next;
+
+  /*
+  First (most recently used) and last (least recently used) frame.
+  */
+  int F_first;
+  int F_last;
+
+  /*
+  Number of accesses to a loaded chunk (hits) and to a chunk 
+  to be loaded (misses).
+  */
+  unsigned long my_hits;
+  unsigned long my_misses;
+
+/* ------------------------------------------------------------------------ */
+/*                          Creation and deletion                           */
+/* ------------------------------------------------------------------------ */
+
+  public:
+
+  /*
+  Create a page cache for file fd, using about budget bytes of memory 
+  for the frames. The cache has no sections.
+  The file is closed when the cache is destroyed.
+  */
+  MT_PageCacheClass(FILE * fd, long budget);
+
+  /*
+  Destroy the page cache, release frames and close the file.
+  */
+  ~MT_PageCacheClass(void);
+
+  /*
+  Add a section of num records of size bytes each, starting at file
+  offset pos. Sections are numbered from 0 in the order they are added.
+  Return the number of the new section, -1 on failure.
+  */
+  int MT_AddSection(MT_OFFSET pos, size_t size, MT_INDEX num);
+
+/* ------------------------------------------------------------------------ */
+/*                            Access to records                             */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Return a pointer to the i-th record of section s, loading its chunk
+  if needed.
+  */
+  inline void * MT_Record(int s, MT_INDEX i)
+  {
+    MT_PageSection * sp = &S_Arr[s];
+    MT_INDEX c = i / sp->my_recs;
+    int f = sp->my_frame[c];
+    if (f<0)  f = MT_LoadChunk(s,c);
+    else
+    {  my_hits++;
+       if (f!=F_first)  MT_Touch(f);
+    }
+    return ( F_data[f] + (i - c*sp->my_recs) * sp->my_size );
+  }
+
+  /*
+  Return a pointer to the c-th chunk of section s, loading it if needed,
+  and set size to the number of bytes in the chunk.
+  */
+  void * MT_Chunk(int s, MT_INDEX c, size_t * size);
+
+  /*
+  Number of chunks of section s.
+  */
+  inline MT_INDEX MT_ChunkNum(int s)  {  return ( S_Arr[s].my_chunks );  }
+
+/* ------------------------------------------------------------------------ */
+/*                               Statistics                                 */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Return the number of hits and misses since the cache was created.
+  */
+  inline unsigned long MT_Hits(void)    {  return (my_hits);  }
+  inline unsigned long MT_Misses(void)  {  return (my_misses);  }
+
+  /*
+  Return the number of frames currently allocated.
+  */
+  inline int MT_FrameNum(void)  {  return (F_Num);  }
+
+/* ------------------------------------------------------------------------ */
+/*                          Auxiliary functions                             */
+/* ------------------------------------------------------------------------ */
+
+  protected:
+
+  /*
+  Move frame f to the front of the list of frames.
+  */
+  void MT_Touch(int f);
+
+  /*
+  Load chunk c of section s into a frame (a new one, if the maximum 
+  number of frames has not been reached, otherwise the least recently
+  used one), and return the frame.
+  */
+  int MT_LoadChunk(int s, MT_INDEX c);
+
+};
+
+/* ------------------------------------------------------------------------ */
+
+#endif  /* MT_PAGE_INCLUDED */
@@ -55,8 +55,52 @@ A file containing a persistent object starts with a header specifying:
 - parameters used to allocate internal structures of this object
 - text describing the object contained in the file (optional, and
   ignored on reading)
-- the type of encoding (binary or ascii) for the body
+- the type of encoding (binary, ascii, mapped, compressed or stream) for 
+  the body
 The header is followed by a body containing the data for the object.
+
+The mapped encoding is a binary encoding in which the body is made of 
+sections that are exact images of the internal arrays of the object, each 
+section starting at a file offset which is a multiple of MT_MAPPED_ALIGN. 
+Such a body can be mapped in memory instead of being read (see class
+MT_TileSetClass).
+
+The compressed encoding is a binary encoding in which the arrays of the 
+object are split into blocks of MT_COMPRESS_BLOCK records, each coded
+independently of the others (so that blocks can be decoded in parallel), 
+and preceded by its size in bytes. Inside a block, integers are coded 
+as variable-length sequences of bytes (7 bits per byte, the highest bit 
+set in all bytes but the last one), and signed differences are first 
+mapped to unsigned integers (0,-1,1,-2,2... become 0,1,2,3,4...).
+
+The stream encoding is a binary encoding in which the entities of the
+object are written in the order in which they can be used while the 
+file is still being read (for an MT, node by node in topological order 
+of the DAG starting from the root, see class MT_MultiTesselationClass).
+
+Classes not providing a specific layout for the mapped, compressed or
+stream encoding write and read their body in such encodings as in the 
+binary one (see MT_HasBodyLayout).
+
+In all encodings but the ascii one, the encoding keyword is followed,
+on the same line, by the byte order (MT_LITTLE_ENDIAN_KW or 
+MT_BIG_ENDIAN_KW) and by the sizes in bytes of an MT index and of a 
+real number on the machine which wrote the file. A file written on a 
+machine with the opposite byte order is read by swapping the bytes of 
+each number (such a file cannot be mapped). Files without this 
+information are read in the byte order of the reading machine.
+
+The body may be followed by a footer (in ascii, for any encoding) 
+summarizing the object, so that such information can be obtained 
+without reading the body (see class MT_FileInfoClass). The footer 
+starts with keyword MT_FOOTER_KW, and the file ends with a line 
+containing keyword MT_FOOTER_AT_KW, the file offset of the footer and
+the file offset where the object starts, written on a fixed number of 
+digits. If several objects are written one after the other in the same
+file, the offset of the start of each object is the end of the previous
+one, thus the footer of each object can be found by going back from the
+end of the file. The content of the footer is class-specific (see class
+MT_TileSetClass).
 */
 
 /* ------------------------------------------------------------------------ */
@@ -78,13 +122,72 @@ Keywords for starting the various sections of an MT file.
 #define MT_ENCODE_KW "MT-ENCODE"
 #define MT_BODY_KW "MT-BODY"
 
+/*
+Keywords for the footer of an MT file.
+*/
+#define MT_FOOTER_KW "MT-FOOTER"
+#define MT_BOX_KW "MT-BOX"
+#define MT_RESOLUTION_KW "MT-RESOLUTION"
+#define MT_SECTIONS_KW "MT-SECTIONS"
+#define MT_FOOTER_AT_KW "MT-FOOTER-AT"
+
+/*
+Number of digits of the offset of the footer, and number of bytes
+at the end of a file where the offset is searched.
+*/
+#define MT_FOOTER_DIGITS 20
+#define MT_FOOTER_TAIL 64
+
 /* 
 Keywords for the type of encoding.
 */
 #define MT_ASCII_KW "ASCII"
 #define MT_BINARY_KW "BINARY"
+#define MT_MAPPED_KW "MAPPED"
+#define MT_COMPRESSED_KW "COMPRESSED"
+#define MT_STREAM_KW "STREAM"
 #define MT_ASCII_ENCODING 0
 #define MT_BINARY_ENCODING 1
+#define MT_MAPPED_ENCODING 2
+#define MT_COMPRESSED_ENCODING 3
+#define MT_STREAM_ENCODING 4
+
+/*
+Keywords for the byte order of binary encodings.
+*/
+#define MT_LITTLE_ENDIAN_KW "LE"
+#define MT_BIG_ENDIAN_KW "BE"
+
+/*
+Alignment (in bytes) of the sections in the body of a file written with 
+the mapped encoding. It must be a multiple of the page size of the
+systems where the file is mapped.
+*/
+#define MT_MAPPED_ALIGN 4096
+
+/*
+Number of records in a block of the compressed encoding.
+*/
+#define MT_COMPRESS_BLOCK 65536
+
+/*
+Size (in bytes) of the stream buffer used when reading a file given
+its name. Large buffers let ASCII files be read in few large blocks.
+*/
+#define MT_READ_BUFFER 1048576
+
+/*
+Minimum number of values for reading an array of the body with the 
+threads set by MT_SetThreadNum (see MT_ReadArray and MT_ScanArray). 
+Smaller arrays are read by the calling thread only.
+*/
+#define MT_PARALLEL_READ 65536
+
+/*
+Size (in bytes) of each of the two buffers used for writing a file
+in the background (see MT_StartWrite).
+*/
+#define MT_WRITE_BUFFER 4194304
 
 /*
 Encoding format for auxiliary files.
@@ -111,6 +214,17 @@ class MT_PersistentClass
   */
   char my_descr[MT_DESCR_LEN];
 
+  /*
+  1 if the body of the file being read has the opposite byte order
+  of this machine, 0 otherwise. Set by MT_ReadEncoding.
+  */
+  int swap_bytes;
+
+  /*
+  State of the write started by MT_StartWrite, NULL if none.
+  */
+  struct MT_WriterStruct * my_writer;
+
 /* ------------------------------------------------------------------------ */
 /*                  Class keyword and object description                    */
 /* ------------------------------------------------------------------------ */
@@ -151,6 +265,16 @@ class MT_PersistentClass
   */
   MT_PersistentClass ( void );
 
+  public:
+
+  /*
+  Wait for the completion of the write started by MT_StartWrite, if 
+  any, and release its state. Since this destructor runs after the 
+  ones of the subclasses, a subclass whose data are written by MT_Write 
+  must call MT_WaitWrite in its destructor, before releasing them.
+  */
+  virtual ~MT_PersistentClass ( void );
+
 /* ------------------------------------------------------------------------ */
 /*                           Reading functions                              */
 /* ------------------------------------------------------------------------ */
@@ -172,10 +296,112 @@ class MT_PersistentClass
   int MT_ReadFileKw(FILE * fd);
 
   /*
-  Read an MT index, read an integer counter.
+  Read an MT index, read an integer counter, read a real number.
   */
   int MT_ReadIndex(FILE * fd, MT_INDEX * i, int file_encoding);
   int MT_ReadCount(FILE * fd, int * i, int file_encoding);
+  int MT_ReadFloat(FILE * fd, float * f, int file_encoding);
+
+  /*
+  Scanner for numbers in ASCII format, used by all the reading functions
+  in place of fscanf. Each function skips white spaces, converts the
+  characters forming a number, and leaves the file just after them.
+  Characters are taken directly from the stream buffer, and numbers are 
+  converted without going through the format parsing of fscanf.
+  Real numbers get the same value as with fscanf (correctly rounded). 
+  Return 1 on success, 0 on failure.
+  */
+  int MT_ScanInt(FILE * fd, int * i);
+  int MT_ScanIndex(FILE * fd, MT_INDEX * i);
+  int MT_ScanFloat(FILE * fd, float * f);
+  
+  /*
+  Skip white spaces and read the next character.
+  */
+  int MT_ScanChar(FILE * fd, char * c);
+
+  /*
+  Scanner for numbers in ASCII format working on a memory buffer.
+  Each function converts the number starting at position p, which must
+  be followed by a white space or by '\0', and returns the position 
+  after it. Return NULL on failure.
+  */
+  char * MT_ParseIndex(char * p, MT_INDEX * i);
+  char * MT_ParseFloat(char * p, float * f);
+
+  /*
+  Return 1 if this machine is big-endian, 0 if it is little-endian.
+  */
+  int MT_BigEndian(void);
+
+  /*
+  Return 1 if the numbers in the body of the file being read must
+  have their bytes swapped, i.e., the file has been written on a
+  machine with the opposite byte order.
+  */
+  inline int MT_SwapBytes(void)  {  return (swap_bytes);  }
+
+  /*
+  Reverse the bytes of each of the num elements of size bytes 
+  in array p. The loops are simple enough to be vectorized by 
+  the compiler.
+  */
+  void MT_SwapArray(void * p, size_t size, size_t num);
+
+  /*
+  Read an array of the body, and leave the file just after it.
+  MT_ReadArray reads in binary num elements of size bytes into array p,
+  swapping their bytes if needed (see MT_SwapBytes).
+  MT_ScanArray reads in ASCII float_num real numbers into array f,
+  followed by index_num MT indexes into array v.
+  Large arrays are read through a memory buffer: MT_ReadArray splits
+  the array into ranges read at the same time, MT_ScanArray splits the
+  text into chunks where numbers are counted and converted at the same
+  time, by the threads set with MT_SetThreadNum. 
+  Return 1 on success, 0 on failure.
+  */
+  int MT_ReadArray(FILE * fd, void * p, size_t size, size_t num);
+  int MT_ScanArray(FILE * fd, MT_INDEX float_num, float * f,
+                              MT_INDEX index_num, MT_INDEX * v);
+
+  /*
+  Primitives for the compressed encoding, working on memory buffers.
+  MT_PutVarint writes i at position p as a variable-length integer, and
+  returns the position after it (at most 5 bytes are written).
+  MT_GetVarint reads a variable-length integer from position p into i,
+  and returns the position after it; it returns NULL if the integer
+  does not end before position end, or it is longer than 5 bytes.
+  MT_ZigZag and MT_UnZigZag map signed differences to unsigned integers
+  and back.
+  */
+  inline unsigned char * MT_PutVarint(unsigned char * p, MT_INDEX i)
+  {
+    while (i >= 0x80)  {  *(p++) = (unsigned char) (i | 0x80);  i >>= 7;  }
+    *(p++) = (unsigned char) i;
+    return p;
+  }
+  inline unsigned char * MT_GetVarint(unsigned char * p, unsigned char * end,
+                                      MT_INDEX * i)
+  {
+    MT_INDEX v;
+    int s = 7;
+    if (p >= end) return NULL;
+    v = *(p++);
+    if (v & 0x80)
+    {  v &= 0x7f;
+       do
+       {  if ( (p >= end) || (s >= 35) ) return NULL;
+          v |= ((MT_INDEX) (*p & 0x7f)) << s;  s += 7;
+       }
+       while (*(p++) & 0x80);
+    }
+    (*i) = v;
+    return p;
+  }
+  inline MT_INDEX MT_ZigZag(int d)
+  {  return ( ((MT_INDEX) d << 1) ^ (MT_INDEX) (d >> 31) );  }
+  inline int MT_UnZigZag(MT_INDEX i)
+  {  return ( (int) (i >> 1) ^ -((int) (i & 1)) );  }
 
   /*
   Read the class stored in the file and its parameters.
@@ -204,10 +430,28 @@ class MT_PersistentClass
 
   /*
   Read the encoding of the file, and return it. The file encoding will
-  be used for reading the body.  Return 1 on success, 0 on failure.
+  be used for reading the body. For binary encodings, also read the
+  byte order and the sizes of numbers, and set swap_bytes.
+  Return 1 on success, 0 on failure.
   */
   int MT_ReadEncoding(FILE * fd, int * file_encoding);
 
+  /*
+  Read the header of the file, up to the beginning of the body, and 
+  return its encoding (see MT_ReadEncoding). Return 1 on success, 
+  0 on failure.
+  */
+  int MT_ReadHeader(FILE * fd, int * file_encoding);
+
+  /*
+  Return 1 if this class has a body layout specific of the given 
+  encoding. Otherwise, the body is read and written as in the binary 
+  encoding. Here, only the ascii and binary encodings have a layout.
+  Redefined in the subclasses providing a mapped, compressed or stream
+  layout.
+  */
+  virtual int MT_HasBodyLayout(int file_encoding);
+
   /*
   Read the content of the file and fill the internal data structures
   of this object with the data contained in it.
@@ -221,7 +465,7 @@ class MT_PersistentClass
   If successful, use the data contained in the file to fill this object.
   */
   int MT_Read(FILE * fd);
-  int MT_Read(char * fname);
+  int MT_Read(char * fname);
 
 /* ------------------------------------------------------------------------ */
 /*                            Writing functions                             */
@@ -264,7 +508,8 @@ class MT_PersistentClass
 
   /*
   Write the encoding of the file. The same encoding 
-  will be used for writing the body.
+  will be used for writing the body. For binary encodings, also write
+  the byte order and the sizes of numbers of this machine.
   */
   void MT_WriteEncoding(FILE * fd, int file_encoding);
 
@@ -274,12 +519,55 @@ class MT_PersistentClass
   */
   virtual void MT_WriteBody(FILE * fd, int file_encoding) = 0;
 
+  /*
+  Write the footer after the body, for a file written in the given 
+  encoding, where the object starts at offset start. Here, no footer 
+  is written.
+  In the subclasses, this function can be redefined to write a footer.
+  MT_WriteFooterAt writes the last line of the footer, given the offset
+  of its beginning and the one of the object.
+  */
+  virtual void MT_WriteFooter(FILE * fd, int file_encoding, long start);
+  void MT_WriteFooterAt(FILE * fd, long pos, long start);
+
   /*
   Write the whole file, taking the object description from string my_descr.
   */
   virtual void MT_Write(FILE * fd, int file_encoding = MT_ASCII_ENCODING);
-  virtual int MT_Write(char * fname, int file_encoding = MT_ASCII_ENCODING);
-  
+  virtual int MT_Write(char * fname, int file_encoding = MT_ASCII_ENCODING);
+
+/* ------------------------------------------------------------------------ */
+/*                          Writing in the background                       */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Start writing the whole file, as MT_Write does, and return at once.
+  A separate thread formats the data into two large buffers in turn,
+  while a second thread writes the other buffer to the file, thus 
+  formatting, disk transfers and the caller overlap.
+  Until the write is completed (see MT_WaitWrite), this object must 
+  not be modified (and a paged MT must not be accessed); destroying 
+  it waits for the completion of the write.
+  A write still in progress is completed before starting the new one.
+  On systems without POSIX threads and user-defined streams (function
+  fopencookie of the GNU C library), the file is written before 
+  returning. Return 1 if the file has been opened, 0 otherwise.
+  */
+  int MT_StartWrite(char * fname, int file_encoding = MT_ASCII_ENCODING);
+
+  /*
+  Return 1 if the write started by MT_StartWrite is completed,
+  or if no write has been started, 0 if it is still in progress.
+  */
+  int MT_WriteDone(void);
+
+  /*
+  Wait for the completion of the write started by MT_StartWrite.
+  Return 1 if the whole file has been written (or if no write has been
+  started), 0 on failure.
+  */
+  int MT_WaitWrite(void);
+  
 
 };
 
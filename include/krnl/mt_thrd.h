@@ -0,0 +1,170 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_thrd.h ------------------------------- */
+
+#ifndef MT_THREAD_INCLUDED
+#define MT_THREAD_INCLUDED
+
+#include "mt_glob.h"
+
+/* ------------------------------------------------------------------------ */
+/*                  PARALLEL EXECUTION OF INDEPENDENT JOBS                  */
+/* ------------------------------------------------------------------------ */
+
+/*
+This file contains functions to execute a number of independent jobs
+on several threads. They are used inside the library for operations 
+that can be split into independent parts, e.g., decoding the blocks of
+a file in compressed encoding.
+
+Each job is identified by a number from 0 to the number of jobs minus one.
+The jobs are distributed among the threads as soon as each thread 
+becomes free, and the calling thread executes jobs as well.
+On systems without POSIX threads (_WIN32), jobs are executed in 
+sequence by the calling thread.
+*/
+
+/* ------------------------------------------------------------------------ */
+/*                                  MACROS                                  */
+/* ------------------------------------------------------------------------ */
+
+/*
+Maximum number of threads used to run jobs.
+*/
+#define MT_MAX_THREADS 64
+
+/* ------------------------------------------------------------------------ */
+/*                                FUNCTIONS                                 */
+/* ------------------------------------------------------------------------ */
+
+/*
+Type of the function executing a job. Parameter data is the pointer 
+given to MT_RunJobs, parameter job is the number of the job.
+*/
+typedef void (* MT_JobFunction) (void * data, int job);
+
+/*
+Set the number of threads used to run jobs (including the calling 
+thread). If n<=0, use as many threads as processors. Default is 0.
+*/
+extern void MT_SetThreadNum(int n);
+
+/*
+Return the number of threads used to run jobs.
+*/
+extern int MT_TheThreadNum(void);
+
+/*
+Execute job_num jobs by calling fun(data,i) for i = 0..job_num-1,
+and return when all jobs are completed.
+*/
+extern void MT_RunJobs(int job_num, MT_JobFunction fun, void * data);
+
+/* ------------------------------------------------------------------------ */
+/*                  PARALLEL EXECUTION OF GENERATED TASKS                   */
+/* ------------------------------------------------------------------------ */
+
+/*
+The following functions execute a set of tasks where each task may 
+generate new tasks, e.g., the visit of a DAG where visiting a node 
+generates the visit of its neighbors. A task is identified by an
+MT_INDEX (e.g., the node to be visited).
+
+Each thread (worker) keeps a stack of the tasks it has generated and 
+executes them from the top. A worker whose stack is empty steals the 
+oldest tasks from the stack of another worker. All threads terminate 
+when no task is left and no task is being executed.
+*/
+
+/*
+Set of tasks being executed by MT_RunTasks.
+*/
+typedef struct MT_TaskPoolStruct * MT_TaskPool;
+
+/*
+Type of the function executing a task. Parameter data is the pointer
+given to MT_RunTasks, parameter worker is the number of the thread 
+executing the task (from 0 to MT_TheThreadNum()-1), parameter task is
+the task. The function may add new tasks by calling MT_PushTask with
+the same pool and worker.
+*/
+typedef void (* MT_TaskFunction) (void * data, MT_TaskPool pool, 
+                                  int worker, MT_INDEX task);
+
+/*
+Execute the given task, and all the tasks generated from it, by
+calling fun on each task, and return when all tasks are completed.
+Return 1 on success, 0 if some task could not be added because of
+a failed allocation (in this case some tasks have not been executed).
+*/
+extern int MT_RunTasks(MT_INDEX task, MT_TaskFunction fun, void * data);
+
+/*
+Add a task to the stack of the given worker. To be called only within
+a function executing a task.
+*/
+extern void MT_PushTask(MT_TaskPool pool, int worker, MT_INDEX task);
+
+/*
+Set the marker pointed by m to value v, if it is different from v,
+as an atomic operation. Return 1 if the marker has been set by this 
+call, 0 if it was already equal to v. Tasks use it to ensure that
+only one of them acquires a shared object (e.g., a node to be visited).
+*/
+extern int MT_MarkOnce(unsigned int * m, unsigned int v);
+
+/* ------------------------------------------------------------------------ */
+/*                            MUTUAL EXCLUSION                              */
+/* ------------------------------------------------------------------------ */
+
+/*
+A mutex protects an object shared by threads that are not run by the
+functions above (e.g., the threads of an application using the library
+as a server). At most one thread at a time holds a mutex.
+On systems without POSIX threads (_WIN32), mutexes do nothing.
+*/
+
+typedef struct MT_MutexStruct * MT_Mutex;
+
+/*
+Create a mutex. Return NULL if it could not be created.
+*/
+extern MT_Mutex MT_NewMutex(void);
+
+/*
+Delete a mutex, which must not be held by any thread.
+*/
+extern void MT_DeleteMutex(MT_Mutex mx);
+
+/*
+Acquire a mutex, waiting until no other thread holds it, and release it.
+*/
+extern void MT_LockMutex(MT_Mutex mx);
+extern void MT_UnlockMutex(MT_Mutex mx);
+
+/* ------------------------------------------------------------------------ */
+
+#endif  /* MT_THREAD_INCLUDED */
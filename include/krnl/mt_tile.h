@@ -29,6 +29,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define MT_TESSELATION_INCLUDED
 
 #include "mt_prst.h"
+#include "mt_page.h"
 
 /* ------------------------------------------------------------------------ */
 /*                       A PERSISTENT TESSELATION                           */
@@ -75,6 +76,32 @@ The first element (position 0) of each array is used to encode the null
 entity (value returned by operations when the result is undefined).
 Valid indices start from 1.
 */
+
+/*
+Sections of the mapped encoding containing the vertex coordinates and the
+tile vertices, as numbered in the page cache of a paged object and in
+the footer of a file.
+*/
+#define MT_COORD_SECTION  0
+#define MT_VERTEX_SECTION 1
+
+/*
+Maximum number of sections in the footer of a file.
+*/
+#define MT_MAX_SECTIONS 8
+
+/*
+Data structure for a block of records in the compressed encoding.
+*/
+typedef struct MT_BlockStruct
+{
+  int my_section;          /* section (array) containing the records */
+  MT_INDEX my_first;       /* index of the first record in the block */
+  MT_INDEX my_num;         /* number of records in the block */
+  unsigned char * my_data; /* encoded records */
+  size_t my_size;          /* size of the encoded records, in bytes */
+  int my_ok;               /* 1 if the block has been decoded correctly */
+} MT_Block;
   
 /* ------------------------------------------------------------------------ */
 /*                          THE TESSELATION CLASS                           */
@@ -131,6 +158,51 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   Array storing all tile vertices, entries inside T_Arr point here.
   */
   MT_INDEX * all_vert;
+
+  /*
+  Memory mapping of the file this object has been read from, if the
+  file was in mapped encoding (NULL otherwise), and its length.
+  Arrays all_coord and all_vert (and the arrays of the subclasses
+  having a mapped layout) may point inside the mapping, in such case
+  they must not be freed. The mapping is private: pages are shared among
+  the processes mapping the same file until they are modified.
+  */
+  char * map_addr;
+  size_t map_len;
+
+  /*
+  Offset in the file of the first byte after the last section
+  read or mapped.
+  */
+  MT_OFFSET map_pos;
+
+  /*
+  Page cache, used only by paged objects (NULL otherwise), see class
+  MT_PagedMultiTesselationClass. If present, arrays V_Arr, T_Arr, 
+  all_coord and all_vert are not allocated, and vertices and tiles are
+  taken from the page cache.
+  */
+  MT_PageCache pages;
+
+  /*
+  Return the coordinates of vertex v / the vertices of tile t from the
+  page cache. The accessors test V_Arr / T_Arr, and call these 
+  functions only for paged objects, which keep such arrays NULL.
+  */
+  float * MT_PagedVertexCoords(MT_INDEX v);
+  MT_INDEX * MT_PagedTileVertices(MT_INDEX t);
+
+  /*
+  Number of bits used for quantizing each vertex coordinate in the 
+  compressed encoding (16 or 24), or 0 if coordinates are not quantized.
+  */
+  int q_bits;
+
+  /*
+  Offsets in the file of the sections of the body written last, 
+  0 for the sections not present in its encoding. Written in the footer.
+  */
+  long s_pos[MT_MAX_SECTIONS];
   
 /* ------------------------------------------------------------------------ */
 /*                         Global information                               */
@@ -157,6 +229,14 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   inline MT_INDEX MT_VertexNum(void)   { return (V_Num); }
   inline MT_INDEX MT_TileNum(void)     { return (T_Num); }
 
+  /*
+  Number of tiles of the tesselations at minimum and at maximum 
+  resolution. A tile set is a single tesselation, thus both are
+  the number of its tiles. Redefined in MT_MultiTesselationClass.
+  */
+  virtual MT_INDEX MT_MinResolutionTileNum(void) { return (T_Num); }
+  virtual MT_INDEX MT_MaxResolutionTileNum(void) { return (T_Num); }
+
 /* ------------------------------------------------------------------------ */
 /*                              Bounding box                                */
 /* ------------------------------------------------------------------------ */
@@ -188,6 +268,15 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   inline float MT_MaxY(void) { return ( F_max[1] ); }
   inline float MT_MaxZ(void) { return ( F_max[2] ); }
 
+  /*
+  Compute the bounding box from the coordinates of the vertices.
+  This is done when reading the object from a file, while MT_AddVertex
+  keeps the box updated when the object is built. With many vertices,
+  boxes of ranges of vertices are computed by the threads set with 
+  MT_SetThreadNum, and then merged.
+  */
+  void MT_ComputeBoundingBox(void);
+
 /* ------------------------------------------------------------------------ */
 /*                          Information for vertices                        */
 /* ------------------------------------------------------------------------ */
@@ -195,10 +284,10 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   /* 
   Return a pointer to the array of coordinates of vertex v.
   */
-  inline void MT_VertexCoords(MT_INDEX v, float ** f)
-  {  (*f) = V_Arr[v].my_coord;  }
   inline float * MT_VertexCoords(MT_INDEX v)
-  {  return (V_Arr[v].my_coord);  }
+  {  return ( V_Arr ? V_Arr[v].my_coord : MT_PagedVertexCoords(v) );  }
+  inline void MT_VertexCoords(MT_INDEX v, float ** f)
+  {  (*f) = MT_VertexCoords(v);  }
 
   /*
   Copy the coordinates of vertex v in array f, f must have at least
@@ -210,15 +299,15 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   Return the i-th coordinate of v. Parameter i must be 0 <= i < V_Dim.
   */
   inline float MT_VertexCoord(MT_INDEX v, int i)
-  { return ( V_Arr[v].my_coord[i] ); } 
+  { return ( MT_VertexCoords(v)[i] ); } 
 
   /*
   Shortcuts for the first three coordinates.
   Getting the Z coordinate is only safe if we are in 3D.
   */
-  inline float MT_VertexX(MT_INDEX v) { return ( V_Arr[v].my_coord[0] ); }
-  inline float MT_VertexY(MT_INDEX v) { return ( V_Arr[v].my_coord[1] ); } 
-  inline float MT_VertexZ(MT_INDEX v) { return ( V_Arr[v].my_coord[2] ); } 
+  inline float MT_VertexX(MT_INDEX v) { return ( MT_VertexCoords(v)[0] ); }
+  inline float MT_VertexY(MT_INDEX v) { return ( MT_VertexCoords(v)[1] ); } 
+  inline float MT_VertexZ(MT_INDEX v) { return ( MT_VertexCoords(v)[2] ); } 
   
 /* ------------------------------------------------------------------------ */
 /*                         Information for tiles                            */
@@ -227,10 +316,10 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   /*
   Return a pointer to the array of vertices of tile t.
   */
-  inline void MT_TileVertices(MT_INDEX t, MT_INDEX ** v)
-  {  (*v) = T_Arr[t].my_vertex;  }
   inline MT_INDEX * MT_TileVertices(MT_INDEX t)
-  {  return (T_Arr[t].my_vertex);  }
+  {  return ( T_Arr ? T_Arr[t].my_vertex : MT_PagedTileVertices(t) );  }
+  inline void MT_TileVertices(MT_INDEX t, MT_INDEX ** v)
+  {  (*v) = MT_TileVertices(t);  }
 
   /*
   Copy the vertices of tile t into array v, v must have 
@@ -242,7 +331,7 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   Return the i-th vertex of tile t.
   */
   inline MT_INDEX MT_TileVertex(MT_INDEX t, int i)
-  {  return ( T_Arr[t].my_vertex[i] );  }
+  {  return ( MT_TileVertices(t)[i] );  }
   
   /*
   Return the index (in the range 0..T_Dim) of vertex v in tile t.
@@ -268,7 +357,8 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   /*
   This constructor does nothing. It is used just in subclasses.
   */
-  inline MT_TileSetClass (void) { }
+  inline MT_TileSetClass (void) 
+  {  map_addr = NULL; map_len = 0; pages = NULL; q_bits = 0;  }
   /*********** CONTROLLA SE SERVE ***************/
 
   public:
@@ -283,14 +373,16 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   MT_TileSetClass ( int vert_dim, int tile_dim );
 
   /*
-  Set the dimensions of the vertex and tile arrays.
+  Set the dimensions of the vertex and tile arrays. MT_SetVertexNum 
+  also empties the bounding box.
   Return 1 on success, 0 on failure.
   */
   virtual int MT_SetVertexNum (MT_INDEX i);
   virtual int MT_SetTileNum (MT_INDEX i);
   
   /*
-  Add a vertex, add a tile.
+  Add a vertex, add a tile. MT_AddVertex enlarges the bounding box to
+  contain the vertex.
   */
   void MT_AddVertex(MT_INDEX v, float * coord_array);
   void MT_AddTile(MT_INDEX t, MT_INDEX * vert_array);
@@ -300,6 +392,132 @@ class MT_TileSetClass : public virtual MT_PersistentClass
   */
   virtual ~MT_TileSetClass ();
 
+/* ------------------------------------------------------------------------ */
+/*                           Page cache statistics                          */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Number of hits and misses in the page cache, 0 if this object is 
+  not paged.
+  */
+  inline unsigned long MT_PageHits(void)
+  {  return ( pages ? pages->MT_Hits() : 0 );  }
+  inline unsigned long MT_PageMisses(void)
+  {  return ( pages ? pages->MT_Misses() : 0 );  }
+
+  /*
+  Return 1 if this object is paged, 0 otherwise. The records of a paged
+  object must not be accessed by several threads at the same time, 
+  since each access may update the page cache.
+  */
+  inline int MT_IsPaged(void)  {  return ( pages != NULL );  }
+
+/* ------------------------------------------------------------------------ */
+/*                        Memory-mapped file access                         */
+/* ------------------------------------------------------------------------ */
+
+  /*
+  Check if array p points inside the current file mapping.
+  */
+  inline int MT_IsMapped(void * p)
+  {  return ( map_addr && ((char *)p >= map_addr) && 
+              ((char *)p < map_addr + map_len) );  }
+
+  /*
+  Free array p, unless it points inside the current file mapping.
+  */
+  inline void MT_FreeArray(void * p)
+  {  if (p && !MT_IsMapped(p)) free(p);  }
+
+  protected:
+
+  /*
+  Map the whole file fd in memory, and set map_pos to the current file
+  position. If mapping is not possible on this system, or it fails, 
+  or the file has the opposite byte order of this machine,
+  leave map_addr NULL: sections will then be read with fread.
+  Any previous mapping must have been released.
+  */
+  void MT_MapFile(FILE * fd);
+
+  /*
+  Release the current file mapping, if any.
+  */
+  void MT_UnmapFile(void);
+
+  /*
+  Return the first offset multiple of MT_MAPPED_ALIGN after map_pos,
+  where a section of size bytes starts, and advance map_pos after it.
+  */
+  MT_OFFSET MT_NextSection(size_t size);
+
+  /*
+  Return a pointer to a section of size bytes starting at the 
+  first offset multiple of MT_MAPPED_ALIGN after map_pos, advance map_pos.
+  The pointer is inside the mapping, if the file is mapped; otherwise
+  the section is read into a newly allocated array, and its bytes are
+  swapped if needed. Return NULL on failure.
+  */
+  void * MT_MapSection(FILE * fd, size_t size);
+
+  /*
+  Write a section of size bytes from array p, preceded by the zero bytes
+  needed to start at a file offset multiple of MT_MAPPED_ALIGN.
+  Return the offset where the section starts.
+  */
+  long MT_WriteSection(FILE * fd, void * p, size_t size);
+
+/* ------------------------------------------------------------------------ */
+/*                            Compressed encoding                           */
+/* ------------------------------------------------------------------------ */
+
+  public:
+
+  /*
+  Set the number of bits used for the coordinates of the vertices when 
+  writing in the compressed encoding: 16 or 24 bits (lossy: coordinates
+  are quantized within the bounding box), or 0 (lossless, default).
+  Return 1 on success, 0 if bits is not valid.
+  When an object is read in the compressed encoding, its quantization 
+  becomes the one of the file.
+  */
+  int MT_SetQuantization(int bits);
+  inline int MT_TheQuantization(void)  {  return (q_bits);  }
+
+  /*
+  Decode block b, filling the records of the array it refers to. 
+  Return 1 on success, 0 if the block is not valid.
+  Used by the jobs decoding the blocks in parallel.
+  */
+  virtual int MT_DecodeBlock(MT_Block * b);
+
+  protected:
+
+  /*
+  Maximum size of num records of section s once encoded.
+  */
+  virtual size_t MT_BlockBound(int s, MT_INDEX num);
+
+  /*
+  Encode records first..first+num-1 of section s into buf, and return
+  the size of the encoded records.
+  */
+  virtual size_t MT_EncodeBlock(int s, MT_INDEX first, MT_INDEX num,
+                                unsigned char * buf);
+
+  /*
+  Read records 1..num of section s, stored as blocks of 
+  MT_COMPRESS_BLOCK records, and decode the blocks in parallel 
+  (see mt_thrd.h). Return 1 on success, 0 on failure.
+  */
+  int MT_ReadBlocks(FILE * fd, int s, MT_INDEX num);
+
+  /*
+  Write records 1..num of section s as blocks of MT_COMPRESS_BLOCK
+  records, each preceded by its size.
+  */
+  void MT_WriteBlocks(FILE * fd, int s, MT_INDEX num);
+
 /* ------------------------------------------------------------------------ */
 /*                          READ / WRITE  PRIMITIVES                        */
 /* ------------------------------------------------------------------------ */
@@ -325,7 +543,11 @@ class MT_TileSetClass : public virtual MT_PersistentClass
 
   /*
   Functions redefined from superclass MT_PersistentClass.
+  All encodings have a specific layout.
+  In the mapped encoding, MT_ReadBody maps the file and points
+  the vertex and tile arrays inside the mapping.
   */
+  int MT_HasBodyLayout(int file_encoding);
   int MT_ReadClassAndParams(FILE * fd);
   int MT_ReadObjParams(FILE * fd);
   int MT_ReadBody(FILE * fd, int file_encoding);
@@ -338,10 +560,27 @@ class MT_TileSetClass : public virtual MT_PersistentClass
 
   /*
   Functions redefined from superclass MT_PersistentClass.
+  In the mapped encoding, the body consists of three sections: 
+  the bounding box (F_min followed by F_max), array all_coord and array 
+  all_vert, both including position 0.
+  In the compressed encoding, the body consists of the quantization
+  bits, the bounding box, and the blocks of vertices and of tiles.
+  The footer contains the class and its parameters, the object 
+  parameters and the encoding (as in the header), then the bounding box, 
+  the numbers of tiles at minimum and maximum resolution, and the offsets 
+  of the sections of the body (see MT_COORD_SECTION and following).
+  Inside a block of vertices, each coordinate is coded as the difference
+  from the same coordinate of the previous vertex: between the quantized
+  values, or between the bit patterns (exclusive or) if not quantized.
+  Inside a block of tiles, the first vertex of each tile is coded as the 
+  difference from the first vertex of the previous tile, the others as 
+  the difference from the previous vertex of the same tile (tiles of 
+  the same arc of an MT are consecutive, and share most vertices).
   */
   void MT_WriteClassAndParams(FILE * fd);
   void MT_WriteObjParams(FILE * fd);
   void MT_WriteBody(FILE * fd, int file_encoding);
+  void MT_WriteFooter(FILE * fd, int file_encoding, long start);
            
 };
 
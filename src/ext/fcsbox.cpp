@@ -148,6 +148,23 @@ void BoxClass :: TheBox (float *x1, float *y1, float *z1,
    (*x2) = maxF[0]; (*y2) = maxF[1]; (*z2) = maxF[2];
 }
    
+/* ------------------------------------------------------------------------ */
+/*                       Relation with another box                          */
+/* ------------------------------------------------------------------------ */
+
+int BoxClass :: BoxRelation (float * min_coord, float * max_coord, float e)
+{
+   int i;
+   int inside = 1;
+   for (i=0; i<BoxDim(); i++)
+   {  if ( (max_coord[i] < minF[i]-e) || (min_coord[i] > maxF[i]+e) )
+         return MT_BOX_OUT;
+      if ( (min_coord[i] < minF[i]) || (max_coord[i] > maxF[i]) )
+         inside = 0;
+   }
+   return ( inside ? MT_BOX_IN : MT_BOX_CROSS );
+}
+
 /* ------------------------------------------------------------------------ */
 /*                          Creation of the box                             */
 /* ------------------------------------------------------------------------ */
@@ -198,6 +215,13 @@ int Box2FocusOnTrianglesClass ::
   return 0;
 }
 
+int Box2FocusOnTrianglesClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  return ( BoxRelation(min_coord, max_coord) );
+}
+
 int Box2FocusOnTrianglesClass :: MT_IsGood(MT_MultiTesselation m)
 {
   if (m->MT_TileDim() != 2)
@@ -229,15 +253,17 @@ Box3FocusOnTrianglesClass(WithTileError m,
    my_mt = m;
 }
 
-int Box3FocusOnTrianglesClass :: 
-    MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
-{ 
+/*
+Return 1 if triangle t intersects the box with corners minF and maxF,
+expanded of an amount equal to e.
+*/
+static int ClipTile3D(MT_MultiTesselation m, MT_INDEX t, 
+                      float * minF, float * maxF, float e)
+{
   MT_INDEX * v;   /* triangle vertices */
   float x[3], y[3], z[3];
   int i;
-  float minXX = minF[0], minYY = minF[1], minZZ = minF[2];
-  float maxXX = maxF[0], maxYY = maxF[1], maxZZ = maxF[2];
-  
+
   m->MT_TileVertices(t, &v);
   /* we assume that the tile is a triangle, thus three vertices. */
   for (i=0;i<3;i++)
@@ -246,17 +272,58 @@ int Box3FocusOnTrianglesClass ::
     y[i] = m->MT_VertexY(v[i]);
     z[i] = m->MT_VertexZ(v[i]);
   }  
-  /* if flag is MT_LOOSE, expand the tile of an amount equal to its
-     approximation error. */
+  return ( ClipTriangle3D(minF[0]-e,minF[1]-e,minF[2]-e,
+                          maxF[0]+e,maxF[1]+e,maxF[2]+e, x,y,z) );
+}
+
+int Box3FocusOnTrianglesClass :: 
+    MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+{ 
+  /* if flag is MT_LOOSE, expand the box of an amount equal to the
+     approximation error of the tile. */
   if (flag==MT_LOOSE) 
-  {  
-    minXX -= my_mt->TileError(t); maxXX += my_mt->TileError(t);
-    minYY -= my_mt->TileError(t); maxYY += my_mt->TileError(t);
-    minZZ -= my_mt->TileError(t); maxZZ += my_mt->TileError(t);
+     return ( ClipTile3D(m,t, minF,maxF, my_mt->TileError(t)) );
+  return ( ClipTile3D(m,t, minF,maxF, 0.0) );
+}
+
+int Box3FocusOnTrianglesClass :: 
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                     int flag, unsigned char * res)
+{ 
+  float err[MT_TILE_BATCH];     /* tile errors */
+  MT_INDEX t, n;                /* range of tiles */
+  int i, cnt = 0;
+
+  if (flag!=MT_LOOSE)
+  {
+    for (t=t1; t<=t2; t++)
+       cnt += ( res[t-t1] = ClipTile3D(m,t, minF,maxF, 0.0) );
+    return cnt;
   }
-  if ( ClipTriangle3D(minXX,minYY,minZZ, maxXX,maxYY,maxZZ, x,y,z) )
-  {  return 1;  }
-  return 0;
+  for (t=t1; t<=t2; t+=n)
+  {
+    n = t2-t+1;
+    if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+    my_mt->TileErrors(t,t+n-1,err);
+    for (i=0;i<(int)n;i++)
+       cnt += ( res[t-t1+i] = ClipTile3D(m,t+i, minF,maxF, err[i]) );
+  }
+  return cnt;
+}
+
+int Box3FocusOnTrianglesClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  if (flag!=MT_LOOSE)  return ( BoxRelation(min_coord, max_coord) );
+  /* no tile intersects the box expanded of the maximum error, or
+     all tiles are inside the box (thus inside it when expanded) */
+  if (max_err<0.0)  max_err = my_mt->MaxError();
+  if (BoxRelation(min_coord, max_coord, max_err) == MT_BOX_OUT)
+     return MT_BOX_OUT;
+  if (BoxRelation(min_coord, max_coord) == MT_BOX_IN)
+     return MT_BOX_IN;
+  return MT_BOX_CROSS;
 }
 
 int Box3FocusOnTrianglesClass :: MT_IsGood(MT_MultiTesselation m)
@@ -340,6 +407,13 @@ int Box3FocusOnTetrahedraClass ::
   return 0;
 }
 
+int Box3FocusOnTetrahedraClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  return ( BoxRelation(min_coord, max_coord) );
+}
+
 int Box3FocusOnTetrahedraClass :: MT_IsGood(MT_MultiTesselation m)
 {
   if (m->MT_TileDim() != 3)
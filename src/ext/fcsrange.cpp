@@ -94,7 +94,7 @@ float PointDistClass ::
   if ( PointInTetra(p_coord[0],p_coord[1],p_coord[2], 
                     p[0],p[1],p[2],p[3]) )
       return 0.0;
-  TetraCenter(p[0],p[1],p[2],p[3], &c[0], &c[1], &c[3]);    
+  TetraCenter(p[0],p[1],p[2],p[3], &c[0], &c[1], &c[2]);    
   d = SquaredPointDist(c[0],c[1],c[2], p_coord[0],p_coord[1],p_coord[2]);
   for (i=0; i<4; i++)
   {
@@ -112,6 +112,28 @@ float PointDistClass ::
 RangeClass :: RangeClass(int d, float r) : PointDistClass(d)
 {  SetRadius(r);  }
 
+int RangeClass :: BoxRelation(float * min_coord, float * max_coord, float e)
+{
+  float d1, d2;           /* distances along one axis */
+  float near2 = 0.0;      /* squared distance of the nearest box point */
+  float far2 = 0.0;       /* squared distance of the farthest box point */
+  float r = radius + e;
+  int i;
+  for (i=0; i<PointDim(); i++)
+  {
+    d1 = p_coord[i] - min_coord[i];
+    d2 = max_coord[i] - p_coord[i];
+    if (d1<0.0) near2 += d1*d1;
+    else if (d2<0.0) near2 += d2*d2;
+    /* at most one of d1, d2 is negative, the farthest is the largest */
+    d1 = ( (d1>d2) ? d1 : d2 );
+    far2 += d1*d1;
+  }
+  if (near2 >= r*r) return MT_BOX_OUT;
+  if (far2 < radius*radius) return MT_BOX_IN;
+  return MT_BOX_CROSS;
+}
+
 /* ------------------------------------------------------------------------ */
 /*                2D RANGE FOCUS ON MTs WITH TRIANGULAR TILES               */
 /* ------------------------------------------------------------------------ */
@@ -126,6 +148,26 @@ int Range2FocusOnTrianglesClass ::
   return ( SquaredDistanceTriangle2(m,t) < (radius*radius) );
 }
 
+int Range2FocusOnTrianglesClass ::
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                     int flag, unsigned char * res)
+{
+  float r2 = radius*radius;
+  MT_INDEX t;
+  int cnt = 0;
+
+  for (t=t1; t<=t2; t++)
+     cnt += ( res[t-t1] = ( SquaredDistanceTriangle2(m,t) < r2 ) );
+  return cnt;
+}
+
+int Range2FocusOnTrianglesClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  return ( BoxRelation(min_coord, max_coord) );
+}
+
 int Range2FocusOnTrianglesClass :: MT_IsGood(MT_MultiTesselation m)
 {
   if (m->MT_TileDim() != 2)
@@ -155,6 +197,51 @@ int Range3FocusOnTrianglesClass ::
    return ( ApproxSquaredDistanceTriangle3(m,t) < (r*r) );
 }
 
+int Range3FocusOnTrianglesClass :: 
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                     int flag, unsigned char * res)
+{  
+   float r[MT_TILE_BATCH];   /* radius for each tile */
+   float r2 = radius*radius;
+   MT_INDEX t, n;            /* range of tiles */
+   int i, cnt = 0;
+
+   if (flag!=MT_LOOSE)
+   {
+     for (t=t1; t<=t2; t++)
+        cnt += ( res[t-t1] = ( ApproxSquaredDistanceTriangle3(m,t) < r2 ) );
+     return cnt;
+   }
+   for (t=t1; t<=t2; t+=n)
+   {
+     n = t2-t+1;
+     if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+     my_mt->TileErrors(t,t+n-1,r);
+     for (i=0;i<(int)n;i++)
+     {
+       r[i] += radius;
+       cnt += ( res[t-t1+i] = 
+                ( ApproxSquaredDistanceTriangle3(m,t+i) < (r[i]*r[i]) ) );
+     }
+   }
+   return cnt;
+}
+
+int Range3FocusOnTrianglesClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  if (flag!=MT_LOOSE)  return ( BoxRelation(min_coord, max_coord) );
+  /* no tile is within the radius increased of the maximum error, or
+     all tiles are within the radius (thus within it when increased) */
+  if (max_err<0.0)  max_err = my_mt->MaxError();
+  if (BoxRelation(min_coord, max_coord, max_err) == MT_BOX_OUT)
+     return MT_BOX_OUT;
+  if (BoxRelation(min_coord, max_coord) == MT_BOX_IN)
+     return MT_BOX_IN;
+  return MT_BOX_CROSS;
+}
+
 int Range3FocusOnTrianglesClass :: MT_IsGood(MT_MultiTesselation m)
 {
   if ( (m->MT_TileDim() != 2) || (m->MT_VertexDim() < 3) )
@@ -181,6 +268,26 @@ int Range3FocusOnTetrahedraClass ::
    return ( ApproxSquaredDistanceTetra3(m,t) < (radius*radius) );
 }
 
+int Range3FocusOnTetrahedraClass ::
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                     int flag, unsigned char * res)
+{
+   float r2 = radius*radius;
+   MT_INDEX t;
+   int cnt = 0;
+
+   for (t=t1; t<=t2; t++)
+      cnt += ( res[t-t1] = ( ApproxSquaredDistanceTetra3(m,t) < r2 ) );
+   return cnt;
+}
+
+int Range3FocusOnTetrahedraClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  return ( BoxRelation(min_coord, max_coord) );
+}
+
 int Range3FocusOnTetrahedraClass :: MT_IsGood(MT_MultiTesselation m)
 {
   if (m->MT_TileDim() != 3)
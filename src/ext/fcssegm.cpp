@@ -71,6 +71,32 @@ void SegmentClass :: TheSegment(float * x1, float * y1, float * z1,
    (*x2) = endp2[0]; (*y2) = endp2[1]; (*z2) = endp2[2];  
 }
       
+int SegmentClass :: BoxRelation(float * min_coord, float * max_coord)
+{
+  float x, y;          /* box corner */
+  int left = 0, right = 0; /* corners on each side of the segment */
+  int i;
+
+  for (i=0;i<2;i++)
+  {
+    if ( ( (endp1[i] < min_coord[i]) && (endp2[i] < min_coord[i]) ) ||
+         ( (endp1[i] > max_coord[i]) && (endp2[i] > max_coord[i]) ) )
+       return MT_BOX_OUT;
+  }
+  for (i=0;i<4;i++)
+  {
+    x = ( (i&1) ? max_coord[0] : min_coord[0] );
+    y = ( (i&2) ? max_coord[1] : min_coord[1] );
+    switch ( PointTurn2D(x, y, endp1[0], endp1[1], endp2[0], endp2[1]) )
+    {
+       case LEFT_TURN:  left++;  break;
+       case RIGHT_TURN: right++;  break;
+    }
+  }
+  if ( (left==4) || (right==4) ) return MT_BOX_OUT;
+  return MT_BOX_CROSS;
+}
+
 SegmentClass :: SegmentClass(int d)
 {
    int i;
@@ -132,6 +158,13 @@ int Segment2FocusOnTrianglesClass  ::
   return 0;  
 }
 
+int Segment2FocusOnTrianglesClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  return ( BoxRelation(min_coord, max_coord) );
+}
+
 int Segment2FocusOnTrianglesClass  :: MT_IsGood(MT_MultiTesselation m)
 {
   if (m->MT_TileDim() != 2)
@@ -477,6 +510,13 @@ int Segment3FocusOnTriFieldClass ::
   return 0;  
 }
 
+int Segment3FocusOnTriFieldClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  return ( BoxRelation(min_coord, max_coord) );
+}
+
 int Segment3FocusOnTriFieldClass :: MT_IsGood(MT_MultiTesselation m)
 {
   if ( (m->MT_TileDim() != 2) || (m->MT_VertexDim() < 3) )
@@ -144,6 +144,32 @@ void WedgeClass ::  TheRightPoint(float * x, float * y, float dist)
                        w_axis[1] * cos(-open_angle[0]) );
 }
 
+int WedgeClass :: BoxRelation(float * min_coord, float * max_coord)
+{
+  float p_left[2];    /* a point lying on the left side of the wedge */
+  float p_right[2];   /* a point lying on the right side of the wedge */
+  float x, y;         /* box corner */
+  int in1 = 0, in2 = 0; /* corners inside each half-plane */
+  int i;
+
+  TheLeftPoint(&p_left[0],&p_left[1]);
+  TheRightPoint(&p_right[0],&p_right[1]);
+  for (i=0;i<4;i++)
+  {
+    x = ( (i&1) ? max_coord[0] : min_coord[0] );
+    y = ( (i&2) ? max_coord[1] : min_coord[1] );
+    if (PointTurn2D(v_coord[0], v_coord[1], p_right[0], p_right[1],
+                    x, y) == LEFT_TURN)  in1++;
+    if (PointTurn2D(p_left[0], p_left[1], v_coord[0], v_coord[1],
+                    x, y) == LEFT_TURN)  in2++;
+  }
+  /* the turns are linear in the corner, thus a point of the box turns
+     left only if some corner does */
+  if ( (!in1) || (!in2) ) return MT_BOX_OUT;
+  if ( (in1==4) && (in2==4) ) return MT_BOX_IN;
+  return MT_BOX_CROSS;
+}
+
 WedgeClass :: WedgeClass(int d)
 {
   int i, j;
@@ -219,6 +245,13 @@ int Wedge2FocusOnTrianglesClass ::
   return 0;
 }
 
+int Wedge2FocusOnTrianglesClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+  return ( BoxRelation(min_coord, max_coord) );
+}
+
 int Wedge2FocusOnTrianglesClass :: MT_IsGood(MT_MultiTesselation m)
 {
   if (m->MT_TileDim() != 2)
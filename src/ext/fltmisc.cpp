@@ -33,9 +33,24 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 /* ------------------------------------------------------------------------ */
 
 int TileErrFilterClass ::
-    MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                     int flag, unsigned char * res)
 {
-  return ( my_mt->TileError(t) < my_thr->ThresholdValue(m,t) );
+  float err[MT_TILE_BATCH];  /* tile errors */
+  float thr[MT_TILE_BATCH];  /* threshold values */
+  MT_INDEX t, n;             /* range of tiles */
+  int i, cnt = 0;
+
+  for (t=t1; t<=t2; t+=n)
+  {
+    n = t2-t+1;
+    if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+    my_mt->TileErrors(t,t+n-1,err);
+    my_thr->ThresholdValues(m,t,t+n-1,thr);
+    for (i=0;i<(int)n;i++)
+       cnt += ( res[t-t1+i] = ( err[i] < thr[i] ) );
+  }
+  return cnt;
 }
 
 TileErrFilterClass ::
@@ -43,22 +58,96 @@ TileErrFilterClass(WithTileErrorClass * m, Threshold tr)
 {
   my_mt = m;  my_thr = tr;
 }
+
+/* ------------------------------------------------------------------------ */
+/*                      PRIORITY GIVEN BY TILE ERRORS                       */
+/* ------------------------------------------------------------------------ */
+
+/*
+Ratio between an error and a threshold value. A null threshold gives
+the highest priority to any positive error.
+*/
+static float ErrRatio(float err, float thr)
+{
+  if (thr > 0.0) return ( err / thr );
+  return ( (err > 0.0) ? FLT_MAX : 0.0 );
+}
+
+float TileErrPriorityClass ::
+      MT_EvalPriority(MT_MultiTesselation m, MT_INDEX t)
+{
+  if (!my_thr)  return ( my_mt->TileError(t) );
+  return ( ErrRatio(my_mt->TileError(t), my_thr->ThresholdValue(m,t)) );
+}
+
+void TileErrPriorityClass ::
+     MT_EvalPriorityRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                          float * res)
+{
+  float thr[MT_TILE_BATCH];  /* threshold values */
+  MT_INDEX t, n;             /* range of tiles */
+  int i;
+
+  for (t=t1; t<=t2; t+=n)
+  {
+    n = t2-t+1;
+    if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+    my_mt->TileErrors(t,t+n-1,&res[t-t1]);
+    if (my_thr)
+    {
+      my_thr->ThresholdValues(m,t,t+n-1,thr);
+      for (i=0;i<(int)n;i++)
+         res[t-t1+i] = ErrRatio(res[t-t1+i], thr[i]);
+    }
+  }
+}
+
+TileErrPriorityClass ::
+TileErrPriorityClass(WithTileErrorClass * m, Threshold tr)   
+{
+  my_mt = m;  my_thr = tr;
+}
    
 /* ------------------------------------------------------------------------ */
 /*                   TESTING THE THRESHOLD ON TILE AREAS                    */
 /* ------------------------------------------------------------------------ */
 
-int TriangleArea2FilterClass ::
-    MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+/*
+Area of tile t in the x-y plane.
+*/
+static float TileArea2(MT_MultiTesselation m, MT_INDEX t)
 {
-  float area;         /* tile area */
   MT_INDEX * v;       /* tile vertices */
 
   m->MT_TileVertices(t,&v);
-  area = TriangleArea2D(m->MT_VertexX(v[0]), m->MT_VertexY(v[0]),
-                        m->MT_VertexX(v[1]), m->MT_VertexY(v[1]),
-                        m->MT_VertexX(v[2]), m->MT_VertexY(v[2]));
-  return ( area < my_thr->ThresholdValue(m,t) );
+  return ( TriangleArea2D(m->MT_VertexX(v[0]), m->MT_VertexY(v[0]),
+                          m->MT_VertexX(v[1]), m->MT_VertexY(v[1]),
+                          m->MT_VertexX(v[2]), m->MT_VertexY(v[2])) );
+}
+
+int TriangleArea2FilterClass ::
+    MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+{
+  return ( TileArea2(m,t) < my_thr->ThresholdValue(m,t) );
+}
+
+int TriangleArea2FilterClass ::
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                     int flag, unsigned char * res)
+{
+  float thr[MT_TILE_BATCH];    /* threshold values */
+  MT_INDEX t, n;               /* range of tiles */
+  int i, cnt = 0;
+
+  for (t=t1; t<=t2; t+=n)
+  {
+    n = t2-t+1;
+    if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+    my_thr->ThresholdValues(m,t,t+n-1,thr);
+    for (i=0;i<(int)n;i++)
+       cnt += ( res[t-t1+i] = ( TileArea2(m,t+i) < thr[i] ) );
+  }
+  return cnt;
 }
 
 int TriangleArea2FilterClass :: MT_IsGood(MT_MultiTesselation m)
@@ -83,23 +172,48 @@ TriangleArea2FilterClass :: TriangleArea2FilterClass(Threshold tr)
 
 /* ------------------------------------------------------------------------ */
 
-int TriangleArea3FilterClass ::
-    MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+/*
+Area of tile t in 3D.
+*/
+static float TileArea3(MT_MultiTesselation m, MT_INDEX t)
 {
-  float area;         /* tile area */
   MT_INDEX * v;       /* tile vertices */
      
   m->MT_TileVertices(t,&v);
-  area = TriangleArea(m->MT_VertexX(v[0]),
-                      m->MT_VertexY(v[0]),
-                      m->MT_VertexZ(v[0]),
-                      m->MT_VertexX(v[1]),
-                      m->MT_VertexY(v[1]),
-                      m->MT_VertexZ(v[1]),
-                      m->MT_VertexX(v[2]),
-                      m->MT_VertexY(v[2]),
-                      m->MT_VertexZ(v[2]));
-  return ( area < my_thr->ThresholdValue(m,t) );
+  return ( TriangleArea(m->MT_VertexX(v[0]),
+                        m->MT_VertexY(v[0]),
+                        m->MT_VertexZ(v[0]),
+                        m->MT_VertexX(v[1]),
+                        m->MT_VertexY(v[1]),
+                        m->MT_VertexZ(v[1]),
+                        m->MT_VertexX(v[2]),
+                        m->MT_VertexY(v[2]),
+                        m->MT_VertexZ(v[2])) );
+}
+
+int TriangleArea3FilterClass ::
+    MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+{
+  return ( TileArea3(m,t) < my_thr->ThresholdValue(m,t) );
+}
+
+int TriangleArea3FilterClass ::
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2,
+                     int flag, unsigned char * res)
+{
+  float thr[MT_TILE_BATCH];    /* threshold values */
+  MT_INDEX t, n;               /* range of tiles */
+  int i, cnt = 0;
+
+  for (t=t1; t<=t2; t+=n)
+  {
+    n = t2-t+1;
+    if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+    my_thr->ThresholdValues(m,t,t+n-1,thr);
+    for (i=0;i<(int)n;i++)
+       cnt += ( res[t-t1+i] = ( TileArea3(m,t+i) < thr[i] ) );
+  }
+  return cnt;
 }
 
 void TriangleArea3FilterClass ::
@@ -453,8 +453,9 @@ the coordinates of its four vertices
 int PointInTetra (float xp, float yp, float zp,
                   float * v1, float * v2, float * v3, float * v4)
 {
-  static float * v[4] = {v1, v2, v3, v4};
+  float * v[4];
   int i, turn;
+  v[0] = v1; v[1] = v2; v[2] = v3; v[3] = v4;
   for (i=0;i<4;i++)
   {
     turn = FourPointTurn(xp, yp, zp,
@@ -474,8 +475,9 @@ int PointInTetra (float xp, float yp, float zp,
 int PointOutTetra (float xp, float yp, float zp,
                    float * v1, float * v2, float * v3, float * v4)
 {
-  static float * v[4] = {v1, v2, v3, v4};
+  float * v[4];
   int i, turn;
+  v[0] = v1; v[1] = v2; v[2] = v3; v[3] = v4;
   for (i=0;i<4;i++)
   {
     turn = FourPointTurn(xp, yp, zp,
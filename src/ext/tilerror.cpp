@@ -40,14 +40,8 @@ WithTileErrorTableClass :: ~WithTileErrorTableClass(void)
 int WithTileErrorTableClass :: ReadTileErrors(FILE * fd)
 {  return ( my_error->MT_Read(fd) );  }
 
-int WithTileErrorTableClass :: ReadTileErrors(char * fname)
-{
-  FILE * fd = fopen(fname,"r");
-  int ok = 0;
-  if (fd) ok = ReadTileErrors(fd);
-  fclose(fd);
-  return ok;
-}
+int WithTileErrorTableClass :: ReadTileErrors(char * fname)
+{  return ( my_error->MT_Read(fname) );  }
 
 void WithTileErrorTableClass :: WriteTileErrors(FILE * fd, int file_encoding)
 {  my_error->MT_Write(fd, file_encoding);  }
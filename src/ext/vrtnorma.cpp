@@ -49,13 +49,7 @@ int WithVertexNormalTableClass :: ReadVertexNormals(FILE * fd)
 {  return ( my_norm->MT_Read(fd) );  }
 
 int WithVertexNormalTableClass :: ReadVertexNormals(char * fname)
-{  
-  FILE * fd = fopen(fname,"r");
-  int ok = 0;
-  if (fd) ok = ReadVertexNormals(fd);
-  fclose(fd);
-  return ok;
-}
+{  return ( my_norm->MT_Read(fname) );  }
 
 void WithVertexNormalTableClass :: 
      WriteVertexNormals(FILE * fd, int file_encoding)
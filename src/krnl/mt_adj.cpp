@@ -0,0 +1,348 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_adj.c ------------------------------- */
+
+#include "mt_adj.h"
+
+/* ------------------------------------------------------------------------ */
+/*                          Access primitives                               */
+/* ------------------------------------------------------------------------ */
+
+int MT_AdjTableClass :: MT_IsGood(MT_MultiTesselation m)
+{
+  return ( (first_Arr!=NULL) && (m->MT_NumTileVertices()==fac_num) &&
+           (m->MT_TileNum()==my_num) );
+}
+
+/* ------------------------------------------------------------------------ */
+/*                        Computing the candidates                          */
+/* ------------------------------------------------------------------------ */
+
+/*
+A facet of a tile, with the same hints used by the hash table of
+extractors (see mt_hash.h), and the coded tile and facet index.
+*/
+typedef struct MT_FacetRecStruct
+{
+  MT_INDEX my_sum;  /* sum of the vertices of the facet */
+  MT_INDEX my_min;  /* minimum vertex of the facet */
+  MT_INDEX my_max;  /* maximum vertex of the facet */
+  MT_INDEX my_code; /* tile*k+i, where i is the opposite vertex */
+} MT_FacetRec;
+
+/*
+Order facets by hints, so that equal facets are consecutive.
+*/
+static int MT_CompareFacets(const void * p1, const void * p2)
+{
+  const MT_FacetRec * f1 = (const MT_FacetRec *) p1;
+  const MT_FacetRec * f2 = (const MT_FacetRec *) p2;
+  if (f1->my_min != f2->my_min) return ( (f1->my_min < f2->my_min) ? -1 : 1 );
+  if (f1->my_max != f2->my_max) return ( (f1->my_max < f2->my_max) ? -1 : 1 );
+  if (f1->my_sum != f2->my_sum) return ( (f1->my_sum < f2->my_sum) ? -1 : 1 );
+  if (f1->my_code != f2->my_code) return ( (f1->my_code < f2->my_code) ? -1 : 1 );
+  return 0;
+}
+
+/*
+Return 1 if the facets of two records with the same hints are the 
+same. Hints are enough for facets with at most three vertices.
+*/
+static int MT_SameFacetRec(MT_MultiTesselation m, int k, 
+                           MT_FacetRec * f1, MT_FacetRec * f2)
+{
+  MT_INDEX t1 = f1->my_code / k, t2 = f2->my_code / k;
+  int i1 = f1->my_code % k, i2 = f2->my_code % k;
+  int i, j, found;
+
+  if (k<=4) return 1;
+  for (i=0; i<k; i++)
+  {
+    if (i==i1) continue;
+    found = 0;
+    for (j=0; (!found) && (j<k); j++)
+    {  if ( (j!=i2) && 
+            (m->MT_TileVertex(t2,j)==m->MT_TileVertex(t1,i)) ) found = 1;
+    }
+    if (!found) return 0;
+  }
+  return 1;
+}
+
+int MT_AdjTableClass :: MT_BuildAdjTable(MT_MultiTesselation m)
+{
+  MT_FacetRec * rec;
+  MT_INDEX t, n, g1, g2, p, q, j;
+  MT_INDEX v;
+  int i, h;
+
+  if (m->MT_NumTileVertices()!=fac_num)
+  {  MT_Error((char *)"Wrong number of tile vertices",
+              (char *)"MT_AdjTableClass::MT_BuildAdjTable");
+     return 0;
+  }
+  if (m->MT_LoadedNodeNum()<m->MT_NodeNum())
+  {  MT_Error((char *)"MT not completely loaded",
+              (char *)"MT_AdjTableClass::MT_BuildAdjTable");
+     return 0;
+  }
+  n = m->MT_TileNum()*fac_num;
+  rec = (MT_FacetRec *) malloc ( (n+1)*sizeof(MT_FacetRec) );
+  if ( (!rec) || (!MT_SetAttrNum(m->MT_TileNum())) )
+  {  MT_Error((char *)"Allocation failed",
+              (char *)"MT_AdjTableClass::MT_BuildAdjTable");
+     if (rec) free(rec);
+     return 0;
+  }
+
+  /* one record for each facet of each tile */
+  p = 0;
+  for (t=1; t<=my_num; t++)
+  {
+    for (i=0; i<fac_num; i++)
+    {
+      rec[p].my_code = t*fac_num+i;
+      rec[p].my_sum = 0;
+      rec[p].my_min = rec[p].my_max = m->MT_TileVertex(t,(i+1)%fac_num);
+      for (h=0; h<fac_num; h++)
+      {  if (h==i) continue;
+         v = m->MT_TileVertex(t,h);
+         rec[p].my_sum += v;
+         if (v<rec[p].my_min) rec[p].my_min = v;
+         if (v>rec[p].my_max) rec[p].my_max = v;
+      }
+      p++;
+    }
+  }
+  qsort(rec, n, sizeof(MT_FacetRec), MT_CompareFacets);
+
+  /* count the candidates of each facet in first_Arr[code+1], 
+     scanning the groups of facets with the same hints */
+  for (g1=0; g1<n; g1=g2)
+  {
+    for (g2=g1+1; (g2<n) && 
+                  (rec[g2].my_min==rec[g1].my_min) && 
+                  (rec[g2].my_max==rec[g1].my_max) &&
+                  (rec[g2].my_sum==rec[g1].my_sum); g2++);
+    for (p=g1; p<g2; p++)
+    for (q=g1; q<g2; q++)
+    {  if ( (p!=q) && MT_SameFacetRec(m, fac_num, &rec[p], &rec[q]) )
+          first_Arr[rec[p].my_code+1]++;
+    }
+  }
+  for (j=1; j<=(my_num+1)*fac_num; j++)  first_Arr[j] += first_Arr[j-1];
+  if (!MT_SetCandNum(first_Arr[(my_num+1)*fac_num]))
+  {  free(rec);
+     return 0;
+  }
+
+  /* fill the candidates */
+  for (g1=0; g1<n; g1=g2)
+  {
+    for (g2=g1+1; (g2<n) && 
+                  (rec[g2].my_min==rec[g1].my_min) && 
+                  (rec[g2].my_max==rec[g1].my_max) &&
+                  (rec[g2].my_sum==rec[g1].my_sum); g2++);
+    for (p=g1; p<g2; p++)
+    {  j = first_Arr[rec[p].my_code];
+       for (q=g1; q<g2; q++)
+       {  if ( (p!=q) && MT_SameFacetRec(m, fac_num, &rec[p], &rec[q]) )
+             cand_Arr[j++] = rec[q].my_code;
+       }
+    }
+  }
+  free(rec);
+  return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+/*                            Reading and writing                           */
+/* ------------------------------------------------------------------------ */
+
+int MT_AdjTableClass :: MT_SetAttrNum(MT_INDEX n)
+{
+  if (first_Arr) free(first_Arr);
+  /* calloc is used to leave all facets without candidates */
+  first_Arr = (MT_INDEX *) calloc ( (n+1)*fac_num+1, sizeof(MT_INDEX) );
+  if (!first_Arr)
+  {  MT_ErrorC((char *)"Failed allocation",
+               (char *)"MT_AdjTableClass", (char *)"MT_SetAttrNum");
+     my_num = 0;
+     return 0;
+  }
+  my_num = n;
+  return 1;
+}  
+
+int MT_AdjTableClass :: MT_SetCandNum(MT_INDEX n)
+{
+  if (cand_Arr) free(cand_Arr);
+  cand_Arr = (MT_INDEX *) malloc ( (n+1)*sizeof(MT_INDEX) );
+  if (!cand_Arr)
+  {  MT_ErrorC((char *)"Failed allocation",
+               (char *)"MT_AdjTableClass", (char *)"MT_SetCandNum");
+     cand_num = 0;
+     return 0;
+  }
+  cand_num = n;
+  return 1;
+}  
+
+int MT_AdjTableClass :: 
+    MT_ReadAttr(FILE * fd, MT_INDEX i, int file_encoding)
+{
+  MT_INDEX n, j, t;
+  int f, h;
+
+  for (f=0; f<fac_num; f++)
+  {
+    if (!MT_ReadIndex(fd, &n, file_encoding)) return 0;
+    j = first_Arr[i*fac_num+f];
+    if (j+n>cand_num)
+    {  MT_Error((char *)"Too many candidates",
+                (char *)"MT_AdjTableClass::MT_ReadAttr");
+       return 0;
+    }
+    first_Arr[i*fac_num+f+1] = j+n;
+    for ( ; n>0; n--)
+    {  if ( (!MT_ReadIndex(fd, &t, file_encoding)) || 
+            (!MT_ReadCount(fd, &h, file_encoding)) ) return 0;
+       cand_Arr[j++] = t*fac_num+h;
+    }
+  }
+  return 1;
+}
+
+void MT_AdjTableClass :: 
+     MT_WriteAttr(FILE * fd, MT_INDEX i, int file_encoding)
+{
+  MT_INDEX j;
+  int f;
+
+  for (f=0; f<fac_num; f++)
+  {
+    MT_WriteIndex(fd, MT_FacetCandNum(i,f), file_encoding);
+    for (j=first_Arr[i*fac_num+f]; j<first_Arr[i*fac_num+f+1]; j++)
+    {  MT_WriteIndex(fd, MT_CandTile(cand_Arr[j]), file_encoding);
+       MT_WriteCount(fd, MT_CandFacet(cand_Arr[j]), file_encoding);
+    }
+  }
+  if (file_encoding==MT_ASCII_ENCODING) fprintf(fd, "\n");
+}
+
+int MT_AdjTableClass :: MT_ReadClassAndParams(FILE * fd)
+{
+  int k;
+  if (!MT_SearchKeyword(fd, MT_ClassKeyword())) return 0;
+  if (fscanf(fd, "%d", &k)==1)
+  {  if (k == fac_num) return 1;  }
+  /* else */
+  MT_Error((char *)"Class parameters do not match with this object",
+           (char *)"MT_AdjTableClass::MT_ReadClassAndParams");
+  return 0;
+}
+
+int MT_AdjTableClass :: MT_ReadObjParams(FILE * fd)
+{
+  int tn, cn;
+  if (!MT_SearchKeyword(fd, (char *)MT_OBJECT_KW)) return 0;
+  if (fscanf(fd, "%d %d", &tn, &cn)==2)
+  {  if ( (tn>=0) && (cn>=0) )
+     {  my_num = tn;
+        cand_num = cn;
+        return 1;
+     }
+  }
+  /* else */
+  MT_Error((char *)"Invalid object parameters",
+           (char *)"MT_AdjTableClass::MT_ReadObjParams");
+  return 0;
+}
+
+int MT_AdjTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
+{  
+  MT_INDEX i, n = my_num;
+  if ( (!MT_SetAttrNum(n)) || (!MT_SetCandNum(cand_num)) ) return 0;
+  if (file_encoding==MT_BINARY_ENCODING)
+  {  /* the positions of the facets of all tiles, then all candidates */
+     if (!MT_ReadArray(fd, first_Arr+fac_num, sizeof(MT_INDEX), 
+                       n*fac_num+1)) return 0;
+     if (first_Arr[(n+1)*fac_num]!=cand_num)
+     {  MT_Error((char *)"Wrong number of candidates",
+                 (char *)"MT_AdjTableClass::MT_ReadBody");
+        return 0;
+     }
+     return ( MT_ReadArray(fd, cand_Arr, sizeof(MT_INDEX), cand_num) );
+  }
+  for (i=1; i<=n; i++)
+  {  if (!MT_ReadAttr(fd, i, file_encoding)) return 0;  }
+  return 1;
+}
+
+void MT_AdjTableClass :: MT_WriteClassAndParams(FILE * fd)
+{
+  MT_WriteKeyword(fd, MT_ClassKeyword());
+  fprintf(fd, " %d\n", fac_num);
+}
+  
+void MT_AdjTableClass :: MT_WriteObjParams(FILE * fd)
+{  
+  MT_WriteKeyword(fd, (char *)MT_OBJECT_KW);
+  fprintf(fd, " %d %d\n", my_num, cand_num);
+}
+
+void MT_AdjTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
+{  
+  MT_INDEX i;
+  if (file_encoding==MT_BINARY_ENCODING)
+  {  fwrite(first_Arr+fac_num, sizeof(MT_INDEX), my_num*fac_num+1, fd);
+     fwrite(cand_Arr, sizeof(MT_INDEX), cand_num, fd);
+  }
+  else
+  {  for (i=1; i<=my_num; i++)  MT_WriteAttr(fd, i, file_encoding);  }
+}
+
+/* ------------------------------------------------------------------------ */
+/*                         Creation and deletion                            */
+/* ------------------------------------------------------------------------ */
+
+MT_AdjTableClass :: MT_AdjTableClass(int k) 
+{  
+  my_num = 0; 
+  cand_num = 0;
+  fac_num = k;
+  first_Arr = NULL;
+  cand_Arr = NULL;
+}
+       
+MT_AdjTableClass :: ~MT_AdjTableClass(void)
+{  
+  MT_WaitWrite();
+  {  if (first_Arr) free(first_Arr);  first_Arr = NULL;  }
+  {  if (cand_Arr) free(cand_Arr);  cand_Arr = NULL;  }
+}
+
+/* ------------------------------------------------------------------------ */
@@ -47,9 +47,10 @@ int MT_BoolTableClass ::
            MT_Error((char *)"Read error",(char *)"MT_BoolTableClass::MT_ReadAttr");
            return 0;
         }
+        if (swap_bytes) MT_SwapArray(&b, sizeof(int), 1);
         break;
      case MT_ASCII_ENCODING:
-        if ( fscanf(fd, "%d", &b) != 1 )
+        if ( !MT_ScanInt(fd, &b) )
         {
            MT_Error((char *)"Read error",(char *)"MT_BoolTableClass::MT_ReadAttr");
            return 0;
@@ -84,14 +85,20 @@ void MT_BoolTableClass ::
 int MT_BoolTableClass :: 
     MT_ReadBlock(FILE * fd, MT_INDEX block, int file_encoding)
 {
+  MT_INDEX b;
   switch (file_encoding)
   {  case MT_BINARY_ENCODING:
         if (fread(&bit_Arr[block], sizeof(MT_BLOCK), 1, fd) == 1 )
+        {  if (swap_bytes) MT_SwapArray(&bit_Arr[block], sizeof(MT_BLOCK), 1);
            return 1;
+        }
         break;
      case MT_ASCII_ENCODING:
-        if ( fscanf(fd, MT_BLOCK_STRING, &bit_Arr[block]) == 1 )
+        /* blocks are written as unsigned integers */
+        if ( MT_ScanIndex(fd, &b) )
+        {  bit_Arr[block] = (MT_BLOCK) b;
            return 1;
+        }
         break;   
   }
   MT_Error((char *)"Read error",(char *)"MT_BoolTableClass::MT_ReadBlock");
@@ -117,21 +124,24 @@ void MT_BoolTableClass ::
 int MT_BoolTableClass ::
     MT_ReadBody(FILE * fd, int file_encoding)
 {
-  unsigned int i;
-  MT_SetAttrNum(my_num);
-  for (i=1; i<=blk_Num; i++)
-  {
-     if (!MT_ReadBlock(fd, i, file_encoding)) return 0;
-  }
-  return 1;
+  if (!MT_SetAttrNum(my_num)) return 0;
+  /* read all blocks directly into the bit array */
+  if (file_encoding==MT_BINARY_ENCODING)
+     return ( MT_ReadArray(fd, bit_Arr+1, sizeof(MT_BLOCK), blk_Num) );
+  /* blocks are written as unsigned integers */
+  return ( MT_ScanArray(fd, 0, NULL, blk_Num, (MT_INDEX *) (bit_Arr+1)) );
 }
 
 void MT_BoolTableClass ::
      MT_WriteBody(FILE * fd, int file_encoding)
 {
   unsigned int i;
-  for (i=1; i<=blk_Num; i++)
-  {  MT_WriteBlock(fd, i, file_encoding);  }
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(bit_Arr+1, sizeof(MT_BLOCK), blk_Num, fd);
+  else
+  {  for (i=1; i<=blk_Num; i++)
+     {  MT_WriteBlock(fd, i, file_encoding);  }
+  }
 }
 
 /* ------------------------------------------------------------------------ */
@@ -164,7 +174,7 @@ MT_BoolTableClass :: MT_BoolTableClass(void) : MT_BitClass()  { }
 /*
 This seems to do nothing but it calls the destructor of the superclass.
 */
-MT_BoolTableClass ::  ~MT_BoolTableClass(void)  { }
+MT_BoolTableClass ::  ~MT_BoolTableClass(void)  {  MT_WaitWrite();  }
 /********* CONTROLLA SE VERO **********/
 
 /* ------------------------------------------------------------------------ */
@@ -180,6 +190,7 @@ MT_BoolBuildingInterfaceClass :: MT_BoolBuildingInterfaceClass( void )
 
 MT_BoolBuildingInterfaceClass :: ~MT_BoolBuildingInterfaceClass( void )
 {
+  MT_WaitWrite();
   if (spec_attr) delete spec_attr;
   spec_attr = NULL;  my_attr = NULL;
 }
@@ -0,0 +1,278 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_box.c ------------------------------- */
+
+#include "mt_box.h"
+
+/* ------------------------------------------------------------------------ */
+/*                          Access primitives                               */
+/* ------------------------------------------------------------------------ */
+
+int MT_BoxTableClass :: MT_IsGood(MT_MultiTesselation m)
+{
+  return ( (box_Arr!=NULL) && (m->MT_VertexDim()==box_dim) &&
+           (m->MT_ArcNum()==arc_num) && 
+           (m->MT_NodeNum()==my_num-arc_num) );
+}
+
+/* ------------------------------------------------------------------------ */
+/*                        Computing the boxes                               */
+/* ------------------------------------------------------------------------ */
+
+/*
+Extend the entry at position e with the entry at position f.
+*/
+static void MT_MergeBox(float * e, float * f, int d)
+{
+  int j;
+  for (j=0; j<d; j++)
+  {  if (f[j]<e[j]) e[j] = f[j];
+     if (f[d+j]>e[d+j]) e[d+j] = f[d+j];
+  }
+  if (f[2*d]>e[2*d]) e[2*d] = f[2*d];
+}
+
+int MT_BoxTableClass :: MT_BuildBoxes(MT_MultiTesselation m, MT_FloatTable err)
+{
+  MT_INDEX a, t, t2, n, i, k;
+  MT_INDEX * order;  /* nodes in topological order */
+  int * cnt;         /* in-arcs of each node not yet reached */
+  float * e, * c;
+  int j, h;
+
+  if (m->MT_VertexDim()!=box_dim)
+  {  MT_Error((char *)"Wrong number of coordinates",
+              (char *)"MT_BoxTableClass::MT_BuildBoxes");
+     return 0;
+  }
+  if (m->MT_LoadedNodeNum()<m->MT_NodeNum())
+  {  MT_Error((char *)"MT not completely loaded",
+              (char *)"MT_BoxTableClass::MT_BuildBoxes");
+     return 0;
+  }
+  if (err && (err->MT_AttrNum()<m->MT_TileNum()))
+  {  MT_Error((char *)"Too few tile errors",
+              (char *)"MT_BoxTableClass::MT_BuildBoxes");
+     return 0;
+  }
+  order = (MT_INDEX *) calloc (m->MT_NodeNum()+1, sizeof(MT_INDEX));
+  cnt = (int *) calloc (m->MT_NodeNum()+1, sizeof(int));
+  if ( (!order) || (!cnt) || (!MT_SetAttrNum(m->MT_ArcNum()+m->MT_NodeNum())) )
+  {  MT_Error((char *)"Allocation failed",
+              (char *)"MT_BoxTableClass::MT_BuildBoxes");
+     if (order) free(order);
+     if (cnt) free(cnt);
+     return 0;
+  }
+  arc_num = m->MT_ArcNum();
+  
+  /* boxes of the arcs, bounding the vertices of their tiles */
+  for (a=1; a<=arc_num; a++)
+  {
+    e = MT_ArcMin(a);
+    if (err) e[2*box_dim] = 0.0;
+    t = m->MT_FirstArcTile(a);
+    if (t==MT_NULL_INDEX) continue;
+    t2 = m->MT_LastArcTile(a);
+    for ( ; t<=t2; t++)
+    {
+      for (h=0; h<m->MT_NumTileVertices(); h++)
+      {  c = m->MT_VertexCoords(m->MT_TileVertex(t,h));
+         for (j=0; j<box_dim; j++)
+         {  if (c[j]<e[j]) e[j] = c[j];
+            if (c[j]>e[box_dim+j]) e[box_dim+j] = c[j];
+         }
+      }
+      if (err && (err->MT_AttrValue(t)>e[2*box_dim]))
+         e[2*box_dim] = err->MT_AttrValue(t);
+    }
+  }
+
+  /* sort the nodes in topological order, starting from the root */
+  for (n=1; n<=m->MT_NodeNum(); n++)  cnt[n] = m->MT_NumInArcs(n);
+  order[0] = m->MT_Root();
+  k = 1;
+  for (i=0; i<k; i++)
+  {
+    a = m->MT_FirstOutArc(order[i]);
+    while (a!=MT_NULL_INDEX)
+    {  n = m->MT_ArcDest(a);
+       if ((--cnt[n])==0) order[k++] = n;
+       a = m->MT_NextOutArc(order[i],a);
+    }
+  }
+
+  /* boxes of the nodes, from the drain back to the root: each one
+     bounds the out-arcs of the node and the boxes of their destinations */
+  while (k>0)
+  {
+    n = order[--k];
+    e = MT_NodeMin(n);
+    if (err) e[2*box_dim] = 0.0;
+    a = m->MT_FirstOutArc(n);
+    while (a!=MT_NULL_INDEX)
+    {  MT_MergeBox(e, MT_ArcMin(a), box_dim);
+       MT_MergeBox(e, MT_NodeMin(m->MT_ArcDest(a)), box_dim);
+       a = m->MT_NextOutArc(n,a);
+    }
+  }
+  free(order);
+  free(cnt);
+  return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+/*                            Reading and writing                           */
+/* ------------------------------------------------------------------------ */
+
+int MT_BoxTableClass :: MT_SetAttrNum(MT_INDEX n)
+{
+  MT_INDEX i;
+  int j;
+  if (box_Arr) free(box_Arr);
+  box_Arr = (float *) calloc ( (n+1)*entry_size, sizeof(float) );
+  if (!box_Arr)
+  {  MT_ErrorC((char *)"Failed allocation",
+               (char *)"MT_BoxTableClass", (char *)"MT_SetAttrNum");
+     my_num = 0;
+     return 0;
+  }
+  for (i=0; i<=n; i++)
+  {  for (j=0; j<box_dim; j++)
+     {  box_Arr[i*entry_size+j] = FLT_MAX;
+        box_Arr[i*entry_size+box_dim+j] = -FLT_MAX;
+     }
+     box_Arr[i*entry_size+2*box_dim] = -1.0;
+  }
+  my_num = n;
+  return 1;
+}  
+
+int MT_BoxTableClass :: 
+    MT_ReadAttr(FILE * fd, MT_INDEX i, int file_encoding)
+{
+  if (file_encoding==MT_BINARY_ENCODING)
+     return ( MT_ReadArray(fd, box_Arr+i*entry_size, 
+                           sizeof(float), entry_size) );
+  return ( MT_ScanArray(fd, entry_size, box_Arr+i*entry_size, 0, NULL) );
+}
+
+void MT_BoxTableClass :: 
+     MT_WriteAttr(FILE * fd, MT_INDEX i, int file_encoding)
+{
+  int j;
+  if (file_encoding==MT_BINARY_ENCODING)
+  {  fwrite(box_Arr+i*entry_size, sizeof(float), entry_size, fd);
+     return;
+  }
+  /* nine digits, so that boxes are read back exactly and remain
+     conservative */
+  for (j=0; j<entry_size; j++)
+     fprintf(fd, ( (j<entry_size-1) ? "%.9g " : "%.9g\n" ), 
+             box_Arr[i*entry_size+j]);
+}
+
+int MT_BoxTableClass :: MT_ReadClassAndParams(FILE * fd)
+{
+  int d;
+  if (!MT_SearchKeyword(fd, MT_ClassKeyword())) return 0;
+  if (fscanf(fd, "%d", &d)==1)
+  {  if (d == box_dim) return 1;  }
+  /* else */
+  MT_Error((char *)"Class parameters do not match with this object",
+           (char *)"MT_BoxTableClass::MT_ReadClassAndParams");
+  return 0;
+}
+
+int MT_BoxTableClass :: MT_ReadObjParams(FILE * fd)
+{
+  int an, nn;
+  if (!MT_SearchKeyword(fd, (char *)MT_OBJECT_KW)) return 0;
+  if (fscanf(fd, "%d %d", &an, &nn)==2)
+  {  if ( (an>=0) && (nn>=0) )
+     {  arc_num = an;
+        my_num = an + nn;
+        return 1;
+     }
+  }
+  /* else */
+  MT_Error((char *)"Invalid object parameters",
+           (char *)"MT_BoxTableClass::MT_ReadObjParams");
+  return 0;
+}
+
+int MT_BoxTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
+{  
+  MT_INDEX n = my_num;
+  if (!MT_SetAttrNum(n)) return 0;
+  /* read all entries directly into the array */
+  if (file_encoding==MT_BINARY_ENCODING)
+     return ( MT_ReadArray(fd, box_Arr+entry_size, 
+                           sizeof(float), n*entry_size) );
+  return ( MT_ScanArray(fd, n*entry_size, box_Arr+entry_size, 0, NULL) );
+}
+
+void MT_BoxTableClass :: MT_WriteClassAndParams(FILE * fd)
+{
+  MT_WriteKeyword(fd, MT_ClassKeyword());
+  fprintf(fd, " %d\n", box_dim);
+}
+  
+void MT_BoxTableClass :: MT_WriteObjParams(FILE * fd)
+{  
+  MT_WriteKeyword(fd, (char *)MT_OBJECT_KW);
+  fprintf(fd, " %d %d\n", arc_num, my_num-arc_num);
+}
+
+void MT_BoxTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
+{  
+  MT_INDEX i;
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(box_Arr+entry_size, sizeof(float), my_num*entry_size, fd);
+  else
+  {  for (i=1; i<=my_num; i++)  MT_WriteAttr(fd, i, file_encoding);  }
+}
+
+/* ------------------------------------------------------------------------ */
+/*                         Creation and deletion                            */
+/* ------------------------------------------------------------------------ */
+
+MT_BoxTableClass :: MT_BoxTableClass(int d) 
+{  
+  my_num = 0; 
+  arc_num = 0;
+  box_dim = d;
+  entry_size = 2*d+1;
+  box_Arr = NULL;
+}
+       
+MT_BoxTableClass :: ~MT_BoxTableClass(void)
+{
+  MT_WaitWrite();
+  {  if (box_Arr) free(box_Arr);  box_Arr = NULL;  }
+}
+
+/* ------------------------------------------------------------------------ */
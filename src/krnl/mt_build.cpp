@@ -754,6 +754,7 @@ MT_BuildingInterfaceClass :: MT_BuildingInterfaceClass (void)
 MT_BuildingInterfaceClass :: ~MT_BuildingInterfaceClass(void)
 {
   MT_Message((char *)"",(char *)"MT_BuildingInterface Destructor");
+  MT_WaitWrite();
   if (my_tileset) delete my_tileset; my_tileset = NULL;
   if (table1) delete table1; table1 = NULL;
   if (table2) delete table2; table2 = NULL;
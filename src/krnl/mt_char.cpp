@@ -58,7 +58,7 @@ int MT_CharTableClass ::
         }
         break;
      case MT_ASCII_ENCODING:
-        if ( fscanf(fd, "%c", &att_Arr[i]) != 1 )
+        if ( !MT_ScanChar(fd, &att_Arr[i]) )
         {
            MT_WarningC(err_msg,(char *)"MT_CharTableClass",(char *)"MT_ReadAttr");
            return 0;
@@ -66,7 +66,7 @@ int MT_CharTableClass ::
         break;   
   }
   if (att_Arr[i] < bound[0]) bound[0] = att_Arr[i];
-  else if (att_Arr[i] > bound[1]) bound[1] = att_Arr[i];
+  if (att_Arr[i] > bound[1]) bound[1] = att_Arr[i];
   return 1;
 }
 
@@ -104,8 +104,53 @@ int MT_CharTableClass :: MT_ReadObjParams(FILE * fd)
 
 int MT_CharTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
 {  
-  MT_SetAttrNum(my_num);
-  return ( MT_AttrTableClass::MT_ReadBody(fd,file_encoding) );
+  unsigned int i;
+  int ok = 1;
+  if (!MT_SetAttrNum(my_num)) return 0;
+  /* read all values directly into the array, then update the bound */
+  if (file_encoding==MT_BINARY_ENCODING)
+     ok = MT_ReadArray(fd, att_Arr+1, sizeof(char), my_num);
+  else
+  {  /* characters are separated by white spaces */
+     for (i=1; ok && (i<my_num+1); i++)  ok = MT_ScanChar(fd, &att_Arr[i]);
+     if (!ok) MT_WarningC((char *)"char expected",(char *)"MT_CharTableClass",
+                          (char *)"MT_ReadBody");
+  }
+  if (ok) MT_UpdateBound();
+  return ok;
+}
+
+void MT_CharTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
+{  
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(att_Arr+1, sizeof(char), my_num, fd);
+  else MT_AttrTableClass::MT_WriteBody(fd, file_encoding);
+}
+
+void MT_CharTableClass :: MT_UpdateBound(void)
+{
+  /* four independent minima and maxima, on consecutive values, so that 
+     the loop can be executed with vector instructions */
+  char mn[4], mx[4];
+  MT_INDEX i;
+  int j;
+  for (j=0; j<4; j++)  {  mn[j] = bound[0];  mx[j] = bound[1];  }
+  for (i=1; i+3<=my_num; i+=4)
+  {  for (j=0; j<4; j++)
+     {  mn[j] = (att_Arr[i+j] < mn[j]) ? att_Arr[i+j] : mn[j];
+        mx[j] = (att_Arr[i+j] > mx[j]) ? att_Arr[i+j] : mx[j];
+     }
+  }
+  for ( ; i<=my_num; i++)
+  {  mn[0] = (att_Arr[i] < mn[0]) ? att_Arr[i] : mn[0];
+     mx[0] = (att_Arr[i] > mx[0]) ? att_Arr[i] : mx[0];
+  }
+  for (j=1; j<4; j++)
+  {  if (mn[j] < mn[0]) mn[0] = mn[j];
+     if (mx[j] > mx[0]) mx[0] = mx[j];
+  }
+  bound[0] = mn[0];
+  bound[1] = mx[0];
 }
 
 void MT_CharTableClass :: MT_WriteObjParams(FILE * fd)
@@ -128,6 +173,7 @@ MT_CharTableClass :: MT_CharTableClass(void)
 MT_CharTableClass ::  ~MT_CharTableClass(void) 
 {
 //  MT_MessageC("","MT_CharTableClass","Destructor");
+  MT_WaitWrite();
   if (att_Arr) {  free (att_Arr);  }  }
 
 /* ------------------------------------------------------------------------ */
@@ -143,6 +189,7 @@ MT_CharBuildingInterfaceClass :: MT_CharBuildingInterfaceClass( void )
 
 MT_CharBuildingInterfaceClass :: ~MT_CharBuildingInterfaceClass( void )
 {
+  MT_WaitWrite();
   if (spec_attr) delete spec_attr;
   spec_attr = NULL;  my_attr = NULL;
 }
@@ -186,7 +233,7 @@ int MT_CharVectorTableClass ::
           }
           break;
        case MT_ASCII_ENCODING:
-          if ( fscanf(fd, "%c", &av_Arr[j+i*vector_size]) != 1 )
+          if ( !MT_ScanChar(fd, &av_Arr[j+i*vector_size]) )
           {
              MT_ErrorC((char *)"Cannot read vector element",
                        (char *)"MT_CharVectorTableClass",(char *)"MT_ReadAttr");
@@ -250,6 +297,10 @@ int MT_CharVectorTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
   unsigned int i;
   /* allocate char array */
   if (!MT_SetAttrNum(my_num)) return 0;
+  /* read all vectors directly into the array */
+  if (file_encoding==MT_BINARY_ENCODING)
+     return ( MT_ReadArray(fd, av_Arr+vector_size, 
+                           sizeof(char), my_num*vector_size) );
   /* read the values and fill the array */
   for (i=1; i<my_num+1; i++)
   {  if (!MT_ReadAttr(fd, i, file_encoding)) return 0;  }
@@ -271,8 +322,12 @@ void MT_CharVectorTableClass :: MT_WriteObjParams(FILE * fd)
 void MT_CharVectorTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
 {  
   unsigned int i;
-  for (i=1; i<my_num+1; i++)
-  {  MT_WriteAttr(fd, i, file_encoding);  }
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(av_Arr+vector_size, sizeof(char), my_num*vector_size, fd);
+  else
+  {  for (i=1; i<my_num+1; i++)
+     {  MT_WriteAttr(fd, i, file_encoding);  }
+  }
 }
 
 /* ------------------------------------------------------------------------ */
@@ -305,7 +360,10 @@ MT_CharVectorTableClass :: MT_CharVectorTableClass(int num)
 }
        
 MT_CharVectorTableClass :: ~MT_CharVectorTableClass(void)
-{  if (my_num) free(av_Arr);  av_Arr = NULL;  }
+{
+  MT_WaitWrite();
+  {  if (my_num) free(av_Arr);  av_Arr = NULL;  }
+}
 
 /* ------------------------------------------------------------------------ */
 /*               BUILDING INTERFACE FOR char VECTOR ATTRIBUTES               */  
@@ -320,6 +378,7 @@ MT_CharVectorBuildingInterfaceClass :: MT_CharVectorBuildingInterfaceClass( int
 
 MT_CharVectorBuildingInterfaceClass :: ~MT_CharVectorBuildingInterfaceClass( void )
 {
+  MT_WaitWrite();
   if (spec_attr) free (spec_attr);
   my_attr = NULL; spec_attr = NULL;
 }
@@ -338,4 +397,4 @@ int MT_CharVectorBuildingInterfaceClass :: MT_MakeAttrVector(MT_INDEX i, char *v
 }
 
 /* ------------------------------------------------------------------------ */
-
+
@@ -27,6 +27,31 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "mt_cond.h"
 
+/* ------------------------------------------------------------------------ */
+/*                      A GENERIC TILE CONDITION                            */
+/* ------------------------------------------------------------------------ */
+
+int MT_CondClass :: 
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2, 
+                     int flag, unsigned char * res)
+{
+   MT_INDEX t;
+   int cnt = 0;
+   for (t=t1; t<=t2; t++)
+   {
+     res[t-t1] = ( MT_EvalCond(m,t,flag) ? 1 : 0 );
+     cnt += res[t-t1];
+   }
+   return cnt;
+}
+
+int MT_CondClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+   return MT_BOX_CROSS;
+}
+
 /* ------------------------------------------------------------------------ */
 /*            COMPOSITION OF CONDITIONS THROUGH BOOLEAN OPERATORS           */
 /* ------------------------------------------------------------------------ */
@@ -54,6 +79,69 @@ int MT_CompoundCondClass ::
    return 0; /* never reached */
 }
 
+int MT_CompoundCondClass :: 
+    MT_EvalCondRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2, 
+                     int flag, unsigned char * res)
+{
+   unsigned char aux[MT_TILE_BATCH]; /* results of the second argument */
+   MT_INDEX t, n;
+   int i, cnt = 0;
+
+   if ( (my_op!=MT_AND_OP) && (my_op!=MT_OR_OP) )
+   {
+     MT_FatalError((char *)"Invalid operator",
+                   (char *)"MT_CompoundCondClass::MT_EvalCondRange");
+     return 0; /* never reached */
+   }
+   if ( (!arg[0]) || (!arg[1]) )
+   {
+     if ( (my_op==MT_OR_OP) || ((!arg[0]) && (!arg[1])) )
+     {  memset(res, 1, t2-t1+1);  return (t2-t1+1);  }
+     if (arg[0]) return arg[0]->MT_EvalCondRange(m,t1,t2,flag,res);
+     return arg[1]->MT_EvalCondRange(m,t1,t2,flag,res);
+   }
+   /* evaluate in chunks that fit the auxiliary buffer */
+   for (t=t1; t<=t2; t+=n)
+   {
+     n = t2-t+1;
+     if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+     arg[0]->MT_EvalCondRange(m,t,t+n-1,flag,&res[t-t1]);
+     arg[1]->MT_EvalCondRange(m,t,t+n-1,flag,aux);
+     if (my_op==MT_AND_OP)
+        for (i=0;i<(int)n;i++) res[t-t1+i] &= aux[i];
+     else
+        for (i=0;i<(int)n;i++) res[t-t1+i] |= aux[i];
+     for (i=0;i<(int)n;i++) cnt += res[t-t1+i];
+   }
+   return cnt;
+}
+
+int MT_CompoundCondClass :: 
+    MT_EvalBox(MT_MultiTesselation m, float * min_coord, float * max_coord,
+               float max_err, int flag)
+{
+   int r0, r1;  /* results of the two arguments */
+
+   /* a missing argument is identically true, as in MT_EvalCond */
+   r0 = ( arg[0] ? arg[0]->MT_EvalBox(m,min_coord,max_coord,max_err,flag)
+                 : MT_BOX_IN );
+   r1 = ( arg[1] ? arg[1]->MT_EvalBox(m,min_coord,max_coord,max_err,flag)
+                 : MT_BOX_IN );
+   switch (my_op)
+   {
+      case MT_AND_OP:
+        if ( (r0==MT_BOX_OUT) || (r1==MT_BOX_OUT) ) return MT_BOX_OUT;
+        if ( (r0==MT_BOX_IN) && (r1==MT_BOX_IN) ) return MT_BOX_IN;
+        return MT_BOX_CROSS;
+      case MT_OR_OP:
+        if ( (r0==MT_BOX_IN) || (r1==MT_BOX_IN) ) return MT_BOX_IN;
+        if ( (r0==MT_BOX_OUT) && (r1==MT_BOX_OUT) ) return MT_BOX_OUT;
+        return MT_BOX_CROSS;
+   }
+   MT_FatalError((char *)"Invalid operator",(char *)"MT_CompoundCondClass::MT_EvalBox");
+   return 0; /* never reached */
+}
+
 MT_CompoundCondClass :: 
 MT_CompoundCondClass(int op, MT_Cond c1, MT_Cond c2)
 {
@@ -74,3 +162,17 @@ MT_CompoundCondClass(int op, MT_Cond c1, MT_Cond c2)
 }
   
 /* ------------------------------------------------------------------------ */
+
+/* ------------------------------------------------------------------------ */
+/*                        PRIORITIES OF MT TILES                            */
+/* ------------------------------------------------------------------------ */
+
+void MT_PriorityClass :: 
+     MT_EvalPriorityRange(MT_MultiTesselation m, MT_INDEX t1, MT_INDEX t2, 
+                          float * res)
+{
+   MT_INDEX t;
+   for (t=t1; t<=t2; t++)  res[t-t1] = MT_EvalPriority(m,t);
+}
+
+/* ------------------------------------------------------------------------ */
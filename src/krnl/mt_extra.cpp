@@ -25,27 +25,14 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 /* ---------------------------- mt_extra.c -------------------------------- */
 
+#include <float.h>
+
 #include "mt_extra.h"
 
 /* ------------------------------------------------------------------------ */
 /*               EXTRACTION  OF TESSELATIONS FROM AN MT                     */
 /* ------------------------------------------------------------------------ */
 
-/* ------------------------------------------------------------------------ */
-/*                        AUXILIARY DATA STRUCTURES                         */
-/* ------------------------------------------------------------------------ */
-
-MT_TopoClass :: MT_TopoClass (int dim)
-{
-  T_adj = (MT_INDEX *) calloc ( dim, sizeof(MT_INDEX) );
-  /* calloc also initializes all entries to MT_NULL_INDEX */
-  if (!T_adj)
-  {  MT_FatalError((char *)"Failed allocation",(char *)"MT_TopoClass Constructor");  }
-}
-
-MT_TopoClass :: ~MT_TopoClass(void)  
-{  free (T_adj); }
-
 /* ------------------------------------------------------------------------ */
 /*                       GENERIC  EXTRACTOR  CLASS                          */
 /* ------------------------------------------------------------------------ */
@@ -81,6 +68,41 @@ int MT_ExtractorClass :: MT_SetFocus(MT_Cond fcs)
    return 1;
 }
 
+int MT_ExtractorClass :: MT_SetBoxTable(MT_BoxTable b)
+{
+   if ( (b) && (!b->MT_IsGood(mt)) )
+   {  MT_Warning((char *)"Box table not good for MT",(char *)"MT_ExtractorClass::MT_SetBoxTable");
+      return 0;
+   }
+   /* else */
+   box_tbl = b;
+   return 1;
+}
+
+int MT_ExtractorClass :: MT_SetAdjTable(MT_AdjTable c)
+{
+   MT_INDEX t;
+
+   if ( (c) && (!c->MT_IsGood(mt)) )
+   {  MT_Warning((char *)"Adjacency table not good for MT",(char *)"MT_ExtractorClass::MT_SetAdjTable");
+      return 0;
+   }
+   /* else */
+   if (topo_enabled && c && !adj_tbl)
+   {
+     /* the tiles of the current tesselation must have an
+        adjacency record, even if they have no adjacent tiles */
+     t = MT_FirstFrontTile();
+     while (t != MT_NULL_INDEX)
+     {
+        if (!adj_slot[t]) MT_NewAdjSlot(t);
+        t = MT_NextFrontTile(t);
+     }
+   }
+   adj_tbl = c;
+   return 1;
+}
+
 /* ------------------------------------------------------------------------ */
 /*                       Extraction of a tesselation                        */
 /* ------------------------------------------------------------------------ */
@@ -102,7 +124,8 @@ MT_INDEX MT_ExtractorClass :: MT_ExtractTesselation( void )
 
 MT_INDEX MT_ExtractorClass :: MT_ExtractedTiles(MT_INDEX ** t_arr)
 {
-  if (tiles_ok)
+  /* fill the arrays if the extraction has not done it */
+  if ( tiles_ok || MT_ExtractionCompleted() )
   { 
     (*t_arr) = T_good;
     return num_good;
@@ -119,24 +142,17 @@ MT_INDEX MT_ExtractorClass :: MT_ExtractedTiles(MT_INDEX ** t_arr)
 /*                  Topology of the extracted tesselation                   */
 /* ------------------------------------------------------------------------ */
 
-MT_INDEX MT_ExtractorClass :: MT_TileAdj(MT_INDEX t, int i)
-{
-   if (!topo_enabled) return MT_NULL_INDEX;
-   if ( (t == MT_NULL_INDEX) || (!topo[t]) ) return MT_NULL_INDEX;
-   return ( topo[t]->T_adj[i] );
-}
-
 MT_INDEX * MT_ExtractorClass :: MT_TileAdjs(MT_INDEX t)
 {
    if (!topo_enabled) return NULL;
-   if ( (t == MT_NULL_INDEX) || (!topo[t]) ) return MT_NULL_INDEX;
-   return ( topo[t]->T_adj );
+   if ( (t == MT_NULL_INDEX) || (!adj_slot[t]) ) return NULL;
+   return ( adj_Arr + adj_slot[t]*mt_dim );
 }
 
 void MT_ExtractorClass :: MT_CopyTileAdjs(MT_INDEX t, MT_INDEX * ta)
 {
    int i;
-   if (!topo_enabled || (t == MT_NULL_INDEX) || (!topo[t]) ) 
+   if (!topo_enabled || (t == MT_NULL_INDEX) || (!adj_slot[t]) ) 
    {
      for (i=0; i<mt_dim; i++)
      {  ta[i] = MT_NULL_INDEX;  }
@@ -144,8 +160,68 @@ void MT_ExtractorClass :: MT_CopyTileAdjs(MT_INDEX t, MT_INDEX * ta)
    else
    {
      for (i=0; i<mt_dim; i++)
-     {  ta[i] = topo[t]->T_adj[i];  }
+     {  ta[i] = adj_Arr[adj_slot[t]*mt_dim+i];  }
+   }
+}
+
+/* ------------------------------------------------------------------------ */
+/*                Vertex stars of the extracted tesselation                 */
+/* ------------------------------------------------------------------------ */
+
+int MT_ExtractorClass :: MT_SetVertexStars(int flag)
+{
+   MT_INDEX a; /* variable for arc */
+
+   if (!flag)
+   {
+     if (V_pos) {  free(V_pos); V_pos = NULL;  }
+     if (V_list) {  free(V_list); V_list = NULL;  }
+     if (V_count) {  free(V_count); V_count = NULL;  }
+     if (V_first) {  free(V_first); V_first = NULL;  }
+     if (V_star) {  free(V_star); V_star = NULL;  }
+     V_num = V_max = star_size = 0;
+     star_enabled = star_ok = 0;
+     return 1;
+   }
+   if (star_enabled)  return 1;
+   if (!A_front)
+   {
+     MT_Warning((char *)"Vertex stars not available",
+                (char *)"MT_ExtractorClass::MT_SetVertexStars");
+     return 0;
    }
+   /* calloc is used to leave all vertices out of the front */
+   V_pos = (MT_INDEX *) calloc ( mt->MT_VertexNum()+1, sizeof(MT_INDEX) );
+   V_max = MT_STAR_VERTICES;
+   V_list = (MT_INDEX *) malloc ( (V_max+1)*sizeof(MT_INDEX) );
+   V_count = (MT_INDEX *) malloc ( (V_max+1)*sizeof(MT_INDEX) );
+   V_first = (MT_INDEX *) malloc ( (V_max+2)*sizeof(MT_INDEX) );
+   star_enabled = 1;
+   if ( !(V_pos && V_list && V_count && V_first) )
+   {
+     MT_Error((char *)"Failed allocation",(char *)"MT_ExtractorClass::MT_SetVertexStars");
+     MT_SetVertexStars(0);
+     return 0;
+   }
+
+   /* count the tiles of the current front */
+   a = A_front->MT_FirstElem();
+   while (a != MT_NULL_INDEX)
+   { 
+     if (!MT_AddStarTiles(a))
+     {  MT_SetVertexStars(0);
+        return 0;
+     }
+     a = A_front->MT_NextElem(a);
+   }
+   return 1;
+}
+
+MT_INDEX * MT_ExtractorClass :: MT_VertexStar(MT_INDEX v)
+{
+   if ( (!star_enabled) || (!V_pos[v]) ) return NULL;
+   if ( (!star_ok) && (!MT_BuildStars()) ) return NULL;
+   return ( V_star + V_first[V_pos[v]] );
 }
 
 /* ------------------------------------------------------------------------ */
@@ -172,17 +248,50 @@ MT_INDEX MT_ExtractorClass :: MT_NextFrontTile (MT_INDEX t)
 
 /* ------------------------------------------------------------------------ */
 
+int MT_ExtractorClass :: MT_RefineArc(MT_INDEX a, MT_INDEX * tested)
+{
+  unsigned char focus[MT_TILE_BATCH]; /* tiles in the focus set */
+  unsigned char good[MT_TILE_BATCH];  /* tiles feasible for the filter */
+  MT_INDEX t, t2, n;  /* range of tiles */
+  int i;
+  
+  /* no tile must be refined if there is no resolution filter, and if
+     a enters the drain (such tiles are always feasible) */
+  t = mt->MT_FirstArcTile(a);
+  if ( (!resol_cnd) || (t == MT_NULL_INDEX) || 
+       (mt->MT_ArcDest(a) == mt->MT_Drain()) )
+     return 0;
+  t2 = mt->MT_LastArcTile(a);
+  if (t==t2) /* single tile, not worth a range evaluation */
+  {
+    (*tested)++;
+    return ( MT_FocusTile(t,MT_LOOSE) && 
+             !resol_cnd->MT_EvalCond(mt,t,MT_LOOSE) );
+  }
+  for ( ; t<=t2; t+=n)
+  {
+    n = t2-t+1;
+    if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+    (*tested) += n;
+    if ( MT_FocusTiles(t,t+n-1,MT_LOOSE,focus) &&
+         (resol_cnd->MT_EvalCondRange(mt,t,t+n-1,MT_LOOSE,good) < (int)n) )
+    {
+      for (i=0;i<(int)n;i++)
+        if (focus[i] && !good[i]) return 1;
+    }
+  }
+  return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+
 int MT_ExtractorClass :: 
     OneWaySetAdjLink(MT_INDEX t1, MT_INDEX t2, int j)
 {
    if (t1!=MT_NULL_INDEX)
    {
-     if (!topo[t1]) topo[t1] = new MT_TopoClass(mt_dim);
-     if (!topo[t1])
-     {  MT_Error((char *)"Failed allocation",(char *)"MT_ExtractorClass::MT_SetAdjLink");
-        return 0;
-     }
-     topo[t1]->T_adj[j] = t2;
+     if ( (!adj_slot[t1]) && (!MT_NewAdjSlot(t1)) )  return 0;
+     adj_Arr[adj_slot[t1]*mt_dim+j] = t2;
      return 1;
    }  
    return 1; /* if t1 is null, nothing to be done */
@@ -198,51 +307,281 @@ int MT_ExtractorClass ::
 
 int MT_ExtractorClass :: MT_RemAdjLinks(MT_INDEX t)
 {
+   MT_INDEX s;
+
    if (!topo_enabled) return 1;
-   if (topo[t]) 
+   if ( (s = adj_slot[t]) ) 
    {
-     delete topo[t];  topo[t] = NULL;
+     /* put the slot of t in the free list */
+     adj_Arr[s*mt_dim] = slot_free;
+     slot_free = s;
+     adj_slot[t] = MT_NULL_INDEX;
+     /* if no slot is in use, start again from the first one */
+     if ((--slot_used)==0)  slot_top = slot_free = 0;
      return 1;
    }
    return 0;
 }
 
+MT_INDEX MT_ExtractorClass :: MT_NewAdjSlot(MT_INDEX t)
+{
+   MT_INDEX s;
+   int i;
+
+   if (slot_free)
+   {  s = slot_free;
+      slot_free = adj_Arr[s*mt_dim];
+   }
+   else
+   {  if (!MT_GrowAdjSlots(slot_top+1))  return 0;
+      s = ++slot_top;
+   }
+   for (i=0; i<mt_dim; i++)  adj_Arr[s*mt_dim+i] = MT_NULL_INDEX;
+   adj_slot[t] = s;
+   slot_used++;
+   return s;
+}
+
+int MT_ExtractorClass :: MT_GrowAdjSlots(MT_INDEX n)
+{
+   MT_INDEX * aux;
+   MT_INDEX m = slot_max;
+
+   if (n <= slot_max)  return 1;
+   while (m < n)  m *= 2;
+   aux = (MT_INDEX *) realloc ( adj_Arr, (m+1)*mt_dim*sizeof(MT_INDEX) );
+   if (!aux)
+   {  MT_Error((char *)"Failed allocation",(char *)"MT_ExtractorClass::MT_GrowAdjSlots");
+      return 0;
+   }
+   adj_Arr = aux;
+   slot_max = m;
+   return 1;
+}
+
+MT_INDEX MT_ExtractorClass :: MT_FindCandAdj(MT_INDEX t, int i, int * ii)
+{
+   MT_INDEX * c = adj_tbl->MT_FacetCands(t,i);
+   int j, n = adj_tbl->MT_FacetCandNum(t,i);
+   MT_INDEX t1;
+
+   for (j=0; j<n; j++)
+   {
+     t1 = adj_tbl->MT_CandTile(c[j]);
+     if (adj_slot[t1])
+     {  (*ii) = adj_tbl->MT_CandFacet(c[j]);
+        return t1;
+     }
+   }
+   (*ii) = -1;
+   return MT_NULL_INDEX;
+}
+
+int MT_ExtractorClass :: MT_LinkCandTile(MT_INDEX t)
+{
+   MT_INDEX s, t1;
+   int i, i1;
+
+   /* the slot marks t as belonging to the current tesselation */
+   if ( (!(s = adj_slot[t])) && (!(s = MT_NewAdjSlot(t))) )  return 0;
+   for (i=0; i<mt_dim; i++)
+   {
+     t1 = MT_FindCandAdj(t,i,&i1);
+     adj_Arr[s*mt_dim+i] = t1;
+     if (t1)  adj_Arr[adj_slot[t1]*mt_dim+i1] = t;
+   }
+   return 1;
+}
+
+int MT_ExtractorClass :: MT_UnlinkCandTile(MT_INDEX t)
+{
+   MT_INDEX * c;
+   MT_INDEX t1, t2;
+   int i, i1, i2, j, n;
+
+   if (!MT_RemAdjLinks(t)) return 0;
+   /* while new tiles are being added and old ones removed, a facet
+      may be shared by more than two tiles, thus all candidates 
+      linked to t are linked again */
+   for (i=0; i<mt_dim; i++)
+   {
+     c = adj_tbl->MT_FacetCands(t,i);
+     n = adj_tbl->MT_FacetCandNum(t,i);
+     for (j=0; j<n; j++)
+     {
+       t1 = adj_tbl->MT_CandTile(c[j]);
+       i1 = adj_tbl->MT_CandFacet(c[j]);
+       if ( adj_slot[t1] && (adj_Arr[adj_slot[t1]*mt_dim+i1]==t) )
+       {
+         t2 = MT_FindCandAdj(t1,i1,&i2);
+         adj_Arr[adj_slot[t1]*mt_dim+i1] = t2;
+         if (t2)  adj_Arr[adj_slot[t2]*mt_dim+i2] = t1;
+       }
+     }
+   }
+   return 1;
+}
+
 /* ----------------------------------------------------------------------- */
 
-int MT_ExtractorClass :: MT_ExpandExtractor (void)
+int MT_ExtractorClass :: MT_AddStarTiles(MT_INDEX a)
 {
-  MT_INDEX a;    /* variable for arc */ 
-  MT_INDEX t;    /* variable for tile */
-  int flag;      /* boolean control variable */
+   MT_INDEX t;    /* variable for tile */
+   MT_INDEX * v;  /* vertices of t */
+   MT_INDEX k;    /* position in V_list */
+   int i;
+
+   star_ok = 0;
+   t = mt->MT_FirstArcTile(a);
+   while (t != MT_NULL_INDEX)
+   {
+     v = mt->MT_TileVertices(t);
+     for (i=0; i<mt_dim; i++)
+     {
+       if ( !(k = V_pos[v[i]]) )
+       {
+         /* v[i] enters the front */
+         if ( (V_num == V_max) && (!MT_GrowStarVertices()) )  return 0;
+         k = V_pos[v[i]] = ++V_num;
+         V_list[k] = v[i];
+         V_count[k] = 0;
+       }
+       V_count[k]++;
+     }
+     t = mt->MT_NextArcTile(a,t);
+   }
+   return 1;
+}
+
+void MT_ExtractorClass :: MT_RemStarTiles(MT_INDEX a)
+{
+   MT_INDEX t;    /* variable for tile */
+   MT_INDEX * v;  /* vertices of t */
+   MT_INDEX k;    /* position in V_list */
+   int i;
+
+   star_ok = 0;
+   t = mt->MT_FirstArcTile(a);
+   while (t != MT_NULL_INDEX)
+   {
+     v = mt->MT_TileVertices(t);
+     for (i=0; i<mt_dim; i++)
+     {
+       k = V_pos[v[i]];
+       if ( (!k) || (--V_count[k]) )  continue;
+       /* v[i] leaves the front, the last vertex takes its position */
+       V_pos[v[i]] = 0;
+       if (k<V_num)
+       {  V_list[k] = V_list[V_num];
+          V_count[k] = V_count[V_num];
+          V_pos[V_list[k]] = k;
+       }
+       V_num--;
+     }
+     t = mt->MT_NextArcTile(a,t);
+   }
+}
+
+int MT_ExtractorClass :: MT_GrowStarVertices(void)
+{
+   MT_INDEX * aux1, * aux2, * aux3;
+
+   aux1 = (MT_INDEX *) realloc ( V_list, (2*V_max+1)*sizeof(MT_INDEX) );
+   if (aux1)  V_list = aux1;
+   aux2 = (MT_INDEX *) realloc ( V_count, (2*V_max+1)*sizeof(MT_INDEX) );
+   if (aux2)  V_count = aux2;
+   aux3 = (MT_INDEX *) realloc ( V_first, (2*V_max+2)*sizeof(MT_INDEX) );
+   if (aux3)  V_first = aux3;
+   if ( !(aux1 && aux2 && aux3) )
+   {  MT_Error((char *)"Failed allocation",(char *)"MT_ExtractorClass::MT_GrowStarVertices");
+      return 0;
+   }
+   V_max *= 2;
+   return 1;
+}
+
+int MT_ExtractorClass :: MT_BuildStars(void)
+{
+   MT_INDEX a;    /* variable for arc */
+   MT_INDEX t;    /* variable for tile */
+   MT_INDEX * v;  /* vertices of t */
+   MT_INDEX * aux;
+   MT_INDEX k;
+   int i;
+
+   /* V_first[k+1] is the position after the star of V_list[k] */
+   V_first[1] = 0;
+   for (k=1; k<=V_num; k++)  V_first[k+1] = V_first[k] + V_count[k];
+   if (star_size < V_first[V_num+1])
+   {
+     aux = (MT_INDEX *) realloc ( V_star, 
+                                  (V_first[V_num+1]+1)*sizeof(MT_INDEX) );
+     if (!aux)
+     {  MT_Error((char *)"Failed allocation",(char *)"MT_ExtractorClass::MT_BuildStars");
+        return 0;
+     }
+     V_star = aux;
+     star_size = V_first[V_num+1];
+   }
+
+   /* put each tile in the stars of its vertices, moving V_first[k]
+      forward to the start of the next star, then move back */
+   a = A_front->MT_FirstElem();
+   while (a != MT_NULL_INDEX)
+   { 
+     t = mt->MT_FirstArcTile(a);
+     while (t != MT_NULL_INDEX)
+     {
+       v = mt->MT_TileVertices(t);
+       for (i=0; i<mt_dim; i++)  V_star[V_first[V_pos[v[i]]]++] = t;
+       t = mt->MT_NextArcTile(a,t);
+     }
+     a = A_front->MT_NextElem(a);
+   }
+   for (k=V_num; k>=1; k--)  V_first[k+1] = V_first[k];
+   V_first[1] = 0;
+   star_ok = 1;
+   return 1;
+}
+
+/* ----------------------------------------------------------------------- */
 
+int MT_ExtractorClass :: MT_ExpandExtractor (void)
+{
   A_front->MT_CurrInit(0);
+  return MT_AdvanceFront();
+}
+
+int MT_ExtractorClass :: MT_AdvanceFront (void)
+{
   /************ TAPULLO PER CAD ****************/
-  while (A_front->MT_CurrElem(0) != MT_NULL_INDEX)
+  while (MT_AdvanceFrontArc());
 //  while ( (A_front->MT_CurrElem(0) != MT_NULL_INDEX) &&
 //          (num_tiles<max_tile_num) )
-  {
-    if (stat_enabled)  a_tested++;
+  return 1;
+}
 
-    a = A_front->MT_CurrElem(0);
-    A_front->MT_CurrAdvance(0);
-    /* check whether some tile of a must be refined.
-       flag == 1 iff no tiles must be refined */
-    flag = 1;
-    t = mt->MT_FirstArcTile(a);
-    while (flag && (t != MT_NULL_INDEX))
-    {
-       if (stat_enabled)  t_tested++;
+int MT_ExtractorClass :: MT_AdvanceFrontArc (void)
+{
+  MT_INDEX a;    /* variable for arc */ 
+  MT_INDEX tn;   /* number of tiles tested on an arc */
+  int flag;      /* boolean control variable */
 
-       flag = ( (!MT_FocusTile(t,MT_LOOSE))
-                 || 
-                 MT_FilterTile(t,MT_LOOSE) );
-              /* flag becomes == 0 if t not valid */ 
-       t = mt->MT_NextArcTile(a,t);
-    }
-    /* if flag == 0, refine the current extracted tesselation
-       by sweeping the front forward */
-    if (!flag)  MT_IncludeNode(mt->MT_ArcDest(a));
-  }
+  if (A_front->MT_CurrElem(0) == MT_NULL_INDEX)  return 0;
+  if (stat_enabled)  a_tested++;
+
+  a = A_front->MT_CurrElem(0);
+  A_front->MT_CurrAdvance(0);
+  /* check whether some tile of a must be refined.
+     flag == 1 iff no tiles must be refined */
+  tn = 0;
+  flag = !MT_RefineArc(a, &tn);
+  if (stat_enabled)  t_tested += tn;
+  /* if flag == 0, refine the current extracted tesselation
+     by sweeping the front forward, unless the node beyond a
+     has not been loaded yet (see MT_OpenStream) */
+  if ( (!flag) && mt->MT_IsLoaded(mt->MT_ArcDest(a)) )
+     MT_IncludeNode(mt->MT_ArcDest(a));
   return 1;
 }
 
@@ -250,7 +589,14 @@ int MT_ExtractorClass :: MT_ExpandExtractor (void)
 
 int MT_ExtractorClass :: MT_ResetExtractor(void)
 {
-   MT_INDEX t;
+   MT_ClearExtractor();
+   MT_IncludeNode(mt->MT_Root());
+   return 1;
+}
+
+void MT_ExtractorClass :: MT_ClearExtractor(void)
+{
+   MT_INDEX t, k;
 
    if (stat_enabled)  MT_ResetAllStat();
 
@@ -264,18 +610,24 @@ int MT_ExtractorClass :: MT_ResetExtractor(void)
      }
    }
 
+   if (star_enabled)
+   {
+     for (k=1; k<=V_num; k++)  V_pos[V_list[k]] = 0;
+     V_num = 0;
+     star_ok = 0;
+   }
+
    if (T_good)  {  free(T_good); T_good = NULL;  }
    extr_count++; /* this empties N_set */
    A_front->MT_EmptyList();
    num_good = num_tiles = 0;
    tiles_ok = 0;
-   MT_IncludeNode(mt->MT_Root());
-   return 1;
 }
 
 /* ------------------------------------------------------------------------ */
 
-MT_ExtractorClass :: MT_ExtractorClass (MT_MultiTesselation m, int topo_flag)
+MT_ExtractorClass :: MT_ExtractorClass (MT_MultiTesselation m, int topo_flag,
+                                        int dense_flag)
 {
    /* allocate just the fields, each derived class will add code to allocate
       additional fields and to put the extractor in an initial state */
@@ -290,30 +642,51 @@ MT_ExtractorClass :: MT_ExtractorClass (MT_MultiTesselation m, int topo_flag)
    /* no extraction conditions */
    resol_cnd = NULL;
    place_cnd = NULL;
+   box_tbl = NULL;
+   adj_tbl = NULL;
    
    extr_count = 1;
    tiles_ok = 0;
-   N_set = 
-      (unsigned int *) calloc ( mt->MT_NodeNum()+1, sizeof(unsigned int) );
-   A_front = new MT_ListClass(mt->MT_ArcNum()+1,1);
-   if ( !(N_set && A_front) )
+   N_set = NULL;
+   A_front = NULL;
+   W_node = W_arc = NULL;
+   if (dense_flag)
    {
-     MT_FatalError((char *)"Allocation failed",(char *)"MT_Extractor Constructor");
+     N_set = 
+        (unsigned int *) calloc ( mt->MT_NodeNum()+1, sizeof(unsigned int) );
+     A_front = new MT_ListClass(mt->MT_ArcNum()+1,1);
+     W_node = (MT_INDEX *) malloc ( (mt->MT_NodeNum()+1)*sizeof(MT_INDEX) );
+     W_arc = (MT_INDEX *) malloc ( (mt->MT_NodeNum()+1)*sizeof(MT_INDEX) );
+     if ( !(N_set && A_front && W_node && W_arc) )
+     {
+       MT_FatalError((char *)"Allocation failed",(char *)"MT_Extractor Constructor");
+     }
    }
    topo_enabled = topo_flag;
+   adj_slot = adj_Arr = NULL;
+   slot_max = slot_top = slot_free = slot_used = 0;
    if (topo_enabled)
    {
-     topo = (MT_Topo *) calloc ( mt->MT_TileNum()+1, sizeof(MT_Topo) );
+     adj_slot = (MT_INDEX *) calloc ( mt->MT_TileNum()+1, sizeof(MT_INDEX) );
      /* calloc is used to set all array elements to zeroes */
-     hash_table = new MT_HashTableClass(10,mt);
-     if ( !hash_table )
+     slot_max = MT_ADJ_SLOTS;
+     adj_Arr = (MT_INDEX *) malloc ( (slot_max+1)*mt_dim*sizeof(MT_INDEX) );
+     hash_table = new MT_HashTableClass(256,mt);
+     if ( !(adj_slot && adj_Arr && hash_table) )
      {
        MT_FatalError((char *)"Allocation failed",(char *)"MT_Extractor Constructor");
      }
    } 
 
+   /* vertex stars are enabled with MT_SetVertexStars */
+   star_enabled = 0;
+   V_pos = V_list = V_count = V_first = V_star = NULL;
+   V_num = V_max = star_size = 0;
+   star_ok = 0;
+
    /* by default, disable statistics */ 
    stat_enabled = 0;
+   p_hits = p_misses = 0;
    
    /********** TAPULLO PER CAD **********/
    max_tile_num = m->MT_TileNum();
@@ -324,16 +697,14 @@ MT_ExtractorClass :: ~MT_ExtractorClass (void)
    MT_Message((char *)"",(char *)"MT_Extractor Destructor");
    if (topo_enabled)
    {
-     int i;
-     if (topo)
-     {
-        if (tiles_ok)
-          for (i=0;i<num_good;i++)  MT_RemAdjLinks(T_good[i]);
-        free(topo);  topo = NULL;
-     }
+     if (adj_slot) {  free(adj_slot); adj_slot = NULL;  }
+     if (adj_Arr) {  free(adj_Arr); adj_Arr = NULL;  }
      delete hash_table;
    } 
+   MT_SetVertexStars(0);
    if (N_set) {  free(N_set); N_set = NULL;  }
+   if (W_node) {  free(W_node); W_node = NULL;  }
+   if (W_arc) {  free(W_arc); W_arc = NULL;  }
    delete (A_front); A_front = NULL;
    num_good = num_tiles = 0;
    if (T_good)  {  free(T_good); T_good = NULL; T_bad = NULL;  }
@@ -346,7 +717,8 @@ MT_INDEX MT_ExtractorClass ::
          MT_AllExtractedTiles (MT_INDEX ** t_arr1, MT_INDEX * size1,
                                MT_INDEX ** t_arr2, MT_INDEX * size2)
 {
-  if (tiles_ok)
+  /* fill the arrays if the extraction has not done it */
+  if ( tiles_ok || MT_ExtractionCompleted() )
   { 
     (*t_arr1) = T_good;
     (*t_arr2) = T_bad;
@@ -366,7 +738,8 @@ MT_INDEX MT_ExtractorClass ::
 
 MT_INDEX MT_ExtractorClass :: MT_AllExtractedTiles (MT_INDEX ** t_arr)
 {
-  if (tiles_ok)
+  /* fill the arrays if the extraction has not done it */
+  if ( tiles_ok || MT_ExtractionCompleted() )
   { 
     (*t_arr) = T_good;
     return num_tiles;
@@ -384,8 +757,9 @@ MT_INDEX MT_ExtractorClass :: MT_AllExtractedTiles (MT_INDEX ** t_arr)
 
 int MT_ExtractorClass :: MT_IncludeNode (MT_INDEX n)
 {
-  MT_INDEX a; /* variable for arc */
-  MT_INDEX p; /* variable for parent node */
+  MT_INDEX a;   /* variable for arc */
+  MT_INDEX p;   /* variable for parent node */
+  MT_INDEX top; /* top of the work stack */
 
 /*************** TAPULLO PER CAD ************/
   /* se includendo questo nodo si sfora */
@@ -393,40 +767,59 @@ int MT_ExtractorClass :: MT_IncludeNode (MT_INDEX n)
 
   if (stat_enabled)  n_visited++;
 
-  a = mt->MT_FirstInArc(n);
-  while (a != MT_NULL_INDEX)
+  /* The parents of n not in the set must be included before n, and
+     so on for their parents. Instead of recursing, each node is kept
+     in the work stack with the next arc entering it, and it is included
+     when all such arcs have been examined. The order in which nodes
+     are included is the same as in a recursive visit. */
+  top = 0;
+  W_node[0] = n;
+  W_arc[0] = mt->MT_FirstInArc(n);
+  while (1)
   {
-    if (stat_enabled)  a_tested++;
+    n = W_node[top];
+    a = W_arc[top];
+    if (a != MT_NULL_INDEX)
+    {
+      if (stat_enabled)  a_tested++;
 
-    p = mt->MT_ArcSource(a);
+      p = mt->MT_ArcSource(a);
+      W_arc[top] = mt->MT_NextInArc(n,a);
+      if (!MT_IsInSet(p))
+      {
 /*************** TAPULLO PER CAD ************/
-//    if (!MT_IsInSet(p)) MT_IncludeNode(p);
-      if (!MT_IsInSet(p))  
-      {  int flag = MT_IncludeNode(p);
-         if (!flag) return 0;
-      }
+         if ((MT_INDEX)(num_tiles+2)>max_tile_num) return 0;
 /**************** FINE TAPULLO **************/
-      a = mt->MT_NextInArc(n,a);
-  }
+         if (stat_enabled)  n_visited++;
+         top++;
+         W_node[top] = p;
+         W_arc[top] = mt->MT_FirstInArc(p);
+      }
+      continue;
+    }
 
-  MT_AddToSet(n);
+    /* all parents of n are in the set */
+    MT_AddToSet(n);
 
-  a = mt->MT_FirstInArc(n);
-  while (a != MT_NULL_INDEX)
-  {
-    A_front->MT_RemElem(a);
-    MT_RemTiles(a);
-    a = mt->MT_NextInArc(n,a);
-  }
+    a = mt->MT_FirstInArc(n);
+    while (a != MT_NULL_INDEX)
+    {
+      A_front->MT_RemElem(a);
+      MT_RemTiles(a);
+      a = mt->MT_NextInArc(n,a);
+    }
   
-  a = mt->MT_FirstOutArc(n);
-  while (a != MT_NULL_INDEX)
-  {
-    A_front->MT_AddElem(a);
-    MT_AddTiles(a);
-    a = mt->MT_NextOutArc(n,a);
+    a = mt->MT_FirstOutArc(n);
+    while (a != MT_NULL_INDEX)
+    {
+      A_front->MT_AddElem(a);
+      MT_AddTiles(a);
+      a = mt->MT_NextOutArc(n,a);
+    }
+
+    if (top==0) return 1;
+    top--;
   }
-  return 1;
 }
 
 /* ------------------------------------------------------------------------ */
@@ -440,97 +833,16 @@ void MT_ExtractorClass :: MT_AddToSet(MT_INDEX n)
 /* ------------------------------------------------------------------------ */
 
 int MT_ExtractorClass :: MT_AddTiles (MT_INDEX a)
-{
-  if (stat_enabled)
-  {  a_infront++;
-     a_visited++;
-     t_visited += mt->MT_NumArcTiles(a);
-  }
-
-  tiles_ok = 0;
-  
-  if (topo_enabled)
-  {
-     MT_INDEX t, t1; /* variables for 
-     tiles */
-     int i1;
-//OTTOBRE     MT_INDEX * v;   /* for the vertices of t */
-     int i;
+{  return ( MT_AddArcTiles(a, mt_dim) );  }
 
-     /* set adjacency links for the tiles of a, 
-        since they are now inserted in the current tesselation */
-     t = mt->MT_FirstArcTile(a);
-     while (t != MT_NULL_INDEX)
-     {  
-//OTTOBRE        mt->MT_TileVertices(t,&v);
-        for (i=0; i<mt_dim; i++)
-        {  
-           if (hash_table->MT_HashGet(i,t,&i1,&t1))
-                 MT_SetAdjLink(t,t1,i,i1);
-           else
-           {
-           /*****fprintf(stderr,"Metto in tabella %d(%d)\n",t,i);***/
-                 hash_table->MT_HashPut(i,t);
-           }
-        }
-        t = mt->MT_NextArcTile(a,t);
-     }
-  }
-  num_tiles += mt->MT_NumArcTiles(a);
-  return 1;
-}
+int MT_ExtractorClass :: MT_RemTiles(MT_INDEX a)
+{  return ( MT_RemArcTiles(a, mt_dim) );  }
 
 /* ------------------------------------------------------------------------ */
 
-int MT_ExtractorClass :: MT_RemTiles(MT_INDEX a)
-{
-  if (stat_enabled)
-  {  a_infront--;
-     a_visited++;
-     t_visited += mt->MT_NumArcTiles(a);
-  }
-
-  tiles_ok = 0;
-
-  if (topo_enabled)
-  {
-    MT_INDEX t, t1, t2; /* variables for tiles */
-    int i1, i2;
-    MT_INDEX * v;   /* for the vertices of t */
-    int i;
-
-    /* collect the surviving adjacent tiles of the tiles of a, which
-       are now removed from the current tesselation */
-    t = mt->MT_FirstArcTile(a);
-    while (t != MT_NULL_INDEX)
-    {  
-       mt->MT_TileVertices(t,&v);
-       for (i=0; i<mt_dim; i++)
-       {  
-          if (!hash_table->MT_HashGet(i,t,&i2,&t2))
-          if ( t1 = MT_TileAdj(t,i) )
-          {
-             i1 = mt->MT_OppositeVertexPosition(t1, t, i);
-/***********/
-//fprintf(stderr,"  %d %d-o vert di %d\n",mt->MT_TileVertex(t,i),i1,t1);
-           hash_table->MT_HashPut(i1,t1);
-//fprintf(stderr,"  Metto in tabella %d(%d)\n",t1,i1);
-/************/
-          }
-       }
-       MT_RemAdjLinks(t);
-       t = mt->MT_NextArcTile(a,t);
-    }
-  }
-
-  num_tiles -= mt->MT_NumArcTiles(a);
-  return 1;
-}
-
-/* ------------------------------------------------------------------------ */
-
-int MT_ExtractorClass :: MT_ExtractionCompleted(void)
+int MT_ExtractorClass :: MT_ExtractionCompleted(void)
 {
+   MT_INDEX a;  /* variable for arc */
    MT_INDEX t;  /* variable for tile */
    int i, j;    /* array indices */
    
@@ -561,14 +873,11 @@ int MT_ExtractorClass :: MT_ExtractionCompleted(void)
        
    i = 0;
    j = num_tiles-1;
-   t = MT_FirstFrontTile();
-   while (t != MT_NULL_INDEX)
+   a = A_front->MT_FirstElem();
+   while (a != MT_NULL_INDEX)
    { 
-     if ( MT_FocusTile(t,MT_STRICT) )
-        T_good[i++] = t;
-     else
-        T_good[j--] = t;     
-     t = MT_NextFrontTile(t);
+     MT_PutArcTiles(a, &i, &j);
+     a = A_front->MT_NextElem(a);
    }
    num_good = i;
    if (num_good<num_tiles)
@@ -580,6 +889,29 @@ int MT_ExtractorClass :: MT_ExtractionCompleted(void)
    return 1;
 }
 
+void MT_ExtractorClass :: MT_PutArcTiles(MT_INDEX a, int * i, int * j)
+{
+   MT_INDEX t, t2, n, k; /* range of tiles of an arc */
+   unsigned char focus[MT_TILE_BATCH]; /* tiles in the focus set */
+
+   /* test the tiles of a together, in groups of MT_TILE_BATCH */
+   t = mt->MT_FirstArcTile(a);
+   t2 = mt->MT_LastArcTile(a);
+   for ( ; (t != MT_NULL_INDEX) && (t<=t2); t+=n)
+   {
+     n = t2-t+1;
+     if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+     MT_FocusTiles(t,t+n-1,MT_STRICT,focus);
+     for (k=0;k<n;k++)
+     {
+       if ( focus[k] )
+          T_good[(*i)++] = t+k;
+       else
+          T_good[(*j)--] = t+k;     
+     }
+   }
+}
+
 /* ------------------------------------------------------------------------ */
 /*                           EXTRACTION STATISTICS                          */
 /* ------------------------------------------------------------------------ */
@@ -589,6 +921,8 @@ void MT_ExtractorClass :: MT_ResetAllStat(void)
   n_visited = n_inset = n_tested = 0;
   a_visited = a_infront = a_tested = 0;
   t_visited = t_tested = 0;
+  p_hits = mt->MT_PageHits();
+  p_misses = mt->MT_PageMisses();
 }
 
 void MT_ExtractorClass :: MT_ResetAlgoStat(void)
@@ -596,6 +930,8 @@ void MT_ExtractorClass :: MT_ResetAlgoStat(void)
   n_visited = n_tested = 0;
   a_visited = a_tested = 0;
   t_visited = t_tested = 0;
+  p_hits = mt->MT_PageHits();
+  p_misses = mt->MT_PageMisses();
 }
 
 void MT_ExtractorClass :: MT_EnableStat(void)
@@ -608,10 +944,13 @@ void MT_ExtractorClass :: MT_EnableStat(void)
     for (i=1; i<=mt->MT_NodeNum(); i++)
     {  if (MT_IsInSet(i)) n_inset++;  }
     /* compute a_infront */
-    for (i=A_front->MT_FirstElem();
-         i!=MT_NULL_INDEX;
-         i=A_front->MT_NextElem(i)) 
-    {  a_infront++;  }
+    if (A_front)
+    {
+      for (i=A_front->MT_FirstElem();
+           i!=MT_NULL_INDEX;
+           i=A_front->MT_NextElem(i)) 
+      {  a_infront++;  }
+    }
     stat_enabled = 1;
   }
 }
@@ -645,6 +984,486 @@ MT_StaticExtractorClass :: ~MT_StaticExtractorClass()
    MT_Message((char *)"",(char *)"MT_StaticExtractor Destructor");
 }
 
+/* ------------------------------------------------------------------------ */
+/*                     GLOBAL PARALLEL STATIC EXTRACTOR                     */
+/* ------------------------------------------------------------------------ */
+
+/*
+Passes of the jobs: count the front arcs leaving each range of nodes,
+put them in array P_arc, test the tiles of each range of front arcs
+against the focus condition, put such tiles in the array of extracted
+tiles.
+If adjacency generation is enabled, further passes give an adjacency
+slot to each range of extracted tiles and compute the keys of their
+facets, count the values of the current digit of each range of keys
+and move the keys in order of that digit (once for each digit), link
+the tiles of the facets in each range of the sorted keys.
+*/
+#define MT_COUNT_PASS 0
+#define MT_FILL_PASS  1
+#define MT_FOCUS_PASS 2
+#define MT_TILE_PASS  3
+#define MT_SLOT_PASS  4
+#define MT_DIGIT_PASS 5
+#define MT_SORT_PASS  6
+#define MT_LINK_PASS  7
+
+/*
+Key of the facet of tile vertices v opposite to the i-th one, mixing
+the same hints used by the hash table of extractors (see mt_hash.h).
+*/
+static MT_INDEX MT_FacetKeyOf(MT_INDEX * v, int dim, int i)
+{
+  MT_INDEX sum_v = 0, min_v = v[(i+1)%dim], max_v = min_v;
+  unsigned long h;
+  int j;
+
+  for (j=0; j<dim; j++)
+  {  if (j==i) continue;
+     sum_v += v[j];
+     if (v[j]<min_v) min_v = v[j];
+     if (v[j]>max_v) max_v = v[j];
+  }
+  h = (unsigned long)min_v * 0x9E3779B1UL
+      ^ (unsigned long)max_v * 0x85EBCA77UL
+      ^ (unsigned long)sum_v * 0xC2B2AE3DUL;
+  h ^= (h >> 16);
+  return ( (MT_INDEX)h );
+}
+
+/*
+Return 1 if the facet of tile vertices v1 opposite to the i1-th one
+has the same vertices as the facet of v2 opposite to the i2-th one.
+*/
+static int MT_SameFacetOf(MT_INDEX * v1, int i1, MT_INDEX * v2, int i2,
+                          int dim)
+{
+  int i, j, found;
+
+  for (i=0; i<dim; i++)
+  {
+    if (i==i1) continue;
+    found = 0;
+    for (j=0; (!found) && (j<dim); j++)
+    {  if ( (j!=i2) && (v2[j]==v1[i]) ) found = 1;  }
+    if (!found) return 0;
+  }
+  return 1;
+}
+
+void MT_ParallelSweepTask (void * data, MT_TaskPool pool,
+                           int worker, MT_INDEX n)
+{  ((MT_ParallelExtractor) data)->MT_SweepNode(pool,worker,n);  }
+
+void MT_ParallelJobTask (void * data, int job)
+{  ((MT_ParallelExtractor) data)->MT_ParallelJob(job);  }
+
+void MT_ParallelExtractorClass :: 
+     MT_SweepNode (MT_TaskPool pool, int worker, MT_INDEX n)
+{
+  MT_INDEX a;  /* variable for arc */
+  MT_INDEX p;  /* variable for parent or child node */
+  MT_INDEX a_num = 0, t_num = 0; /* arcs and tiles tested */
+
+  /* add the parents of n */
+  a = mt->MT_FirstInArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    a_num++;
+    p = mt->MT_ArcSource(a);
+    if ( MT_MarkOnce(&N_set[p], extr_count) )
+       MT_PushTask(pool, worker, p);
+    a = mt->MT_NextInArc(n,a);
+  }
+
+  /* add the children of n reached by arcs that must be refined, 
+     as in MT_ExpandExtractor */
+  a = mt->MT_FirstOutArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    p = mt->MT_ArcDest(a);
+    if ( (!MT_IsInSet(p)) && mt->MT_IsLoaded(p) )
+    {
+      a_num++;
+      if ( MT_RefineArc(a, &t_num) && MT_MarkOnce(&N_set[p], extr_count) )
+         MT_PushTask(pool, worker, p);
+    }
+    a = mt->MT_NextOutArc(n,a);
+  }
+
+  if (stat_enabled)
+  {
+    P_stat[worker][0]++;
+    P_stat[worker][1] += a_num;
+    P_stat[worker][2] += t_num;
+  }
+}
+
+void MT_ParallelExtractorClass :: MT_ParallelJob (int job)
+{
+  MT_INDEX a;      /* variable for arc */
+  MT_INDEX t;      /* variable for tile */
+  MT_INDEX n, n1, n2; /* range of nodes of the job */
+  MT_INDEX i;      /* index in P_arc */
+  MT_INDEX k, j;   /* positions of tiles */
+  MT_INDEX count = 0;
+  MT_INDEX * v, * v1;  /* tile vertices */
+  MT_INDEX c, c1;  /* coded facets */
+  MT_INDEX q;      /* position of facet key */
+  int h;
+
+  switch (P_pass)
+  {
+    case MT_COUNT_PASS:
+    case MT_FILL_PASS:
+      /* front arcs are the arcs from a node in the set to a node 
+         not in the set */
+      n1 = 1 + (MT_INDEX) ( (double)mt->MT_NodeNum() * job / P_job_num );
+      n2 = 1 + (MT_INDEX) ( (double)mt->MT_NodeNum() * (job+1) / P_job_num );
+      i = P_first[job];
+      for (n=n1; n<n2; n++)
+      {
+        if (!MT_IsInSet(n)) continue;
+        a = mt->MT_FirstOutArc(n);
+        while (a != MT_NULL_INDEX)
+        {
+          if (!MT_IsInSet(mt->MT_ArcDest(a)))
+          {
+            if (P_pass == MT_FILL_PASS)  P_arc[i++] = a;
+            else count++;
+          }
+          a = mt->MT_NextOutArc(n,a);
+        }
+      }
+      if (P_pass == MT_COUNT_PASS)  P_first[job] = count;
+      break;
+
+    case MT_FOCUS_PASS:
+      k = P_tile[job];
+      for (i=P_first[job]; i<P_first[job+1]; i++)
+      {
+        t = mt->MT_FirstArcTile(P_arc[i]);
+        if (t == MT_NULL_INDEX)  continue;
+        j = mt->MT_LastArcTile(P_arc[i]);
+        count += MT_FocusTiles(t,j,MT_STRICT,&P_active[k]);
+        k += j-t+1;
+      }
+      P_good[job] = count;
+      break;
+
+    case MT_TILE_PASS:
+      /* as in MT_ExtractionCompleted, active tiles are put forward from
+         the beginning of the array, non-active ones backward from the end */
+      k = P_good[job];
+      j = num_tiles - 1 - (P_tile[job] - P_good[job]);
+      count = P_tile[job];
+      for (i=P_first[job]; i<P_first[job+1]; i++)
+      {
+        t = mt->MT_FirstArcTile(P_arc[i]);
+        while (t != MT_NULL_INDEX)
+        {
+          if ( (!place_cnd) || P_active[count] )  T_good[k++] = t;
+          else  T_good[j--] = t;
+          count++;
+          t = mt->MT_NextArcTile(P_arc[i],t);
+        }
+      }
+      break;
+
+    case MT_SLOT_PASS:
+      n1 = (MT_INDEX) ( (double)num_tiles * job / P_job_num );
+      n2 = (MT_INDEX) ( (double)num_tiles * (job+1) / P_job_num );
+      for (k=n1; k<n2; k++)
+      {
+        t = T_good[k];
+        adj_slot[t] = k+1;
+        v = mt->MT_TileVertices(t);
+        for (h=0; h<mt_dim; h++)
+        {  adj_Arr[(k+1)*mt_dim+h] = MT_NULL_INDEX;
+           P_key[k*mt_dim+h].my_key = MT_FacetKeyOf(v, mt_dim, h);
+           P_key[k*mt_dim+h].my_code = (k+1)*mt_dim+h;
+        }
+      }
+      break;
+
+    case MT_DIGIT_PASS:
+    case MT_SORT_PASS:
+      /* stable, thus keys with the same digit stay in the order 
+         given by the previous digits */
+      n = num_tiles*mt_dim;
+      n1 = (MT_INDEX) ( (double)n * job / P_job_num );
+      n2 = (MT_INDEX) ( (double)n * (job+1) / P_job_num );
+      v = &P_digit[job*MT_RADIX_SIZE];
+      if (P_pass == MT_DIGIT_PASS)
+      {  for (h=0; h<MT_RADIX_SIZE; h++)  v[h] = 0;
+         for (i=n1; i<n2; i++)  
+           v[(P_key[i].my_key >> P_shift) & (MT_RADIX_SIZE-1)]++;
+      }
+      else
+      {  for (i=n1; i<n2; i++)
+           P_key_aux[v[(P_key[i].my_key >> P_shift) & (MT_RADIX_SIZE-1)]++]
+              = P_key[i];
+      }
+      break;
+
+    case MT_LINK_PASS:
+      /* a group of equal keys is scanned by the job where it starts */
+      n = num_tiles*mt_dim;
+      n1 = (MT_INDEX) ( (double)n * job / P_job_num );
+      n2 = (MT_INDEX) ( (double)n * (job+1) / P_job_num );
+      while ( (n1>0) && (n1<n2) && (P_key[n1].my_key==P_key[n1-1].my_key) )
+        n1++;
+      for (i=n1; i<n2; i=j)
+      {
+        for (j=i+1; (j<n) && (P_key[j].my_key==P_key[i].my_key); j++);
+        /* link each facet of the group to another with the same 
+           vertices, and mark both as linked by a null key code */
+        for (k=i; k<j; k++)
+        {
+          if ( (c = P_key[k].my_code) == MT_NULL_INDEX )  continue;
+          v = mt->MT_TileVertices(T_good[c/mt_dim-1]);
+          for (q=k+1; q<j; q++)
+          {
+            if ( (c1 = P_key[q].my_code) == MT_NULL_INDEX )  continue;
+            v1 = mt->MT_TileVertices(T_good[c1/mt_dim-1]);
+            if (MT_SameFacetOf(v, c%mt_dim, v1, c1%mt_dim, mt_dim))
+            {  adj_Arr[c] = T_good[c1/mt_dim-1];
+               adj_Arr[c1] = T_good[c/mt_dim-1];
+               P_key[q].my_code = MT_NULL_INDEX;
+               break;
+            }
+          }
+        }
+      }
+      break;
+  }
+}
+
+int MT_ParallelExtractorClass :: MT_ParallelExpand (void)
+{
+  MT_INDEX i, j, k;
+  int w;
+
+  MT_ClearExtractor();
+  if (stat_enabled)
+  {  for (w=0; w<MT_MAX_THREADS; w++)
+        P_stat[w][0] = P_stat[w][1] = P_stat[w][2] = 0;
+  }
+
+  /* find the set of nodes above the front */
+  N_set[mt->MT_Root()] = extr_count;
+  if (!MT_RunTasks(mt->MT_Root(), MT_ParallelSweepTask, this))
+  {  MT_Error((char *)"Allocation failed",
+              (char *)"MT_ParallelExtractorClass::MT_ParallelExpand");
+     return 0;
+  }
+  if (stat_enabled)
+  {  for (w=0; w<MT_MAX_THREADS; w++)
+     {  n_visited += P_stat[w][0];
+        a_tested += P_stat[w][1];
+        t_tested += P_stat[w][2];
+     }
+     n_inset = n_visited;
+  }
+
+  /* find the front arcs */
+  P_job_num = MT_TheThreadNum() * MT_JOBS_PER_THREAD;
+  if ((MT_INDEX)P_job_num > mt->MT_NodeNum())  P_job_num = mt->MT_NodeNum();
+  P_pass = MT_COUNT_PASS;
+  MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+  k = 0;
+  for (w=0; w<P_job_num; w++)
+  {  i = P_first[w];
+     P_first[w] = k;
+     k += i;
+  }
+  P_first[P_job_num] = k;
+  P_pass = MT_FILL_PASS;
+  MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+
+  /* build the front, adjacency links are set by MT_ParallelAdjLinks */
+  for (w=0; w<P_job_num; w++)
+  {
+    P_tile[w] = num_tiles;
+    for (j=P_first[w]; j<P_first[w+1]; j++)
+    {
+      A_front->MT_AddElem(P_arc[j]);
+      if (!topo_enabled)
+      {  MT_AddTiles(P_arc[j]);  continue;  }
+      if (stat_enabled)
+      {  a_infront++;
+         a_visited++;
+         t_visited += mt->MT_NumArcTiles(P_arc[j]);
+      }
+      if ( star_enabled && (!MT_AddStarTiles(P_arc[j])) )
+         MT_SetVertexStars(0);
+      num_tiles += mt->MT_NumArcTiles(P_arc[j]);
+    }
+  }
+  P_tile[P_job_num] = num_tiles;
+  return 1;
+}
+
+int MT_ParallelExtractorClass :: MT_ParallelCompleted (void)
+{
+   MT_INDEX t;  /* variable for tile */
+   int i;
+   
+   if (topo_enabled)
+   {
+     /* empty the hash table */
+     while (hash_table->MT_HashPop(&i,&t));
+   }
+
+   if (T_good) free(T_good);
+   T_good = (MT_INDEX *) calloc ( num_tiles+1, sizeof(MT_INDEX) );
+   if (place_cnd && (P_active_size < (MT_INDEX)num_tiles) )
+   {
+     if (P_active) free(P_active);
+     P_active = (unsigned char *) malloc ( num_tiles );
+     P_active_size = (P_active ? num_tiles : 0);
+   }
+   if ( (!T_good) || (place_cnd && !P_active) )
+   {
+     MT_Error((char *)"Allocation failed", 
+              (char *)"MT_ParallelExtractorClass::MT_ParallelCompleted");
+     return 0;
+   }
+
+   num_good = num_tiles;
+   if (place_cnd)
+   {
+     P_pass = MT_FOCUS_PASS;
+     MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+     num_good = 0;
+     for (i=0; i<P_job_num; i++)
+     {  t = P_good[i];
+        P_good[i] = num_good;
+        num_good += t;
+     }
+   }
+   else
+   {
+     for (i=0; i<P_job_num; i++)  P_good[i] = P_tile[i];
+   }
+   P_pass = MT_TILE_PASS;
+   MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+   if ( topo_enabled && (!MT_ParallelAdjLinks()) )  return 0;
+   if (num_good<num_tiles)
+      T_bad = T_good + num_good;
+   else 
+      T_bad = NULL;
+   tiles_ok = 1;
+   return 1;
+}
+
+int MT_ParallelExtractorClass :: MT_ParallelAdjLinks (void)
+{
+   MT_INDEX n = num_tiles*mt_dim; /* number of facets */
+   MT_INDEX c, k;
+   MT_FacetKey * aux;
+   int w, h;
+
+   if (P_key_size < n)
+   {
+     if (P_key) free(P_key);
+     if (P_key_aux) free(P_key_aux);
+     P_key = (MT_FacetKey *) malloc ( n*sizeof(MT_FacetKey) );
+     P_key_aux = (MT_FacetKey *) malloc ( n*sizeof(MT_FacetKey) );
+     P_key_size = ( (P_key && P_key_aux) ? n : 0 );
+   }
+   if ( (!P_key_size && n) || (!MT_GrowAdjSlots(num_tiles)) )
+   {
+     MT_Error((char *)"Allocation failed", 
+              (char *)"MT_ParallelExtractorClass::MT_ParallelAdjLinks");
+     return 0;
+   }
+
+   /* the extractor has been cleared, thus no slot is in use, and the
+      tile in position k of T_good gets slot k+1 */
+   slot_top = slot_used = num_tiles;
+   slot_free = 0;
+   P_pass = MT_SLOT_PASS;
+   MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+
+   /* radix sort of the keys, skipping the digits that are equal
+      for all keys */
+   for (P_shift=0; P_shift<(int)(8*sizeof(MT_INDEX)); P_shift+=MT_RADIX_BITS)
+   {
+     P_pass = MT_DIGIT_PASS;
+     MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+     for (h=0; h<MT_RADIX_SIZE; h++)
+     {  c = 0;
+        for (w=0; w<P_job_num; w++)  c += P_digit[w*MT_RADIX_SIZE+h];
+        if (c==n)  break;
+     }
+     if (h<MT_RADIX_SIZE)  continue;
+     c = 0;
+     for (h=0; h<MT_RADIX_SIZE; h++)
+     for (w=0; w<P_job_num; w++)
+     {  k = P_digit[w*MT_RADIX_SIZE+h];
+        P_digit[w*MT_RADIX_SIZE+h] = c;
+        c += k;
+     }
+     P_pass = MT_SORT_PASS;
+     MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+     aux = P_key;  P_key = P_key_aux;  P_key_aux = aux;
+   }
+
+   P_pass = MT_LINK_PASS;
+   MT_RunJobs(P_job_num, MT_ParallelJobTask, this);
+   return 1;
+}
+
+MT_INDEX MT_ParallelExtractorClass :: MT_ExtractTesselation( void )
+{
+  if ( (MT_TheThreadNum()<2) || mt->MT_IsPaged() ||
+       (max_tile_num<mt->MT_TileNum()) || 
+       (!MT_ParallelExpand()) || (!MT_ParallelCompleted()) )
+  {
+    /* serial algorithm */
+    return MT_StaticExtractorClass::MT_ExtractTesselation();
+  }
+  return MT_ExtractedTilesNum();
+}
+
+MT_ParallelExtractorClass :: 
+MT_ParallelExtractorClass(MT_MultiTesselation m, int topo_flag)
+: MT_StaticExtractorClass(m,topo_flag)
+{
+   MT_Message((char *)"",(char *)"MT_ParallelExtractor Constructor");
+   P_arc = (MT_INDEX *) malloc ( (mt->MT_ArcNum()+1)*sizeof(MT_INDEX) );
+   if (!P_arc)
+   {
+     MT_FatalError((char *)"Allocation failed",(char *)"MT_ParallelExtractor Constructor");
+   }
+   P_active = NULL;
+   P_active_size = 0;
+   P_job_num = 0;
+   P_key = P_key_aux = NULL;
+   P_key_size = 0;
+   P_digit = NULL;
+   if (topo_enabled)
+   {
+     P_digit = (MT_INDEX *) malloc ( MT_MAX_THREADS*MT_JOBS_PER_THREAD*
+                                     MT_RADIX_SIZE*sizeof(MT_INDEX) );
+     if (!P_digit)
+     {
+       MT_FatalError((char *)"Allocation failed",(char *)"MT_ParallelExtractor Constructor");
+     }
+   }
+}
+
+MT_ParallelExtractorClass :: ~MT_ParallelExtractorClass()  
+{
+   MT_Message((char *)"",(char *)"MT_ParallelExtractor Destructor");
+   if (P_arc)  {  free(P_arc); P_arc = NULL;  }
+   if (P_active)  {  free(P_active); P_active = NULL;  }
+   if (P_key)  {  free(P_key); P_key = NULL;  }
+   if (P_key_aux)  {  free(P_key_aux); P_key_aux = NULL;  }
+   if (P_digit)  {  free(P_digit); P_digit = NULL;  }
+}
+
 /* ------------------------------------------------------------------------ */
 /*                          GLOBAL DYNAMIC EXTRACTOR                        */
 /* ------------------------------------------------------------------------ */
@@ -692,6 +1511,18 @@ void MT_DynamicExtractorClass :: MT_RemFromSet(MT_INDEX n)
    N_free->MT_RemElem(n); /* n is no more a leaf */
 }
 
+int MT_DynamicExtractorClass :: MT_AddTiles(MT_INDEX a)
+{
+   if (delta_enabled)  MT_MoveArc(a);
+   return ( MT_AddArcTiles(a, mt_dim) );
+}
+
+int MT_DynamicExtractorClass :: MT_RemTiles(MT_INDEX a)
+{
+   if (delta_enabled)  MT_MoveArc(a);
+   return ( MT_RemArcTiles(a, mt_dim) );
+}
+
 /* ----------------------------------------------------------------------- */
 
 int MT_DynamicExtractorClass :: MT_ExcludeNode (MT_INDEX n)
@@ -723,10 +1554,13 @@ int MT_DynamicExtractorClass :: MT_ExcludeNode (MT_INDEX n)
 
 int MT_DynamicExtractorClass :: MT_ContractExtractor (void)
 {
-  MT_INDEX n;    /* variable for node */ 
-  MT_INDEX t;    /* variable for tile */
-  int flag;      /* boolean control variable */
+  MT_ContractInit();
+  while (MT_ContractLeaf());
+  return 1;
+}
 
+void MT_DynamicExtractorClass :: MT_ContractInit (void)
+{
   if ( (N_free->MT_CurrElem(2) != N_free->MT_CurrElem(1)) && /* GENNAIO */
        (N_free->MT_FirstElem() == N_free->MT_CurrElem(1)) )
      /* if the first of N_free is one of those added in expansion,
@@ -734,42 +1568,51 @@ int MT_DynamicExtractorClass :: MT_ContractExtractor (void)
   {  N_free->MT_CurrFlush(0); N_free->MT_CurrAdvance(0);  }
   else
   {  N_free->MT_CurrInit(0);  }
-  
-  while (N_free->MT_CurrElem(0) != MT_NULL_INDEX)
-  {
-    n = N_free->MT_CurrElem(0);
+}
 
-    if (stat_enabled)  n_tested++;
-    if (N_free->MT_CurrElem(0) == N_free->MT_CurrElem(1))
-       /* if the next node is one of those added during expansion, then
-          jump to the first node added in contraction stage */
-    {  N_free->MT_CurrReach(0,2); N_free->MT_CurrAdvance(0);  }
-    else
-    {  N_free->MT_CurrAdvance(0);  }
-    if (n != mt->MT_Root() )
-    {
-      /* Check the tiles of the interference set of n (the tiles removed by
-         n) to see if n can be simplified. flag == 1 iff all such tiles are
-         feasible for the resolution condition. */
-      flag = 1;
-      t = mt->MT_FirstRemovedTile(n);
-      while (flag && (t != MT_NULL_INDEX))
-      {
-         if (stat_enabled)  t_tested++;
- 
-         flag = ( (!MT_FocusTile(t,MT_LOOSE))
-                   || 
-                   MT_FilterTile(t,MT_LOOSE) );
-              /* flag becomes == 0 if t is not feasible */
-         t = mt->MT_NextRemovedTile(n,t);
-      }
-      /* if flag == 1, then simplify */
-      if ( flag )  MT_ExcludeNode(n);
-    }
+int MT_DynamicExtractorClass :: MT_ContractLeaf (void)
+{
+  MT_INDEX n;    /* variable for node */ 
+  MT_INDEX tn;   /* number of tiles tested on the arcs entering n */
+  int flag;      /* boolean control variable */
+
+  if (N_free->MT_CurrElem(0) == MT_NULL_INDEX)  return 0;
+  n = N_free->MT_CurrElem(0);
+
+  if (stat_enabled)  n_tested++;
+  if (N_free->MT_CurrElem(0) == N_free->MT_CurrElem(1))
+     /* if the next node is one of those added during expansion, then
+        jump to the first node added in contraction stage */
+  {  N_free->MT_CurrReach(0,2); N_free->MT_CurrAdvance(0);  }
+  else
+  {  N_free->MT_CurrAdvance(0);  }
+  if (n != mt->MT_Root() )
+  {
+    /* Check the tiles of the interference set of n (the tiles removed by
+       n) to see if n can be simplified. flag == 1 iff all such tiles are
+       feasible for the resolution condition. */
+    tn = 0;
+    flag = !MT_KeepLeaf(n, &tn);
+    if (stat_enabled)  t_tested += tn;
+    /* if flag == 1, then simplify */
+    if ( flag )  MT_ExcludeNode(n);
   }
   return 1;
 }
 
+int MT_DynamicExtractorClass :: MT_KeepLeaf (MT_INDEX n, MT_INDEX * tested)
+{
+  MT_INDEX a;    /* variable for arc */
+
+  /* removed tiles are those labelling the arcs entering n */
+  for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX;
+       a = mt->MT_NextInArc(n,a))
+  {
+    if (MT_RefineArc(a, tested))  return 1;
+  }
+  return 0;
+}
+
 /* --------------------------------------------------------------------------- */
 
 MT_INDEX MT_DynamicExtractorClass :: MT_ExtractTesselation (void)
@@ -793,29 +1636,232 @@ MT_INDEX MT_DynamicExtractorClass :: MT_ExtractTesselation (void)
   N_free->MT_CurrFlush(2);   
   /* 2) Contraction */
   MT_ContractExtractor();
+  /* a sliced extraction in progress has been completed */
+  slice_stage = MT_SLICE_DONE;
+  if (delta_enabled)
+  {
+    /* update the buffer with the tiles of the arcs that have moved */
+    MT_DeltaCompleted();
+    return MT_AllExtractedTilesNum();
+  }
   /* copy the extracted tiles in the array */
   MT_ExtractionCompleted();
   return MT_ExtractedTilesNum();
 }
 
+/* ------------------------------------------------------------------------ */
+/*                          Time-sliced extraction                          */
 /* ------------------------------------------------------------------------ */
 
-MT_DynamicExtractorClass :: 
-MT_DynamicExtractorClass(MT_MultiTesselation m, int topo_flag)
-: MT_ExtractorClass(m,topo_flag)
+MT_INDEX MT_DynamicExtractorClass :: MT_ExtractSlice (void)
 {
-   MT_Message((char *)"",(char *)"MT_DynamicExtractor Constructor");
+  MT_INDEX k;    /* number of steps done by this slice */
+  double start;  /* starting time of this slice */
 
-   /* create N_free as a list with three cursors */
-   N_free = new MT_ListClass(mt->MT_NodeNum()+1,3);
-   if ( !N_free )
-   {
-      MT_FatalError((char *)"Allocation failed",(char *)"MT_DynamicExtractor Constructor");
-   }
+  if (slice_stage == MT_SLICE_DONE)
+  {
+    /* start a new extraction, setting the cursors as in 
+       MT_ExtractTesselation */
+    if (stat_enabled)  MT_ResetAlgoStat();
+    N_free->MT_CurrFlush(1); 
+    A_front->MT_CurrInit(0);
+    slice_arcs = slice_leaves = 0;
+    slice_stage = MT_SLICE_EXPAND;
+  }
+  start = ( (slice_time > 0.0) ? MT_WallTime() : 0.0 );
+  k = 0;
+  while (slice_stage != MT_SLICE_DONE)
+  {
+    /* stop when the limits are reached, after at least one step */
+    if ( (slice_steps > 0) && (k >= slice_steps) )  break;
+    if ( (slice_time > 0.0) && (k > 0) && (k % MT_SLICE_CHECK == 0) &&
+         (MT_WallTime() - start >= slice_time) )  break;
+    if (slice_stage == MT_SLICE_EXPAND)
+    {
+      /* 1) Expansion, one front arc at a time */
+      if (MT_AdvanceFrontArc())  slice_arcs++;
+      else
+      {
+        N_free->MT_CurrFlush(2);   
+        MT_ContractInit();
+        slice_stage = MT_SLICE_CONTRACT;
+        continue;
+      }
+    }
+    else
+    {
+      /* 2) Contraction, one leaf at a time */
+      if (MT_ContractLeaf())  slice_leaves++;
+      else
+      {
+        slice_stage = MT_SLICE_DONE;
+        continue;
+      }
+    }
+    k++;
+  }
+  /* the front is consistent after each step, take the extracted
+     tiles from it */
+  if (delta_enabled)
+  {
+    MT_DeltaCompleted();
+    return MT_AllExtractedTilesNum();
+  }
+  MT_ExtractionCompleted();
+  return MT_ExtractedTilesNum();
+}
 
-   /* set an initial state */
-   MT_ResetAllStat();
-   MT_IncludeNode(mt->MT_Root());
+float MT_DynamicExtractorClass :: MT_SliceProgress (void)
+{
+  MT_INDEX i;        /* variable for arc or node */
+  MT_INDEX todo = 0; /* arcs and leaves still to be tested */
+  
+  if (slice_stage == MT_SLICE_DONE)  return 1.0;
+  if (slice_stage == MT_SLICE_EXPAND)
+  {
+    /* the front arcs after cursor 0, and all leaves for the contraction */
+    for (i = A_front->MT_CurrElem(0); i != MT_NULL_INDEX; 
+         i = A_front->MT_NextElem(i))
+    {  todo++;  }
+    i = N_free->MT_FirstElem();
+  }
+  else
+    i = N_free->MT_CurrElem(0);
+  for ( ; i != MT_NULL_INDEX; i = N_free->MT_NextElem(i))
+  {  todo++;  }
+  if (slice_arcs + slice_leaves + todo == 0)  return 0.0;
+  return ( (float)(slice_arcs + slice_leaves) / 
+           (float)(slice_arcs + slice_leaves + todo) );
+}
+
+/* ------------------------------------------------------------------------ */
+/*                  Changes of the extracted tesselation                    */
+/* ------------------------------------------------------------------------ */
+
+void MT_DynamicExtractorClass :: MT_DeltaCompleted(void)
+{
+   MT_INDEX a;      /* variable for arc */
+   MT_INDEX t, t1;  /* variables for tile */
+   MT_INDEX p;      /* position in D_tiles */
+   MT_INDEX k;      /* index in D_arcs */
+   MT_INDEX last = mt->MT_TileNum()-1; /* last position of D_change */
+   int i;
+
+   if (topo_enabled)
+   {
+     /* empty the hash table, as MT_ExtractionCompleted */
+     while (hash_table->MT_HashPop(&i,&t));
+   }
+   D_added = D_removed = 0;
+   for (k=0; k<D_arcnum; k++)
+   {
+     a = D_arcs[k];
+     A_moved[a] = 0;
+     /* an arc that has entered and left the front (or conversely) 
+        in this extraction does not change the tesselation */
+     if ( A_front->MT_IsInList(a) == A_inbuf[a] )  continue;
+     A_inbuf[a] = !A_inbuf[a];
+     for (t = mt->MT_FirstArcTile(a); t != MT_NULL_INDEX; 
+          t = mt->MT_NextArcTile(a,t))
+     {
+       if (A_inbuf[a])
+       {
+         D_pos[t] = D_num;
+         D_tiles[D_num++] = t;
+         D_change[D_added++] = t;
+       }
+       else
+       {
+         /* move the last tile of the buffer in place of t */
+         p = D_pos[t];
+         t1 = D_tiles[--D_num];
+         D_tiles[p] = t1;
+         D_pos[t1] = p;
+         D_change[last - (D_removed++)] = t;
+       }
+     }
+   }
+   D_arcnum = 0;
+}
+
+int MT_DynamicExtractorClass :: MT_EnableDelta(void)
+{
+   MT_INDEX a;  /* variable for arc */
+   MT_INDEX t;  /* variable for tile */
+
+   if (delta_enabled)  return 1;
+   D_tiles = (MT_INDEX *) malloc ( mt->MT_TileNum()*sizeof(MT_INDEX) );
+   D_pos = (MT_INDEX *) malloc ( (mt->MT_TileNum()+1)*sizeof(MT_INDEX) );
+   D_change = (MT_INDEX *) malloc ( mt->MT_TileNum()*sizeof(MT_INDEX) );
+   D_arcs = (MT_INDEX *) malloc ( (mt->MT_ArcNum()+1)*sizeof(MT_INDEX) );
+   A_moved = 
+      (unsigned char *) calloc ( mt->MT_ArcNum()+1, sizeof(unsigned char) );
+   A_inbuf = 
+      (unsigned char *) calloc ( mt->MT_ArcNum()+1, sizeof(unsigned char) );
+   if ( !(D_tiles && D_pos && D_change && D_arcs && A_moved && A_inbuf) )
+   {
+     MT_Error((char *)"Allocation failed", 
+              (char *)"MT_DynamicExtractorClass::MT_EnableDelta");
+     MT_DisableDelta();
+     return 0;
+   }
+   /* fill the buffer with the current tesselation */
+   D_num = D_added = D_removed = D_arcnum = 0;
+   for (a = A_front->MT_FirstElem(); a != MT_NULL_INDEX; 
+        a = A_front->MT_NextElem(a))
+   {
+     A_inbuf[a] = 1;
+     for (t = mt->MT_FirstArcTile(a); t != MT_NULL_INDEX; 
+          t = mt->MT_NextArcTile(a,t))
+     {
+       D_pos[t] = D_num;
+       D_tiles[D_num++] = t;
+     }
+   }
+   delta_enabled = 1;
+   return 1;
+}
+
+void MT_DynamicExtractorClass :: MT_DisableDelta(void)
+{
+   if (D_tiles)  {  free(D_tiles); D_tiles = NULL;  }
+   if (D_pos)  {  free(D_pos); D_pos = NULL;  }
+   if (D_change)  {  free(D_change); D_change = NULL;  }
+   if (D_arcs)  {  free(D_arcs); D_arcs = NULL;  }
+   if (A_moved)  {  free(A_moved); A_moved = NULL;  }
+   if (A_inbuf)  {  free(A_inbuf); A_inbuf = NULL;  }
+   D_num = D_added = D_removed = D_arcnum = 0;
+   delta_enabled = 0;
+}
+
+/* ------------------------------------------------------------------------ */
+
+MT_DynamicExtractorClass :: 
+MT_DynamicExtractorClass(MT_MultiTesselation m, int topo_flag)
+: MT_ExtractorClass(m,topo_flag)
+{
+   MT_Message((char *)"",(char *)"MT_DynamicExtractor Constructor");
+
+   /* create N_free as a list with three cursors */
+   N_free = new MT_ListClass(mt->MT_NodeNum()+1,3);
+   if ( !N_free )
+   {
+      MT_FatalError((char *)"Allocation failed",(char *)"MT_DynamicExtractor Constructor");
+   }
+   /* delta mode disabled */
+   delta_enabled = 0;
+   D_tiles = D_pos = D_change = D_arcs = NULL;
+   A_moved = A_inbuf = NULL;
+   D_num = D_added = D_removed = D_arcnum = 0;
+   /* no sliced extraction in progress, and no limits on slices */
+   slice_stage = MT_SLICE_DONE;
+   slice_steps = 0;
+   slice_time = 0.0;
+   slice_arcs = slice_leaves = 0;
+
+   /* set an initial state */
+   MT_ResetAllStat();
+   MT_IncludeNode(mt->MT_Root());
    MT_ExtractionCompleted();
 }
 
@@ -824,6 +1870,7 @@ MT_DynamicExtractorClass :: ~MT_DynamicExtractorClass(void)
    MT_Message((char *)"",(char *)"MT_DynamicExtractor Destructor");
    /* deallocate the additional fields */
    delete (N_free);
+   MT_DisableDelta();
 }
 
 /* ------------------------------------------------------------------------ */
@@ -832,70 +1879,98 @@ MT_DynamicExtractorClass :: ~MT_DynamicExtractorClass(void)
 
 int MT_LocalExtractorClass :: MT_FocusArc(MT_INDEX a)
 {
-   MT_INDEX t;
+   unsigned char focus[MT_TILE_BATCH]; /* tiles in the focus set */
+   MT_INDEX t, t2, n;  /* range of tiles */
+   int box;            /* result of the box test */
    int flag = 0;
    
    /* check whether the result of the test is already known on a */
    if (MT_HintYes(a)) return 1;
    if (MT_HintNot(a)) return 0;
-   /* if not known, look at the tiles of arc a */
-   for (t = mt->MT_FirstArcTile(a); 
-        ( (t != MT_NULL_INDEX) && !flag );
-        t = mt->MT_NextArcTile(a,t))
+   /* if not known, look at the tiles of arc a, in groups of 
+      MT_TILE_BATCH */
+   t = mt->MT_FirstArcTile(a);
+   if (t == MT_NULL_INDEX) return 0;
+   t2 = mt->MT_LastArcTile(a);
+   /* the box of arc a may decide the test without looking at its tiles */
+   box = MT_FocusArcBox(a);
+   if (box == MT_BOX_IN) flag = 1;
+   for ( ; (box == MT_BOX_CROSS) && (t<=t2) && !flag; t+=n)
    {
-      if (stat_enabled)  t_tested++;
+      n = t2-t+1;
+      if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+      if (stat_enabled)  t_tested += n;
 
-      flag = (MT_FocusTile(t,MT_LOOSE));
-      /* record the computed result */
-      if (flag) A_pos[a] = extr_count; else A_neg[a] = extr_count;
+      flag = ( MT_FocusTiles(t,t+n-1,MT_LOOSE,focus) > 0 );
    }
+   /* record the computed result */
+   if (flag) A_pos[a] = extr_count; else A_neg[a] = extr_count;
    return flag;
 }
 
 int MT_LocalExtractorClass :: MT_IncludeNode (MT_INDEX n)
 {
-  MT_INDEX a; /* variable for arc */
-  MT_INDEX p; /* variable for parent node */
+  MT_INDEX a;   /* variable for arc */
+  MT_INDEX p;   /* variable for parent node */
+  MT_INDEX top; /* top of the work stack */
 
   if (stat_enabled)  n_visited++;
 
-  a = mt->MT_FirstInArc(n);
-  while (a != MT_NULL_INDEX)
+  /* visit the parents through the work stack, as in the global
+     extractor, following only the arcs interfering with the focus */
+  top = 0;
+  W_node[0] = n;
+  W_arc[0] = mt->MT_FirstInArc(n);
+  while (1)
   {
-    if (stat_enabled)  a_tested++;
-
-    p = mt->MT_ArcSource(a);
-    if ((!MT_IsInSet(p)) && MT_FocusArc(a))
+    n = W_node[top];
+    a = W_arc[top];
+    if (a != MT_NULL_INDEX)
     {
-       MT_IncludeNode(p);
+      if (stat_enabled)  a_tested++;
+
+      p = mt->MT_ArcSource(a);
+      W_arc[top] = mt->MT_NextInArc(n,a);
+      if ((!MT_IsInSet(p)) && MT_FocusArc(a))
+      {
+         if (stat_enabled)  n_visited++;
+         top++;
+         W_node[top] = p;
+         W_arc[top] = mt->MT_FirstInArc(p);
+      }
+      continue;
     }
-    a = mt->MT_NextInArc(n,a);
-  }
 
-  MT_AddToSet(n);
+    /* all parents of n interfering with the focus are in the set */
+    MT_AddToSet(n);
 
-  a = mt->MT_FirstInArc(n);
-  while (a != MT_NULL_INDEX)
-  {
-    if ( A_front->MT_IsInList(a) )
+    a = mt->MT_FirstInArc(n);
+    while (a != MT_NULL_INDEX)
     {
-      A_front->MT_RemElem(a);
-      MT_RemTiles(a);
+      if ( A_front->MT_IsInList(a) )
+      {
+        A_front->MT_RemElem(a);
+        MT_RemTiles(a);
+      }
+      a = mt->MT_NextInArc(n,a);
     }
-    a = mt->MT_NextInArc(n,a);
-  }
   
-  a = mt->MT_FirstOutArc(n);
-  while (a != MT_NULL_INDEX)
-  {
-    if (MT_FocusArc(a))
+    /* skip the out-arcs if the sub-DAG of n is outside the focus */
+    a = ( (MT_FocusNodeBox(n) == MT_BOX_OUT) ? MT_NULL_INDEX :
+          mt->MT_FirstOutArc(n) );
+    while (a != MT_NULL_INDEX)
     {
-      A_front->MT_AddElem(a);
-      MT_AddTiles(a);
+      if (MT_FocusArc(a))
+      {
+        A_front->MT_AddElem(a);
+        MT_AddTiles(a);
+      }
+      a = mt->MT_NextOutArc(n,a);
     }
-    a = mt->MT_NextOutArc(n,a);
+
+    if (top==0) return 1;
+    top--;
   }
-  return 1;
 }
 
 MT_LocalExtractorClass :: 
@@ -929,3 +2004,964 @@ MT_LocalExtractorClass :: ~MT_LocalExtractorClass(void)
 }
 
 /* ------------------------------------------------------------------------ */
+/*                          LOCAL DYNAMIC EXTRACTOR                         */
+/* ------------------------------------------------------------------------ */
+
+int MT_LocalDynamicExtractorClass :: MT_FocusArc(MT_INDEX a)
+{
+   unsigned char focus[MT_TILE_BATCH]; /* tiles in the focus set */
+   MT_INDEX t, t2, n;  /* range of tiles */
+   int box;            /* result of the box test */
+   int flag = 0;
+   
+   /* check whether the result of the test is already known on a */
+   if (MT_HintYes(a)) return 1;
+   if (MT_HintNot(a)) return 0;
+   t = mt->MT_FirstArcTile(a);
+   if (t == MT_NULL_INDEX) return 0;
+   t2 = mt->MT_LastArcTile(a);
+   /* the box of arc a may decide the test without looking at its tiles */
+   box = MT_FocusArcBox(a);
+   if (box == MT_BOX_IN) flag = 1;
+   for ( ; (box == MT_BOX_CROSS) && (t<=t2) && !flag; t+=n)
+   {
+      n = t2-t+1;
+      if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+      if (stat_enabled)  t_tested += n;
+      flag = ( MT_FocusTiles(t,t+n-1,MT_LOOSE,focus) > 0 );
+   }
+   /* record the computed result */
+   if (flag) A_pos[a] = extr_count; else A_neg[a] = extr_count;
+   return flag;
+}
+
+MT_INDEX MT_LocalDynamicExtractorClass :: MT_CollectFocusArcs(void)
+{
+  MT_INDEX n, d;  /* variables for node */
+  MT_INDEX a;     /* variable for arc */
+  MT_INDEX top;   /* number of nodes in the stack */
+  MT_INDEX num = 0;
+
+  /* visit the nodes of the set from the root, following the arcs
+     interfering with the focus set; such arcs are in the front if
+     they lead outside the set. Work stack W_node is used for the 
+     visit, each node is pushed at most once. */
+  visit_count++;
+  N_visit[mt->MT_Root()] = visit_count;
+  W_node[0] = mt->MT_Root();
+  top = 1;
+  while (top>0)
+  {
+    n = W_node[--top];
+    /* skip the out-arcs if the sub-DAG of n is outside the focus */
+    if (MT_FocusNodeBox(n) == MT_BOX_OUT)  continue;
+    for (a = mt->MT_FirstOutArc(n); a != MT_NULL_INDEX;
+         a = mt->MT_NextOutArc(n,a))
+    {
+      if (!MT_FocusArc(a))  continue;
+      d = mt->MT_ArcDest(a);
+      if (!MT_IsInSet(d))
+      {
+         A_cand[a] = extr_count;
+         F_arc[num++] = a;
+      }
+      else if (N_visit[d] != visit_count)
+      {
+         if (stat_enabled)  n_visited++;
+         N_visit[d] = visit_count;
+         W_node[top++] = d;
+      }
+    }
+  }
+  return num;
+}
+
+int MT_LocalDynamicExtractorClass :: MT_LocalExpand(void)
+{
+  MT_INDEX a;    /* variable for arc */ 
+  MT_INDEX k, num;
+  MT_INDEX tn;   /* number of tiles tested on an arc */
+
+  num = MT_CollectFocusArcs();
+  /* from now on, the arcs entering the front are added to F_arc */
+  F_num = num;
+  F_update = 1;
+  /* the arcs entering the front from now on follow cursor 0 */
+  A_front->MT_CurrFlush(0);
+  for (k=0; k<num; k++)
+  {
+    a = F_arc[k];
+    /* a may have left the front because of previous arcs */
+    if (!A_front->MT_IsInList(a))  continue;
+    if (stat_enabled)  a_tested++;
+    tn = 0;
+    if ( MT_RefineArc(a, &tn) && mt->MT_IsLoaded(mt->MT_ArcDest(a)) )
+       MT_IncludeNode(mt->MT_ArcDest(a));
+    if (stat_enabled)  t_tested += tn;
+  }
+  return MT_AdvanceFront();
+}
+
+int MT_LocalDynamicExtractorClass :: MT_ExtractionCompleted(void)
+{
+   MT_INDEX k, num;
+   MT_INDEX a;  /* variable for arc */
+   MT_INDEX p;  /* variable for node */
+   MT_INDEX t;  /* variable for tile */
+   int i, j;    /* array indices */
+   
+   if (topo_enabled)
+   {
+     /* empty the hash table */
+     while (hash_table->MT_HashPop(&i,&t));
+   }
+   if (F_update)
+   {
+     /* the arcs found by a new visit are among those found before the
+        expansion and those which have entered the front since then:
+        keep the ones still in the front whose source would be reached
+        by the visit */
+     num = 0;
+     for (k=0; k<F_num; k++)
+     {
+       a = F_arc[k];
+       p = mt->MT_ArcSource(a);
+       if ( A_front->MT_IsInList(a) && (N_visit[p] == visit_count) &&
+            (MT_FocusNodeBox(p) != MT_BOX_OUT) && MT_FocusArc(a) )
+          F_arc[num++] = a;
+     }
+     F_update = 0;
+   }
+   else
+     num = MT_CollectFocusArcs();
+   num_tiles = 0;
+   for (k=0; k<num; k++)  num_tiles += mt->MT_NumArcTiles(F_arc[k]);
+
+   if (T_good) free(T_good);
+   T_good = (MT_INDEX *) calloc ( num_tiles+1, sizeof(MT_INDEX) );
+   if (!T_good)
+   {
+     MT_Error((char *)"Allocation failed", (char *)"MT_LocalDynamicExtractorClass::MT_ExtractionCompleted");
+     return 0;
+   }
+   i = 0;
+   j = num_tiles-1;
+   for (k=0; k<num; k++)  MT_PutArcTiles(F_arc[k], &i, &j);
+   num_good = i;
+   if (num_good<num_tiles)
+      T_bad = T_good + i;
+   else 
+      T_bad = NULL;
+   tiles_ok = 1;
+   return 1;
+}
+
+MT_INDEX MT_LocalDynamicExtractorClass :: MT_ExtractTesselation (void)
+{
+  if (stat_enabled)  MT_ResetAlgoStat();
+
+  /* new markers for the results of MT_FocusArc */
+  extr_count++;
+  num_tiles = front_tiles;
+  /* 1) Expansion, cursors on N_free as in the global dynamic extractor */
+  N_free->MT_CurrFlush(1); 
+  MT_LocalExpand();
+  N_free->MT_CurrFlush(2);   
+  /* 2) Contraction */
+  MT_ContractExtractor();
+  /* copy the extracted tiles in the array */
+  front_tiles = num_tiles;
+  MT_ExtractionCompleted();
+  return MT_ExtractedTilesNum();
+}
+
+void MT_LocalDynamicExtractorClass :: MT_AddToSet(MT_INDEX n)
+{
+   MT_INDEX a; /* variable for arc */
+   MT_INDEX p; /* variable for parent node of n */
+
+   MT_DynamicExtractorClass::MT_AddToSet(n);
+   if (!F_update)  return;
+   /* all parents of n are in the set, n would be reached by the visit 
+      from a reached parent through an arc interfering with the focus */
+   for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX;
+        a = mt->MT_NextInArc(n,a))
+   {
+     p = mt->MT_ArcSource(a);
+     if ( (N_visit[p] == visit_count) && 
+          (MT_FocusNodeBox(p) != MT_BOX_OUT) && MT_FocusArc(a) )
+     {
+       N_visit[n] = visit_count;
+       return;
+     }
+   }
+}
+
+int MT_LocalDynamicExtractorClass :: MT_AddTiles(MT_INDEX a)
+{
+   if ( F_update && (A_cand[a] != extr_count) )
+   {
+     A_cand[a] = extr_count;
+     F_arc[F_num++] = a;
+   }
+   return ( MT_DynamicExtractorClass::MT_AddTiles(a) );
+}
+
+int MT_LocalDynamicExtractorClass :: MT_KeepLeaf (MT_INDEX n, 
+                                                  MT_INDEX * tested)
+{
+  MT_INDEX a;    /* variable for arc */
+
+  for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX;
+       a = mt->MT_NextInArc(n,a))
+  {
+    /* an arc outside the focus set needs no refinement */
+    if ( MT_HintNot(a) || (MT_FocusArcBox(a) == MT_BOX_OUT) )  continue;
+    if (MT_RefineArc(a, tested))  return 1;
+  }
+  return 0;
+}
+
+int MT_LocalDynamicExtractorClass :: MT_EnableDelta(void)
+{
+   MT_Warning((char *)"Delta mode not available",
+              (char *)"MT_LocalDynamicExtractorClass::MT_EnableDelta");
+   return 0;
+}
+
+MT_LocalDynamicExtractorClass :: 
+MT_LocalDynamicExtractorClass(MT_MultiTesselation m, int topo_flag)
+: MT_DynamicExtractorClass(m,topo_flag)
+{
+   MT_Message((char *)"",(char *)"MT_LocalDynamicExtractor Constructor");
+
+   /* allocate the additional fields */
+   A_pos = 
+         (unsigned int *) calloc ( mt->MT_ArcNum()+1, sizeof(unsigned int) );
+   A_neg =
+         (unsigned int *) calloc ( mt->MT_ArcNum()+1, sizeof(unsigned int) );
+   N_visit =
+         (unsigned int *) calloc ( mt->MT_NodeNum()+1, sizeof(unsigned int) );
+   F_arc = (MT_INDEX *) malloc ( (mt->MT_ArcNum()+1)*sizeof(MT_INDEX) );
+   A_cand =
+         (unsigned int *) calloc ( mt->MT_ArcNum()+1, sizeof(unsigned int) );
+   if ( !(A_pos && A_neg && N_visit && F_arc && A_cand) )
+   {
+      MT_FatalError((char *)"Allocation failed",(char *)"MT_LocalDynamicExtractor Constructor");
+   }
+   visit_count = 0;
+   F_num = 0;
+   F_update = 0;
+
+   /* the global dynamic extractor has swept the root, take the
+      extracted tiles from its front */
+   front_tiles = num_tiles;
+   MT_ExtractionCompleted();
+}
+
+MT_LocalDynamicExtractorClass :: ~MT_LocalDynamicExtractorClass(void)
+{
+   MT_Message((char *)"",(char *)"MT_LocalDynamicExtractor Destructor");
+   /* deallocate the additional fields */
+   free(A_pos);
+   free(A_neg);
+   free(N_visit);
+   free(F_arc);
+   free(A_cand);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                            BUDGETED EXTRACTOR                            */
+/* ------------------------------------------------------------------------ */
+
+int MT_BudgetExtractorClass :: MT_SetPriority(MT_Priority p)
+{
+   if ( (p) && (!p->MT_IsGood(mt)) )
+   {  MT_Warning((char *)"Priority not good for MT",(char *)"MT_BudgetExtractorClass::MT_SetPriority");
+      return 0;
+   }
+   /* else */
+   prio_fun = p;
+   return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+
+int MT_BudgetExtractorClass :: MT_SplitPriority(MT_INDEX a, float * p)
+{
+  unsigned char focus[MT_TILE_BATCH]; /* tiles in the focus set */
+  unsigned char good[MT_TILE_BATCH];  /* tiles feasible for the filter */
+  float pr[MT_TILE_BATCH];            /* priorities of tiles */
+  MT_INDEX t, t2, n;  /* range of tiles */
+  int i, flag = 0;
+  
+  /* tiles of arcs entering the drain need no refinement */
+  t = mt->MT_FirstArcTile(a);
+  if ( (t == MT_NULL_INDEX) || (mt->MT_ArcDest(a) == mt->MT_Drain()) ||
+       (!mt->MT_IsLoaded(mt->MT_ArcDest(a))) )
+     return 0;
+  (*p) = -FLT_MAX;
+  t2 = mt->MT_LastArcTile(a);
+  for ( ; t<=t2; t+=n)
+  {
+    n = t2-t+1;
+    if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+    if (stat_enabled)  t_tested += n;
+    if (!MT_FocusTiles(t,t+n-1,MT_LOOSE,focus))  continue;
+    if (!resol_cnd)
+       memset(good, 0, n);
+    else if (resol_cnd->MT_EvalCondRange(mt,t,t+n-1,MT_LOOSE,good)==(int)n)
+       continue;
+    if (prio_fun)  prio_fun->MT_EvalPriorityRange(mt,t,t+n-1,pr);
+    for (i=0;i<(int)n;i++)
+    {
+      if ( focus[i] && !good[i] )
+      {
+        flag = 1;
+        if (!prio_fun)
+        {  (*p) = 0.0;
+           return 1;
+        }
+        if (pr[i] > (*p))  (*p) = pr[i];
+      }
+    }
+  }
+  return flag;
+}
+
+float MT_BudgetExtractorClass :: MT_MergePriority(MT_INDEX n)
+{
+  MT_INDEX a;    /* variable for arc */
+  float p, res = -FLT_MAX;
+
+  for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX; 
+       a = mt->MT_NextInArc(n,a))
+  {
+    if ( MT_SplitPriority(a,&p) && (p > res) )  res = p;
+  }
+  return res;
+}
+
+/* ------------------------------------------------------------------------ */
+
+long MT_BudgetExtractorClass :: MT_IncludeCost(MT_INDEX n)
+{
+  MT_INDEX a;    /* variable for arc */
+  MT_INDEX p;    /* variable for parent node */
+  MT_INDEX top;  /* number of nodes in the stack */
+  long cost = 0;
+
+  /* visit n and its ancestors not in the set, which would be swept 
+     by MT_IncludeNode(n), summing the tiles that each one adds and 
+     removes. Work stack W_node is used for the visit, each node is 
+     pushed at most once. */
+  cost_count++;
+  N_cost[n] = cost_count;
+  W_node[0] = n;
+  top = 1;
+  while (top>0)
+  {
+    n = W_node[--top];
+    for (a = mt->MT_FirstOutArc(n); a != MT_NULL_INDEX;
+         a = mt->MT_NextOutArc(n,a))
+    {  cost += mt->MT_NumArcTiles(a);  }
+    for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX;
+         a = mt->MT_NextInArc(n,a))
+    {
+      cost -= mt->MT_NumArcTiles(a);
+      p = mt->MT_ArcSource(a);
+      if ( (!MT_IsInSet(p)) && (N_cost[p] != cost_count) )
+      {
+         N_cost[p] = cost_count;
+         W_node[top++] = p;
+      }
+    }
+  }
+  return cost;
+}
+
+/* ------------------------------------------------------------------------ */
+
+void MT_BudgetExtractorClass :: MT_BudgetContract(int all)
+{
+  MT_INDEX n;    /* variable for node */ 
+  MT_INDEX a;    /* variable for arc */
+  float p;
+  int flag;      /* boolean control variable */
+
+  /* new leaves are added at the end of N_free, thus they are 
+     examined by the same loop */
+  N_free->MT_CurrInit(0);
+  while (N_free->MT_CurrElem(0) != MT_NULL_INDEX)
+  {
+    n = N_free->MT_CurrElem(0);
+    N_free->MT_CurrAdvance(0);
+    if (n == mt->MT_Root())  continue;
+    if (stat_enabled)  n_tested++;
+    /* flag == 1 iff n can be removed */
+    flag = 1;
+    if (!all)
+    {
+      a = mt->MT_FirstInArc(n);
+      while (flag && (a != MT_NULL_INDEX))
+      {
+         flag = !MT_SplitPriority(a,&p);
+         a = mt->MT_NextInArc(n,a);
+      }
+    }
+    if (flag)  MT_ExcludeNode(n);
+  }
+}
+
+void MT_BudgetExtractorClass :: MT_BudgetCoarsen(void)
+{
+  MT_INDEX n;    /* variable for node */ 
+  float p;
+
+  Q_merge->MT_EmptyHeap();
+  for (n = N_free->MT_FirstElem(); n != MT_NULL_INDEX; 
+       n = N_free->MT_NextElem(n))
+  {
+    if (n != mt->MT_Root())  Q_merge->MT_HeapPush(n, -MT_MergePriority(n));
+  }
+  merging = 1;
+  while ( ((MT_INDEX)num_tiles > tile_budget) && Q_merge->MT_HeapPop(&n,&p) )
+  {
+    /* n may have been pushed twice, the second time it is not a leaf */
+    if (N_set[n] == 1)  MT_ExcludeNode(n);
+  }
+  merging = 0;
+}
+
+void MT_BudgetExtractorClass :: MT_BudgetRefine(void)
+{
+  MT_INDEX a;    /* variable for arc */ 
+  MT_INDEX n;    /* variable for node */ 
+  MT_Heap q;     /* auxiliary variable for swapping queues */
+  float p;
+  int done;      /* flag if some node has been swept in a pass */
+
+  Q_split->MT_EmptyHeap();
+  Q_wait->MT_EmptyHeap();
+  for (a = A_front->MT_FirstElem(); a != MT_NULL_INDEX;
+       a = A_front->MT_NextElem(a))
+  {
+    if (stat_enabled)  a_tested++;
+    if (MT_SplitPriority(a,&p))  Q_split->MT_HeapPush(a,p);
+  }
+  splitting = 1;
+  do
+  {
+    done = 0;
+    while ( ( (min_cost <= 0) || 
+              ((long)tile_budget - (long)num_tiles >= min_cost) ) &&
+            Q_split->MT_HeapPop(&a,&p) )
+    {
+      /* a may have left the front because of previous arcs */
+      if (!A_front->MT_IsInList(a))  continue;
+      if (stat_enabled)  a_tested++;
+      n = mt->MT_ArcDest(a);
+      if ( (long)num_tiles + MT_IncludeCost(n) <= (long)tile_budget )
+      {  if (MT_IncludeNode(n))  done = 1;  }
+      else
+         Q_wait->MT_HeapPush(a,p);
+    }
+    /* the arcs skipped so far may fit now, if the nodes swept 
+       afterwards have swept some of the nodes they need */
+    q = Q_split;  Q_split = Q_wait;  Q_wait = q;
+  }
+  while ( done && Q_split->MT_HeapNum() );
+  splitting = 0;
+}
+
+/* ------------------------------------------------------------------------ */
+
+int MT_BudgetExtractorClass :: MT_AddTiles(MT_INDEX a)
+{
+   float p;
+   if ( splitting && MT_SplitPriority(a,&p) )  Q_split->MT_HeapPush(a,p);
+   return ( MT_DynamicExtractorClass::MT_AddTiles(a) );
+}
+
+int MT_BudgetExtractorClass :: MT_ExcludeNode(MT_INDEX n)
+{
+   MT_INDEX a;  /* variable for arc */
+   MT_INDEX p;  /* variable for parent node */
+
+   MT_DynamicExtractorClass::MT_ExcludeNode(n);
+   if (merging)
+   {
+     /* parents of n which have become leaves */
+     for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX; 
+          a = mt->MT_NextInArc(n,a))
+     {
+       p = mt->MT_ArcSource(a);
+       if ( (p != mt->MT_Root()) && (N_set[p] == 1) )
+          Q_merge->MT_HeapPush(p, -MT_MergePriority(p));
+     }
+   }
+   return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+
+MT_INDEX MT_BudgetExtractorClass :: MT_ExtractTesselation (void)
+{
+  if (stat_enabled)  MT_ResetAlgoStat();
+
+  /* 1) Contraction */
+  if (incr_enabled)
+  {
+    MT_BudgetContract(0);
+    if ((MT_INDEX)num_tiles > tile_budget)  MT_BudgetCoarsen();
+  }
+  else
+    MT_BudgetContract(1);
+  /* 2) Expansion */
+  MT_BudgetRefine();
+  if (delta_enabled)
+  {
+    /* update the buffer with the tiles of the arcs that have moved */
+    MT_DeltaCompleted();
+    return MT_AllExtractedTilesNum();
+  }
+  /* copy the extracted tiles in the array */
+  MT_ExtractionCompleted();
+  return MT_ExtractedTilesNum();
+}
+
+/* ------------------------------------------------------------------------ */
+
+MT_BudgetExtractorClass :: 
+MT_BudgetExtractorClass(MT_MultiTesselation m, MT_INDEX budget, int topo_flag)
+: MT_DynamicExtractorClass(m,topo_flag)
+{
+   MT_INDEX n;  /* variable for node */
+   MT_INDEX a;  /* variable for arc */
+   long c;      /* tiles added by a node */
+   int first;   /* flag for the first node */
+
+   MT_Message((char *)"",(char *)"MT_BudgetExtractor Constructor");
+
+   /* allocate the additional fields */
+   N_cost =
+         (unsigned int *) calloc ( mt->MT_NodeNum()+1, sizeof(unsigned int) );
+   Q_split = new MT_HeapClass(1024);
+   Q_wait = new MT_HeapClass(1024);
+   Q_merge = new MT_HeapClass(1024);
+   if ( !(N_cost && Q_split && Q_wait && Q_merge) )
+   {
+      MT_FatalError((char *)"Allocation failed",(char *)"MT_BudgetExtractor Constructor");
+   }
+   cost_count = 0;
+   splitting = merging = 0;
+   /* compute the minimum number of tiles added by a node, the root
+      and the drain are never swept by MT_BudgetRefine */
+   min_cost = 0;
+   first = 1;
+   for (n=1; n<=mt->MT_NodeNum(); n++)
+   {
+     if ( (n == mt->MT_Root()) || (n == mt->MT_Drain()) )  continue;
+     c = 0;
+     for (a = mt->MT_FirstOutArc(n); a != MT_NULL_INDEX;
+          a = mt->MT_NextOutArc(n,a))
+     {  c += mt->MT_NumArcTiles(a);  }
+     for (a = mt->MT_FirstInArc(n); a != MT_NULL_INDEX;
+          a = mt->MT_NextInArc(n,a))
+     {  c -= mt->MT_NumArcTiles(a);  }
+     if ( first || (c < min_cost) )
+     {  min_cost = c;  first = 0;  }
+   }
+   prio_fun = NULL;
+   tile_budget = budget;
+   incr_enabled = 0;
+}
+
+MT_BudgetExtractorClass :: ~MT_BudgetExtractorClass(void)
+{
+   MT_Message((char *)"",(char *)"MT_BudgetExtractor Destructor");
+   /* deallocate the additional fields */
+   free(N_cost);
+   delete (Q_split);
+   delete (Q_wait);
+   delete (Q_merge);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                          SPARSE LOCAL EXTRACTOR                          */
+/* ------------------------------------------------------------------------ */
+
+/*
+Bits of the mark of an arc in A_mark: results of MT_FocusArc, and shift 
+of the position of the arc in the front.
+*/
+#define MT_FOCUS_YES    1
+#define MT_FOCUS_NOT    2
+#define MT_FOCUS_BITS   3
+#define MT_FRONT_SHIFT  2
+
+int MT_SparseExtractorClass :: MT_IsInSet(MT_INDEX n)
+{  return ( N_mark->MT_GetMark(n) != 0 );  }
+
+void MT_SparseExtractorClass :: MT_AddToSet(MT_INDEX n)
+{  
+   if (N_mark->MT_SetMark(n,1) && stat_enabled)  n_inset++;
+}
+
+/* ------------------------------------------------------------------------ */
+
+int MT_SparseExtractorClass :: MT_FocusArc(MT_INDEX a)
+{
+   unsigned char focus[MT_TILE_BATCH]; /* tiles in the focus set */
+   MT_INDEX t, t2, n;  /* range of tiles */
+   unsigned int m;     /* mark of a */
+   int box;            /* result of the box test */
+   int flag = 0;
+   
+   /* check whether the result of the test is already known on a */
+   m = A_mark->MT_GetMark(a);
+   if (m & MT_FOCUS_YES) return 1;
+   if (m & MT_FOCUS_NOT) return 0;
+   /* if not known, look at the tiles of arc a, in groups of 
+      MT_TILE_BATCH */
+   t = mt->MT_FirstArcTile(a);
+   if (t == MT_NULL_INDEX) return 0;
+   t2 = mt->MT_LastArcTile(a);
+   /* the box of arc a may decide the test without looking at its tiles */
+   box = MT_FocusArcBox(a);
+   if (box == MT_BOX_IN) flag = 1;
+   for ( ; (box == MT_BOX_CROSS) && (t<=t2) && !flag; t+=n)
+   {
+      n = t2-t+1;
+      if (n>MT_TILE_BATCH) n = MT_TILE_BATCH;
+      if (stat_enabled)  t_tested += n;
+
+      flag = ( MT_FocusTiles(t,t+n-1,MT_LOOSE,focus) > 0 );
+   }
+   /* record the computed result, if possible */
+   A_mark->MT_SetMark(a, m | (flag ? MT_FOCUS_YES : MT_FOCUS_NOT));
+   return flag;
+}
+
+/* ------------------------------------------------------------------------ */
+
+int MT_SparseExtractorClass :: MT_AddFrontArc(MT_INDEX a)
+{
+   MT_INDEX * f1; /* enlarged array */
+   unsigned int m = A_mark->MT_GetMark(a) & MT_FOCUS_BITS;
+
+   if (F_num==F_size)
+   {
+     f1 = (MT_INDEX *) realloc ( F_arc, 2 * F_size * sizeof(MT_INDEX) );
+     if (!f1) return 0;
+     F_arc = f1;
+     F_size *= 2;
+   }
+   if ( !A_mark->MT_SetMark(a, m | ((F_num+1) << MT_FRONT_SHIFT)) )  
+      return 0;
+   F_arc[F_num++] = a;
+   return 1;
+}
+
+int MT_SparseExtractorClass :: MT_RemFrontArc(MT_INDEX a)
+{
+   unsigned int * m = A_mark->MT_FindMark(a);
+   if ( (!m) || !((*m) >> MT_FRONT_SHIFT) ) return 0;
+   F_arc[((*m) >> MT_FRONT_SHIFT) - 1] = MT_NULL_INDEX;
+   (*m) &= MT_FOCUS_BITS;
+   return 1;
+}
+
+int MT_SparseExtractorClass :: MT_GrowWork(void)
+{
+   MT_INDEX * w1; /* enlarged arrays */
+
+   w1 = (MT_INDEX *) realloc ( W_node, 2 * W_size * sizeof(MT_INDEX) );
+   if (!w1) return 0;
+   W_node = w1;
+   w1 = (MT_INDEX *) realloc ( W_arc, 2 * W_size * sizeof(MT_INDEX) );
+   if (!w1) return 0;
+   W_arc = w1;
+   W_size *= 2;
+   return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+
+int MT_SparseExtractorClass :: MT_IncludeNode (MT_INDEX n)
+{
+  MT_INDEX a;   /* variable for arc */
+  MT_INDEX p;   /* variable for parent node */
+  MT_INDEX top; /* top of the work stack */
+
+  /* stop including nodes when the upper bound on the number of tiles 
+     is reached, as in MT_ExtractorClass; this is not a failure */
+  if ((MT_INDEX)(num_tiles+2)>max_tile_num) return 1;
+
+  if (stat_enabled)  n_visited++;
+
+  /* visit the parents through the work stack, as in the local
+     extractor, enlarging the stack when needed */
+  top = 0;
+  W_node[0] = n;
+  W_arc[0] = mt->MT_FirstInArc(n);
+  while (1)
+  {
+    n = W_node[top];
+    a = W_arc[top];
+    if (a != MT_NULL_INDEX)
+    {
+      if (stat_enabled)  a_tested++;
+
+      p = mt->MT_ArcSource(a);
+      W_arc[top] = mt->MT_NextInArc(n,a);
+      if ((!MT_IsInSet(p)) && MT_FocusArc(a))
+      {
+         if ((MT_INDEX)(num_tiles+2)>max_tile_num) return 1;
+         if ( (top+1 == W_size) && !MT_GrowWork() )  return 0;
+         if (stat_enabled)  n_visited++;
+         top++;
+         W_node[top] = p;
+         W_arc[top] = mt->MT_FirstInArc(p);
+      }
+      continue;
+    }
+
+    /* all parents of n interfering with the focus are in the set */
+    if (!N_mark->MT_SetMark(n,1))  return 0;
+    if (stat_enabled)  n_inset++;
+
+    a = mt->MT_FirstInArc(n);
+    while (a != MT_NULL_INDEX)
+    {
+      if ( MT_RemFrontArc(a) )  MT_RemTiles(a);
+      a = mt->MT_NextInArc(n,a);
+    }
+  
+    /* skip the out-arcs if the sub-DAG of n is outside the focus */
+    a = ( (MT_FocusNodeBox(n) == MT_BOX_OUT) ? MT_NULL_INDEX :
+          mt->MT_FirstOutArc(n) );
+    while (a != MT_NULL_INDEX)
+    {
+      if (MT_FocusArc(a))
+      {
+        if (!MT_AddFrontArc(a))  return 0;
+        MT_AddTiles(a);
+      }
+      a = mt->MT_NextOutArc(n,a);
+    }
+
+    if (top==0) return 1;
+    top--;
+  }
+}
+
+/* ------------------------------------------------------------------------ */
+
+MT_INDEX MT_SparseExtractorClass :: MT_ExtractTesselation( void )
+{
+  MT_INDEX i;    /* position in the front */
+  MT_INDEX a;    /* variable for arc */ 
+  MT_INDEX tn;   /* number of tiles tested on an arc */
+  int ok;
+
+  /* 1) Reset: empty the tables, keeping their memory */
+  if (stat_enabled)  MT_ResetAllStat();
+  N_mark->MT_EmptyTable();
+  A_mark->MT_EmptyTable();
+  F_num = 0;
+  num_good = num_tiles = 0;
+  tiles_ok = 0;
+  extr_count++;
+  ok = MT_IncludeNode(mt->MT_Root());
+
+  /* 2) Expansion: test the front arcs in the order in which they have
+     been added, as the cursor of A_front in MT_AdvanceFront */
+  for (i=0; ok && (i<F_num); i++)
+  {
+    a = F_arc[i];
+    if (a == MT_NULL_INDEX)  continue;
+    if (stat_enabled)  a_tested++;
+    tn = 0;
+    if ( MT_RefineArc(a, &tn) && mt->MT_IsLoaded(mt->MT_ArcDest(a)) )
+       ok = MT_IncludeNode(mt->MT_ArcDest(a));
+    if (stat_enabled)  t_tested += tn;
+  }
+  if (!ok)
+  {
+    MT_Error((char *)"Allocation failed",
+             (char *)"MT_SparseExtractorClass::MT_ExtractTesselation");
+    return 0;
+  }
+  /* copy the extracted tiles in the array */
+  MT_ExtractionCompleted();
+  return MT_ExtractedTilesNum();
+}
+
+int MT_SparseExtractorClass :: MT_ExtractionCompleted(void)
+{
+   MT_INDEX k;  /* position in the front */
+   int i, j;    /* array indices */
+   
+   /* enlarge the array of extracted tiles if needed, otherwise keep it */
+   if ((MT_INDEX)num_tiles > T_size)
+   {
+     if (T_good) free(T_good);
+     T_good = (MT_INDEX *) malloc ( num_tiles * sizeof(MT_INDEX) );
+     if (!T_good)
+     {
+       T_size = 0;
+       MT_Error((char *)"Allocation failed", (char *)"MT_SparseExtractorClass::MT_ExtractionCompleted");
+       return 0;
+     }
+     T_size = num_tiles;
+   }
+
+   /* as in MT_ExtractorClass, active tiles from the beginning of the
+      array, non-active ones from the end */
+   i = 0;
+   j = num_tiles-1;
+   for (k=0; k<F_num; k++)
+   { 
+     if (F_arc[k] != MT_NULL_INDEX)  MT_PutArcTiles(F_arc[k], &i, &j);
+   }
+   num_good = i;
+   if (num_good<num_tiles)
+      T_bad = T_good + i;
+   else 
+      T_bad = NULL;
+   tiles_ok = 1;
+
+   return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+
+long MT_SparseExtractorClass :: MT_StateMemory(void)
+{
+   return ( (long)sizeof(MT_SparseExtractorClass) + 
+            N_mark->MT_TableMemory() + A_mark->MT_TableMemory() +
+            (long)(F_size + 2*W_size + T_size) * (long)sizeof(MT_INDEX) );
+}
+
+/* ------------------------------------------------------------------------ */
+
+MT_SparseExtractorClass :: 
+MT_SparseExtractorClass(MT_MultiTesselation m)
+: MT_ExtractorClass(m,MT_ADJ_DISABLE,0)
+{
+   MT_Message((char *)"",(char *)"MT_SparseExtractor Constructor");
+
+   /* allocate the additional fields, small at the beginning */
+   N_mark = new MT_MarkTableClass(64);
+   A_mark = new MT_MarkTableClass(256);
+   F_size = W_size = 64;
+   F_arc = (MT_INDEX *) malloc ( F_size * sizeof(MT_INDEX) );
+   W_node = (MT_INDEX *) malloc ( W_size * sizeof(MT_INDEX) );
+   W_arc = (MT_INDEX *) malloc ( W_size * sizeof(MT_INDEX) );
+   if ( !(N_mark && A_mark && F_arc && W_node && W_arc) )
+   {
+      MT_FatalError((char *)"Allocation failed",(char *)"MT_SparseExtractor Constructor");
+   }
+   F_num = 0;
+   T_size = 0;
+
+   /* set an initial state */
+   MT_ResetAllStat();
+   MT_IncludeNode(mt->MT_Root());
+   MT_ExtractionCompleted();
+}
+
+MT_SparseExtractorClass :: ~MT_SparseExtractorClass(void)
+{
+   MT_Message((char *)"",(char *)"MT_SparseExtractor Destructor");
+   /* deallocate the additional fields, the work stack is released
+      by the destructor of MT_ExtractorClass */
+   delete (N_mark);
+   delete (A_mark);
+   free(F_arc);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                            POOL OF EXTRACTORS                            */
+/* ------------------------------------------------------------------------ */
+
+MT_SparseExtractor MT_ExtractorPoolClass :: MT_Acquire(void)
+{
+   MT_SparseExtractor e = NULL;
+
+   if (!MT_IsGood())
+   {
+     MT_Error((char *)"Pool not usable",(char *)"MT_ExtractorPoolClass::MT_Acquire");
+     return NULL;
+   }
+   MT_LockMutex(lock);
+   if (idle_num)  e = P_idle[--idle_num];
+   else created_num++;
+   MT_UnlockMutex(lock);
+   if (e) return e;
+
+   /* no extractor available, create a new one outside the mutex */
+   e = new MT_SparseExtractorClass(mt);
+   if (!e)
+   {
+     MT_LockMutex(lock);
+     created_num--;
+     MT_UnlockMutex(lock);
+     MT_Error((char *)"Allocation failed",(char *)"MT_ExtractorPoolClass::MT_Acquire");
+   }
+   return e;
+}
+
+void MT_ExtractorPoolClass :: MT_Release(MT_SparseExtractor e)
+{
+   MT_SparseExtractor * p1; /* enlarged array */
+
+   if (!e) return;
+   e->MT_SetFilter(NULL);
+   e->MT_SetFocus(NULL);
+   MT_LockMutex(lock);
+   if (idle_num==idle_size)
+   {
+     p1 = (MT_SparseExtractor *) 
+          realloc ( P_idle, 2 * (idle_size+8) * sizeof(MT_SparseExtractor) );
+     if (!p1)
+     {
+       /* the extractor cannot be kept */
+       created_num--;
+       MT_UnlockMutex(lock);
+       delete e;
+       return;
+     }
+     P_idle = p1;
+     idle_size = 2 * (idle_size+8);
+   }
+   P_idle[idle_num++] = e;
+   MT_UnlockMutex(lock);
+}
+
+/* ------------------------------------------------------------------------ */
+
+MT_ExtractorPoolClass :: MT_ExtractorPoolClass(MT_MultiTesselation m)
+{
+   MT_Message((char *)"",(char *)"MT_ExtractorPool Constructor");
+   mt = m;
+   my_freeze = mt->MT_Freeze();
+   P_idle = NULL;
+   idle_num = idle_size = created_num = 0;
+   lock = MT_NewMutex();
+}
+
+MT_ExtractorPoolClass :: ~MT_ExtractorPoolClass(void)
+{
+   MT_Message((char *)"",(char *)"MT_ExtractorPool Destructor");
+   if (idle_num < created_num)
+      MT_Warning((char *)"Extractors not released",
+                 (char *)"MT_ExtractorPool Destructor");
+   while (idle_num)  delete P_idle[--idle_num];
+   if (P_idle) free(P_idle);
+   MT_DeleteMutex(lock);
+   if (my_freeze)  mt->MT_Unfreeze();
+}
+
+/* ------------------------------------------------------------------------ */
@@ -56,9 +56,10 @@ int MT_FloatTableClass ::
            MT_WarningC(err_msg,(char *)"MT_FloatTableClass",(char *)"MT_ReadAttr");
            return 0;
         }
+        if (swap_bytes) MT_SwapArray(&att_Arr[i], sizeof(float), 1);
         break;
      case MT_ASCII_ENCODING:
-        if ( fscanf(fd, "%g", &att_Arr[i]) != 1 )
+        if ( !MT_ScanFloat(fd, &att_Arr[i]) )
         {
            MT_WarningC(err_msg,(char *)"MT_FloatTableClass",(char *)"MT_ReadAttr");
            return 0;
@@ -66,7 +67,7 @@ int MT_FloatTableClass ::
         break;   
   }
   if (att_Arr[i] < bound[0]) bound[0] = att_Arr[i];
-  else if (att_Arr[i] > bound[1]) bound[1] = att_Arr[i];
+  if (att_Arr[i] > bound[1]) bound[1] = att_Arr[i];
   return 1;
 }
 
@@ -104,8 +105,47 @@ int MT_FloatTableClass :: MT_ReadObjParams(FILE * fd)
 
 int MT_FloatTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
 {  
-  MT_SetAttrNum(my_num);
-  return ( MT_AttrTableClass::MT_ReadBody(fd,file_encoding) );
+  int ok = 1;
+  if (!MT_SetAttrNum(my_num)) return 0;
+  /* read all values directly into the array, then update the bound */
+  if (file_encoding==MT_BINARY_ENCODING)
+     ok = MT_ReadArray(fd, att_Arr+1, sizeof(float), my_num);
+  else ok = MT_ScanArray(fd, my_num, att_Arr+1, 0, NULL);
+  if (ok) MT_UpdateBound();
+  return ok;
+}
+
+void MT_FloatTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
+{  
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(att_Arr+1, sizeof(float), my_num, fd);
+  else MT_AttrTableClass::MT_WriteBody(fd, file_encoding);
+}
+
+void MT_FloatTableClass :: MT_UpdateBound(void)
+{
+  /* four independent minima and maxima, on consecutive values, so that 
+     the loop can be executed with vector instructions */
+  float mn[4], mx[4];
+  MT_INDEX i;
+  int j;
+  for (j=0; j<4; j++)  {  mn[j] = bound[0];  mx[j] = bound[1];  }
+  for (i=1; i+3<=my_num; i+=4)
+  {  for (j=0; j<4; j++)
+     {  mn[j] = (att_Arr[i+j] < mn[j]) ? att_Arr[i+j] : mn[j];
+        mx[j] = (att_Arr[i+j] > mx[j]) ? att_Arr[i+j] : mx[j];
+     }
+  }
+  for ( ; i<=my_num; i++)
+  {  mn[0] = (att_Arr[i] < mn[0]) ? att_Arr[i] : mn[0];
+     mx[0] = (att_Arr[i] > mx[0]) ? att_Arr[i] : mx[0];
+  }
+  for (j=1; j<4; j++)
+  {  if (mn[j] < mn[0]) mn[0] = mn[j];
+     if (mx[j] > mx[0]) mx[0] = mx[j];
+  }
+  bound[0] = mn[0];
+  bound[1] = mx[0];
 }
 
 void MT_FloatTableClass :: MT_WriteObjParams(FILE * fd)
@@ -128,6 +168,7 @@ MT_FloatTableClass :: MT_FloatTableClass(void)
 MT_FloatTableClass ::  ~MT_FloatTableClass(void) 
 {
 //  MT_MessageC("","MT_FloatTableClass","Destructor");
+  MT_WaitWrite();
   if (att_Arr) {  free (att_Arr);  }  }
 
 /* ------------------------------------------------------------------------ */
@@ -143,6 +184,7 @@ MT_FloatBuildingInterfaceClass :: MT_FloatBuildingInterfaceClass( void )
 
 MT_FloatBuildingInterfaceClass :: ~MT_FloatBuildingInterfaceClass( void )
 {
+  MT_WaitWrite();
   if (spec_attr) delete spec_attr;
   spec_attr = NULL;  my_attr = NULL;
 }
@@ -184,9 +226,10 @@ int MT_FloatVectorTableClass ::
                        (char *)"MT_FloatVectorTableClass",(char *)"MT_ReadAttr");
              return 0;
           }
+          if (swap_bytes) MT_SwapArray(&av_Arr[j+i*vector_size], sizeof(float), 1);
           break;
        case MT_ASCII_ENCODING:
-          if ( fscanf(fd, "%g", &av_Arr[j+i*vector_size]) != 1 )
+          if ( !MT_ScanFloat(fd, &av_Arr[j+i*vector_size]) )
           {
              MT_ErrorC((char *)"Cannot read vector element",
                        (char *)"MT_FloatVectorTableClass",(char *)"MT_ReadAttr");
@@ -247,13 +290,13 @@ int MT_FloatVectorTableClass :: MT_ReadObjParams(FILE * fd)
 
 int MT_FloatVectorTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
 {  
-  unsigned int i;
   /* allocate float array */
   if (!MT_SetAttrNum(my_num)) return 0;
-  /* read the values and fill the array */
-  for (i=1; i<my_num+1; i++)
-  {  if (!MT_ReadAttr(fd, i, file_encoding)) return 0;  }
-  return 1;
+  /* read all vectors directly into the array */
+  if (file_encoding==MT_BINARY_ENCODING)
+     return ( MT_ReadArray(fd, av_Arr+vector_size, 
+                           sizeof(float), my_num*vector_size) );
+  return ( MT_ScanArray(fd, my_num*vector_size, av_Arr+vector_size, 0, NULL) );
 }
 
 void MT_FloatVectorTableClass :: MT_WriteClassAndParams(FILE * fd)
@@ -271,8 +314,12 @@ void MT_FloatVectorTableClass :: MT_WriteObjParams(FILE * fd)
 void MT_FloatVectorTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
 {  
   unsigned int i;
-  for (i=1; i<my_num+1; i++)
-  {  MT_WriteAttr(fd, i, file_encoding);  }
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(av_Arr+vector_size, sizeof(float), my_num*vector_size, fd);
+  else
+  {  for (i=1; i<my_num+1; i++)
+     {  MT_WriteAttr(fd, i, file_encoding);  }
+  }
 }
 
 /* ------------------------------------------------------------------------ */
@@ -305,7 +352,10 @@ MT_FloatVectorTableClass :: MT_FloatVectorTableClass(int num)
 }
        
 MT_FloatVectorTableClass :: ~MT_FloatVectorTableClass(void)
-{  if (my_num) free(av_Arr);  av_Arr = NULL;  }
+{
+  MT_WaitWrite();
+  {  if (my_num) free(av_Arr);  av_Arr = NULL;  }
+}
 
 /* ------------------------------------------------------------------------ */
 /*               BUILDING INTERFACE FOR float VECTOR ATTRIBUTES               */  
@@ -320,6 +370,7 @@ MT_FloatVectorBuildingInterfaceClass :: MT_FloatVectorBuildingInterfaceClass( in
 
 MT_FloatVectorBuildingInterfaceClass :: ~MT_FloatVectorBuildingInterfaceClass( void )
 {
+  MT_WaitWrite();
   if (spec_attr) free (spec_attr);
   my_attr = NULL; spec_attr = NULL;
 }
@@ -338,4 +389,4 @@ int MT_FloatVectorBuildingInterfaceClass :: MT_MakeAttrVector(MT_INDEX i, float
 }
 
 /* ------------------------------------------------------------------------ */
-
+
@@ -29,10 +29,21 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 /*                  GENERAL CONVENTIONS FOR THE MT PACKAGE                  */
 /* ------------------------------------------------------------------------ */
 
+/* 64-bit offsets for fseeko / ftello, also where long has 32 bits */
+#ifndef _WIN32
+#define _FILE_OFFSET_BITS 64
+#include <sys/types.h>
+#endif
+
 #ifdef MT_MEMDEBUG
 #include <malloc.h>
 #endif /* MT_MEMDEBUG */
 
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
 #include "mt_glob.h"
 
 /* ------------------------------------------------------------------------ */
@@ -59,6 +70,43 @@ void MT_ErrorC(char * msg, char * cls, char * fun)
 void MT_FatalErrorC(char * msg, char * cls, char * fun)
 {  fprintf(stderr,"Fatal error [%s::%s]: %s\n", cls, fun, msg);  exit(1);  }
 
+/* ------------------------------------------------------------------------ */
+/*                              TIME UTILITIES                              */
+/* ------------------------------------------------------------------------ */
+
+double MT_WallTime(void)
+{
+#ifdef _WIN32
+   return ( (double)clock() / (double)CLOCKS_PER_SEC );
+#else
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0 );
+#endif
+}
+
+/* ------------------------------------------------------------------------ */
+/*                              FILE UTILITIES                              */
+/* ------------------------------------------------------------------------ */
+
+int MT_SeekFile(FILE * fd, MT_OFFSET pos, int whence)
+{
+#ifdef _WIN32
+   return ( _fseeki64(fd, pos, whence) );
+#else
+   return ( fseeko(fd, (off_t) pos, whence) );
+#endif
+}
+
+MT_OFFSET MT_TellFile(FILE * fd)
+{
+#ifdef _WIN32
+   return ( _ftelli64(fd) );
+#else
+   return ( (MT_OFFSET) ftello(fd) );
+#endif
+}
+
 /* ------------------------------------------------------------------------ */
 /*                           DEBUGGING UTILITIES                            */
 /* ------------------------------------------------------------------------ */
@@ -31,21 +31,6 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 /*  HASH TABLES FOR GENERATING ADJACENCY LINKS IN THE EXTRACTED TESSELATION  */
 /* ------------------------------------------------------------------------- */
 
-/* ------------------------------------------------------------------------- */
-/*                      CLASS FOR THE BUCKET LISTS                           */
-/* ------------------------------------------------------------------------- */
-
-MT_FacetTileClass :: 
-MT_FacetTileClass (int ind, MT_INDEX t,
-                   MT_INDEX sum_v, MT_INDEX min_v, MT_INDEX max_v)
-{
-  my_i = ind;
-  my_t = t;
-  my_sum = sum_v;
-  my_min = min_v;
-  my_max = max_v;
-}
-
 /* ------------------------------------------------------------------------- */
 /*                         CLASS FOR THE HASH TABLE                          */
 /* ------------------------------------------------------------------------- */
@@ -123,12 +108,15 @@ int MT_HashTableClass ::
 MT_HashTableClass :: 
 MT_HashTableClass(int table_size, MT_MultiTesselation m)
 {  
-  my_table = (MT_FacetTile*) calloc (table_size, sizeof(MT_FacetTile));
+  my_mt = m;
+  my_num = my_scan = 0;
+  my_size = 16;
+  while (my_size < table_size) my_size *= 2;
+  /* calloc is used to set all entries to empty */
+  my_table = (MT_FacetTile) calloc (my_size, sizeof(MT_FacetTileClass));
   if (!my_table)
-  {  MT_Error((char *)"Allocation failed",(char *)"MT_HashTableClass::MT_HashInit");  }
-  else 
-  {  my_size = table_size;
-     my_mt = m;
+  {  MT_Error((char *)"Allocation failed",(char *)"MT_HashTableClass::MT_HashInit");
+     my_size = 0;
   }
 }
 
@@ -136,22 +124,63 @@ MT_HashTableClass(int table_size, MT_MultiTesselation m)
 
 MT_HashTableClass :: ~MT_HashTableClass(void)
 {
-  if (my_size>0)
-  {
-     int i;
-     MT_FacetTile aux;
-     for (i=0;i<my_size;i++) 
-     {
-        while  (aux = my_table[i])
-        {
-           my_table[i] = my_table[i]->my_next;
-           delete aux;
-        }
-     }
-     free(my_table);
+  if (my_table)
+  {  free(my_table);
      my_table = NULL;
-     my_size = 0;
-   }
+  }
+  my_size = my_num = 0;
+}
+
+/* ------------------------------------------------------------------------- */
+
+void MT_HashTableClass :: MT_HashRemove(int i)
+{
+  int j, k;
+  int mask = my_size-1;
+
+  j = i;
+  while (1)
+  {
+    j = (j+1) & mask;
+    if (my_table[j].my_t == MT_NULL_INDEX) break;
+    k = MT_HashIndex(my_table[j].my_sum, my_table[j].my_min, 
+                     my_table[j].my_max);
+    /* the entry in j stays there if its hash code k lies 
+       cyclically in (i,j], otherwise it is moved back to i */
+    if ( (i<=j) ? ((i<k) && (k<=j)) : ((i<k) || (k<=j)) ) continue;
+    my_table[i] = my_table[j];
+    i = j;
+  }
+  my_table[i].my_t = MT_NULL_INDEX;
+  my_num--;
+}
+
+/* ------------------------------------------------------------------------- */
+
+int MT_HashTableClass :: MT_HashGrow(void)
+{
+  MT_FacetTile old_table = my_table;
+  int old_size = my_size;
+  int i, j;
+
+  my_table = (MT_FacetTile) calloc (2*old_size, sizeof(MT_FacetTileClass));
+  if (!my_table)
+  {  MT_Error((char *)"Allocation failed",(char *)"MT_HashTableClass::MT_HashGrow");
+     my_table = old_table;
+     return 0;
+  }
+  my_size = 2*old_size;
+  for (i=0; i<old_size; i++)
+  {
+    if (old_table[i].my_t == MT_NULL_INDEX) continue;
+    j = MT_HashIndex(old_table[i].my_sum, old_table[i].my_min, 
+                     old_table[i].my_max);
+    while (my_table[j].my_t != MT_NULL_INDEX)  j = (j+1) & (my_size-1);
+    my_table[j] = old_table[i];
+  }
+  free(old_table);
+  my_scan = 0;
+  return 1;
 }
 
 /* ------------------------------------------------------------------------- */
@@ -160,39 +189,24 @@ int MT_HashTableClass ::
     MT_HashGet (int ind, MT_INDEX t, int * ii, MT_INDEX * tt)
 {
   int i;
-  MT_INDEX sum_v, min_v, max_v;
-  MT_FacetTile aux; MT_FacetTile aux1;
+  MT_INDEX v, sum_v, min_v, max_v;
 
   if (!my_table)  {  return MT_NULL_INDEX;  }
-  MT_ComputeHints(my_mt->MT_TileVertex(t,ind), t, &sum_v, &min_v, &max_v); 
+  v = my_mt->MT_TileVertex(t,ind);
+  MT_ComputeHints(v, t, &sum_v, &min_v, &max_v); 
   i = MT_HashIndex (sum_v, min_v, max_v);
-  if (!my_table[i]) return MT_NULL_INDEX;
-  if ( MT_SameFacet(my_table[i], my_mt->MT_TileVertex(t,ind), t, 
-                    sum_v, min_v, max_v) )
-  {  (*ii) = my_table[i]->my_i;
-     (*tt) = my_table[i]->my_t;
-     aux = my_table[i];
-     my_table[i] = my_table[i]->my_next;
-     free(aux);
-     return 1;
-  }
-  aux = my_table[i];
-  while (aux->my_next)
+  while (my_table[i].my_t != MT_NULL_INDEX)
   {
-    aux1 = aux->my_next;
-    if ( MT_SameFacet(aux1, my_mt->MT_TileVertex(t,ind), t, 
-                      sum_v, min_v, max_v) )
-    {  (*ii) = aux1->my_i;
-       (*tt) = aux1->my_t;
-       aux->my_next = aux1->my_next;
-       free(aux1);
+    if ( MT_SameFacet(&my_table[i], v, t, sum_v, min_v, max_v) )
+    {  (*ii) = my_table[i].my_i;
+       (*tt) = my_table[i].my_t;
+       MT_HashRemove(i);
        return 1;
     }
-    else aux = aux1;
+    i = (i+1) & (my_size-1);
   }     
   (*ii) = -1;
   (*tt) = MT_NULL_INDEX;
-//fprintf(stderr,"...Non trovato\n");/*********/
   return 0; 
 }
 
@@ -202,18 +216,23 @@ int MT_HashTableClass :: MT_HashPut (int ind, MT_INDEX t)
 { 
   int i;
   MT_INDEX sum_v, min_v, max_v;
-  MT_FacetTile aux;
   
-//fprintf(stderr,"Inserisco %d(%d-esima faccia)\n",t,ind);/*********/
-  MT_ComputeHints(my_mt->MT_TileVertex(t,ind), t, &sum_v, &min_v, &max_v);
-  aux = new MT_FacetTileClass(ind, t, sum_v, min_v, max_v);
-  if (!aux)
-  {  MT_Error((char *)"Allocation failed",(char *)"MT_HashTableClass::MT_HashPut");
+  if (!my_table)  {  return 0;  }
+  /* keep the table at most half full, if it cannot grow go on
+     until it is full */
+  if ( (2*(my_num+1) > my_size) && !MT_HashGrow() && (my_num+1 >= my_size) )
+  {  MT_Error((char *)"Table full",(char *)"MT_HashTableClass::MT_HashPut");
      return 0;
   }
+  MT_ComputeHints(my_mt->MT_TileVertex(t,ind), t, &sum_v, &min_v, &max_v);
   i = MT_HashIndex (sum_v, min_v, max_v);
-  aux->my_next = my_table[i];
-  my_table[i] = aux;
+  while (my_table[i].my_t != MT_NULL_INDEX)  i = (i+1) & (my_size-1);
+  my_table[i].my_i = ind;
+  my_table[i].my_t = t;
+  my_table[i].my_sum = sum_v;
+  my_table[i].my_min = min_v;
+  my_table[i].my_max = max_v;
+  my_num++;
   return 1;
 }
 
@@ -221,24 +240,21 @@ int MT_HashTableClass :: MT_HashPut (int ind, MT_INDEX t)
 
 int MT_HashTableClass :: MT_HashPop(int * ind, MT_INDEX * t)
 { 
-  int i;
-  MT_FacetTile aux;
-
-  i=0;
-  while ( (i<my_size) && (!my_table[i]) ) i++;
-  if (i==my_size)
+  if (my_num==0)
   {
     /* the table is empty */
     (*ind) = -1;
     (*t) = MT_NULL_INDEX;
+    my_scan = 0;
     return 0;
-  }  
-  aux = my_table[i];
-  (*ind) = aux->my_i;
-  (*t) = aux->my_t;
-  my_table[i] = aux->my_next;
-  free(aux);
-  aux = NULL;
+  }
+  /* removing an entry may move back an entry scanned before,
+     thus the scan goes on cyclically */
+  while (my_table[my_scan].my_t == MT_NULL_INDEX)
+     my_scan = (my_scan+1) & (my_size-1);
+  (*ind) = my_table[my_scan].my_i;
+  (*t) = my_table[my_scan].my_t;
+  MT_HashRemove(my_scan);
   return 1;
 }
 
@@ -0,0 +1,169 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_info.c ------------------------------- */
+
+#include "mt_info.h"
+
+/* ------------------------------------------------------------------------ */
+/*                 INFORMATION ON AN MT FILE WITHOUT READING IT             */
+/* ------------------------------------------------------------------------ */
+
+MT_FileInfoClass :: MT_FileInfoClass(void)
+{
+  MT_Reset();
+}
+
+void MT_FileInfoClass :: MT_Reset(void)
+{
+  int j;
+  my_class[0] = '\0';
+  V_Dim = T_Dim = 0;
+  V_Num = T_Num = N_Num = A_Num = 0;
+  my_encoding = MT_ASCII_ENCODING;
+  my_footer = 0;
+  for (j=0; j<MT_MAX_DIM; j++)  {  F_min[j] = F_max[j] = 0.0;  }
+  min_res = max_res = 0;
+  s_num = 0;
+  for (j=0; j<MT_MAX_SECTIONS; j++)  {  s_pos[j] = 0;  }
+}
+
+/* ------------------------------------------------------------------------ */
+/*                                Reading                                   */
+/* ------------------------------------------------------------------------ */
+
+int MT_FileInfoClass :: MT_ReadSummary(FILE * fd)
+{
+  char line[MT_MAX_STRLEN];
+  /* class keyword and parameters, on the rest of the line */
+  if (fscanf(fd, "%99s", my_class) != 1) return 0;
+  if (!fgets(line, MT_MAX_STRLEN, fd)) return 0;
+  sscanf(line, "%d %d", &V_Dim, &T_Dim);
+  if ( (V_Dim<0) || (V_Dim>MT_MAX_DIM) || (T_Dim<0) || (T_Dim>MT_MAX_DIM+1) )
+  {  MT_Error((char *)"Invalid class parameters",
+              (char *)"MT_FileInfoClass::MT_ReadSummary");
+     return 0;
+  }
+  /* object parameters, as many as the class has */
+  if (!MT_SearchKeyword(fd, (char *)MT_OBJECT_KW)) return 0;
+  if (!fgets(line, MT_MAX_STRLEN, fd)) return 0;
+  sscanf(line, "%u %u %u %u", &V_Num, &T_Num, &N_Num, &A_Num);
+  return ( MT_ReadEncoding(fd, &my_encoding) );
+}
+
+int MT_FileInfoClass :: MT_ReadFooter(FILE * fd, long start)
+{
+  char tail[MT_FOOTER_TAIL+1];
+  char kw[MT_MAX_STRLEN];
+  int len = strlen(MT_FOOTER_AT_KW);
+  long size, end, pos, obj;
+  int i, j, n;
+  if (fseek(fd, 0, SEEK_END) != 0) return 0;
+  if ( (size = ftell(fd)) <= 0 ) return 0;
+  /* the last line of each object gives the offset of its footer and 
+     the one where the object starts, which is the end of the previous
+     object: go back from the end of the file to the object at start */
+  end = size;
+  while (1)
+  {
+    n = (end > MT_FOOTER_TAIL) ? MT_FOOTER_TAIL : (int) end;
+    if (fseek(fd, end-n, SEEK_SET) != 0) return 0;
+    n = fread(tail, 1, n, fd);
+    tail[n] = '\0';
+    pos = 0;  obj = -1;
+    for (i=n-len; i>=0; i--)
+    {  if (!memcmp(tail+i, MT_FOOTER_AT_KW, len))
+       {  sscanf(tail+i+len, "%ld %ld", &pos, &obj);
+          break;
+       }
+    }
+    if ( (pos <= start) || (pos >= end) ) return 0;
+    /* without the start of the object, the footer is taken only for
+       the whole file */
+    if ( (obj < 0) && (start == 0) && (end == size) ) break;
+    if (obj == start) break;
+    if ( (obj < start) || (obj >= end) ) return 0;
+    end = obj;
+  }
+  /* the footer */
+  if (fseek(fd, pos, SEEK_SET) != 0) return 0;
+  if ( (fscanf(fd, "%99s", kw) != 1) || strcmp(kw, MT_FOOTER_KW) ) return 0;
+  if (!MT_ReadSummary(fd)) return 0;
+  if (!MT_SearchKeyword(fd, (char *)MT_BOX_KW)) return 0;
+  for (j=0; j<V_Dim; j++)  {  if (!MT_ScanFloat(fd, &F_min[j])) return 0;  }
+  for (j=0; j<V_Dim; j++)  {  if (!MT_ScanFloat(fd, &F_max[j])) return 0;  }
+  if (!MT_SearchKeyword(fd, (char *)MT_RESOLUTION_KW)) return 0;
+  if (!MT_ScanIndex(fd, &min_res) || !MT_ScanIndex(fd, &max_res)) return 0;
+  if (!MT_SearchKeyword(fd, (char *)MT_SECTIONS_KW)) return 0;
+  if (!MT_ScanInt(fd, &s_num)) return 0;
+  if ( (s_num<0) || (s_num>MT_MAX_SECTIONS) ) return 0;
+  for (j=0; j<s_num; j++)
+  {  if ( (fscanf(fd, "%ld", &s_pos[j]) != 1) || (s_pos[j]<0) || 
+          (s_pos[j]>=pos) || (s_pos[j] && (s_pos[j]<start)) ) return 0;
+  }
+  /* leave the file at the end of the object */
+  return ( fseek(fd, end, SEEK_SET) == 0 );
+}
+
+int MT_FileInfoClass :: MT_Read(FILE * fd)
+{
+  long start = ftell(fd);
+  MT_Reset();
+  /* the footer, if the file has one */
+  if (start >= 0)
+  {  if (MT_ReadFooter(fd, start))
+     {  my_footer = 1;
+        return 1;
+     }
+     MT_Reset();
+     if (fseek(fd, start, SEEK_SET) != 0) return 0;
+  }
+  /* otherwise, the header */
+  if ( (!MT_ReadFileKw(fd)) || (!MT_ReadSummary(fd)) )
+  {  MT_Warning((char *)"Not an MT file",(char *)"MT_FileInfoClass::MT_Read");
+     MT_Reset();
+     return 0;
+  }
+  return 1;
+}
+
+int MT_FileInfoClass :: MT_Read(char * fname)
+{
+  FILE * fd = fopen(fname,"r");
+  int ok = 0;
+  if (fd) 
+  {  ok = MT_Read(fd);
+     fclose(fd);
+  }
+  return ok;
+}
+
+int MT_FileInfoClass :: MT_SeekSection(FILE * fd, int s)
+{
+  long pos = MT_SectionOffset(s);
+  return ( pos && (fseek(fd, pos, SEEK_SET) == 0) );
+}
+
+/* ------------------------------------------------------------------------ */
@@ -56,9 +56,10 @@ int MT_IntTableClass ::
            MT_WarningC(err_msg,(char *)"MT_IntTableClass",(char *)"MT_ReadAttr");
            return 0;
         }
+        if (swap_bytes) MT_SwapArray(&att_Arr[i], sizeof(int), 1);
         break;
      case MT_ASCII_ENCODING:
-        if ( fscanf(fd, "%d", &att_Arr[i]) != 1 )
+        if ( !MT_ScanInt(fd, &att_Arr[i]) )
         {
            MT_WarningC(err_msg,(char *)"MT_IntTableClass",(char *)"MT_ReadAttr");
            return 0;
@@ -66,7 +67,7 @@ int MT_IntTableClass ::
         break;   
   }
   if (att_Arr[i] < bound[0]) bound[0] = att_Arr[i];
-  else if (att_Arr[i] > bound[1]) bound[1] = att_Arr[i];
+  if (att_Arr[i] > bound[1]) bound[1] = att_Arr[i];
   return 1;
 }
 
@@ -104,8 +105,47 @@ int MT_IntTableClass :: MT_ReadObjParams(FILE * fd)
 
 int MT_IntTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
 {  
-  MT_SetAttrNum(my_num);
-  return ( MT_AttrTableClass::MT_ReadBody(fd,file_encoding) );
+  int ok = 1;
+  if (!MT_SetAttrNum(my_num)) return 0;
+  /* read all values directly into the array, then update the bound */
+  if (file_encoding==MT_BINARY_ENCODING)
+     ok = MT_ReadArray(fd, att_Arr+1, sizeof(int), my_num);
+  else ok = MT_ScanArray(fd, 0, NULL, my_num, (MT_INDEX *) (att_Arr+1));
+  if (ok) MT_UpdateBound();
+  return ok;
+}
+
+void MT_IntTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
+{  
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(att_Arr+1, sizeof(int), my_num, fd);
+  else MT_AttrTableClass::MT_WriteBody(fd, file_encoding);
+}
+
+void MT_IntTableClass :: MT_UpdateBound(void)
+{
+  /* four independent minima and maxima, on consecutive values, so that 
+     the loop can be executed with vector instructions */
+  int mn[4], mx[4];
+  MT_INDEX i;
+  int j;
+  for (j=0; j<4; j++)  {  mn[j] = bound[0];  mx[j] = bound[1];  }
+  for (i=1; i+3<=my_num; i+=4)
+  {  for (j=0; j<4; j++)
+     {  mn[j] = (att_Arr[i+j] < mn[j]) ? att_Arr[i+j] : mn[j];
+        mx[j] = (att_Arr[i+j] > mx[j]) ? att_Arr[i+j] : mx[j];
+     }
+  }
+  for ( ; i<=my_num; i++)
+  {  mn[0] = (att_Arr[i] < mn[0]) ? att_Arr[i] : mn[0];
+     mx[0] = (att_Arr[i] > mx[0]) ? att_Arr[i] : mx[0];
+  }
+  for (j=1; j<4; j++)
+  {  if (mn[j] < mn[0]) mn[0] = mn[j];
+     if (mx[j] > mx[0]) mx[0] = mx[j];
+  }
+  bound[0] = mn[0];
+  bound[1] = mx[0];
 }
 
 void MT_IntTableClass :: MT_WriteObjParams(FILE * fd)
@@ -128,6 +168,7 @@ MT_IntTableClass :: MT_IntTableClass(void)
 MT_IntTableClass ::  ~MT_IntTableClass(void) 
 {
 //  MT_MessageC("","MT_IntTableClass","Destructor");
+  MT_WaitWrite();
   if (att_Arr) {  free (att_Arr);  }  }
 
 /* ------------------------------------------------------------------------ */
@@ -143,6 +184,7 @@ MT_IntBuildingInterfaceClass :: MT_IntBuildingInterfaceClass( void )
 
 MT_IntBuildingInterfaceClass :: ~MT_IntBuildingInterfaceClass( void )
 {
+  MT_WaitWrite();
   if (spec_attr) delete spec_attr;
   spec_attr = NULL;  my_attr = NULL;
 }
@@ -183,9 +225,10 @@ int MT_IntVectorTableClass ::
                        (char *)"MT_IntVectorTableClass",(char *)"MT_ReadAttr");
              return 0;
           }
+          if (swap_bytes) MT_SwapArray(&av_Arr[j+i*vector_size], sizeof(int), 1);
           break;
        case MT_ASCII_ENCODING:
-          if ( fscanf(fd, "%d", &av_Arr[j+i*vector_size]) != 1 )
+          if ( !MT_ScanInt(fd, &av_Arr[j+i*vector_size]) )
           {
              MT_ErrorC((char *)"Cannot read vector element",
                        (char *)"MT_IntVectorTableClass",(char *)"MT_ReadAttr");
@@ -246,13 +289,14 @@ int MT_IntVectorTableClass :: MT_ReadObjParams(FILE * fd)
 
 int MT_IntVectorTableClass :: MT_ReadBody(FILE * fd, int file_encoding)
 {  
-  unsigned int i;
   /* allocate int array */
   if (!MT_SetAttrNum(my_num)) return 0;
-  /* read the values and fill the array */
-  for (i=1; i<my_num+1; i++)
-  {  if (!MT_ReadAttr(fd, i, file_encoding)) return 0;  }
-  return 1;
+  /* read all vectors directly into the array */
+  if (file_encoding==MT_BINARY_ENCODING)
+     return ( MT_ReadArray(fd, av_Arr+vector_size, 
+                           sizeof(int), my_num*vector_size) );
+  return ( MT_ScanArray(fd, 0, NULL, my_num*vector_size, 
+                        (MT_INDEX *) (av_Arr+vector_size)) );
 }
 
 void MT_IntVectorTableClass :: MT_WriteClassAndParams(FILE * fd)
@@ -270,8 +314,12 @@ void MT_IntVectorTableClass :: MT_WriteObjParams(FILE * fd)
 void MT_IntVectorTableClass :: MT_WriteBody(FILE * fd, int file_encoding)
 {  
   unsigned int i;
-  for (i=1; i<my_num+1; i++)
-  {  MT_WriteAttr(fd, i, file_encoding);  }
+  if (file_encoding==MT_BINARY_ENCODING)
+     fwrite(av_Arr+vector_size, sizeof(int), my_num*vector_size, fd);
+  else
+  {  for (i=1; i<my_num+1; i++)
+     {  MT_WriteAttr(fd, i, file_encoding);  }
+  }
 }
 
 /* ------------------------------------------------------------------------ */
@@ -304,7 +352,10 @@ MT_IntVectorTableClass :: MT_IntVectorTableClass(int num)
 }
        
 MT_IntVectorTableClass :: ~MT_IntVectorTableClass(void)
-{  if (my_num) free(av_Arr);  av_Arr = NULL;  }
+{
+  MT_WaitWrite();
+  {  if (my_num) free(av_Arr);  av_Arr = NULL;  }
+}
 
 /* ------------------------------------------------------------------------ */
 /*               BUILDING INTERFACE FOR int VECTOR ATTRIBUTES               */  
@@ -319,6 +370,7 @@ MT_IntVectorBuildingInterfaceClass :: MT_IntVectorBuildingInterfaceClass( int nu
 
 MT_IntVectorBuildingInterfaceClass :: ~MT_IntVectorBuildingInterfaceClass( void )
 {
+  MT_WaitWrite();
   if (spec_attr) free (spec_attr);
   my_attr = NULL; spec_attr = NULL;
 }
@@ -337,4 +389,4 @@ int MT_IntVectorBuildingInterfaceClass :: MT_MakeAttrVector(MT_INDEX i, int *v)
 }
 
 /* ------------------------------------------------------------------------ */
-
+
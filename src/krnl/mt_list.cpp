@@ -119,3 +119,167 @@ int MT_ListClass :: MT_IsInList(MT_INDEX i)
   /* else the list contains at least two elements */
   return (prev[i] || next[i]);
 }
+
+/* ---------------------------------------------------------------------- */
+/*                    PRIORITY QUEUES OF MT INDEXES                       */
+/* ---------------------------------------------------------------------- */
+
+MT_HeapClass :: MT_HeapClass(int sz)
+{
+   if (sz<1) sz = 1;
+   elem = (MT_INDEX *) malloc ( sz * sizeof(MT_INDEX) );
+   prio = (float *) malloc ( sz * sizeof(float) );
+   if (! (elem && prio) )
+   {
+     if (elem) free(elem);
+     if (prio) free(prio);
+     MT_FatalError((char*)"Allocation failed",(char *)"MT_HeapClass Creator");
+   }
+   num = 0;
+   size = sz;
+}
+
+/* ---------------------------------------------------------------------- */
+
+MT_HeapClass :: ~MT_HeapClass(void)
+{
+   free(elem);
+   free(prio);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MT_HeapClass :: MT_HeapPush(MT_INDEX i, float p)
+{
+   MT_INDEX * e1;  /* enlarged arrays */
+   float * p1;
+   int k, h;       /* positions in the heap */
+
+   if (num==size)
+   {
+     e1 = (MT_INDEX *) realloc ( elem, 2 * size * sizeof(MT_INDEX) );
+     if (e1) elem = e1;
+     p1 = (float *) realloc ( prio, 2 * size * sizeof(float) );
+     if (p1) prio = p1;
+     if (! (e1 && p1) )
+     {
+       MT_Error((char*)"Allocation failed",(char *)"MT_HeapClass::MT_HeapPush");
+       return 0;
+     }
+     size *= 2;
+   }
+   /* move the new element up from the last position */
+   k = num++;
+   while (k>0)
+   {
+     h = (k-1)/2;
+     if (prio[h] >= p) break;
+     elem[k] = elem[h];  prio[k] = prio[h];
+     k = h;
+   }
+   elem[k] = i;  prio[k] = p;
+   return 1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MT_HeapClass :: MT_HeapPop(MT_INDEX * i, float * p)
+{
+   MT_INDEX i1;  /* last element, to be moved down from the top */
+   float p1;
+   int k, h;     /* positions in the heap */
+
+   if (num==0) return 0;
+   (*i) = elem[0];  (*p) = prio[0];
+   i1 = elem[--num];  p1 = prio[num];
+   k = 0;
+   while ( (h = 2*k+1) < num )
+   {
+     if ( (h+1<num) && (prio[h+1] > prio[h]) ) h++;
+     if (p1 >= prio[h]) break;
+     elem[k] = elem[h];  prio[k] = prio[h];
+     k = h;
+   }
+   elem[k] = i1;  prio[k] = p1;
+   return 1;
+}
+
+/* ---------------------------------------------------------------------- */
+/*                     SPARSE TABLES OF MT INDEXES                        */
+/* ---------------------------------------------------------------------- */
+
+MT_MarkTableClass :: MT_MarkTableClass(int sz)
+{
+   /* round the size to a power of two */
+   size = 2;
+   while (size<sz) size *= 2;
+   entry = (MT_MarkEntry *) calloc ( size, sizeof(MT_MarkEntry) );
+   /* calloc also initializes all entries to zeroes */
+   if (!entry)
+   {
+     MT_FatalError((char*)"Allocation failed",(char *)"MT_MarkTableClass Creator");
+   }
+   num = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+MT_MarkTableClass :: ~MT_MarkTableClass(void)
+{
+   free(entry);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void MT_MarkTableClass :: MT_EmptyTable(void)
+{
+   if (num)
+   {
+     memset(entry, 0, size*sizeof(MT_MarkEntry));
+     num = 0;
+   }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int MT_MarkTableClass :: MT_GrowTable(void)
+{
+   MT_MarkEntry * e1 = entry; /* old array */
+   int s1 = size;
+   int h, p;
+
+   entry = (MT_MarkEntry *) calloc ( 2*size, sizeof(MT_MarkEntry) );
+   if (!entry)
+   {
+     entry = e1;
+     MT_Error((char*)"Allocation failed",(char *)"MT_MarkTableClass::MT_SetMark");
+     return 0;
+   }
+   /* put the elements in the new array */
+   size *= 2;
+   for (h=0; h<s1; h++)
+   {
+     if (e1[h].my_key)
+     {  p = MT_TablePos(e1[h].my_key);
+        entry[p] = e1[h];
+     }
+   }
+   free(e1);
+   return 1;
+}
+
+int MT_MarkTableClass :: MT_SetMark(MT_INDEX i, unsigned int v)
+{
+   int h = MT_TablePos(i);
+   if (!entry[h].my_key)
+   {
+     /* new element, enlarge the table if it would be more than half 
+        full */
+     if ( (2*(num+1) > size) && !MT_GrowTable() )  return 0;
+     h = MT_TablePos(i);
+     entry[h].my_key = i;
+     num++;
+   }
+   entry[h].my_mark = v;
+   return 1;
+}
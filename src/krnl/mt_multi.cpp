@@ -25,6 +25,12 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 /* ----------------------------- mt_multi.c ------------------------------- */
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #include "mt_multi.h"
 
 /* ------------------------------------------------------------------------ */
@@ -122,7 +128,9 @@ int MT_MultiTesselationClass :: MT_AddTileArc (MT_INDEX t, MT_INDEX a)
 
 int MT_MultiTesselationClass :: MT_SetArcNum(MT_INDEX i)
 {
-  if (A_Arr) free (A_Arr); A_Arr = NULL;
+  if (MT_FrozenError((char *)"MT_MultiTesselationClass::MT_SetArcNum"))
+     return 0;
+  MT_FreeArray (A_Arr); A_Arr = NULL;
   A_Arr = (MT_Arc *) calloc ( i+1, sizeof(MT_Arc) );
   if (A_Arr) 
   {  A_Num = i; return 1;  }
@@ -134,7 +142,9 @@ int MT_MultiTesselationClass :: MT_SetArcNum(MT_INDEX i)
 
 int MT_MultiTesselationClass :: MT_SetNodeNum(MT_INDEX i)
 {
-  if (N_Arr) free (N_Arr); N_Arr = NULL;
+  if (MT_FrozenError((char *)"MT_MultiTesselationClass::MT_SetNodeNum"))
+     return 0;
+  MT_FreeArray (N_Arr); N_Arr = NULL;
   N_Arr = (MT_Node *) calloc ( i+1, sizeof(MT_Node) );
   if (N_Arr)
   {  N_Num = i; return 1;  }
@@ -144,10 +154,19 @@ int MT_MultiTesselationClass :: MT_SetNodeNum(MT_INDEX i)
   return 0;
 }
 
+int MT_MultiTesselationClass :: MT_SetVertexNum (MT_INDEX i)
+{
+  if (MT_FrozenError((char *)"MT_MultiTesselationClass::MT_SetVertexNum"))
+     return 0;
+  return ( MT_TileSetClass::MT_SetVertexNum(i) );
+}
+
 int MT_MultiTesselationClass :: MT_SetTileNum (MT_INDEX i)
 {
+  if (MT_FrozenError((char *)"MT_MultiTesselationClass::MT_SetTileNum"))
+     return 0;
   if ( MT_TileSetClass::MT_SetTileNum(i) )
-  {  if (TA_Arr) free (TA_Arr); TA_Arr = NULL;
+  {  MT_FreeArray (TA_Arr); TA_Arr = NULL;
      TA_Arr = (MT_TileToArc *) calloc ( i+1, sizeof(MT_TileToArc) );
      if (TA_Arr) 
      {  T_Num = i; return 1;  }
@@ -167,16 +186,25 @@ MT_MultiTesselationClass (int vert_dim, int tile_dim)
   TA_Arr = NULL;
   A_Arr = NULL;
   N_Arr = NULL;
+  stream_fd = NULL;
+  stream_own = 0;
+  N_Read = 0;
+  N_Loaded = NULL;
+  frozen = 0;
 }
 
 MT_MultiTesselationClass :: ~MT_MultiTesselationClass ( void )
 {
    MT_Message((char *)"",(char *)"MT_MultiTesselation Destructor");
+   MT_WaitWrite();
    /* Arrays all_vert, all_coord, V_Arr, T_Arr, F_min, F_max are already
-      freed by the destructor of superclass MT_TileSetClass */
-   if (TA_Arr) free (TA_Arr); TA_Arr = NULL;
-   if (A_Arr) free (A_Arr); A_Arr = NULL;
-   if (N_Arr) free (N_Arr); N_Arr = NULL;
+      freed by the destructor of superclass MT_TileSetClass, which also
+      releases the file mapping */
+   MT_FreeArray (TA_Arr); TA_Arr = NULL;
+   MT_FreeArray (A_Arr); A_Arr = NULL;
+   MT_FreeArray (N_Arr); N_Arr = NULL;
+   MT_CloseStream();
+   if (N_Loaded) free(N_Loaded); N_Loaded = NULL;
 }
 
 
@@ -236,14 +264,62 @@ int MT_MultiTesselationClass :: MT_ReadObjParams(FILE * fd)
    return 0;
 }
 
+int MT_MultiTesselationClass :: MT_HasBodyLayout(int file_encoding)
+{
+  return ( (file_encoding==MT_STREAM_ENCODING) ||
+           MT_TileSetClass::MT_HasBodyLayout(file_encoding) );
+}
+
 int MT_MultiTesselationClass :: MT_ReadBody(FILE * fd, int file_encoding)
 {  
    int i;
+   MT_INDEX a;
+   if (MT_FrozenError((char *)"MT_MultiTesselationClass::MT_ReadBody"))
+      return 0;
+   /* stop a progressive loading, if any */
+   MT_CloseStream();
+   if (N_Loaded) free(N_Loaded); N_Loaded = NULL;
+   if (file_encoding==MT_STREAM_ENCODING)
+   {
+     if (!MT_StartStream(fd)) return 0;
+     while (N_Loaded)
+     {  if (!MT_ReadStreamNode(fd)) return 0;  }
+     return 1;
+   }
+   if (file_encoding==MT_MAPPED_ENCODING)
+   {
+     /* release the current arrays before the mapping is replaced */
+     MT_FreeArray (TA_Arr); TA_Arr = NULL;
+     MT_FreeArray (A_Arr); A_Arr = NULL;
+     MT_FreeArray (N_Arr); N_Arr = NULL;
+     /* map vertices and tiles */
+     if (!MT_TileSetClass::MT_ReadBody(fd, file_encoding)) return 0;
+     /* tile-to-arc, arc and node arrays are stored as they are,
+        no need to rebuild the node array from the arcs */
+     TA_Arr = (MT_TileToArc *) MT_MapSection(fd, (T_Num+1)*sizeof(MT_TileToArc));
+     A_Arr = (MT_Arc *) MT_MapSection(fd, (A_Num+1)*sizeof(MT_Arc));
+     N_Arr = (MT_Node *) MT_MapSection(fd, (N_Num+1)*sizeof(MT_Node));
+     if (! (TA_Arr && A_Arr && N_Arr) )
+     {  MT_Error((char *)"Cannot load mapped sections",
+                 (char *)"MT_MultiTesselationClass::MT_ReadBody");
+        return 0;
+     }
+     MT_SeekFile(fd, map_pos, SEEK_SET);
+     return 1;
+   }
    /* read vertices and tiles */
    if (!MT_TileSetClass::MT_ReadBody(fd, file_encoding)) return 0;
    /* allocate node array and arc array */
    if (!MT_SetNodeNum(N_Num)) return 0;
    if (!MT_SetArcNum(A_Num)) return 0;
+   if (file_encoding==MT_COMPRESSED_ENCODING)
+   {
+     /* decode the arcs, then link them to their nodes */
+     if (!MT_ReadBlocks(fd, MT_ARC_SECTION, A_Num)) return 0;
+     for (a=1; a<=A_Num; a++)
+     {  MT_AddArc(a, A_Arr[a].my_node[0], A_Arr[a].my_node[1]);  }
+     return 1;
+   }
    /* read arcs */
    for (i=1; i<A_Num+1; i++)
    {
@@ -294,8 +370,30 @@ void MT_MultiTesselationClass :: MT_WriteObjParams(FILE * fd)
 void MT_MultiTesselationClass :: MT_WriteBody(FILE * fd, int file_encoding)
 {  
    int i;
+   if (file_encoding==MT_STREAM_ENCODING)
+   {
+     MT_WriteStream(fd);
+     return;
+   }
    /* write vertice and tiles */
    MT_TileSetClass::MT_WriteBody(fd, file_encoding);
+   if (file_encoding==MT_MAPPED_ENCODING)
+   {
+     /* write the arrays as they are */
+     s_pos[MT_TILEARC_SECTION] = 
+         MT_WriteSection(fd, TA_Arr, (T_Num+1)*sizeof(MT_TileToArc));
+     s_pos[MT_ARC_SECTION] = 
+         MT_WriteSection(fd, A_Arr, (A_Num+1)*sizeof(MT_Arc));
+     s_pos[MT_NODE_SECTION] = 
+         MT_WriteSection(fd, N_Arr, (N_Num+1)*sizeof(MT_Node));
+     return;
+   }
+   s_pos[MT_ARC_SECTION] = ftell(fd);
+   if (file_encoding==MT_COMPRESSED_ENCODING)
+   {
+     MT_WriteBlocks(fd, MT_ARC_SECTION, A_Num);
+     return;
+   }
    /* write arcs */
    for (i=1; i<A_Num+1; i++)
    {
@@ -305,3 +403,526 @@ void MT_MultiTesselationClass :: MT_WriteBody(FILE * fd, int file_encoding)
 }
 
 /* ------------------------------------------------------------------------ */
+/*                       Stream encoding and loading                        */
+/* ------------------------------------------------------------------------ */
+
+int MT_MultiTesselationClass :: MT_StartStream(FILE * fd)
+{
+   if (N_Loaded) free(N_Loaded); N_Loaded = NULL;
+   N_Read = 0;
+   /* allocate all arrays, entities are loaded at their position */
+   if (!MT_SetVertexNum(V_Num)) return 0;
+   if (!MT_SetTileNum(T_Num)) return 0;
+   if (!MT_SetNodeNum(N_Num)) return 0;
+   if (!MT_SetArcNum(A_Num)) return 0;
+   if ( !MT_ReadArray(fd, F_min, sizeof(float), V_Dim) ||
+        !MT_ReadArray(fd, F_max, sizeof(float), V_Dim) )
+   {  MT_Error((char *)"Cannot read bounding box",
+               (char *)"MT_MultiTesselationClass::MT_StartStream");
+      return 0;
+   }
+   if (N_Num)
+   {  N_Loaded = (char *) calloc ( N_Num+1, sizeof(char) );
+      if (!N_Loaded)
+      {  MT_Error((char *)"Allocation failed",
+                  (char *)"MT_MultiTesselationClass::MT_StartStream");
+         return 0;
+      }
+   }
+   return 1;
+}
+
+int MT_MultiTesselationClass :: MT_ReadStreamNode(FILE * fd)
+{
+   MT_INDEX n, v, a, d, t, first_a, first_t;
+   int i, j, num, arc_num;
+   /* the node, which must not be loaded, the first one being the root */
+   if (!MT_ReadIndex(fd, &n, MT_BINARY_ENCODING)) return 0;
+   if ( (n==MT_NULL_INDEX) || (n>N_Num) || N_Loaded[n] ||
+        ( (N_Read==0) && (n!=MT_Root()) ) )
+   {  MT_Error((char *)"Invalid node",
+               (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+      return 0;
+   }
+   /* new vertices */
+   if (!MT_ReadCount(fd, &num, MT_BINARY_ENCODING)) return 0;
+   if ( (num<0) || ((MT_INDEX)num>V_Num) )
+   {  MT_Error((char *)"Invalid number of vertices",
+               (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+      return 0;
+   }
+   for (i=0; i<num; i++)
+   {
+     if (!MT_ReadIndex(fd, &v, MT_BINARY_ENCODING)) return 0;
+     if ( (v==MT_NULL_INDEX) || (v>V_Num) )
+     {  MT_Error((char *)"Invalid vertex",
+                 (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+        return 0;
+     }
+     if (!MT_ReadArray(fd, V_Arr[v].my_coord, sizeof(float), V_Dim)) 
+        return 0;
+   }
+   /* arcs leaving n, stored at consecutive positions */
+   if (!MT_ReadCount(fd, &arc_num, MT_BINARY_ENCODING)) return 0;
+   first_a = MT_NULL_INDEX;
+   if ( (arc_num>0) && !MT_ReadIndex(fd, &first_a, MT_BINARY_ENCODING) )
+      return 0;
+   if ( (arc_num<0) || ((MT_INDEX)arc_num>A_Num) || 
+        ( (arc_num>0) && ( (first_a==MT_NULL_INDEX) || 
+                           (first_a>A_Num+1-arc_num) ) ) )
+   {  MT_Error((char *)"Invalid arcs",
+               (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+      return 0;
+   }
+   for (a=first_a; a<first_a+arc_num; a++)
+   {
+     /* the destination must not be loaded yet, so that the arcs 
+        entering a loaded node are all known */
+     if (!MT_ReadIndex(fd, &d, MT_BINARY_ENCODING)) return 0;
+     if ( (A_Arr[a].my_node[0]!=MT_NULL_INDEX) || 
+          (d==MT_NULL_INDEX) || (d>N_Num) || (d==n) || N_Loaded[d] )
+     {  MT_Error((char *)"Nodes not in topological order",
+                 (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+        return 0;
+     }
+     /* tiles of the arc, stored at consecutive positions */
+     if (!MT_ReadCount(fd, &num, MT_BINARY_ENCODING)) return 0;
+     first_t = MT_NULL_INDEX;
+     if ( (num>0) && !MT_ReadIndex(fd, &first_t, MT_BINARY_ENCODING) )
+        return 0;
+     if ( (num<0) || ((MT_INDEX)num>T_Num) ||
+          ( (num>0) && ( (first_t==MT_NULL_INDEX) || 
+                         (first_t>T_Num+1-num) ) ) )
+     {  MT_Error((char *)"Invalid tiles",
+                 (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+        return 0;
+     }
+     for (t=first_t; t<first_t+num; t++)
+     {  if (TA_Arr[t].my_arc!=MT_NULL_INDEX)
+        {  MT_Error((char *)"Tile in two arcs",
+                    (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+           return 0;
+        }
+     }
+     if ( (num>0) &&
+          !MT_ReadArray(fd, T_Arr[first_t].my_vertex, sizeof(MT_INDEX),
+                        num*T_Dim) ) return 0;
+     for (t=first_t; t<first_t+num; t++)
+     {  for (j=0; j<T_Dim; j++)
+        {  if ( (T_Arr[t].my_vertex[j]==MT_NULL_INDEX) || 
+                (T_Arr[t].my_vertex[j]>V_Num) )
+           {  MT_Error((char *)"Invalid vertex",
+                       (char *)"MT_MultiTesselationClass::MT_ReadStreamNode");
+              return 0;
+           }
+        }
+        MT_AddTileArc(t, a);
+     }
+     MT_AddArc(a, n, d);
+   }
+   /* now n can be used */
+   N_Loaded[n] = 1;
+   if (++N_Read==N_Num)  {  free(N_Loaded); N_Loaded = NULL;  }
+   return 1;
+}
+
+int MT_MultiTesselationClass :: MT_OpenStream(FILE * fd)
+{
+   int file_encoding;
+   if (MT_FrozenError((char *)"MT_MultiTesselationClass::MT_OpenStream"))
+      return 0;
+   MT_CloseStream();
+   if (!MT_ReadHeader(fd, &file_encoding)) return 0;
+   if (file_encoding!=MT_STREAM_ENCODING)
+   {  MT_Error((char *)"File not in stream encoding",
+               (char *)"MT_MultiTesselationClass::MT_OpenStream");
+      return 0;
+   }
+   if (!MT_StartStream(fd)) return 0;
+   stream_fd = fd;
+   stream_own = 0;
+   /* load the root */
+   return ( MT_ReadStream(1) );
+}
+
+int MT_MultiTesselationClass :: MT_OpenStream(char * fname)
+{
+   FILE * fd = fopen(fname,"r");
+   if (!fd)
+   {  MT_Error((char *)"Cannot open file",
+               (char *)"MT_MultiTesselationClass::MT_OpenStream");
+      return 0;
+   }
+   setvbuf(fd, NULL, _IOFBF, MT_READ_BUFFER);
+   if (!MT_OpenStream(fd))
+   {  fclose(fd);
+      return 0;
+   }
+   /* the file is closed here if all nodes have already been loaded */
+   if (stream_fd) stream_own = 1;
+   else fclose(fd);
+   return 1;
+}
+
+int MT_MultiTesselationClass :: MT_ReadStream(MT_INDEX node_num)
+{
+   MT_INDEX i;
+   int ok = 1;
+   if (!N_Loaded)  {  MT_CloseStream(); return 1;  }
+   if (!stream_fd)
+   {  MT_Error((char *)"No file being loaded",
+               (char *)"MT_MultiTesselationClass::MT_ReadStream");
+      return 0;
+   }
+   for (i=0; ok && N_Loaded && ( (node_num==0) || (i<node_num) ); i++)
+   {  ok = MT_ReadStreamNode(stream_fd);  }
+   if ( (!ok) || (!N_Loaded) ) MT_CloseStream();
+   return ok;
+}
+
+void MT_MultiTesselationClass :: MT_CloseStream(void)
+{
+   if (stream_fd && stream_own) fclose(stream_fd);
+   stream_fd = NULL;
+   stream_own = 0;
+}
+
+void MT_MultiTesselationClass :: MT_WriteStream(FILE * fd)
+{
+   MT_INDEX * order; /* nodes in topological order */
+   MT_INDEX * count; /* for each node, number of parents not yet visited */
+   char * v_done;    /* for each vertex, 1 if written, 2 if to be written */
+   MT_INDEX i, k, n, a, t, v;
+   int j, num;
+   for (j=0; j<MT_MAX_SECTIONS; j++)  s_pos[j] = 0;
+   fwrite(F_min, sizeof(float), V_Dim, fd);
+   fwrite(F_max, sizeof(float), V_Dim, fd);
+   order = (MT_INDEX *) malloc ( (N_Num+1)*sizeof(MT_INDEX) );
+   count = (MT_INDEX *) malloc ( (N_Num+1)*sizeof(MT_INDEX) );
+   v_done = (char *) calloc ( V_Num+1, sizeof(char) );
+   if ( !(order && count && v_done) )
+   {  MT_Error((char *)"Allocation failed",
+               (char *)"MT_MultiTesselationClass::MT_WriteStream");
+      if (order) free(order);
+      if (count) free(count);
+      if (v_done) free(v_done);
+      return;
+   }
+   /* topological order, visiting a node when all its parents have 
+      been visited, starting from the root (breadth-first) */
+   for (k=0, n=1; n<=N_Num; n++)
+   {  count[n] = MT_NumInArcs(n);
+      if (count[n]==0) order[k++] = n;
+   }
+   for (i=0; i<k; i++)
+   {  n = order[i];
+      for (a=MT_FirstOutArc(n); a!=MT_NULL_INDEX; a=MT_NextOutArc(n,a))
+      {  if (--count[MT_ArcDest(a)]==0) order[k++] = MT_ArcDest(a);  }
+   }
+   for (i=0; i<k; i++)
+   {
+     n = order[i];
+     MT_WriteIndex(fd, n, MT_BINARY_ENCODING);
+     /* mark the vertices used for the first time by the tiles of n
+        (and, at the last node, the vertices never used) */
+     num = 0;
+     for (a=MT_FirstOutArc(n); a!=MT_NULL_INDEX; a=MT_NextOutArc(n,a))
+     {  for (t=MT_FirstArcTile(a); t!=MT_NULL_INDEX; t=MT_NextArcTile(a,t))
+        {  for (j=0; j<T_Dim; j++)
+           {  v = MT_TileVertex(t,j);
+              if (!v_done[v])  {  v_done[v] = 2; num++;  }
+           }
+        }
+     }
+     if (i==k-1)
+     {  for (v=1; v<=V_Num; v++)
+        {  if (!v_done[v])  {  v_done[v] = 2; num++;  }  }
+     }
+     /* write them in the same order */
+     MT_WriteCount(fd, num, MT_BINARY_ENCODING);
+     for (a=MT_FirstOutArc(n); a!=MT_NULL_INDEX; a=MT_NextOutArc(n,a))
+     {  for (t=MT_FirstArcTile(a); t!=MT_NULL_INDEX; t=MT_NextArcTile(a,t))
+        {  for (j=0; j<T_Dim; j++)
+           {  v = MT_TileVertex(t,j);
+              if (v_done[v]==2)
+              {  MT_WriteIndex(fd, v, MT_BINARY_ENCODING);
+                 fwrite(MT_VertexCoords(v), sizeof(float), V_Dim, fd);
+                 v_done[v] = 1;
+              }
+           }
+        }
+     }
+     if (i==k-1)
+     {  for (v=1; v<=V_Num; v++)
+        {  if (v_done[v]==2)
+           {  MT_WriteIndex(fd, v, MT_BINARY_ENCODING);
+              fwrite(MT_VertexCoords(v), sizeof(float), V_Dim, fd);
+              v_done[v] = 1;
+           }
+        }
+     }
+     /* arcs leaving n, and their tiles */
+     a = MT_FirstOutArc(n);
+     MT_WriteCount(fd, ( a ? MT_NumOutArcs(n) : 0 ), MT_BINARY_ENCODING);
+     if (a) MT_WriteIndex(fd, a, MT_BINARY_ENCODING);
+     for ( ; a!=MT_NULL_INDEX; a=MT_NextOutArc(n,a))
+     {
+       MT_WriteIndex(fd, MT_ArcDest(a), MT_BINARY_ENCODING);
+       t = MT_FirstArcTile(a);
+       MT_WriteCount(fd, ( t ? MT_NumArcTiles(a) : 0 ), MT_BINARY_ENCODING);
+       if (t) MT_WriteIndex(fd, t, MT_BINARY_ENCODING);
+       for ( ; t!=MT_NULL_INDEX; t=MT_NextArcTile(a,t))
+       {  fwrite(MT_TileVertices(t), sizeof(MT_INDEX), T_Dim, fd);  }
+     }
+   }
+   free(order);
+   free(count);
+   free(v_done);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                           Compressed encoding                            */
+/* ------------------------------------------------------------------------ */
+
+size_t MT_MultiTesselationClass :: MT_BlockBound(int s, MT_INDEX num)
+{
+  if (s==MT_ARC_SECTION) return ( (size_t)num * 4 * 5 );
+  return ( MT_TileSetClass::MT_BlockBound(s, num) );
+}
+
+size_t MT_MultiTesselationClass :: 
+       MT_EncodeBlock(int s, MT_INDEX first, MT_INDEX num, unsigned char * buf)
+{
+  unsigned char * p = buf;
+  MT_INDEX a, src, dst, n;
+  MT_INDEX prev_src = 0, prev_last = 0;
+  if (s!=MT_ARC_SECTION) 
+     return ( MT_TileSetClass::MT_EncodeBlock(s, first, num, buf) );
+  for (a=first; a<first+num; a++)
+  {
+    src = MT_ArcSource(a);
+    dst = MT_ArcDest(a);
+    n = MT_FirstArcTile(a) ? MT_NumArcTiles(a) : 0;
+    p = MT_PutVarint(p, MT_ZigZag((int)(src-prev_src)));
+    p = MT_PutVarint(p, MT_ZigZag((int)(dst-src)));
+    p = MT_PutVarint(p, n);
+    if (n)
+    {  p = MT_PutVarint(p, MT_ZigZag((int)(MT_FirstArcTile(a)-prev_last-1)));
+       prev_last = MT_FirstArcTile(a) + n - 1;
+    }
+    prev_src = src;
+  }
+  return (size_t) (p - buf);
+}
+
+int MT_MultiTesselationClass :: MT_DecodeBlock(MT_Block * b)
+{
+  unsigned char * p = b->my_data;
+  unsigned char * end = b->my_data + b->my_size;
+  MT_INDEX a, t, u, n;
+  MT_INDEX prev_src = 0, prev_last = 0;
+  if (b->my_section!=MT_ARC_SECTION) 
+     return ( MT_TileSetClass::MT_DecodeBlock(b) );
+  for (a=b->my_first; a<b->my_first+b->my_num; a++)
+  {
+    if (!(p = MT_GetVarint(p, end, &u))) return 0;
+    A_Arr[a].my_node[0] = prev_src + (MT_INDEX) MT_UnZigZag(u);
+    prev_src = A_Arr[a].my_node[0];
+    if (!(p = MT_GetVarint(p, end, &u))) return 0;
+    A_Arr[a].my_node[1] = prev_src + (MT_INDEX) MT_UnZigZag(u);
+    if (!(p = MT_GetVarint(p, end, &n))) return 0;
+    if (n)
+    {  if (!(p = MT_GetVarint(p, end, &u))) return 0;
+       A_Arr[a].my_tile[0] = prev_last + 1 + (MT_INDEX) MT_UnZigZag(u);
+       A_Arr[a].my_tile[1] = A_Arr[a].my_tile[0] + n - 1;
+       prev_last = A_Arr[a].my_tile[1];
+       if ( (A_Arr[a].my_tile[0]==MT_NULL_INDEX) || (n>T_Num) ||
+            (A_Arr[a].my_tile[1]<A_Arr[a].my_tile[0]) ||
+            (A_Arr[a].my_tile[1]>T_Num) ) return 0;
+       /* labels of distinct arcs are disjoint, entries of TA_Arr
+          are written by one block only */
+       for (t=A_Arr[a].my_tile[0]; t<=A_Arr[a].my_tile[1]; t++)
+       {  TA_Arr[t].my_arc = a;  }
+    }
+    if ( (A_Arr[a].my_node[0]==MT_NULL_INDEX) || (A_Arr[a].my_node[0]>N_Num) ||
+         (A_Arr[a].my_node[1]==MT_NULL_INDEX) || (A_Arr[a].my_node[1]>N_Num) )
+       return 0;
+  }
+  return ( p == end );
+}
+
+/* ------------------------------------------------------------------------ */
+/*                          Sharing among threads                           */
+/* ------------------------------------------------------------------------ */
+
+int MT_MultiTesselationClass :: MT_Freeze(void)
+{
+   if (pages)
+   {  MT_Error((char *)"A paged MT cannot be shared",
+               (char *)"MT_MultiTesselationClass::MT_Freeze");
+      return 0;
+   }
+   if (N_Loaded)
+   {  MT_Error((char *)"MT still being loaded",
+               (char *)"MT_MultiTesselationClass::MT_Freeze");
+      return 0;
+   }
+   frozen++;
+   return 1;
+}
+
+int MT_MultiTesselationClass :: MT_FrozenError(char * fun)
+{
+   if (!frozen) return 0;
+   MT_Error((char *)"A frozen MT cannot be modified", fun);
+   return 1;
+}
+
+/* ------------------------------------------------------------------------ */
+/*                              Paged access                                */
+/* ------------------------------------------------------------------------ */
+
+MT_Arc * MT_MultiTesselationClass :: MT_PagedArcRecord(MT_INDEX a)
+{  return ( (MT_Arc *) pages->MT_Record(MT_ARC_SECTION,a) );  }
+
+MT_Node * MT_MultiTesselationClass :: MT_PagedNodeRecord(MT_INDEX n)
+{  return ( (MT_Node *) pages->MT_Record(MT_NODE_SECTION,n) );  }
+
+MT_INDEX MT_MultiTesselationClass :: MT_PagedTileArc(MT_INDEX t)
+{  return ( ((MT_TileToArc *) pages->MT_Record(MT_TILEARC_SECTION,t))->my_arc );  }
+
+/* ------------------------------------------------------------------------ */
+/* ------------------------------------------------------------------------ */
+/*                       THE PAGED MULTI-TESSELATION                        */
+/* ------------------------------------------------------------------------ */
+
+MT_PagedMultiTesselationClass :: 
+MT_PagedMultiTesselationClass (int vert_dim, int tile_dim, long budget)
+: MT_MultiTesselationClass(vert_dim, tile_dim)
+{
+  MT_Message((char *)"",(char *)"MT_PagedMultiTesselation Constructor");
+  page_budget = budget;
+}
+
+MT_PagedMultiTesselationClass :: ~MT_PagedMultiTesselationClass ( void )
+{
+   MT_Message((char *)"",(char *)"MT_PagedMultiTesselation Destructor");
+   MT_WaitWrite();
+   MT_ClosePages();
+}
+
+void MT_PagedMultiTesselationClass :: MT_ClosePages(void)
+{
+   if (pages) delete pages;
+   pages = NULL;
+}
+
+int MT_PagedMultiTesselationClass :: MT_SetVertexNum (MT_INDEX i)
+{
+  MT_Error((char *)"A paged MT cannot be modified",
+           (char *)"MT_PagedMultiTesselationClass::MT_SetVertexNum");
+  return 0;
+}
+
+int MT_PagedMultiTesselationClass :: MT_SetTileNum (MT_INDEX i)
+{
+  MT_Error((char *)"A paged MT cannot be modified",
+           (char *)"MT_PagedMultiTesselationClass::MT_SetTileNum");
+  return 0;
+}
+
+int MT_PagedMultiTesselationClass :: MT_ReadBody(FILE * fd, int file_encoding)
+{
+   float * box;
+   FILE * aux;
+   int j;
+   if (MT_FrozenError((char *)"MT_PagedMultiTesselationClass::MT_ReadBody"))
+      return 0;
+   if (file_encoding!=MT_MAPPED_ENCODING)
+   {  MT_Error((char *)"A paged MT must be read in mapped encoding",
+               (char *)"MT_PagedMultiTesselationClass::MT_ReadBody");
+      return 0;
+   }
+   if (swap_bytes)
+   {  MT_Error((char *)"A paged MT must have the byte order of this machine",
+               (char *)"MT_PagedMultiTesselationClass::MT_ReadBody");
+      return 0;
+   }
+   MT_ClosePages();
+   /* the bounding box is read, the file is never mapped */
+   map_pos = MT_TellFile(fd);
+   box = (float *) MT_MapSection(fd, 2*V_Dim*sizeof(float));
+   if (!box) return 0;
+   for (j=0; j<V_Dim; j++)  {  F_min[j] = box[j]; F_max[j] = box[V_Dim+j];  }
+   free(box);
+   /* the page cache reads from its own copy of the file descriptor,
+      so that fd can be closed by the caller */
+#ifdef _WIN32
+   aux = _fdopen(_dup(_fileno(fd)), "rb");
+#else
+   aux = fdopen(dup(fileno(fd)), "r");
+#endif
+   if (!aux)
+   {  MT_Error((char *)"Cannot duplicate file descriptor",
+               (char *)"MT_PagedMultiTesselationClass::MT_ReadBody");
+      return 0;
+   }
+   pages = new MT_PageCacheClass(aux, page_budget);
+   /* sections must be added in the order of their numbers */
+   if ( (pages->MT_AddSection(MT_NextSection((V_Num+1)*V_Dim*sizeof(float)),
+                              V_Dim*sizeof(float), V_Num+1) < 0) ||
+        (pages->MT_AddSection(MT_NextSection((T_Num+1)*T_Dim*sizeof(MT_INDEX)),
+                              T_Dim*sizeof(MT_INDEX), T_Num+1) < 0) ||
+        (pages->MT_AddSection(MT_NextSection((T_Num+1)*sizeof(MT_TileToArc)),
+                              sizeof(MT_TileToArc), T_Num+1) < 0) ||
+        (pages->MT_AddSection(MT_NextSection((A_Num+1)*sizeof(MT_Arc)),
+                              sizeof(MT_Arc), A_Num+1) < 0) ||
+        (pages->MT_AddSection(MT_NextSection((N_Num+1)*sizeof(MT_Node)),
+                              sizeof(MT_Node), N_Num+1) < 0) )
+   {  MT_ClosePages();
+      return 0;
+   }
+   /* check that the file contains all sections */
+   if ( (MT_SeekFile(fd, 0, SEEK_END) != 0) || (MT_TellFile(fd) < map_pos) )
+   {  MT_Error((char *)"File too short",
+               (char *)"MT_PagedMultiTesselationClass::MT_ReadBody");
+      MT_ClosePages();
+      return 0;
+   }
+   MT_SeekFile(fd, map_pos, SEEK_SET);
+   return 1;
+}
+
+void MT_PagedMultiTesselationClass :: MT_WritePagedSection(FILE * fd, int s)
+{
+   MT_INDEX c;
+   size_t size;
+   void * p;
+   for (c=0; c<pages->MT_ChunkNum(s); c++)
+   {
+     p = pages->MT_Chunk(s, c, &size);
+     /* only the first chunk is aligned */
+     if (c==0) s_pos[s] = MT_WriteSection(fd, p, size);
+     else fwrite(p, 1, size, fd);
+   }
+}
+
+void MT_PagedMultiTesselationClass :: MT_WriteBody(FILE * fd, int file_encoding)
+{
+   int s;
+   if (file_encoding!=MT_MAPPED_ENCODING)
+   {  /* arcs and tiles are accessed through the page cache */
+      MT_MultiTesselationClass::MT_WriteBody(fd, file_encoding);
+      return;
+   }
+   for (s=0; s<MT_MAX_SECTIONS; s++)  s_pos[s] = 0;
+   MT_WriteSection(fd, F_min, V_Dim*sizeof(float));
+   fwrite(F_max, sizeof(float), V_Dim, fd);
+   MT_WritePagedSection(fd, MT_COORD_SECTION);
+   MT_WritePagedSection(fd, MT_VERTEX_SECTION);
+   MT_WritePagedSection(fd, MT_TILEARC_SECTION);
+   MT_WritePagedSection(fd, MT_ARC_SECTION);
+   MT_WritePagedSection(fd, MT_NODE_SECTION);
+}
+
+/* ------------------------------------------------------------------------ */
@@ -0,0 +1,184 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_page.c ------------------------------- */
+
+#include "mt_page.h"
+
+/* ------------------------------------------------------------------------ */
+/*                          THE PAGE CACHE CLASS                            */
+/* ------------------------------------------------------------------------ */
+
+/* ------------------------------------------------------------------------ */
+/*                          Creation and deletion                           */
+/* ------------------------------------------------------------------------ */
+
+MT_PageCacheClass :: MT_PageCacheClass(FILE * fd, long budget)
+{
+  MT_Message((char *)"",(char *)"MT_PageCache Constructor");
+  my_file = fd;
+  /* chunks are read at once, no need for buffering */
+  if (my_file)  setvbuf(my_file, NULL, _IONBF, 0);
+  S_Num = 0;
+  S_Arr = NULL;
+  F_Max = (int) (budget / MT_PAGE_SIZE);
+  if (F_Max < MT_PAGE_MIN_FRAMES)  F_Max = MT_PAGE_MIN_FRAMES;
+  F_Num = 0;
+  F_first = F_last = -1;
+  F_data = (char **) calloc ( F_Max, sizeof(char *) );
+  F_sect = (int *) calloc ( F_Max, sizeof(int) );
+  F_chunk = (MT_INDEX *) calloc ( F_Max, sizeof(MT_INDEX) );
+  F_prev = (int *) calloc ( F_Max, sizeof(int) );
+  F_next = (int *) calloc ( F_Max, sizeof(int) );
+  if (! (F_data && F_sect && F_chunk && F_prev && F_next) )
+  {  MT_FatalError((char *)"Allocation failed",(char *)"MT_PageCache Constructor");
+  }
+  my_hits = my_misses = 0;
+}
+
+MT_PageCacheClass :: ~MT_PageCacheClass(void)
+{
+  int i;
+  MT_Message((char *)"",(char *)"MT_PageCache Destructor");
+  for (i=0; i<F_Num; i++)  free(F_data[i]);
+  for (i=0; i<S_Num; i++)  free(S_Arr[i].my_frame);
+  {  if (S_Arr) free(S_Arr);  S_Arr = NULL;  }
+  free(F_data); F_data = NULL;
+  free(F_sect); F_sect = NULL;
+  free(F_chunk); F_chunk = NULL;
+  free(F_prev); F_prev = NULL;
+  free(F_next); F_next = NULL;
+  {  if (my_file) fclose(my_file);  my_file = NULL;  }
+}
+
+int MT_PageCacheClass :: MT_AddSection(MT_OFFSET pos, size_t size, MT_INDEX num)
+{
+  MT_PageSection * aux;
+  MT_INDEX c;
+  if ( (size==0) || (size>MT_PAGE_SIZE) )
+  {  MT_Error((char *)"Invalid record size",
+              (char *)"MT_PageCacheClass::MT_AddSection");
+     return -1;
+  }
+  aux = (MT_PageSection *) realloc ( S_Arr, (S_Num+1)*sizeof(MT_PageSection) );
+  if (!aux)
+  {  MT_Error((char *)"Allocation failed",
+              (char *)"MT_PageCacheClass::MT_AddSection");
+     return -1;
+  }
+  S_Arr = aux;
+  aux = &S_Arr[S_Num];
+  aux->my_offset = pos;
+  aux->my_size = size;
+  aux->my_num = num;
+  aux->my_recs = (MT_INDEX) (MT_PAGE_SIZE / size);
+  aux->my_chunks = (num + aux->my_recs - 1) / aux->my_recs;
+  aux->my_frame = (int *) malloc ( (aux->my_chunks+1)*sizeof(int) );
+  if (!aux->my_frame)
+  {  MT_Error((char *)"Allocation failed",
+              (char *)"MT_PageCacheClass::MT_AddSection");
+     return -1;
+  }
+  for (c=0; c<=aux->my_chunks; c++)  aux->my_frame[c] = -1;
+  return (S_Num++);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                            Access to records                             */
+/* ------------------------------------------------------------------------ */
+
+void * MT_PageCacheClass :: MT_Chunk(int s, MT_INDEX c, size_t * size)
+{
+  MT_PageSection * sp = &S_Arr[s];
+  MT_INDEX n = sp->my_num - c*sp->my_recs;
+  if (n > sp->my_recs)  n = sp->my_recs;
+  (*size) = n * sp->my_size;
+  return MT_Record(s, c*sp->my_recs);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                          Auxiliary functions                             */
+/* ------------------------------------------------------------------------ */
+
+void MT_PageCacheClass :: MT_Touch(int f)
+{
+  /* detach f */
+  if (F_prev[f]>=0) F_next[F_prev[f]] = F_next[f];
+  else F_first = F_next[f];
+  if (F_next[f]>=0) F_prev[F_next[f]] = F_prev[f];
+  else F_last = F_prev[f];
+  /* put f in front */
+  F_prev[f] = -1;
+  F_next[f] = F_first;
+  if (F_first>=0) F_prev[F_first] = f;
+  F_first = f;
+  if (F_last<0) F_last = f;
+}
+
+int MT_PageCacheClass :: MT_LoadChunk(int s, MT_INDEX c)
+{
+  MT_PageSection * sp = &S_Arr[s];
+  MT_INDEX n;
+  size_t size;
+  int f;
+  my_misses++;
+  if (F_Num < F_Max)
+  {  /* take a new frame, and put it at the end of the list */
+     f = F_Num;
+     F_data[f] = (char *) malloc (MT_PAGE_SIZE);
+     if (!F_data[f])
+     {  MT_FatalError((char *)"Allocation failed",
+                      (char *)"MT_PageCacheClass::MT_LoadChunk");
+     }
+     F_Num++;
+     F_prev[f] = F_last;
+     F_next[f] = -1;
+     if (F_last>=0) F_next[F_last] = f;
+     else F_first = f;
+     F_last = f;
+  }
+  else
+  {  /* reuse the least recently used frame */
+     f = F_last;
+     S_Arr[F_sect[f]].my_frame[F_chunk[f]] = -1;
+  }
+  n = sp->my_num - c*sp->my_recs;
+  if (n > sp->my_recs)  n = sp->my_recs;
+  size = n * sp->my_size;
+  if ( (MT_SeekFile(my_file, sp->my_offset + 
+                   (MT_OFFSET)(c*sp->my_recs) * (MT_OFFSET)sp->my_size,
+                   SEEK_SET) != 0) ||
+       (fread(F_data[f], 1, size, my_file) != size) )
+  {  MT_FatalError((char *)"Cannot read chunk",
+                   (char *)"MT_PageCacheClass::MT_LoadChunk");
+  }
+  F_sect[f] = s;
+  F_chunk[f] = c;
+  sp->my_frame[c] = f;
+  if (f!=F_first)  MT_Touch(f);
+  return f;
+}
+
+/* ------------------------------------------------------------------------ */
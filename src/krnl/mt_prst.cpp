@@ -25,7 +25,32 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 /* ------------------------------ mt_prst.c ------------------------------- */
 
+#include <math.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/*
+Files are written in the background only where threads and 
+user-defined streams (fopencookie) are available.
+*/
+#ifdef __GLIBC__
+#include <pthread.h>
+#define MT_BACKGROUND_WRITE
+#endif
+
 #include "mt_prst.h"
+#include "mt_thrd.h"
+
+/*
+Get a character from a stream. The stream is never shared among 
+threads while an object is read, thus locking is not needed.
+*/
+#ifdef _WIN32
+#define MT_GETC(fd) getc(fd)
+#else
+#define MT_GETC(fd) getc_unlocked(fd)
+#endif
 
 /* ------------------------------------------------------------------------ */
 /*             A PERSISTENT OBJECT CLASS IN THE MT LIBRARY                  */
@@ -55,6 +80,14 @@ MT_PersistentClass :: MT_PersistentClass ( void )
 {
   MT_Message((char *)"",(char *)"MT_PersistentClass Constructor");
   MT_SetDescription((char *)"");
+  swap_bytes = 0;
+  my_writer = NULL;
+}
+
+MT_PersistentClass :: ~MT_PersistentClass ( void )
+{
+  MT_Message((char *)"",(char *)"MT_Persistent Destructor");
+  MT_WaitWrite();
 }
 
 /* ------------------------------------------------------------------------ */
@@ -66,9 +99,12 @@ int MT_PersistentClass ::
 {
    int i = 0; /* cursor on keyword */
    int j = 0; /* cursor on my_descr */ 
+   int len = strlen(keyword);
+   int k;
    char c;
-   while ( (i<strlen(keyword)) && (fscanf(fd,"%c",&c)==1) )
-   {  if (c==keyword[i]) i++;
+   while ( (i<len) && ((k = MT_GETC(fd)) != EOF) )
+   {  c = (char) k;
+      if (c==keyword[i]) i++;
       else 
       {  if ( (load_descr) && ((j+i+1)<MT_DESCR_LEN-1) )
          {  int k;
@@ -82,7 +118,7 @@ int MT_PersistentClass ::
       }
    }
    if (load_descr) my_descr[j] = '\0';
-   return (i==strlen(keyword));
+   return (i==len);
 }
 
 int MT_PersistentClass :: MT_ReadFileKw(FILE * fd)
@@ -100,10 +136,14 @@ int MT_PersistentClass ::
   switch (file_encoding)
   {
     case MT_BINARY_ENCODING:
-        if (fread(i, sizeof(MT_INDEX), 1, fd) == 1) return 1;
+    case MT_MAPPED_ENCODING:
+        if (fread(i, sizeof(MT_INDEX), 1, fd) == 1)
+        {  if (swap_bytes) MT_SwapArray(i, sizeof(MT_INDEX), 1);
+           return 1;
+        }
         break;
     case MT_ASCII_ENCODING:
-        if (fscanf(fd, "%d", i) == 1) return 1;
+        if (MT_ScanIndex(fd, i)) return 1;
         break;
   }
   MT_Error((char *)"Index expected",(char *)"MT_PersistentClass::MT_ReadIndex");
@@ -116,16 +156,541 @@ int MT_PersistentClass ::
   switch (file_encoding)
   {
     case MT_BINARY_ENCODING:
-        if (fread(i, sizeof(int), 1, fd) == 1) return 1;
+    case MT_MAPPED_ENCODING:
+        if (fread(i, sizeof(int), 1, fd) == 1)
+        {  if (swap_bytes) MT_SwapArray(i, sizeof(int), 1);
+           return 1;
+        }
         break;
     case MT_ASCII_ENCODING:
-        if (fscanf(fd, "%d", i) == 1) return 1;
+        if (MT_ScanInt(fd, i)) return 1;
         break;
   }
   MT_Error((char *)"Integer expected",(char *)"MT_PersistentClass::MT_ReadCount");
   return 0;
 }
 
+int MT_PersistentClass :: 
+    MT_ReadFloat(FILE * fd, float * f, int file_encoding)
+{
+  switch (file_encoding)
+  {
+    case MT_BINARY_ENCODING:
+    case MT_MAPPED_ENCODING:
+        if (fread(f, sizeof(float), 1, fd) == 1)
+        {  if (swap_bytes) MT_SwapArray(f, sizeof(float), 1);
+           return 1;
+        }
+        break;
+    case MT_ASCII_ENCODING:
+        if (MT_ScanFloat(fd, f)) return 1;
+        break;
+  }
+  MT_Error((char *)"Real number expected",(char *)"MT_PersistentClass::MT_ReadFloat");
+  return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/*                          Scanner for ASCII files                         */
+/* ------------------------------------------------------------------------ */
+
+/*
+Check if character c is a white space.
+*/
+#define MT_IS_SPACE(c) ( ((c)==' ') || ((c)=='\n') || ((c)=='\r') || \
+                         ((c)=='\t') || ((c)=='\v') || ((c)=='\f') )
+
+/*
+Skip white spaces, return the first other character (or EOF).
+*/
+static int MT_SkipSpaces(FILE * fd)
+{
+  int c;
+  do {  c = MT_GETC(fd);  }
+  while ( MT_IS_SPACE(c) );
+  return c;
+}
+
+int MT_PersistentClass :: MT_ScanInt(FILE * fd, int * i)
+{
+  int c = MT_SkipSpaces(fd);
+  int neg = 0;
+  unsigned int v = 0;
+  if ( (c=='-') || (c=='+') )  {  neg = (c=='-');  c = MT_GETC(fd);  }
+  if ( (c<'0') || (c>'9') )  
+  {  if (c!=EOF) ungetc(c, fd);
+     return 0;
+  }
+  do {  v = 10*v + (c-'0');  c = MT_GETC(fd);  }
+  while ( (c>='0') && (c<='9') );
+  if (c!=EOF) ungetc(c, fd);
+  (*i) = neg ? -(int)v : (int)v;
+  return 1;
+}
+
+int MT_PersistentClass :: MT_ScanChar(FILE * fd, char * c)
+{
+  int k = MT_SkipSpaces(fd);
+  if (k==EOF) return 0;
+  (*c) = (char) k;
+  return 1;
+}
+
+int MT_PersistentClass :: MT_ScanIndex(FILE * fd, MT_INDEX * i)
+{
+  int v;
+  if (!MT_ScanInt(fd, &v)) return 0;
+  (*i) = (MT_INDEX) v;
+  return 1;
+}
+
+/*
+Powers of ten exactly representable as doubles.
+*/
+static const double MT_Pow10[23] =
+{  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/*
+Maximum length of the text of a real number.
+*/
+#define MT_NUMBER_LEN 64
+
+/*
+Convert the text of n characters starting at s, and followed by a 
+character not belonging to a number, into a real number. 
+Return the number of characters converted (0 if none).
+The common case [sign] digits [. digits] [e [sign] digits] is converted
+directly, the others by strtof.
+*/
+static int MT_ConvertFloat(char * s, int n, float * f)
+{
+  char * p = s;
+  int neg = 0;
+  double mant = 0.0;  /* digits read, as an integer */
+  int digits = 0;     /* number of significant digits in mant */
+  int any = 0;        /* if some digit has been read */
+  int exp10 = 0;      /* decimal exponent to apply to mant */
+  int exp_val = 0, exp_neg = 0;
+  int fast = (n<MT_NUMBER_LEN);  /* if the number can be converted directly */
+  double d;
+
+  if ( (*p=='-') || (*p=='+') )  {  neg = (*p=='-');  p++;  }
+  while ( (*p>='0') && (*p<='9') )
+  {  if ( (digits>0) || (*p!='0') )
+     {  if (digits<15)  {  mant = 10.0*mant + (*p-'0');  digits++;  }
+        else  {  fast = 0;  }
+     }
+     any = 1;
+     p++;
+  }
+  if (*p=='.')
+  {  p++;
+     while ( (*p>='0') && (*p<='9') )
+     {  if ( (digits>0) || (*p!='0') )
+        {  if (digits<15)  {  mant = 10.0*mant + (*p-'0');  digits++;  }
+           else  {  fast = 0;  }
+        }
+        exp10--;
+        any = 1;
+        p++;
+     }
+  }
+  if ( any && ((*p=='e') || (*p=='E')) )
+  {  p++;
+     if ( (*p=='-') || (*p=='+') )  {  exp_neg = (*p=='-');  p++;  }
+     if ( (*p<'0') || (*p>'9') ) fast = 0;
+     while ( (*p>='0') && (*p<='9') )
+     {  if (exp_val<10000) exp_val = 10*exp_val + (*p-'0');
+        p++;
+     }
+     exp10 += exp_neg ? -exp_val : exp_val;
+  }
+  if (!any) fast = 0;
+
+  if (fast)
+  {
+    /* mant and the power of ten are exact, thus d is correctly rounded */
+    if (mant==0.0) d = 0.0;
+    else if ( (exp10>=0) && (exp10<=22) ) d = mant * MT_Pow10[exp10];
+    else if ( (exp10<0) && (exp10>=-22) ) d = mant / MT_Pow10[-exp10];
+    else fast = 0;
+    if (fast)
+    {
+      /* rounding d to float may differ from rounding the exact value
+         only if d lies half way between two floats */
+      float lo = (float) d;
+      double err = d - (double) lo;
+      if ( (err==0.0) || (fabs(err) != fabs(d - (double) nextafterf(lo, 
+                                       (err>0.0) ? HUGE_VALF : -HUGE_VALF))) )
+      {  (*f) = neg ? -lo : lo;
+         return (int) (p-s);
+      }
+    }
+  }
+  /* general case */
+  {
+    char * end;
+    float v = strtof(s, &end);
+    if (end==s) return 0;
+    (*f) = v;
+    return (int) (end-s);
+  }
+}
+
+int MT_PersistentClass :: MT_ScanFloat(FILE * fd, float * f)
+{
+  char s[MT_NUMBER_LEN+1];
+  int n = 0;          /* length of the text in s */
+  int c = MT_SkipSpaces(fd);
+  int any = 0;        /* if some digit has been read */
+
+  /* collect the characters that may form a number:
+     [sign] digits [. digits] [e [sign] digits], or a word like inf */
+  if ( (c=='-') || (c=='+') )
+  {  s[n++] = (char) c;  c = MT_GETC(fd);  }
+  while ( (c>='0') && (c<='9') )
+  {  any = 1;
+     if (n<MT_NUMBER_LEN) s[n++] = (char) c;
+     c = MT_GETC(fd);
+  }
+  if (c=='.')
+  {  if (n<MT_NUMBER_LEN) s[n++] = (char) c;
+     c = MT_GETC(fd);
+     while ( (c>='0') && (c<='9') )
+     {  any = 1;
+        if (n<MT_NUMBER_LEN) s[n++] = (char) c;
+        c = MT_GETC(fd);
+     }
+  }
+  if ( any && ((c=='e') || (c=='E')) )
+  {  if (n<MT_NUMBER_LEN) s[n++] = (char) c;
+     c = MT_GETC(fd);
+     if ( (c=='-') || (c=='+') )
+     {  if (n<MT_NUMBER_LEN) s[n++] = (char) c;
+        c = MT_GETC(fd);
+     }
+     while ( (c>='0') && (c<='9') )
+     {  if (n<MT_NUMBER_LEN) s[n++] = (char) c;
+        c = MT_GETC(fd);
+     }
+  }
+  if (!any)
+  {  /* not a plain decimal number, e.g., inf or nan */
+     while ( (n<MT_NUMBER_LEN) && 
+             ( ((c>='a') && (c<='z')) || ((c>='A') && (c<='Z')) ||
+               (c=='(') || (c==')') || (c=='_') ) )
+     {  s[n++] = (char) c;  c = MT_GETC(fd);  }
+  }
+  if (c!=EOF) ungetc(c, fd);
+  s[n] = '\0';
+  return ( MT_ConvertFloat(s, n, f) > 0 );
+}
+
+/* ------------------------------------------------------------------------ */
+/*                     Scanner for ASCII memory buffers                     */
+/* ------------------------------------------------------------------------ */
+
+char * MT_PersistentClass :: MT_ParseIndex(char * p, MT_INDEX * i)
+{
+  int neg = 0;
+  unsigned int v = 0;
+  if ( (*p=='-') || (*p=='+') )  {  neg = (*p=='-');  p++;  }
+  if ( (*p<'0') || (*p>'9') ) return NULL;
+  do {  v = 10*v + (*p-'0');  p++;  }
+  while ( (*p>='0') && (*p<='9') );
+  if ( (*p!='\0') && !MT_IS_SPACE(*p) ) return NULL;
+  (*i) = (MT_INDEX) (neg ? -(int)v : (int)v);
+  return p;
+}
+
+char * MT_PersistentClass :: MT_ParseFloat(char * p, float * f)
+{
+  int n = 0;
+  while ( (p[n]!='\0') && !MT_IS_SPACE(p[n]) ) n++;
+  if ( (n==0) || (MT_ConvertFloat(p, n, f) != n) ) return NULL;
+  return (p+n);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                               Byte order                                 */
+/* ------------------------------------------------------------------------ */
+
+int MT_PersistentClass :: MT_BigEndian(void)
+{
+  MT_INDEX one = 1;
+  return ( *((unsigned char *) &one) == 0 );
+}
+
+void MT_PersistentClass :: MT_SwapArray(void * p, size_t size, size_t num)
+{
+  size_t k, j;
+  switch (size)
+  {
+    case 1:
+      break;
+    case 2:
+      {  unsigned short * h = (unsigned short *) p;
+         for (k=0; k<num; k++)  
+         {  h[k] = (unsigned short) ( (h[k] >> 8) | (h[k] << 8) );  }
+      }
+      break;
+    case 4:
+      {  /* no test and no dependency among iterations, so that
+            several numbers are swapped by each vector instruction */
+         unsigned int * w = (unsigned int *) p;
+         unsigned int x;
+         for (k=0; k<num; k++)
+         {  x = w[k];
+            w[k] = (x >> 24) | ((x >> 8) & 0xff00) | 
+                   ((x << 8) & 0xff0000) | (x << 24);
+         }
+      }
+      break;
+    default:
+      {  unsigned char * b = (unsigned char *) p;
+         unsigned char c;
+         for (k=0; k<num; k++, b+=size)
+         {  for (j=0; j<size/2; j++)
+            {  c = b[j];  b[j] = b[size-1-j];  b[size-1-j] = c;  }
+         }
+      }
+      break;
+  }
+}
+
+/* ------------------------------------------------------------------------ */
+/*                        Reading arrays of the body                        */
+/* ------------------------------------------------------------------------ */
+
+#ifndef _WIN32
+
+/*
+Data shared by the jobs reading the ranges of an array in binary.
+*/
+typedef struct MT_ReadJobStruct
+{
+  MT_Persistent my_obj;  /* object being read */
+  int my_file;        /* descriptor of the file */
+  long my_pos;        /* position of the array in the file */
+  char * my_array;    /* array to be filled */
+  size_t my_size;     /* size of the array in bytes */
+  size_t my_elem;     /* size of an element of the array in bytes */
+  size_t my_part;     /* size of the range read by each job, a multiple
+                         of the size of an element */
+  int my_ok[MT_MAX_THREADS];  /* if each job succeeded */
+} MT_ReadJob;
+
+/*
+Job reading a range. Function pread does not move the file position,
+thus all ranges can be read at the same time. The bytes of the range
+are swapped by the same job, if needed.
+*/
+static void MT_ReadRangeJob(void * data, int job)
+{
+  MT_ReadJob * rj = (MT_ReadJob *) data;
+  size_t start = job * rj->my_part;
+  size_t first = start;
+  size_t n = 0;
+  ssize_t r = 1;
+  if (start < rj->my_size) n = rj->my_size - start;
+  if (n > rj->my_part) n = rj->my_part;
+  while ( (n>0) && (r>0) )
+  {  r = pread(rj->my_file, rj->my_array + first, n, 
+               (off_t) (rj->my_pos + first));
+     if (r>0)  {  first += r;  n -= r;  }
+  }
+  rj->my_ok[job] = (n==0);
+  if ( (n==0) && rj->my_obj->MT_SwapBytes() )
+     rj->my_obj->MT_SwapArray(rj->my_array + start, rj->my_elem, 
+                              (first - start) / rj->my_elem);
+}
+
+#endif
+
+int MT_PersistentClass :: 
+    MT_ReadArray(FILE * fd, void * p, size_t size, size_t num)
+{
+#ifndef _WIN32
+  MT_ReadJob rj;
+  int jobs = MT_TheThreadNum();
+  int j, ok = 1;
+  if ( (size_t)jobs > size * num / MT_READ_BUFFER ) 
+     jobs = size * num / MT_READ_BUFFER;
+  if ( (jobs>1) && ((rj.my_pos = ftell(fd)) >= 0) )
+  {
+    rj.my_obj = this;
+    rj.my_file = fileno(fd);
+    rj.my_array = (char *) p;
+    rj.my_size = size * num;
+    rj.my_elem = size;
+    rj.my_part = ( (num + jobs - 1) / jobs ) * size;
+    MT_RunJobs(jobs, MT_ReadRangeJob, &rj);
+    for (j=0; j<jobs; j++)  {  if (!rj.my_ok[j]) ok = 0;  }
+    /* move the stream after the array */
+    if ( ok && (fseek(fd, rj.my_pos+(long)rj.my_size, SEEK_SET)==0) ) 
+       return 1;
+    MT_Error((char *)"Cannot read array",
+             (char *)"MT_PersistentClass::MT_ReadArray");
+    return 0;
+  }
+#endif
+  if (fread(p, size, num, fd) == num)
+  {  if (swap_bytes) MT_SwapArray(p, size, num);
+     return 1;
+  }
+  MT_Error((char *)"Cannot read array",
+           (char *)"MT_PersistentClass::MT_ReadArray");
+  return 0;
+}
+
+/*
+Data shared by the jobs converting the numbers of a piece of text.
+The text is split into chunks, each chunk ending just before a white 
+space or at the end of the text, thus no number is split.
+*/
+typedef struct MT_ScanJobStruct
+{
+  MT_Persistent my_obj;   /* object being read */
+  char * my_text;         /* the text, followed by '\0' */
+  size_t my_cut[MT_MAX_THREADS+1];   /* chunk j is from my_cut[j] to 
+                                        my_cut[j+1] */
+  MT_INDEX my_count[MT_MAX_THREADS]; /* numbers in each chunk */
+  MT_INDEX my_first[MT_MAX_THREADS]; /* index of the first one */
+  int my_ok[MT_MAX_THREADS];  /* if each job succeeded */
+  size_t my_stop;         /* position after the last number needed */
+  MT_INDEX my_float_num;  /* number of real numbers */
+  MT_INDEX my_num;        /* number of real numbers and indexes */
+  float * my_float;       /* array for real numbers */
+  MT_INDEX * my_index;    /* array for indexes */
+} MT_ScanJob;
+
+/*
+Job counting the numbers (i.e., words) in a chunk.
+*/
+static void MT_CountJob(void * data, int job)
+{
+  MT_ScanJob * sj = (MT_ScanJob *) data;
+  char * p = sj->my_text + sj->my_cut[job];
+  char * end = sj->my_text + sj->my_cut[job+1];
+  MT_INDEX n = 0;
+  int space = 1, s;
+  for ( ; p<end; p++)
+  {  s = MT_IS_SPACE(*p);
+     n += (space && !s);
+     space = s;
+  }
+  sj->my_count[job] = n;
+}
+
+/*
+Job converting the numbers in a chunk, knowing the index of the first 
+one. Words after the last number needed are not converted. The numbers
+converted are counted as well, to be used when there is only one chunk.
+*/
+static void MT_ConvertJob(void * data, int job)
+{
+  MT_ScanJob * sj = (MT_ScanJob *) data;
+  char * p = sj->my_text + sj->my_cut[job];
+  char * end = sj->my_text + sj->my_cut[job+1];
+  MT_INDEX i = sj->my_first[job];
+  sj->my_ok[job] = 1;
+  while (i < sj->my_num)
+  {  while ( (p<end) && MT_IS_SPACE(*p) ) p++;
+     if (p>=end) break;
+     if (i < sj->my_float_num)
+        p = sj->my_obj->MT_ParseFloat(p, &sj->my_float[i]);
+     else
+        p = sj->my_obj->MT_ParseIndex(p, &sj->my_index[i-sj->my_float_num]);
+     if (!p)  {  sj->my_ok[job] = 0;  return;  }
+     if (++i == sj->my_num) sj->my_stop = p - sj->my_text;
+  }
+  sj->my_count[job] = i - sj->my_first[job];
+}
+
+int MT_PersistentClass :: MT_ScanArray(FILE * fd, MT_INDEX float_num, 
+                           float * f, MT_INDEX index_num, MT_INDEX * v)
+{
+  MT_ScanJob sj;
+  int jobs = MT_TheThreadNum();
+  size_t cap, len = 0, cut, c;
+  MT_INDEX i, done = 0;
+  int j, ok = 1;
+  if ( (float_num+index_num < MT_PARALLEL_READ) || (ftell(fd) < 0) )
+  {
+    /* few numbers, or a stream that cannot be positioned: 
+       read them one by one */
+    for (i=0; i<float_num; i++)
+    {  if (!MT_ScanFloat(fd, &f[i])) ok = 0;  }
+    for (i=0; i<index_num; i++)
+    {  if (!MT_ScanIndex(fd, &v[i])) ok = 0;  }
+    if (ok) return 1;
+    MT_Error((char *)"Number expected",
+             (char *)"MT_PersistentClass::MT_ScanArray");
+    return 0;
+  }
+  cap = jobs * MT_READ_BUFFER;
+  sj.my_text = (char *) malloc (cap+1);
+  if (!sj.my_text)
+  {  MT_Error((char *)"Allocation failed",
+             (char *)"MT_PersistentClass::MT_ScanArray");
+     return 0;
+  }
+  sj.my_obj = this;
+  sj.my_float_num = float_num;
+  sj.my_num = float_num + index_num;
+  sj.my_float = f;
+  sj.my_index = v;
+  while ( ok && (done < sj.my_num) )
+  {
+    /* fill the buffer after the part of text kept from the previous
+       round, the last word is kept for the next round unless the
+       buffer contains the end of the file */
+    len += fread(sj.my_text+len, 1, cap-len, fd);
+    sj.my_text[len] = '\0';
+    cut = len;
+    if (len==cap)
+    {  while ( (cut>0) && !MT_IS_SPACE(sj.my_text[cut-1]) ) cut--;  }
+    if (cut==0)  {  ok = 0;  break;  }
+    /* split the text into chunks, count their numbers, then convert 
+       them knowing the index of the first number in each chunk */
+    sj.my_cut[0] = 0;
+    for (j=1; j<jobs; j++)
+    {  c = cut / jobs * j;
+       if (c < sj.my_cut[j-1]) c = sj.my_cut[j-1];
+       while ( (c<cut) && !MT_IS_SPACE(sj.my_text[c]) ) c++;
+       sj.my_cut[j] = c;
+    }
+    sj.my_cut[jobs] = cut;
+    if (jobs>1)
+    {  MT_RunJobs(jobs, MT_CountJob, &sj);
+       for (j=0; j<jobs; j++)
+       {  sj.my_first[j] = done;  done += sj.my_count[j];  }
+       MT_RunJobs(jobs, MT_ConvertJob, &sj);
+    }
+    else
+    {  sj.my_first[0] = done;
+       MT_ConvertJob(&sj, 0);
+       done += sj.my_count[0];
+    }
+    for (j=0; j<jobs; j++)  {  if (!sj.my_ok[j]) ok = 0;  }
+    if ( ok && (done >= sj.my_num) )
+    {  /* move the stream just after the last number */
+       if ( fseek(fd, ftell(fd) - (long) (len - sj.my_stop), SEEK_SET) ) 
+          ok = 0;
+    }
+    else
+    {  memmove(sj.my_text, sj.my_text+cut, len-cut);
+       len -= cut;
+    }
+  }
+  free(sj.my_text);
+  if (ok) return 1;
+  MT_Error((char *)"Number expected",
+           (char *)"MT_PersistentClass::MT_ScanArray");
+  return 0;
+}
+
 int MT_PersistentClass :: MT_ReadObjParams(FILE * fd)
 {
   if (!MT_SearchKeyword(fd, (char *)MT_OBJECT_KW)) return 0;
@@ -146,52 +711,90 @@ int MT_PersistentClass :: MT_ReadDescription(FILE * fd)
 int MT_PersistentClass ::
     MT_ReadEncoding(FILE * fd, int * file_encoding)
 {
-  char aux[20];
+  char aux[21];
   if (!MT_SearchKeyword(fd, (char *)MT_ENCODE_KW)) return 0;
   if (fscanf(fd, "%20s", aux) != EOF)
   {  if (strcmp(aux,MT_ASCII_KW)==0) 
         (*file_encoding) = MT_ASCII_ENCODING;
      else if (strcmp(aux,MT_BINARY_KW)==0) 
              (*file_encoding) = MT_BINARY_ENCODING;
-          else 
-          {  MT_Error((char *)"Invalid encoding specification", 
-                      (char *)"MT_PersistentClass::MT_ReadEncoding");
-             return 0;
-          }
+          else if (strcmp(aux,MT_MAPPED_KW)==0) 
+                  (*file_encoding) = MT_MAPPED_ENCODING;
+               else if (strcmp(aux,MT_COMPRESSED_KW)==0) 
+                       (*file_encoding) = MT_COMPRESSED_ENCODING;
+                    else if (strcmp(aux,MT_STREAM_KW)==0) 
+                            (*file_encoding) = MT_STREAM_ENCODING;
+                         else 
+                         {  MT_Error((char *)"Invalid encoding specification", 
+                                     (char *)"MT_PersistentClass::MT_ReadEncoding");
+                            return 0;
+                         }
   }
-  if ((*file_encoding)==MT_BINARY_ENCODING)
+  swap_bytes = 0;
+  if ((*file_encoding)!=MT_ASCII_ENCODING)
   {
-    /* read the end-of-line (and possible separators before it)
-       in order to reach the beginning of the body */
-    char c = ' ';
-    while (c!='\n') fscanf(fd, "%c", &c);
+    /* read the rest of the line in order to reach the beginning of 
+       the body; it may contain byte order and sizes of numbers */
+    char line[MT_MAX_STRLEN];
+    int n, index_size, float_size;
+    if (!fgets(line, MT_MAX_STRLEN, fd)) line[0] = '\0';
+    n = sscanf(line, "%20s %d %d", aux, &index_size, &float_size);
+    if (n>=1)
+    {  if (strcmp(aux,MT_LITTLE_ENDIAN_KW)==0) swap_bytes = MT_BigEndian();
+       else if (strcmp(aux,MT_BIG_ENDIAN_KW)==0) swap_bytes = !MT_BigEndian();
+            else 
+            {  MT_Error((char *)"Invalid byte order", 
+                        (char *)"MT_PersistentClass::MT_ReadEncoding");
+               return 0;
+            }
+    }
+    if ( (n==3) && ( (index_size!=(int)sizeof(MT_INDEX)) ||
+                     (float_size!=(int)sizeof(float)) ) )
+    {  MT_Error((char *)"Unsupported size of indexes or real numbers", 
+                (char *)"MT_PersistentClass::MT_ReadEncoding");
+       return 0;
+    }
   }
   return 1;
 }
 
-int MT_PersistentClass :: MT_Read(FILE * fd)
+int MT_PersistentClass :: MT_HasBodyLayout(int file_encoding)
+{  return ( (file_encoding==MT_ASCII_ENCODING) || 
+            (file_encoding==MT_BINARY_ENCODING) );  }
+
+int MT_PersistentClass :: MT_ReadHeader(FILE * fd, int * file_encoding)
 {
-  int file_encoding;
   if (! MT_ReadFileKw(fd) ) 
-  {   MT_Warning((char *)"Failed MT_ReadFileKw",(char *)"MT_PersistentClass::MT_Read");
+  {   MT_Warning((char *)"Failed MT_ReadFileKw",(char *)"MT_PersistentClass::MT_ReadHeader");
       return 0;
   }
   if (! MT_ReadClassAndParams(fd) ) 
-  {   MT_Warning((char *)"Failed MT_ReadClassAndParams",(char *)"MT_PersistentClass::MT_Read");
+  {   MT_Warning((char *)"Failed MT_ReadClassAndParams",(char *)"MT_PersistentClass::MT_ReadHeader");
       return 0;
   }
   if (! MT_ReadObjParams(fd) ) 
-  {   MT_Warning((char *)"Failed MT_ReadObjParams",(char *)"MT_PersistentClass::MT_Read");
+  {   MT_Warning((char *)"Failed MT_ReadObjParams",(char *)"MT_PersistentClass::MT_ReadHeader");
       return 0;
   }
   if (! MT_ReadDescription(fd) ) 
-  {   MT_Warning((char *)"Failed MT_ReadDescription",(char *)"MT_PersistentClass::MT_Read");
+  {   MT_Warning((char *)"Failed MT_ReadDescription",(char *)"MT_PersistentClass::MT_ReadHeader");
+      return 0;
+  }
+  if (! MT_ReadEncoding(fd, file_encoding) ) 
+  {   MT_Warning((char *)"Failed MT_ReadEncoding",(char *)"MT_PersistentClass::MT_ReadHeader");
       return 0;
   }
-  if (! MT_ReadEncoding(fd, &file_encoding) ) 
-  {   MT_Warning((char *)"Failed MT_ReadEncoding",(char *)"MT_PersistentClass::MT_Read");
+  return 1;
+}
+
+int MT_PersistentClass :: MT_Read(FILE * fd)
+{
+  int file_encoding;
+  if (! MT_ReadHeader(fd, &file_encoding) ) 
+  {   MT_Warning((char *)"Failed MT_ReadHeader",(char *)"MT_PersistentClass::MT_Read");
       return 0;
   }
+  if (! MT_HasBodyLayout(file_encoding) ) file_encoding = MT_BINARY_ENCODING;
   if (! MT_ReadBody(fd, file_encoding) ) 
   {   MT_Warning((char *)"Failed MT_ReadBody",(char *)"MT_PersistentClass::MT_Read");
       return 0;
@@ -199,15 +802,19 @@ int MT_PersistentClass :: MT_Read(FILE * fd)
   return 1;
 }
 
-int MT_PersistentClass :: MT_Read(char * fname)
-{
-  FILE * fd = fopen(fname,"r");
-  int ok = 0;
-  if (fd) ok = MT_Read(fd);
-  fclose(fd);
-  return ok;
-}
-
+int MT_PersistentClass :: MT_Read(char * fname)
+{
+  FILE * fd = fopen(fname,"r");
+  int ok = 0;
+  if (fd) 
+  {  /* read the file in large blocks */
+     setvbuf(fd, NULL, _IOFBF, MT_READ_BUFFER);
+     ok = MT_Read(fd);
+     fclose(fd);
+  }
+  return ok;
+}
+
 /* ------------------------------------------------------------------------ */
 /*                            Writing functions                             */
 /* ------------------------------------------------------------------------ */
@@ -226,6 +833,7 @@ void MT_PersistentClass ::
 {
   switch (file_encoding)
   {  case MT_BINARY_ENCODING:
+     case MT_MAPPED_ENCODING:
        fwrite(&i, sizeof(MT_INDEX), 1, fd); 
        break;
      case MT_ASCII_ENCODING:
@@ -239,6 +847,7 @@ void MT_PersistentClass ::
 {
   switch (file_encoding)
   {  case MT_BINARY_ENCODING:
+     case MT_MAPPED_ENCODING:
        fwrite(&i, sizeof(int), 1, fd); 
        break;
      case MT_ASCII_ENCODING:
@@ -277,6 +886,16 @@ void MT_PersistentClass :: MT_WriteEncoding(FILE * fd, int file_encoding)
     switch (file_encoding)
     {  case MT_ASCII_ENCODING: MT_WriteKeyword(fd, (char *)MT_ASCII_KW); break;
        case MT_BINARY_ENCODING: MT_WriteKeyword(fd, (char *)MT_BINARY_KW); break;
+       case MT_MAPPED_ENCODING: MT_WriteKeyword(fd, (char *)MT_MAPPED_KW); break;
+       case MT_COMPRESSED_ENCODING: 
+            MT_WriteKeyword(fd, (char *)MT_COMPRESSED_KW); break;
+       case MT_STREAM_ENCODING: MT_WriteKeyword(fd, (char *)MT_STREAM_KW); break;
+    }
+    if (file_encoding!=MT_ASCII_ENCODING)
+    {  fprintf(fd," ");
+       if (MT_BigEndian()) MT_WriteKeyword(fd, (char *)MT_BIG_ENDIAN_KW);
+       else MT_WriteKeyword(fd, (char *)MT_LITTLE_ENDIAN_KW);
+       fprintf(fd," %d %d", (int)sizeof(MT_INDEX), (int)sizeof(float));
     }
     fprintf(fd,"\n");
   }
@@ -284,23 +903,276 @@ void MT_PersistentClass :: MT_WriteEncoding(FILE * fd, int file_encoding)
 void MT_PersistentClass ::
      MT_Write(FILE * fd, int file_encoding)
 {
+  long start = ftell(fd);
   MT_WriteFileKw(fd);
   MT_WriteClassAndParams(fd);
   MT_WriteObjParams(fd);
   MT_WriteDescription(fd);
   MT_WriteEncoding(fd, file_encoding);
-  MT_WriteBody(fd, file_encoding);
+  if (MT_HasBodyLayout(file_encoding)) MT_WriteBody(fd, file_encoding);
+  else MT_WriteBody(fd, MT_BINARY_ENCODING);
   fprintf(fd, "\n");           
+  MT_WriteFooter(fd, file_encoding, start);
+}
+
+void MT_PersistentClass :: 
+     MT_WriteFooter(FILE * fd, int file_encoding, long start)
+{  }
+
+void MT_PersistentClass :: MT_WriteFooterAt(FILE * fd, long pos, long start)
+{
+  MT_WriteKeyword(fd, (char *)MT_FOOTER_AT_KW);
+  fprintf(fd, " %0*ld %0*ld\n", MT_FOOTER_DIGITS, pos, 
+                                MT_FOOTER_DIGITS, start);
+}
+
+int MT_PersistentClass ::
+    MT_Write(char * fname, int file_encoding)
+{
+  FILE * fd = fopen(fname,"w");
+  int ok = 0;
+  if (fd) {  MT_Write(fd,file_encoding);  ok = 1;  }
+  fclose(fd);
+  return ok;
+}
+
+/* ------------------------------------------------------------------------ */
+/*                          Writing in the background                       */
+/* ------------------------------------------------------------------------ */
+
+/*
+State of a write started by MT_StartWrite.
+The thread formatting the data writes into a user-defined stream,
+whose output is copied into the buffer being filled. A full buffer 
+is given to the thread writing the file, and the other one is filled
+as soon as that thread has written it.
+*/
+typedef struct MT_WriterStruct
+{
+  MT_Persistent my_obj;     /* object being written */
+  int my_encoding;          /* encoding of the file */
+  FILE * my_file;           /* file being written */
+  int my_ok;                /* 0 if writing the file failed */
+  int my_threads;           /* 1 if written in the background */
+#ifdef MT_BACKGROUND_WRITE
+  FILE * my_stream;         /* stream where the data are formatted */
+  char * my_buf[2];         /* the two buffers */
+  size_t my_len[2];         /* bytes in each buffer */
+  int my_fill;              /* buffer being filled */
+  long my_pos;              /* bytes formatted so far */
+  int my_full[2];           /* 1 if a buffer is given to be written */
+  int my_end;               /* 1 if all data have been formatted */
+  int my_done;              /* 1 if all buffers have been written */
+  pthread_t my_format;      /* thread formatting the data */
+  pthread_t my_io;          /* thread writing the buffers */
+  pthread_mutex_t my_lock;  /* lock protecting full, end, done */
+  pthread_cond_t my_cond;   /* signalled when they change */
+#endif
+} MT_Writer;
+
+#ifdef MT_BACKGROUND_WRITE
+
+/*
+Give the buffer being filled to the thread writing the file, and 
+wait until the other buffer has been written.
+*/
+static void MT_PassBuffer(MT_Writer * w)
+{
+  pthread_mutex_lock(&w->my_lock);
+  w->my_full[w->my_fill] = 1;
+  w->my_fill = 1 - w->my_fill;
+  pthread_cond_broadcast(&w->my_cond);
+  while (w->my_full[w->my_fill]) pthread_cond_wait(&w->my_cond, &w->my_lock);
+  pthread_mutex_unlock(&w->my_lock);
+  w->my_len[w->my_fill] = 0;
+}
+
+/*
+Functions of the user-defined stream: write copies the data into the 
+buffers, seek only tells the current position (for ftell), close 
+gives the last buffer and signals the end of the data.
+*/
+static ssize_t MT_BufferWrite(void * c, const char * buf, size_t size)
+{
+  MT_Writer * w = (MT_Writer *) c;
+  size_t n, done = 0;
+  while (done < size)
+  {
+    n = MT_WRITE_BUFFER - w->my_len[w->my_fill];
+    if (n > size - done) n = size - done;
+    memcpy(w->my_buf[w->my_fill] + w->my_len[w->my_fill], buf + done, n);
+    w->my_len[w->my_fill] += n;
+    done += n;
+    if (w->my_len[w->my_fill] == MT_WRITE_BUFFER) MT_PassBuffer(w);
+  }
+  w->my_pos += (long) size;
+  return (ssize_t) size;
+}
+
+static int MT_BufferSeek(void * c, off64_t * pos, int whence)
+{
+  MT_Writer * w = (MT_Writer *) c;
+  if ( (whence!=SEEK_CUR) || (*pos!=0) ) return -1;
+  (*pos) = w->my_pos;
+  return 0;
+}
+
+static int MT_BufferClose(void * c)
+{
+  MT_Writer * w = (MT_Writer *) c;
+  if (w->my_len[w->my_fill] > 0) MT_PassBuffer(w);
+  pthread_mutex_lock(&w->my_lock);
+  w->my_end = 1;
+  pthread_cond_broadcast(&w->my_cond);
+  pthread_mutex_unlock(&w->my_lock);
+  return 0;
+}
+
+/*
+Body of the thread formatting the data.
+*/
+static void * MT_FormatThread(void * arg)
+{
+  MT_Writer * w = (MT_Writer *) arg;
+  w->my_obj->MT_Write(w->my_stream, w->my_encoding);
+  fclose(w->my_stream);
+  return NULL;
+}
+
+/*
+Body of the thread writing the buffers, in the order they are given.
+*/
+static void * MT_WriteThread(void * arg)
+{
+  MT_Writer * w = (MT_Writer *) arg;
+  int k = 0, more = 1;
+  while (more)
+  {
+    pthread_mutex_lock(&w->my_lock);
+    while ( (!w->my_full[k]) && (!w->my_end) )
+       pthread_cond_wait(&w->my_cond, &w->my_lock);
+    more = w->my_full[k];
+    pthread_mutex_unlock(&w->my_lock);
+    if (more)
+    {  if (fwrite(w->my_buf[k], 1, w->my_len[k], w->my_file) != w->my_len[k])
+          w->my_ok = 0;
+       pthread_mutex_lock(&w->my_lock);
+       w->my_full[k] = 0;
+       pthread_cond_broadcast(&w->my_cond);
+       pthread_mutex_unlock(&w->my_lock);
+       k = 1 - k;
+    }
+  }
+  if (fflush(w->my_file) != 0) w->my_ok = 0;
+  pthread_mutex_lock(&w->my_lock);
+  w->my_done = 1;
+  pthread_mutex_unlock(&w->my_lock);
+  return NULL;
+}
+
+/*
+Create the buffers, the stream and the two threads.
+Return 1 on success, 0 if the file must be written by the caller.
+*/
+static int MT_StartThreads(MT_Writer * w)
+{
+  cookie_io_functions_t f;
+  f.read = NULL;
+  f.write = MT_BufferWrite;
+  f.seek = MT_BufferSeek;
+  f.close = MT_BufferClose;
+  w->my_buf[0] = (char *) malloc (MT_WRITE_BUFFER);
+  w->my_buf[1] = (char *) malloc (MT_WRITE_BUFFER);
+  if ( w->my_buf[0] && w->my_buf[1] && 
+       (w->my_stream = fopencookie(w, "w", f)) )
+  {
+    pthread_mutex_init(&w->my_lock, NULL);
+    pthread_cond_init(&w->my_cond, NULL);
+    if (pthread_create(&w->my_io, NULL, MT_WriteThread, w) == 0)
+    {  if (pthread_create(&w->my_format, NULL, MT_FormatThread, w) == 0)
+       {  w->my_threads = 1;
+          return 1;
+       }
+       /* nothing has been formatted, closing the stream stops the 
+          thread writing the buffers */
+       fclose(w->my_stream);
+       pthread_join(w->my_io, NULL);
+    }
+    else fclose(w->my_stream);
+    pthread_mutex_destroy(&w->my_lock);
+    pthread_cond_destroy(&w->my_cond);
+  }
+  if (w->my_buf[0]) free(w->my_buf[0]);
+  if (w->my_buf[1]) free(w->my_buf[1]);
+  return 0;
+}
+
+#endif
+
+int MT_PersistentClass :: MT_StartWrite(char * fname, int file_encoding)
+{
+  MT_Writer * w;
+  FILE * fd;
+  MT_WaitWrite();
+  fd = fopen(fname,"w");
+  if (!fd) return 0;
+  w = (MT_Writer *) calloc (1, sizeof(MT_Writer));
+  if (!w)
+  {  MT_Error((char *)"Allocation failed",
+              (char *)"MT_PersistentClass::MT_StartWrite");
+     fclose(fd);
+     return 0;
+  }
+  w->my_obj = this;
+  w->my_encoding = file_encoding;
+  w->my_file = fd;
+  w->my_ok = 1;
+  my_writer = w;
+#ifdef MT_BACKGROUND_WRITE
+  if (MT_StartThreads(w)) return 1;
+#endif
+  /* write the file now */
+  MT_Write(fd, file_encoding);
+  if (fclose(fd) != 0) w->my_ok = 0;
+  return 1;
+}
+
+int MT_PersistentClass :: MT_WriteDone(void)
+{
+  int done = 1;
+#ifdef MT_BACKGROUND_WRITE
+  MT_Writer * w = my_writer;
+  if (w && w->my_threads)
+  {  pthread_mutex_lock(&w->my_lock);
+     done = w->my_done;
+     pthread_mutex_unlock(&w->my_lock);
+  }
+#endif
+  return done;
+}
+
+int MT_PersistentClass :: MT_WaitWrite(void)
+{
+  MT_Writer * w = my_writer;
+  int ok;
+  if (!w) return 1;
+#ifdef MT_BACKGROUND_WRITE
+  if (w->my_threads)
+  {  pthread_join(w->my_format, NULL);
+     pthread_join(w->my_io, NULL);
+     if (fclose(w->my_file) != 0) w->my_ok = 0;
+     pthread_mutex_destroy(&w->my_lock);
+     pthread_cond_destroy(&w->my_cond);
+     free(w->my_buf[0]);
+     free(w->my_buf[1]);
+  }
+#endif
+  ok = w->my_ok;
+  free(w);
+  my_writer = NULL;
+  if (!ok) MT_Error((char *)"Cannot write file",
+                    (char *)"MT_PersistentClass::MT_WaitWrite");
+  return ok;
 }
 
-int MT_PersistentClass ::
-    MT_Write(char * fname, int file_encoding)
-{
-  FILE * fd = fopen(fname,"w");
-  int ok = 0;
-  if (fd) {  MT_Write(fd,file_encoding);  ok = 1;  }
-  fclose(fd);
-  return ok;
-}
-
 /* ------------------------------------------------------------------------ */
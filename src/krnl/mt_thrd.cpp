@@ -0,0 +1,392 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ------------------------------ mt_thrd.c ------------------------------- */
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "mt_thrd.h"
+
+/* ------------------------------------------------------------------------ */
+/*                  PARALLEL EXECUTION OF INDEPENDENT JOBS                  */
+/* ------------------------------------------------------------------------ */
+
+/*
+Number of threads set by the user, 0 = as many as processors.
+*/
+static int MT_thread_num = 0;
+
+void MT_SetThreadNum(int n)
+{  MT_thread_num = (n>0) ? n : 0;  }
+
+int MT_TheThreadNum(void)
+{
+  int n = MT_thread_num;
+#ifndef _WIN32
+  if (n==0)  n = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  if (n<1) n = 1;
+  if (n>MT_MAX_THREADS) n = MT_MAX_THREADS;
+  return n;
+}
+
+#ifndef _WIN32
+
+/*
+State shared by the threads running a set of jobs.
+*/
+typedef struct MT_JobSetStruct
+{
+  MT_JobFunction my_fun;  /* function executing a job */
+  void * my_data;         /* its data */
+  int my_num;             /* number of jobs */
+  int my_next;            /* next job to be executed */
+  pthread_mutex_t my_lock;  /* lock protecting my_next */
+} MT_JobSet;
+
+/*
+Body of each thread: take the next job until no job is left.
+*/
+static void * MT_JobThread(void * arg)
+{
+  MT_JobSet * js = (MT_JobSet *) arg;
+  int i;
+  while (1)
+  {
+    pthread_mutex_lock(&js->my_lock);
+    i = js->my_next++;
+    pthread_mutex_unlock(&js->my_lock);
+    if (i >= js->my_num) break;
+    js->my_fun(js->my_data, i);
+  }
+  return NULL;
+}
+
+#endif
+
+void MT_RunJobs(int job_num, MT_JobFunction fun, void * data)
+{
+  int i;
+  int n = MT_TheThreadNum();
+  if (n > job_num) n = job_num;
+#ifndef _WIN32
+  if (n > 1)
+  {
+    MT_JobSet js;
+    pthread_t th[MT_MAX_THREADS];
+    int started = 0;
+    js.my_fun = fun;
+    js.my_data = data;
+    js.my_num = job_num;
+    js.my_next = 0;
+    pthread_mutex_init(&js.my_lock, NULL);
+    /* the calling thread is the n-th one */
+    for (i=0; i<n-1; i++)
+    {  if (pthread_create(&th[started], NULL, MT_JobThread, &js) == 0)
+          started++;
+    }
+    MT_JobThread(&js);
+    for (i=0; i<started; i++)  pthread_join(th[i], NULL);
+    pthread_mutex_destroy(&js.my_lock);
+    return;
+  }
+#endif
+  for (i=0; i<job_num; i++)  fun(data, i);
+}
+
+/* ------------------------------------------------------------------------ */
+/*                  PARALLEL EXECUTION OF GENERATED TASKS                   */
+/* ------------------------------------------------------------------------ */
+
+/*
+Maximum number of tasks taken from another worker in a single steal.
+*/
+#define MT_STEAL_MAX 64
+
+/*
+Stack of tasks of a worker. The tasks are in positions my_bottom .. 
+my_top-1 of array my_task, the owner takes them from the top and the
+other workers steal them from the bottom.
+*/
+typedef struct MT_TaskStackStruct
+{
+  MT_INDEX * my_task;  /* array of tasks */
+  int my_size;         /* size of the array */
+  int my_bottom;       /* oldest task */
+  int my_top;          /* position after the newest task */
+#ifndef _WIN32
+  pthread_mutex_t my_lock;  /* lock protecting the stack */
+#endif
+} MT_TaskStack;
+
+/*
+State shared by the workers.
+*/
+struct MT_TaskPoolStruct
+{
+  MT_TaskFunction my_fun;  /* function executing a task */
+  void * my_data;          /* its data */
+  int my_num;              /* number of workers */
+  long my_pending;         /* tasks added and not yet completed */
+  int my_failed;           /* 1 if an allocation has failed */
+  MT_TaskStack my_stack[MT_MAX_THREADS]; /* stacks of the workers */
+};
+
+#ifndef _WIN32
+#define MT_LockStack(s)    pthread_mutex_lock(&((s)->my_lock))
+#define MT_UnlockStack(s)  pthread_mutex_unlock(&((s)->my_lock))
+#define MT_AddPending(p,k) __sync_add_and_fetch(&((p)->my_pending),(k))
+#else
+#define MT_LockStack(s)
+#define MT_UnlockStack(s)
+#define MT_AddPending(p,k) ((p)->my_pending += (k))
+#endif
+
+/*
+Add a task on top of a stack, the stack must be locked.
+Return 1 on success, 0 if the stack cannot be enlarged.
+*/
+static int MT_StackPush(MT_TaskStack * s, MT_INDEX task)
+{
+  if (s->my_top == s->my_size)
+  {
+    if (s->my_bottom > 0)
+    {  /* move the tasks to the beginning of the array */
+       memmove(s->my_task, s->my_task + s->my_bottom,
+               (s->my_top - s->my_bottom) * sizeof(MT_INDEX));
+       s->my_top -= s->my_bottom;
+       s->my_bottom = 0;
+    }
+    else
+    {
+       int size = (s->my_size ? 2*s->my_size : 1024);
+       MT_INDEX * aux =
+           (MT_INDEX *) realloc ( s->my_task, size*sizeof(MT_INDEX) );
+       if (!aux) return 0;
+       s->my_task = aux;
+       s->my_size = size;
+    }
+  }
+  s->my_task[s->my_top++] = task;
+  return 1;
+}
+
+void MT_PushTask(MT_TaskPool pool, int worker, MT_INDEX task)
+{
+  MT_TaskStack * s = &(pool->my_stack[worker]);
+  int ok;
+  MT_AddPending(pool, 1);
+  MT_LockStack(s);
+  ok = MT_StackPush(s, task);
+  MT_UnlockStack(s);
+  if (!ok)
+  {  pool->my_failed = 1;
+     MT_AddPending(pool, -1);
+  }
+}
+
+/*
+Take the newest task of a worker. Return 1 on success, 0 if its stack
+is empty.
+*/
+static int MT_PopTask(MT_TaskPool pool, int worker, MT_INDEX * task)
+{
+  MT_TaskStack * s = &(pool->my_stack[worker]);
+  int ok = 0;
+  MT_LockStack(s);
+  if (s->my_top > s->my_bottom)
+  {
+    (*task) = s->my_task[--s->my_top];
+    if (s->my_top == s->my_bottom)  s->my_top = s->my_bottom = 0;
+    ok = 1;
+  }
+  MT_UnlockStack(s);
+  return ok;
+}
+
+/*
+Steal up to half of the oldest tasks of another worker, return one of
+them and move the other ones to the stack of this worker. 
+Return 1 on success, 0 if all other stacks are empty.
+*/
+static int MT_StealTask(MT_TaskPool pool, int worker, MT_INDEX * task)
+{
+  MT_INDEX stolen[MT_STEAL_MAX];
+  MT_TaskStack * s;
+  int i, k, n = 0;
+  for (i=1; (i<pool->my_num) && (n==0); i++)
+  {
+    s = &(pool->my_stack[(worker+i) % pool->my_num]);
+    MT_LockStack(s);
+    n = (s->my_top - s->my_bottom + 1) / 2;
+    if (n > MT_STEAL_MAX)  n = MT_STEAL_MAX;
+    for (k=0; k<n; k++)  stolen[k] = s->my_task[s->my_bottom++];
+    if (s->my_top == s->my_bottom)  s->my_top = s->my_bottom = 0;
+    MT_UnlockStack(s);
+  }
+  if (n==0) return 0;
+  /* the stolen tasks are already counted as pending */
+  s = &(pool->my_stack[worker]);
+  MT_LockStack(s);
+  for (k=n-1; k>0; k--)
+  {
+    if (!MT_StackPush(s, stolen[k]))
+    {  pool->my_failed = 1;
+       MT_AddPending(pool, -1);
+    }
+  }
+  MT_UnlockStack(s);
+  (*task) = stolen[0];
+  return 1;
+}
+
+/*
+Body of each worker: execute own tasks, or stolen tasks, until no task 
+is pending.
+*/
+static void MT_TaskWorker(void * data, int worker)
+{
+  MT_TaskPool pool = (MT_TaskPool) data;
+  MT_INDEX task;
+  while (1)
+  {
+    if ( MT_PopTask(pool, worker, &task) ||
+         MT_StealTask(pool, worker, &task) )
+    {
+      pool->my_fun(pool->my_data, pool, worker, task);
+      MT_AddPending(pool, -1);
+    }
+    else if (MT_AddPending(pool, 0) == 0) break;
+#ifndef _WIN32
+    else sched_yield();
+#endif
+  }
+}
+
+int MT_RunTasks(MT_INDEX task, MT_TaskFunction fun, void * data)
+{
+  MT_TaskPool pool;
+  int i, ok;
+  pool = (MT_TaskPool) calloc ( 1, sizeof(struct MT_TaskPoolStruct) );
+  if (!pool)  return 0;
+  pool->my_fun = fun;
+  pool->my_data = data;
+#ifndef _WIN32
+  pool->my_num = MT_TheThreadNum();
+  for (i=0; i<pool->my_num; i++)
+     pthread_mutex_init(&(pool->my_stack[i].my_lock), NULL);
+#else
+  pool->my_num = 1;
+#endif
+  /* the first task is in the stack of worker 0 */
+  MT_PushTask(pool, 0, task);
+  MT_RunJobs(pool->my_num, MT_TaskWorker, pool);
+  ok = !pool->my_failed;
+  for (i=0; i<pool->my_num; i++)
+  {
+#ifndef _WIN32
+    pthread_mutex_destroy(&(pool->my_stack[i].my_lock));
+#endif
+    if (pool->my_stack[i].my_task)  free(pool->my_stack[i].my_task);
+  }
+  free(pool);
+  return ok;
+}
+
+int MT_MarkOnce(unsigned int * m, unsigned int v)
+{
+#ifndef _WIN32
+  unsigned int old = *((volatile unsigned int *) m);
+  while (old != v)
+  {
+    if (__sync_bool_compare_and_swap(m, old, v)) return 1;
+    old = *((volatile unsigned int *) m);
+  }
+  return 0;
+#else
+  if ((*m) == v) return 0;
+  (*m) = v;
+  return 1;
+#endif
+}
+
+/* ------------------------------------------------------------------------ */
+/*                            MUTUAL EXCLUSION                              */
+/* ------------------------------------------------------------------------ */
+
+struct MT_MutexStruct
+{
+#ifndef _WIN32
+  pthread_mutex_t my_lock;
+#else
+  int my_dummy;
+#endif
+};
+
+MT_Mutex MT_NewMutex(void)
+{
+  MT_Mutex mx = (MT_Mutex) malloc ( sizeof(struct MT_MutexStruct) );
+  if (!mx)
+  {  MT_Error((char *)"Allocation failed",(char *)"MT_NewMutex");
+     return NULL;
+  }
+#ifndef _WIN32
+  if (pthread_mutex_init(&mx->my_lock, NULL) != 0)
+  {  MT_Error((char *)"Cannot create mutex",(char *)"MT_NewMutex");
+     free(mx);
+     return NULL;
+  }
+#endif
+  return mx;
+}
+
+void MT_DeleteMutex(MT_Mutex mx)
+{
+  if (!mx) return;
+#ifndef _WIN32
+  pthread_mutex_destroy(&mx->my_lock);
+#endif
+  free(mx);
+}
+
+void MT_LockMutex(MT_Mutex mx)
+{
+#ifndef _WIN32
+  pthread_mutex_lock(&mx->my_lock);
+#endif
+}
+
+void MT_UnlockMutex(MT_Mutex mx)
+{
+#ifndef _WIN32
+  pthread_mutex_unlock(&mx->my_lock);
+#endif
+}
+
+/* ------------------------------------------------------------------------ */
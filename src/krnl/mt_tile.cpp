@@ -27,7 +27,14 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include <float.h>
 
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
 #include "mt_tile.h"
+#include "mt_thrd.h"
 
 /* ------------------------------------------------------------------------ */
 /*                          THE TESSELATION CLASS                           */
@@ -45,6 +52,80 @@ void MT_TileSetClass ::
   for (i=0; i<V_Dim; i++)  { max_values[i] = F_max[i]; }
 }
 
+/*
+Data shared by the jobs computing the bounding box of ranges of 
+vertices, whose coordinates are in a single array.
+*/
+typedef struct MT_BoxJobStruct
+{
+  float * my_coord;   /* coordinates of vertex 0 */
+  int my_dim;         /* number of coordinates of each vertex */
+  MT_INDEX my_num;    /* number of vertices */
+  MT_INDEX my_part;   /* number of vertices in each range */
+  float my_min[MT_MAX_THREADS][MT_MAX_DIM]; /* box of each range */
+  float my_max[MT_MAX_THREADS][MT_MAX_DIM];
+} MT_BoxJob;
+
+static void MT_RangeBoxJob(void * data, int job)
+{
+  MT_BoxJob * bj = (MT_BoxJob *) data;
+  MT_INDEX first = 1 + job * bj->my_part;
+  MT_INDEX last = first + bj->my_part - 1;
+  MT_INDEX i;
+  int j;
+  float * mn = bj->my_min[job];
+  float * mx = bj->my_max[job];
+  float * c = bj->my_coord + first * bj->my_dim;
+  if (last > bj->my_num) last = bj->my_num;
+  for (j=0; j<bj->my_dim; j++)  {  mn[j] = mx[j] = c[j];  }
+  for (i=first+1; i<=last; i++)
+  {  c += bj->my_dim;
+     for (j=0; j<bj->my_dim; j++)
+     {  if (c[j] < mn[j]) mn[j] = c[j];
+        if (c[j] > mx[j]) mx[j] = c[j];
+     }
+  }
+}
+
+void MT_TileSetClass :: MT_ComputeBoundingBox(void)
+{
+  MT_INDEX i;
+  int j, k, jobs = MT_TheThreadNum();
+  if ( (MT_INDEX)jobs > V_Num / MT_PARALLEL_READ ) 
+     jobs = V_Num / MT_PARALLEL_READ;
+  if ( (jobs>1) && !pages )
+  {
+    /* compute the boxes of ranges of vertices in parallel, then
+       merge them */
+    MT_BoxJob * bj = (MT_BoxJob *) malloc (sizeof(MT_BoxJob));
+    if (bj)
+    {  bj->my_coord = all_coord;
+       bj->my_dim = V_Dim;
+       bj->my_num = V_Num;
+       bj->my_part = (V_Num + jobs - 1) / jobs;
+       jobs = (V_Num + bj->my_part - 1) / bj->my_part;
+       MT_RunJobs(jobs, MT_RangeBoxJob, bj);
+       for (j=0; j<V_Dim; j++)
+       {  F_min[j] = bj->my_min[0][j];
+          F_max[j] = bj->my_max[0][j];
+          for (k=1; k<jobs; k++)
+          {  if (bj->my_min[k][j] < F_min[j]) F_min[j] = bj->my_min[k][j];
+             if (bj->my_max[k][j] > F_max[j]) F_max[j] = bj->my_max[k][j];
+          }
+       }
+       free(bj);
+       return;
+    }
+  }
+  for (i=1; i<V_Num+1; i++)
+  {  float * c = MT_VertexCoords(i);
+     for (j=0; j<V_Dim; j++)
+     {  if ( (i==1) || (c[j] < F_min[j]) ) F_min[j] = c[j];
+        if ( (i==1) || (c[j] > F_max[j]) ) F_max[j] = c[j];
+     }
+  }
+}
+
 /* ------------------------------------------------------------------------ */
 /*                        Information for vertices                          */
 /* ------------------------------------------------------------------------ */
@@ -53,7 +134,8 @@ void MT_TileSetClass ::
      MT_CopyVertexCoords(MT_INDEX v, float * f)
 {
   int i;
-  for (i=0; i<V_Dim; i++)  { f[i] = V_Arr[v].my_coord[i]; }
+  float * c = MT_VertexCoords(v);
+  for (i=0; i<V_Dim; i++)  { f[i] = c[i]; }
 }
 
 /* ------------------------------------------------------------------------ */
@@ -64,14 +146,16 @@ void MT_TileSetClass ::
      MT_CopyTileVertices(MT_INDEX t, MT_INDEX * v)
 {
   int i;
-  for (i=0; i<T_Dim; i++)  {  v[i] = T_Arr[t].my_vertex[i]; }
+  MT_INDEX * w = MT_TileVertices(t);
+  for (i=0; i<T_Dim; i++)  {  v[i] = w[i]; }
 }
 
 int MT_TileSetClass :: MT_TileVertexPosition(MT_INDEX t, MT_INDEX v)
 {
   int i;
+  MT_INDEX * w = MT_TileVertices(t);
   for (i=0; i<T_Dim; i++)
-  {  if (v == T_Arr[t].my_vertex[i]) return i;  }
+  {  if (v == w[i]) return i;  }
 //  MT_Warning("Tile does not have the given vertex",
 //             "MT_TileSetClass::MT_TileVertexPosition");
   return -1;
@@ -82,6 +166,8 @@ int MT_TileSetClass ::
 {
   int j, j1;
   int i = 0, sum = 0;
+  MT_INDEX * w = MT_TileVertices(t);
+  MT_INDEX * w1 = MT_TileVertices(t1);
 
   /* Search in t the position of each vertex of t1, except the 
      i1-th one. Accumulate the sum of all such positions on i.
@@ -96,7 +182,7 @@ int MT_TileSetClass ::
      {
         for (j=0; j<T_Dim; j++) /* for each vertex of t */
         {  
-          if ( T_Arr[t1].my_vertex[j1] == T_Arr[t].my_vertex[j] )
+          if ( w1[j1] == w[j] )
           {  /* found, subtract from i */
              i+=j;  
              break;
@@ -134,6 +220,10 @@ MT_TileSetClass :: MT_TileSetClass ( int vert_dim, int tile_dim )
      all_vert = NULL;
      V_Arr = NULL;
      T_Arr = NULL;
+     map_addr = NULL;
+     map_len = 0;
+     pages = NULL;
+     q_bits = 0;
      F_min = (float *) malloc (V_Dim*sizeof(float));
      F_max = (float *) malloc (V_Dim*sizeof(float));
      if (! (F_min && F_max) )
@@ -151,7 +241,7 @@ MT_TileSetClass :: MT_TileSetClass ( int vert_dim, int tile_dim )
 
 int MT_TileSetClass :: MT_SetVertexNum (MT_INDEX i)
 {
-  if (all_coord) free (all_coord); all_coord = NULL;
+  MT_FreeArray (all_coord); all_coord = NULL;
   if (V_Arr) free (V_Arr); V_Arr = NULL;
   all_coord = (float *) malloc ( (i+1)*V_Dim*sizeof(float) );
   V_Arr = (MT_Vertex *) calloc ( i+1, sizeof(MT_Vertex) );
@@ -163,6 +253,9 @@ int MT_TileSetClass :: MT_SetVertexNum (MT_INDEX i)
     {
       V_Arr[j].my_coord = all_coord + j*V_Dim;
     }
+    /* empty bounding box, enlarged by MT_AddVertex */
+    for (j=0; j<(unsigned int)V_Dim; j++)
+    {  F_min[j] = FLT_MAX;  F_max[j] = -FLT_MAX;  }
     return 1;
   }
   /* else */
@@ -173,7 +266,7 @@ int MT_TileSetClass :: MT_SetVertexNum (MT_INDEX i)
 
 int MT_TileSetClass :: MT_SetTileNum (MT_INDEX i)
 {
-  if (all_vert) free (all_vert); all_vert = NULL;
+  MT_FreeArray (all_vert); all_vert = NULL;
   if (T_Arr) free (T_Arr); T_Arr = NULL;
   all_vert = (MT_INDEX *) calloc ( (i+1)*T_Dim, sizeof(MT_INDEX) );
   T_Arr = (MT_Tile *) calloc ( i+1, sizeof(MT_Tile) );
@@ -199,8 +292,8 @@ void MT_TileSetClass :: MT_AddVertex(MT_INDEX v, float * coord_array)
   for (j=0; j<V_Dim; j++)
   {
     V_Arr[v].my_coord[j] = coord_array[j];
- //   if ( V_Arr[v].my_coord[j] < F_min[j] ) F_min[j] = V_Arr[v].my_coord[j];
- //   if ( V_Arr[v].my_coord[j] > F_max[j] ) F_max[j] = V_Arr[v].my_coord[j];
+    if ( V_Arr[v].my_coord[j] < F_min[j] ) F_min[j] = V_Arr[v].my_coord[j];
+    if ( V_Arr[v].my_coord[j] > F_max[j] ) F_max[j] = V_Arr[v].my_coord[j];
   }
 }
 
@@ -216,12 +309,346 @@ void MT_TileSetClass :: MT_AddTile(MT_INDEX t, MT_INDEX * vert_array)
 MT_TileSetClass :: ~MT_TileSetClass ()
 {
   MT_Message((char *)"",(char *)"MT_TileSet Destructor");
-  if (all_vert) free (all_vert); all_vert = NULL;
-  if (all_coord) free (all_coord); all_coord = NULL;
+  MT_WaitWrite();
+  MT_FreeArray (all_vert); all_vert = NULL;
+  MT_FreeArray (all_coord); all_coord = NULL;
   if (V_Arr) free (V_Arr); V_Arr = NULL;
   if (T_Arr) free (T_Arr); T_Arr = NULL;
   if (F_min) free(F_min); F_min = NULL;
   if (F_max) free(F_max); F_max = NULL;
+  MT_UnmapFile();
+}
+
+/* ------------------------------------------------------------------------ */
+/*                        Memory-mapped file access                         */
+/* ------------------------------------------------------------------------ */
+
+void MT_TileSetClass :: MT_MapFile(FILE * fd)
+{
+  map_pos = MT_TellFile(fd);
+  map_addr = NULL;
+  map_len = 0;
+#ifndef _WIN32
+  struct stat info;
+  void * addr;
+  /* a file with the opposite byte order is read and swapped */
+  if (swap_bytes) return;
+  if ( (fstat(fileno(fd), &info) == 0) && (info.st_size > 0) )
+  {
+    /* the mapping is private and writable, so that the arrays 
+       can still be modified (copy on write) */
+    addr = mmap(NULL, (size_t) info.st_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE, fileno(fd), 0);
+    if (addr != MAP_FAILED)
+    {  map_addr = (char *) addr;
+       map_len = (size_t) info.st_size;
+    }
+    else MT_Warning((char *)"Mapping failed, file will be read",
+                    (char *)"MT_TileSetClass::MT_MapFile");
+  }
+#endif
+}
+
+void MT_TileSetClass :: MT_UnmapFile(void)
+{
+#ifndef _WIN32
+  if (map_addr) munmap(map_addr, map_len);
+#endif
+  map_addr = NULL;
+  map_len = 0;
+}
+
+MT_OFFSET MT_TileSetClass :: MT_NextSection(size_t size)
+{
+  MT_OFFSET start = ( (map_pos + MT_MAPPED_ALIGN - 1) / MT_MAPPED_ALIGN )
+                    * MT_MAPPED_ALIGN;
+  map_pos = start + (MT_OFFSET) size;
+  return start;
+}
+
+void * MT_TileSetClass :: MT_MapSection(FILE * fd, size_t size)
+{
+  void * p;
+  MT_OFFSET start = MT_NextSection(size);
+  if (map_addr)
+  {
+    if ( start + (MT_OFFSET)size > (MT_OFFSET)map_len )
+    {  MT_Error((char *)"File too short",
+                (char *)"MT_TileSetClass::MT_MapSection");
+       return NULL;
+    }
+    p = (void *) (map_addr + start);
+  }
+  else
+  {
+    p = malloc(size ? size : 1);
+    if (!p)
+    {  MT_Error((char *)"Allocation failed",
+                (char *)"MT_TileSetClass::MT_MapSection");
+       return NULL;
+    }
+    if ( (MT_SeekFile(fd, start, SEEK_SET) != 0) ||
+         (fread(p, 1, size, fd) != size) )
+    {  MT_Error((char *)"File too short",
+                (char *)"MT_TileSetClass::MT_MapSection");
+       free(p);
+       return NULL;
+    }
+    /* all sections are arrays of MT indexes and real numbers, 
+       which have the same size */
+    if (swap_bytes) MT_SwapArray(p, sizeof(MT_INDEX), size/sizeof(MT_INDEX));
+  }
+  return p;
+}
+
+long MT_TileSetClass :: MT_WriteSection(FILE * fd, void * p, size_t size)
+{
+  long pos = ftell(fd);
+  while (pos % MT_MAPPED_ALIGN)  {  fputc(0, fd); pos++;  }
+  fwrite(p, 1, size, fd);
+  return pos;
+}
+
+/* ------------------------------------------------------------------------ */
+/*                              Paged access                                */
+/* ------------------------------------------------------------------------ */
+
+float * MT_TileSetClass :: MT_PagedVertexCoords(MT_INDEX v)
+{  return ( (float *) pages->MT_Record(MT_COORD_SECTION,v) );  }
+
+MT_INDEX * MT_TileSetClass :: MT_PagedTileVertices(MT_INDEX t)
+{  return ( (MT_INDEX *) pages->MT_Record(MT_VERTEX_SECTION,t) );  }
+
+/* ------------------------------------------------------------------------ */
+/*                            Compressed encoding                           */
+/* ------------------------------------------------------------------------ */
+
+/*
+Bit pattern of a float, rotated so that the sign is the lowest bit:
+close values have equal high bits, and their exclusive or is small.
+*/
+static inline MT_INDEX MT_FloatBits(float f)
+{
+  MT_INDEX b;
+  memcpy(&b, &f, sizeof(MT_INDEX));
+  return ( (b << 1) | (b >> 31) );
+}
+
+static inline float MT_BitsFloat(MT_INDEX b)
+{
+  float f;
+  b = (b >> 1) | (b << 31);
+  memcpy(&f, &b, sizeof(float));
+  return f;
+}
+
+int MT_TileSetClass :: MT_SetQuantization(int bits)
+{
+  if ( (bits!=0) && (bits!=16) && (bits!=24) )
+  {  MT_Error((char *)"Quantization must be 0, 16 or 24 bits",
+              (char *)"MT_TileSetClass::MT_SetQuantization");
+     return 0;
+  }
+  q_bits = bits;
+  return 1;
+}
+
+size_t MT_TileSetClass :: MT_BlockBound(int s, MT_INDEX num)
+{
+  switch (s)
+  {  case MT_COORD_SECTION:  return ( (size_t)num * V_Dim * 5 );
+     case MT_VERTEX_SECTION: return ( (size_t)num * T_Dim * 5 );
+  }
+  return 0;
+}
+
+size_t MT_TileSetClass :: 
+       MT_EncodeBlock(int s, MT_INDEX first, MT_INDEX num, unsigned char * buf)
+{
+  unsigned char * p = buf;
+  MT_INDEX prev[MT_MAX_DIM];  /* previous values, for differences */
+  MT_INDEX i, q;
+  int j;
+  for (j=0; j<MT_MAX_DIM; j++)  prev[j] = 0;
+  switch (s)
+  {
+    case MT_COORD_SECTION:
+      if (q_bits)
+      {  /* coordinates quantized within the bounding box */
+         float scale[MT_MAX_DIM];
+         float d;
+         MT_INDEX q_max = (1 << q_bits) - 1;
+         for (j=0; j<V_Dim; j++)
+         {  scale[j] = (F_max[j]>F_min[j]) ? q_max / (F_max[j]-F_min[j]) : 0.0;  }
+         for (i=first; i<first+num; i++)
+         {  float * c = MT_VertexCoords(i);
+            for (j=0; j<V_Dim; j++)
+            {  /* clamp to [0,q_max] before converting, also for
+                  coordinates outside the box */
+               d = (c[j]-F_min[j]) * scale[j] + 0.5;
+               if (!(d > 0.0)) q = 0;
+               else if (d >= (float) q_max) q = q_max;
+               else q = (MT_INDEX) d;
+               p = MT_PutVarint(p, MT_ZigZag((int)(q-prev[j])));
+               prev[j] = q;
+            }
+         }
+      }
+      else
+      {  /* bit patterns of the coordinates, lossless */
+         for (i=first; i<first+num; i++)
+         {  float * c = MT_VertexCoords(i);
+            for (j=0; j<V_Dim; j++)
+            {  q = MT_FloatBits(c[j]);
+               p = MT_PutVarint(p, q ^ prev[j]);
+               prev[j] = q;
+            }
+         }
+      }
+      break;
+    case MT_VERTEX_SECTION:
+      for (i=first; i<first+num; i++)
+      {  MT_INDEX * w = MT_TileVertices(i);
+         p = MT_PutVarint(p, MT_ZigZag((int)(w[0]-prev[0])));
+         for (j=1; j<T_Dim; j++)
+         {  p = MT_PutVarint(p, MT_ZigZag((int)(w[j]-w[j-1])));  }
+         prev[0] = w[0];
+      }
+      break;
+  }
+  return (size_t) (p - buf);
+}
+
+int MT_TileSetClass :: MT_DecodeBlock(MT_Block * b)
+{
+  unsigned char * p = b->my_data;
+  unsigned char * end = b->my_data + b->my_size;
+  MT_INDEX prev[MT_MAX_DIM];  /* previous values, for differences */
+  MT_INDEX i, q;
+  int j;
+  for (j=0; j<MT_MAX_DIM; j++)  prev[j] = 0;
+  switch (b->my_section)
+  {
+    case MT_COORD_SECTION:
+      if (q_bits)
+      {  float step[MT_MAX_DIM];
+         MT_INDEX q_max = (1 << q_bits) - 1;
+         for (j=0; j<V_Dim; j++)  {  step[j] = (F_max[j]-F_min[j]) / q_max;  }
+         for (i=b->my_first; i<b->my_first+b->my_num; i++)
+         {  float * c = all_coord + i*V_Dim;
+            for (j=0; j<V_Dim; j++)
+            {  if (!(p = MT_GetVarint(p, end, &q))) return 0;
+               prev[j] += (MT_INDEX) MT_UnZigZag(q);
+               if (prev[j] > q_max) return 0;
+               c[j] = F_min[j] + prev[j] * step[j];
+            }
+         }
+      }
+      else
+      {  for (i=b->my_first; i<b->my_first+b->my_num; i++)
+         {  float * c = all_coord + i*V_Dim;
+            for (j=0; j<V_Dim; j++)
+            {  if (!(p = MT_GetVarint(p, end, &q))) return 0;
+               prev[j] ^= q;
+               c[j] = MT_BitsFloat(prev[j]);
+            }
+         }
+      }
+      break;
+    case MT_VERTEX_SECTION:
+      for (i=b->my_first; i<b->my_first+b->my_num; i++)
+      {  MT_INDEX * w = all_vert + i*T_Dim;
+         if (!(p = MT_GetVarint(p, end, &q))) return 0;
+         w[0] = prev[0] + (MT_INDEX) MT_UnZigZag(q);
+         prev[0] = w[0];
+         for (j=1; j<T_Dim; j++)
+         {  if (!(p = MT_GetVarint(p, end, &q))) return 0;
+            w[j] = w[j-1] + (MT_INDEX) MT_UnZigZag(q);
+         }
+         for (j=0; j<T_Dim; j++)
+         {  if ( (w[j]==MT_NULL_INDEX) || (w[j]>V_Num) ) return 0;  }
+      }
+      break;
+    default:
+      return 0;
+  }
+  return ( p == end );
+}
+
+/*
+Data passed to the jobs decoding blocks.
+*/
+typedef struct MT_BlockJobsStruct
+{
+  MT_TileSet my_obj;    /* object to be filled */
+  MT_Block * my_block;  /* array of blocks */
+} MT_BlockJobs;
+
+static void MT_DecodeJob(void * data, int k)
+{
+  MT_BlockJobs * bj = (MT_BlockJobs *) data;
+  bj->my_block[k].my_ok = bj->my_obj->MT_DecodeBlock(&bj->my_block[k]);
+}
+
+int MT_TileSetClass :: MT_ReadBlocks(FILE * fd, int s, MT_INDEX num)
+{
+  int nb = (int) ( (num + MT_COMPRESS_BLOCK - 1) / MT_COMPRESS_BLOCK );
+  int k, ok = 1;
+  MT_INDEX size;
+  MT_BlockJobs bj;
+  MT_Block * b = (MT_Block *) calloc ( nb+1, sizeof(MT_Block) );
+  if (!b)
+  {  MT_Error((char *)"Allocation failed",(char *)"MT_TileSetClass::MT_ReadBlocks");
+     return 0;
+  }
+  /* read all blocks, then decode them */
+  for (k=0; ok && (k<nb); k++)
+  {
+    b[k].my_section = s;
+    b[k].my_first = 1 + k * MT_COMPRESS_BLOCK;
+    b[k].my_num = num + 1 - b[k].my_first;
+    if (b[k].my_num > MT_COMPRESS_BLOCK)  b[k].my_num = MT_COMPRESS_BLOCK;
+    ok = 0;
+    if (!MT_ReadIndex(fd, &size, MT_BINARY_ENCODING)) break;
+    /* the decoder checks the end of the block, no padding is needed */
+    b[k].my_data = (unsigned char *) malloc ( size ? size : 1 );
+    if (!b[k].my_data) break;
+    b[k].my_size = size;
+    ok = ( fread(b[k].my_data, 1, size, fd) == size );
+  }
+  if (ok)
+  {  bj.my_obj = this;
+     bj.my_block = b;
+     MT_RunJobs(nb, MT_DecodeJob, &bj);
+     for (k=0; k<nb; k++)  {  if (!b[k].my_ok) ok = 0;  }
+     if (!ok)  MT_Error((char *)"Invalid block",
+                        (char *)"MT_TileSetClass::MT_ReadBlocks");
+  }
+  else MT_Error((char *)"Cannot read block",
+                (char *)"MT_TileSetClass::MT_ReadBlocks");
+  for (k=0; k<nb; k++)  {  if (b[k].my_data) free(b[k].my_data);  }
+  free(b);
+  return ok;
+}
+
+void MT_TileSetClass :: MT_WriteBlocks(FILE * fd, int s, MT_INDEX num)
+{
+  MT_INDEX first, n, size;
+  unsigned char * buf = 
+     (unsigned char *) malloc ( MT_BlockBound(s,MT_COMPRESS_BLOCK) + 1 );
+  if (!buf)
+  {  MT_Error((char *)"Allocation failed",(char *)"MT_TileSetClass::MT_WriteBlocks");
+     return;
+  }
+  for (first=1; first<=num; first+=n)
+  {
+    n = num + 1 - first;
+    if (n > MT_COMPRESS_BLOCK)  n = MT_COMPRESS_BLOCK;
+    size = (MT_INDEX) MT_EncodeBlock(s, first, n, buf);
+    MT_WriteIndex(fd, size, MT_BINARY_ENCODING);
+    fwrite(buf, 1, size, fd);
+  }
+  free(buf);
 }
 
 /* ------------------------------------------------------------------------ */
@@ -240,11 +667,12 @@ int MT_TileSetClass ::
        flag = 0;
        for (j=0; j<V_Dim; j++)
        {  flag += fread(&coord[j], sizeof(float), 1, fd);  }
+       if (swap_bytes) MT_SwapArray(coord, sizeof(float), V_Dim);
        break;
      case MT_ASCII_ENCODING:
        flag = 0;
        for (j=0; j<V_Dim; j++)
-       flag += fscanf(fd, "%f", &coord[j]);
+       flag += MT_ScanFloat(fd, &coord[j]);
        break;
   }
   if (flag != V_Dim)
@@ -282,6 +710,14 @@ int MT_TileSetClass ::
     return 0;
   }
 
+int MT_TileSetClass :: MT_HasBodyLayout(int file_encoding)
+{
+  return ( (file_encoding==MT_ASCII_ENCODING) || 
+           (file_encoding==MT_BINARY_ENCODING) ||
+           (file_encoding==MT_MAPPED_ENCODING) ||
+           (file_encoding==MT_COMPRESSED_ENCODING) );
+}
+
 int MT_TileSetClass :: MT_ReadClassAndParams(FILE * fd)
 { 
   int vd, td;
@@ -315,23 +751,69 @@ int MT_TileSetClass :: MT_ReadBody(FILE * fd, int file_encoding)
 {  
    unsigned int i;
    int j;
+   if (file_encoding==MT_MAPPED_ENCODING)
+   {  
+     float * box;
+     /* release the current arrays and mapping */
+     MT_FreeArray (all_coord); all_coord = NULL;
+     MT_FreeArray (all_vert); all_vert = NULL;
+     if (V_Arr) free (V_Arr); V_Arr = NULL;
+     if (T_Arr) free (T_Arr); T_Arr = NULL;
+     MT_UnmapFile();
+     /* map the file, take bounding box, coordinates and tile vertices
+        from its sections */
+     MT_MapFile(fd);
+     box = (float *) MT_MapSection(fd, 2*V_Dim*sizeof(float));
+     if (!box) return 0;
+     for (j=0; j<V_Dim; j++)  {  F_min[j] = box[j]; F_max[j] = box[V_Dim+j];  }
+     MT_FreeArray (box);
+     all_coord = (float *) MT_MapSection(fd, (V_Num+1)*V_Dim*sizeof(float));
+     all_vert = (MT_INDEX *) MT_MapSection(fd, (T_Num+1)*T_Dim*sizeof(MT_INDEX));
+     V_Arr = (MT_Vertex *) malloc ( (V_Num+1)*sizeof(MT_Vertex) );
+     T_Arr = (MT_Tile *) malloc ( (T_Num+1)*sizeof(MT_Tile) );
+     if (! (all_coord && all_vert && V_Arr && T_Arr) )
+     {  MT_Error((char *)"Cannot load mapped sections",
+                 (char *)"MT_TileSetClass::MT_ReadBody");
+        return 0;
+     }
+     for (i=0; i<V_Num+1; i++)  {  V_Arr[i].my_coord = all_coord + i*V_Dim;  }
+     for (i=0; i<T_Num+1; i++)  {  T_Arr[i].my_vertex = all_vert + i*T_Dim;  }
+     MT_SeekFile(fd, map_pos, SEEK_SET);
+     return 1;
+   }
+   if (file_encoding==MT_COMPRESSED_ENCODING)
+   {
+     int q;
+     if (!MT_SetVertexNum(V_Num)) return 0;
+     if (!MT_SetTileNum(T_Num)) return 0;
+     /* quantization bits and bounding box, then the blocks */
+     if (!MT_ReadCount(fd, &q, MT_BINARY_ENCODING)) return 0;
+     if (!MT_SetQuantization(q)) return 0;
+     if ( !MT_ReadArray(fd, F_min, sizeof(float), V_Dim) ||
+          !MT_ReadArray(fd, F_max, sizeof(float), V_Dim) )
+     {  MT_Error((char *)"Cannot read bounding box",
+                 (char *)"MT_TileSetClass::MT_ReadBody");
+        return 0;
+     }
+     if (!MT_ReadBlocks(fd, MT_COORD_SECTION, V_Num)) return 0;
+     return ( MT_ReadBlocks(fd, MT_VERTEX_SECTION, T_Num) );
+   }
    /* allocate vertex array and tile array */
    if (!MT_SetVertexNum(V_Num)) return 0;
    if (!MT_SetTileNum(T_Num)) return 0;
-   /* read vertices */
-   for (i=1; i<V_Num+1; i++)
-   {  if (!MT_ReadVertex(fd, i, file_encoding)) return 0;  }
-   for (i=1; i<V_Num+1; i++)
-   {
-	 for (j=0; j<V_Dim; j++)
-     {
-        if ( (i==1) || (V_Arr[i].my_coord[j] < F_min[j]) ) F_min[j] = V_Arr[i].my_coord[j];
-        if ( (i==1) || (V_Arr[i].my_coord[j] > F_max[j]) ) F_max[j] = V_Arr[i].my_coord[j];
-     }
+   /* read vertex coordinates and tile vertices directly into their
+      arrays, in parallel if they are large */
+   if (file_encoding==MT_BINARY_ENCODING)
+   {  if (!MT_ReadArray(fd, all_coord+V_Dim, sizeof(float), V_Num*V_Dim))
+         return 0;
+      if (!MT_ReadArray(fd, all_vert+T_Dim, sizeof(MT_INDEX), T_Num*T_Dim))
+         return 0;
    }
-   /* read tiles */
-   for (i=1; i<T_Num+1; i++)
-   {  if (!MT_ReadTile(fd, i, file_encoding)) return 0;  }
+   else
+   {  if (!MT_ScanArray(fd, V_Num*V_Dim, all_coord+V_Dim, 
+                            T_Num*T_Dim, all_vert+T_Dim)) return 0;
+   }
+   MT_ComputeBoundingBox();
    return 1;
 }
 
@@ -341,15 +823,16 @@ void MT_TileSetClass ::
      MT_WriteVertex(FILE * fd, MT_INDEX v, int file_encoding)
 {
   int j;
+  float * c = MT_VertexCoords(v);
   switch (file_encoding)
   {  case MT_BINARY_ENCODING:
        for (j=0; j<V_Dim; j++)
-       {  fwrite(&V_Arr[v].my_coord[j], sizeof(float), 1, fd);  }
+       {  fwrite(&c[j], sizeof(float), 1, fd);  }
        break;
      case MT_ASCII_ENCODING:
        for (j=0; j<V_Dim; j++)
-       {   if (j<V_Dim-1) fprintf(fd, "%g ", V_Arr[v].my_coord[j]);
-           else fprintf(fd, "%g\n", V_Arr[v].my_coord[j]);
+       {   if (j<V_Dim-1) fprintf(fd, "%g ", c[j]);
+           else fprintf(fd, "%g\n", c[j]);
        }
        break;
   }
@@ -359,9 +842,10 @@ void MT_TileSetClass ::
      MT_WriteTile(FILE * fd, MT_INDEX t, int file_encoding)
 {
   int j;
+  MT_INDEX * w = MT_TileVertices(t);
   for (j=0; j<T_Dim; j++)
   {
-     MT_WriteIndex(fd,T_Arr[t].my_vertex[j],file_encoding);
+     MT_WriteIndex(fd,w[j],file_encoding);
      if (file_encoding==MT_ASCII_ENCODING)
      {   if (j<T_Dim-1) fprintf(fd, " ");
          else fprintf(fd, "\n");
@@ -384,12 +868,70 @@ void MT_TileSetClass :: MT_WriteObjParams(FILE * fd)
 void MT_TileSetClass :: MT_WriteBody(FILE * fd, int file_encoding)
 {  
    unsigned int i;
+   int s;
+   for (s=0; s<MT_MAX_SECTIONS; s++)  s_pos[s] = 0;
+   /* the bounding box, written in the mapped and compressed body and in
+      the footer, is the one computed when the object was built or read:
+      writing does not change the object */
+   if (file_encoding==MT_MAPPED_ENCODING)
+   {
+     /* write bounding box, and the arrays of coordinates and of 
+        tile vertices, including their unused position 0 */
+     MT_WriteSection(fd, F_min, V_Dim*sizeof(float));
+     fwrite(F_max, sizeof(float), V_Dim, fd);
+     s_pos[MT_COORD_SECTION] = 
+         MT_WriteSection(fd, all_coord, (V_Num+1)*V_Dim*sizeof(float));
+     s_pos[MT_VERTEX_SECTION] = 
+         MT_WriteSection(fd, all_vert, (T_Num+1)*T_Dim*sizeof(MT_INDEX));
+     return;
+   }
+   if (file_encoding==MT_COMPRESSED_ENCODING)
+   {
+     MT_WriteCount(fd, q_bits, MT_BINARY_ENCODING);
+     fwrite(F_min, sizeof(float), V_Dim, fd);
+     fwrite(F_max, sizeof(float), V_Dim, fd);
+     s_pos[MT_COORD_SECTION] = ftell(fd);
+     MT_WriteBlocks(fd, MT_COORD_SECTION, V_Num);
+     s_pos[MT_VERTEX_SECTION] = ftell(fd);
+     MT_WriteBlocks(fd, MT_VERTEX_SECTION, T_Num);
+     return;
+   }
    /* write vertices */
+   s_pos[MT_COORD_SECTION] = ftell(fd);
    for (i=1; i<V_Num+1; i++)
    {  MT_WriteVertex(fd, i, file_encoding);  }
    /* write tiles */
+   s_pos[MT_VERTEX_SECTION] = ftell(fd);
    for (i=1; i<T_Num+1; i++)
    {  MT_WriteTile(fd, i, file_encoding);  }
 }
+
+void MT_TileSetClass :: 
+     MT_WriteFooter(FILE * fd, int file_encoding, long start)
+{
+   long pos = ftell(fd);
+   int j, s, n;
+   /* the footer cannot be located in a stream without offsets */
+   if ( (pos < 0) || (start < 0) ) return;
+   MT_WriteKeyword(fd, (char *)MT_FOOTER_KW);
+   fprintf(fd, "\n");
+   MT_WriteClassAndParams(fd);
+   MT_WriteObjParams(fd);
+   MT_WriteEncoding(fd, file_encoding);
+   MT_WriteKeyword(fd, (char *)MT_BOX_KW);
+   for (j=0; j<V_Dim; j++)  fprintf(fd, " %.9g", F_min[j]);
+   for (j=0; j<V_Dim; j++)  fprintf(fd, " %.9g", F_max[j]);
+   fprintf(fd, "\n");
+   MT_WriteKeyword(fd, (char *)MT_RESOLUTION_KW);
+   fprintf(fd, " %u %u\n", MT_MinResolutionTileNum(), 
+                          MT_MaxResolutionTileNum());
+   /* offsets of the sections, up to the last one present */
+   for (n=0, s=0; s<MT_MAX_SECTIONS; s++)  {  if (s_pos[s]) n = s+1;  }
+   MT_WriteKeyword(fd, (char *)MT_SECTIONS_KW);
+   fprintf(fd, " %d", n);
+   for (s=0; s<n; s++)  fprintf(fd, " %ld", s_pos[s]);
+   fprintf(fd, "\n");
+   MT_WriteFooterAt(fd, pos, start);
+}
            
 /* ------------------------------------------------------------------------ */
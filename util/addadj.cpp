@@ -0,0 +1,120 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ----------------------------- addadj.c -------------------------------- */
+
+#include "mt_info.h"
+#include "mt_adj.h"
+
+/* ----------------------------------------------------------------------- */
+/*            COMPUTE THE CANDIDATE ADJACENT TILES OF AN MT                */
+/* ----------------------------------------------------------------------- */
+
+/*
+Read an MT from file, compute the candidate adjacent tiles of the facets
+of its tiles (class MT_AdjTableClass), i.e., for each facet all the other
+tiles of the MT having the same facet, and write them in binary on an 
+attribute file. An extractor given such table (MT_SetAdjTable) finds
+the adjacent tiles of the extracted tiles among the candidates.
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                           global variables                              */
+/* ----------------------------------------------------------------------- */
+
+char fileName[255]; /* file containing the MT */
+char adjName[255];  /* file where to write the table */
+MT_MultiTesselation myMT;
+MT_AdjTable myAdj;
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* termination due to error */
+void fatalError(char *message)
+{
+    fprintf(stderr, "Fatal error: %s\n", message);
+    exit(1);
+}
+
+/* management of command line options */
+void setOptions(int argc, char * argv[])
+{
+   if (argc<3)
+   {
+     fprintf(stderr,"Usage: %s mt_file adj_file\n",argv[0]);
+     fprintf(stderr,"  Compute the candidate adjacent tiles for the MT\n");
+     fprintf(stderr,"  contained in file mt_file and write them in file\n");
+     fprintf(stderr,"  adj_file.\n");
+     exit(1);
+   }
+   strcpy(fileName,argv[1]);
+   strcpy(adjName,argv[2]);
+}
+
+/* load MT from file fileName */
+void loadMT(void)
+{
+   MT_FileInfo info;
+   
+   /* Use info to read the MT dimensions, without reading the MT */
+   info = new MT_FileInfoClass();
+   if (!info->MT_Read(fileName))
+       fatalError("Cannot open file");    
+
+   /* Create mt with the correct dimensions just read */
+   myMT = new MT_MultiTesselationClass(info->MT_VertexDim(), info->MT_TileDim());
+
+   if (myMT->MT_Read(fileName) != 1)
+       fatalError("Cannot read MT from given file");
+   fprintf(stderr,"MT loaded from file %s.\n",fileName);
+   delete info;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    setOptions(argc,argv);
+    loadMT();
+    myAdj = new MT_AdjTableClass(myMT->MT_NumTileVertices());
+    if (!myAdj->MT_BuildAdjTable(myMT))
+       fatalError("Cannot compute the candidates");
+    fprintf(stderr,"%d candidates for %d tiles, %f per facet.\n",
+            myAdj->MT_CandNum(), myMT->MT_TileNum(),
+            (float)myAdj->MT_CandNum() / 
+            (float)(myMT->MT_TileNum()*myMT->MT_NumTileVertices()) );
+    if (!myAdj->MT_Write(adjName, MT_BINARY_ENCODING))
+       fatalError("Cannot write the candidates");
+    fprintf(stderr,"Candidates written on file %s.\n",adjName);
+    delete myAdj;
+    delete myMT;
+    return 0;
+}
+
+/* ----------------------------------------------------------------------- */
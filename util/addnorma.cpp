@@ -45,8 +45,8 @@ vertex of the collapsed edge).
 We use a static extractor and a filter condition identically false on all
 tiles, and extract the tesselation at maximum resolutiuon available in the
 MT. In our assumption, such tesselation contains all vertices. 
-We compute vertex normals on such tesselation and assign them to the MT 
-vertices.
+We compute vertex normals on such tesselation, from the vertex stars kept 
+by the extractor, and assign them to the MT vertices.
 */
 
 /* ----------------------------------------------------------------------- */
@@ -58,56 +58,40 @@ MT_StaticExtractor ex;   /* the extractor */
 MT_FalseCond flt;        /* filter identically false */
 VertexNormalBuildingInterface bi; /* building interface for vertex normals */
 
-MT_INDEX * extra_trgs;  /* array extracted triangles */
-MT_INDEX extra_count;   /* counter for extracted triangles */
-
-float * VN_Arr; /* array: vertex normals for all MT vertices */
-int * VN_count; /* array: counters of incident triangles for all vertices */
-
 /* ----------------------------------------------------------------------- */
 /*                         Auxiliary function                              */
 /* ----------------------------------------------------------------------- */
 
 /*
-Compute vertex normals on the extracted tesselation.
+Compute the normal vn of vertex w on the extracted tesselation, as the
+average of the normals of the triangles incident at w. If w is not in
+the extracted tesselation, vn is null.
 */
-void computeVertexNormals(void)
+void computeVertexNormal(MT_INDEX w, float * vn)
 {
+  MT_INDEX * s;   /* triangles incident at w */
   MT_INDEX * v;   /* vertices of current triangle */
   float n[3];     /* components of normal to current triangle */
-  MT_INDEX i;
-  int j;
+  int i, k;
   
-  for (i=0; i<extra_count; i++)
+  vn[0] = vn[1] = vn[2] = 0.0;
+  k = ex->MT_VertexStarSize(w);
+  s = ex->MT_VertexStar(w);
+  if ( (!k) || (!s) ) return;
+  for (i=0; i<k; i++)
   {
-     mt->MT_TileVertices(extra_trgs[i], &v);
+     mt->MT_TileVertices(s[i], &v);
      TriangleNormalv (mt->MT_VertexCoords(v[0]),
                       mt->MT_VertexCoords(v[1]),
                       mt->MT_VertexCoords(v[2]), n);
-
-     for (j=0;j<3;j++)
-     {
-        VN_count[v[j]]++;
-        VN_Arr[3*v[j]] += n[0];
-        VN_Arr[3*v[j]+1] += n[1];
-        VN_Arr[3*v[j]+2] += n[2];
-     }
-  }
-  for (i=0; i<extra_count; i++)
-  {
-     mt->MT_TileVertices(extra_trgs[i], &v);
-     for (j=0;j<3;j++)
-     {  if (VN_count[v[j]] != 0) /* see [*] below */
-        {
-          VN_Arr[3*v[j]] /=  VN_count[v[j]];
-          VN_Arr[3*v[j]+1] /=  VN_count[v[j]];
-          VN_Arr[3*v[j]+2] /=  VN_count[v[j]];
-          /* [*] set 0 for avoiding examining this vertex another time */
-          VN_count[v[j]] = 0;
-          normalize(&VN_Arr[3*v[j]], &VN_Arr[3*v[j]+1], &VN_Arr[3*v[j]+2]);
-        }
-     }
+     vn[0] += n[0];
+     vn[1] += n[1];
+     vn[2] += n[2];
   }
+  vn[0] /= k;
+  vn[1] /= k;
+  vn[2] /= k;
+  normalize(&vn[0], &vn[1], &vn[2]);
 }
 
 /* ----------------------------------------------------------------------- */
@@ -118,6 +102,7 @@ int main (int argc, char ** argv)
 {
   FILE * fd;
   MT_INDEX i;
+  float vn[3];  /* normal of vertex i */
  
   if (argc<3)
   {
@@ -138,35 +123,33 @@ int main (int argc, char ** argv)
   fclose(fd);   
   fprintf(stderr,"MT loaded from file %s.\n",argv[1]);
 
-  /* Create extractor, filter, and extract tesselation. */
+  /* Create extractor, filter, and extract tesselation with the 
+     vertex stars. */
   ex = new MT_StaticExtractorClass(mt);
+  if (!ex->MT_SetVertexStars(1))
+  {  fprintf(stderr,"Cannot enable vertex stars\n");
+     exit(1);
+  }
   flt = new MT_FalseCondClass();
   ex->MT_SetFilter(flt);
   ex->MT_ExtractTesselation();
-  extra_count = ex->MT_ExtractedTiles(&extra_trgs);
-
-  /* Allocate auxiliary arrays */
-  VN_count = (int *) calloc (mt->MT_VertexNum()+1, sizeof(int) );
-  VN_Arr = (float *) calloc ( 3*(mt->MT_VertexNum()+1), sizeof(float) );
 
-  /* Compute vertex normals on extracted tesselation. */
-  computeVertexNormals();
-  
-  /* delete what is not needed any more */
-  free (VN_count);
-  delete ex;
-  delete flt;
-  
   /* Create vertex normal building interface */
   bi = new VertexNormalBuildingInterfaceClass();
   
-  /* Record vertex normals into the building interface */
+  /* Compute vertex normals on extracted tesselation, and record them 
+     into the building interface */
   bi->StartVertexNormalHistory();
   for (i=1; i<=mt->MT_VertexNum(); i++)
   {
-     bi->MakeVertexNormal(i, VN_Arr+3*i);
+     computeVertexNormal(i, vn);
+     bi->MakeVertexNormal(i, vn);
   }
   bi->EndVertexNormalHistory();
+
+  /* delete what is not needed any more */
+  delete ex;
+  delete flt;
   
   /* convert vertex normal from building interface to vertex normal
      table of the MT */
@@ -186,7 +169,6 @@ int main (int argc, char ** argv)
   /* free allocated memory */
   delete bi;
   delete mt;
-  free (VN_Arr);
 }
 
 /* ----------------------------------------------------------------------- */
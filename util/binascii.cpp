@@ -25,15 +25,16 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 /* ----------------------------- binascii.c ------------------------------ */
 
-#include "mt_multi.h"
+#include "mt_info.h"
 
 /* ----------------------------------------------------------------------- */
 /*                CONVERT AN MT FILE INTO BINARY/ASCII FORMAT              */
 /* ----------------------------------------------------------------------- */
 
 /*
-This program reads an MT and writes it by using either the binary or the
-ascii format, as specified by the macro WHICH_ENCODING.
+This program reads an MT and writes it by using either the binary, the
+ascii, the mapped, the compressed or the stream format, as specified by
+the macro WHICH_ENCODING.
 */
 
 /* ----------------------------------------------------------------------- */
@@ -42,47 +43,18 @@ ascii format, as specified by the macro WHICH_ENCODING.
 
 /*
 This macro decides the output format of the conversion. It must be set to
-either MT_ASCII_ENCODING or MT_BINARY_ENCODING when compiling the program.
+MT_ASCII_ENCODING, MT_BINARY_ENCODING, MT_MAPPED_ENCODING, 
+MT_COMPRESSED_ENCODING or MT_STREAM_ENCODING when compiling the program.
 */
 
 /*******
 #define WHICH_ENCODING MT_ASCII_ENCODING
 #define WHICH_ENCODING MT_BINARY_ENCODING
+#define WHICH_ENCODING MT_MAPPED_ENCODING
+#define WHICH_ENCODING MT_COMPRESSED_ENCODING
+#define WHICH_ENCODING MT_STREAM_ENCODING
 *******/
   
-/* ----------------------------------------------------------------------- */
-/*                         Auxiliary class                                 */
-/* ----------------------------------------------------------------------- */
-
-/*
-This class allows to read just the header of an MT file and to find
-out the dimensions of the MT tiles and of the embedding space.
-*/
-
-class CheckDimensionsClass : public MT_MultiTesselationClass
-{
-  protected:
-  
-  inline int MT_ReadBody(FILE * fd, int file_encoding) {  return 1; }
-  int MT_ReadClassAndParams(FILE * fd);
-  
-  public:
-  
-  /*
-  Constructor (just a dummy initialization of the superclass).
-  */
-  inline CheckDimensionsClass(void): MT_MultiTesselationClass(1,1) {}
-};
-
-int CheckDimensionsClass :: MT_ReadClassAndParams(FILE * fd)
-{ 
-  int vd, td;
-  if (!MT_SearchKeyword(fd, MT_ClassKeyword())) return 0;
-  if (fscanf(fd, "%d %d", &vd, &td)==2)
-  {   V_Dim = vd;  T_Dim = td;  }
-  return 1;
-}
-
 /* ----------------------------------------------------------------------- */
 /*                                    MAIN                                 */
 /* ----------------------------------------------------------------------- */
@@ -92,7 +64,7 @@ int main (int argc, char ** argv)
   char in_name[MT_MAX_STRLEN];
   char out_name[MT_MAX_STRLEN];
   FILE * in_fd, * out_fd;
-  CheckDimensionsClass * chk;
+  MT_FileInfo info;
   MT_MultiTesselation mt;  /* the MT */
 
   if (argc < 3)
@@ -104,6 +76,17 @@ int main (int argc, char ** argv)
       case MT_BINARY_ENCODING:
         fprintf(stderr,"Convert an MT into binary format\n");
         break;
+      case MT_MAPPED_ENCODING:
+        fprintf(stderr,"Convert an MT into mapped format\n");
+        break;
+      case MT_STREAM_ENCODING:
+        fprintf(stderr,"Convert an MT into stream format\n");
+        break;
+      case MT_COMPRESSED_ENCODING:
+        fprintf(stderr,"Convert an MT into compressed format\n");
+        fprintf(stderr,"Need parameters: input_file output_file [bits]\n");
+        fprintf(stderr,"bits = 16 or 24 to quantize coordinates (lossy)\n");
+        exit(1);
     }
     fprintf(stderr,"Need parameters: input_file output_file\n");
     exit(1);
@@ -117,24 +100,29 @@ int main (int argc, char ** argv)
   out_fd = fopen(out_name,"w");
   if (!out_fd)  MT_FatalError("Cannot open output file","main");
   
-  /* Use chk to read the MT dimensions, close and re-open input file */
-  chk = new CheckDimensionsClass();
-  chk->MT_Read(in_fd);
-  fclose(in_fd);
-  in_fd = fopen(in_name,"r");
+  /* Use info to read the MT dimensions, then go back to the beginning */
+  info = new MT_FileInfoClass();
+  info->MT_Read(in_fd);
+  rewind(in_fd);
   
   /* Create mt with the correct dimensions just read */
-  mt = new MT_MultiTesselationClass(chk->MT_VertexDim(), chk->MT_TileDim());
+  mt = new MT_MultiTesselationClass(info->MT_VertexDim(), info->MT_TileDim());
   
   /* Read the MT */
   mt->MT_Read(in_fd);
   
+  /* Set the quantization of coordinates, if given */
+  if ( (WHICH_ENCODING==MT_COMPRESSED_ENCODING) && (argc > 3) )
+  {  if (!mt->MT_SetQuantization(atoi(argv[3])))
+        MT_FatalError("Invalid number of bits","main");
+  }
+
   /* Write the MT in the specified format */
   mt->MT_Write(out_fd,WHICH_ENCODING);
 
   fclose(in_fd);
   fclose(out_fd);
-  delete chk;
+  delete info;
 }
 
 /* ----------------------------------------------------------------------- */
@@ -0,0 +1,262 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+/* ---------------------------- boxbench.c ------------------------------- */
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+#include "mt_extra.h"
+#include "mt_info.h"
+#include "mt_box.h"
+#include "fcsbox.h"
+
+/* ----------------------------------------------------------------------- */
+/*           LOCAL EXTRACTION WITH THE BOXES OF THE ARCS AND NODES         */
+/* ----------------------------------------------------------------------- */
+
+/*
+This program computes the box table of an MT (class MT_BoxTableClass), 
+i.e., the boxes of its arcs and of the sub-DAGs of its nodes, and 
+optionally writes it into a file and reads it back.
+Then it runs a number of requests, each extracting the tesselation at 
+maximum resolution inside a small box (1/32 of the bounding box of the
+MT on each of the first two coordinates), placed at a pseudo-random
+position depending on the request number. The requests are run with a
+local extractor, a sparse extractor and a local dynamic extractor, 
+first without and then with the box table; the local dynamic extractor
+updates the tesselation of each request from the one of the previous 
+request. The program prints the time of each request and the number of
+tiles tested against the focus set, and checks that the sparse and the
+local dynamic extractors extract the same tiles as the local one, and 
+that the box table does not change the extracted tiles.
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                           global variables                              */
+/* ----------------------------------------------------------------------- */
+
+char fileName[255];      /* file to be read */
+char boxName[255];       /* box file to be written, empty if none */
+int requestNum = 256;    /* number of requests */
+
+MT_MultiTesselation mt;  /* the MT */
+MT_BoxTable boxes;       /* its box table */
+MT_Cond filter;          /* resolution filter of all requests */
+MT_Cond * focus;         /* focus condition of each request */
+MT_INDEX * refNum;       /* number of tiles extracted by each request */
+MT_INDEX * refSum;       /* sum of the indexes of such tiles */
+int errorNum = 0;        /* number of wrong extractions */
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* termination due to error */
+void fatalError(char *message)
+{
+    fprintf(stderr, "Fatal error: %s\n", message);
+    exit(1);
+}
+
+/* management of command line options */
+void setOptions(int argc, char * argv[])
+{
+   if (argc==1) /* no command line options */
+   {
+     fprintf(stderr,"Usage: %s XXX [N [YYY]]\n",argv[0]);
+     fprintf(stderr,"Run N small-focus requests (default 256) on the MT ");
+     fprintf(stderr,"in file XXX without and with\n");
+     fprintf(stderr,"its box table, writing the box table in file YYY\n");
+     exit(1);
+   }
+   strcpy(fileName,argv[1]); /* file name to open */
+   if (argc>2) requestNum = atoi(argv[2]);
+   if (requestNum<1) requestNum = 1;
+   boxName[0] = '\0';
+   if (argc>3) strcpy(boxName,argv[3]);
+}
+
+/* elapsed time in seconds from some fixed instant */
+double wallTime(void)
+{
+#ifdef _WIN32
+   return ( (double)clock() / (double)CLOCKS_PER_SEC );
+#else
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0 );
+#endif
+}
+
+/* create the focus condition of request r */
+MT_Cond requestFocus(int r)
+{
+   unsigned long s = 12345 + 7919 * (unsigned long)r; /* pseudo-random */
+   float dx = ( mt->MT_MaxCoord(0) - mt->MT_MinCoord(0) ) / 32.0;
+   float dy = ( mt->MT_MaxCoord(1) - mt->MT_MinCoord(1) ) / 32.0;
+   float x, y;
+   s = (s * 1103515245 + 12345) & 0x7fffffff;
+   x = mt->MT_MinCoord(0) + 31.0 * dx * (float)(s % 1000) / 1000.0;
+   s = (s * 1103515245 + 12345) & 0x7fffffff;
+   y = mt->MT_MinCoord(1) + 31.0 * dy * (float)(s % 1000) / 1000.0;
+   return new Box2FocusOnTrianglesClass(x, y, x+dx, y+dy);
+}
+
+/* ----------------------------------------------------------------------- */
+/*                            input MT                                     */
+/* ----------------------------------------------------------------------- */
+
+/* read the MT from the file */
+MT_MultiTesselation readMT(void)
+{
+   MT_FileInfo info = new MT_FileInfoClass();
+   MT_MultiTesselation m;
+   if ( (!info->MT_Read(fileName)) || 
+        strcmp(info->MT_ClassKeyword(), "MT_MultiTesselation") )
+      fatalError("Not an MT file");
+   if (info->MT_TileDim()!=2)  fatalError("Need triangular tiles");
+   m = new MT_MultiTesselationClass(info->MT_VertexDim(),
+                                    info->MT_TileDim());
+   delete info;
+   if (!m->MT_Read(fileName)) fatalError("Cannot read MT");
+   printf("File %s\n", fileName);
+   return m;
+}
+
+/* compute the box table, and possibly write it and read it back */
+MT_BoxTable makeBoxes(void)
+{
+   MT_BoxTable b = new MT_BoxTableClass(mt->MT_VertexDim());
+   double start = wallTime();
+   if (!b->MT_BuildBoxes(mt)) fatalError("Cannot compute the boxes");
+   printf("%-12s %10.4f sec\n", "box table", wallTime() - start);
+   if (boxName[0])
+   {
+     if (!b->MT_Write(boxName, MT_BINARY_ENCODING))
+        fatalError("Cannot write the box table");
+     delete b;
+     b = new MT_BoxTableClass(mt->MT_VertexDim());
+     if (!b->MT_Read(boxName))  fatalError("Cannot read the box table");
+     printf("Box table written to %s\n", boxName);
+   }
+   return b;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                              extraction                                 */
+/* ----------------------------------------------------------------------- */
+
+/* extract request r with extractor e, and return the sum of the indexes
+   of the extracted tiles */
+MT_INDEX extract(MT_Extractor e, int r, MT_INDEX * num)
+{
+   MT_INDEX * t, sum = 0;
+   MT_INDEX i;
+   e->MT_SetFocus(focus[r]);
+   e->MT_ExtractTesselation();
+   (*num) = e->MT_ExtractedTiles(&t);
+   for (i=0; i<(*num); i++)  sum += t[i];
+   return sum;
+}
+
+/* run all requests with extractor e, check them against the reference
+   (if check is set, otherwise make the reference), and print the time 
+   of a request and the number of tiles tested in it */
+void runRequests(MT_Extractor e, char * name, int check)
+{
+   MT_INDEX num, sum;
+   double start, sec;
+   long tested = 0;
+   int r;
+
+   e->MT_SetFilter(filter);
+   e->MT_EnableStat();
+   start = wallTime();
+   for (r=0; r<requestNum; r++)
+   {
+     sum = extract(e, r, &num);
+     tested += e->MT_TestedTiles();
+     if (!check)  {  refNum[r] = num;  refSum[r] = sum;  }
+     else if ( (num != refNum[r]) || (sum != refSum[r]) )
+     {
+       errorNum++;
+       fprintf(stderr, "Request %d: different tiles extracted\n", r);
+     }
+   }
+   sec = wallTime() - start;
+   printf("%-12s %10.4f msec per request  %10ld tested tiles\n", 
+          name, 1000.0 * sec / requestNum, tested / requestNum);
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    MT_LocalExtractor local;
+    MT_SparseExtractor sparse;
+    MT_LocalDynamicExtractor locdyn;
+    int r;
+
+    setOptions(argc,argv);
+    mt = readMT();
+    printf("%ld nodes, %ld arcs, %d requests\n", (long)mt->MT_NodeNum(),
+           (long)mt->MT_ArcNum(), requestNum);
+    fflush(stdout);
+    boxes = makeBoxes();
+    filter = new MT_FalseCondClass(); /* maximum resolution */
+    focus = (MT_Cond *) malloc ( requestNum * sizeof(MT_Cond) );
+    refNum = (MT_INDEX *) malloc ( requestNum * sizeof(MT_INDEX) );
+    refSum = (MT_INDEX *) malloc ( requestNum * sizeof(MT_INDEX) );
+    if ( !(focus && refNum && refSum) )  fatalError("Allocation failed");
+    for (r=0; r<requestNum; r++)  focus[r] = requestFocus(r);
+
+    local = new MT_LocalExtractorClass(mt);
+    sparse = new MT_SparseExtractorClass(mt);
+    locdyn = new MT_LocalDynamicExtractorClass(mt);
+    runRequests(local, "local", 0);
+    runRequests(sparse, "sparse", 1);
+    runRequests(locdyn, "locdyn", 1);
+    if ( (!local->MT_SetBoxTable(boxes)) || 
+         (!sparse->MT_SetBoxTable(boxes)) ||
+         (!locdyn->MT_SetBoxTable(boxes)) )
+       fatalError("Box table not good for MT");
+    runRequests(local, "local+boxes", 1);
+    runRequests(sparse, "sparse+boxes", 1);
+    runRequests(locdyn, "locdyn+boxes", 1);
+
+    if (errorNum)  printf("%d wrong extractions\n", errorNum);
+    else printf("All extractions correct\n");
+    delete local; delete sparse; delete locdyn;
+    for (r=0; r<requestNum; r++)  delete (Box2FocusOnTriangles) focus[r];
+    free(focus); free(refNum); free(refSum);
+    delete filter; delete boxes; delete mt;
+    return ( errorNum ? 1 : 0 );
+}
+
+/* ----------------------------------------------------------------------- */
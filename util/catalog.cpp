@@ -0,0 +1,109 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ----------------------------- catalog.c ------------------------------- */
+
+#include "mt_info.h"
+
+/* ----------------------------------------------------------------------- */
+/*                 SUMMARY OF MT FILES WITHOUT READING THEM                */
+/* ----------------------------------------------------------------------- */
+
+/*
+Print a summary of each given MT file, taken from its footer (or from
+its header, if the file has no footer): class, dimensions, number of
+vertices, tiles, nodes and arcs, encoding, number of tiles at minimum 
+and maximum resolution, bounding box.
+The body of the files is never read, thus the time needed does not 
+depend on the size of the files.
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* name of an encoding */
+char * encodingName(int e)
+{
+   switch (e)
+   {  case MT_ASCII_ENCODING: return (char *)MT_ASCII_KW;
+      case MT_BINARY_ENCODING: return (char *)MT_BINARY_KW;
+      case MT_MAPPED_ENCODING: return (char *)MT_MAPPED_KW;
+      case MT_COMPRESSED_ENCODING: return (char *)MT_COMPRESSED_KW;
+      case MT_STREAM_ENCODING: return (char *)MT_STREAM_KW;
+   }
+   return (char *)"?";
+}
+
+/* print the summary of a file */
+void printInfo(char * fileName, MT_FileInfo info)
+{
+   int j;
+   printf("%s: %s %d %d, %u vertices, %u tiles, %u nodes, %u arcs, %s\n",
+          fileName, info->MT_ClassKeyword(), 
+          info->MT_VertexDim(), info->MT_TileDim(),
+          info->MT_VertexNum(), info->MT_TileNum(), 
+          info->MT_NodeNum(), info->MT_ArcNum(),
+          encodingName(info->MT_TheEncoding()));
+   if (!info->MT_HasFooter())
+   {
+     printf("  (no footer)\n");
+     return;
+   }
+   printf("  tiles at min resolution = %u, at max resolution = %u\n",
+          info->MT_MinResolutionTileNum(), info->MT_MaxResolutionTileNum());
+   printf("  bounding box =");
+   for (j=0; j<info->MT_VertexDim(); j++)
+   {  printf(" [%g %g]", info->MT_MinCoord(j), info->MT_MaxCoord(j));  }
+   printf("\n");
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+   MT_FileInfo info = new MT_FileInfoClass();
+   int i, ok = 1;
+   if (argc==1) /* no command line options */
+   {
+     fprintf(stderr,"Usage: %s XXX ...\n",argv[0]);
+     fprintf(stderr,"Print a summary of the MT files XXX ...\n"); 
+     exit(1);
+   }
+   for (i=1; i<argc; i++)
+   {
+     if (info->MT_Read(argv[i])) printInfo(argv[i], info);
+     else
+     {  fprintf(stderr,"%s: cannot read file\n", argv[i]);
+        ok = 0;
+     }
+   }
+   delete info;
+   return ( ok ? 0 : 1 );
+}
+
+/* ----------------------------------------------------------------------- */
@@ -0,0 +1,351 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ---------------------------- inclbench.c ------------------------------ */
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+#include "mt_extra.h"
+#include "mt_info.h"
+
+/* ----------------------------------------------------------------------- */
+/*              BENCHMARK FOR THE INCLUSION OF NODES IN EXTRACTORS         */
+/* ----------------------------------------------------------------------- */
+
+/*
+Function MT_IncludeNode of the extractors adds a node to the current set
+after adding all its ancestors not yet in the set. It visits such ancestors
+through an explicit work stack. Before, it called itself recursively on
+each parent, thus a call needed stack space proportional to the length
+of the longest chain of ancestors to be added, and long chains (e.g.,
+in MTs built by refining one vertex at a time) could overflow the stack.
+
+This program extracts the tesselation at maximum resolution from an MT
+with a global static extractor, and the one at maximum resolution in
+the left half of the bounding box with a local extractor. It uses both
+the extractors of the library and subclasses of them that redefine 
+MT_IncludeNode as the recursive function used before, checks that the
+extracted tiles are the same, and prints the elapsed times.
+The MT is read from a file, or it is a synthetic MT where the first 
+node to be included has a chain of N ancestors, each one being a parent 
+of the next one: the root has an arc to each node of the chain (the arc 
+to the last one is the first in the front), and each node of the chain 
+has an arc to the next one and to the drain.
+On large N, the recursive version may crash because of stack overflow
+(it is run after the iterative one, whose results are printed first).
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                           global variables                              */
+/* ----------------------------------------------------------------------- */
+
+char fileName[255];      /* file to be read, empty for a synthetic MT */
+MT_INDEX chainLen = 0;   /* length of the chain in the synthetic MT */
+int repeatNum = 5;       /* number of times each extraction is repeated */
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* termination due to error */
+void fatalError(char *message)
+{
+    fprintf(stderr, "Fatal error: %s\n", message);
+    exit(1);
+}
+
+/* management of command line options */
+void setOptions(int argc, char * argv[])
+{
+   if (argc==1) /* no command line options */
+   {
+     fprintf(stderr,"Usage: %s XXX [N]\n",argv[0]);
+     fprintf(stderr,"Time extractions from the MT in file XXX or, if XXX ");
+     fprintf(stderr,"is a number, from a synthetic MT\n");
+     fprintf(stderr,"with a chain of XXX nodes, ");
+     fprintf(stderr,"repeating each extraction N times (default 5)\n");
+     exit(1);
+   }
+   fileName[0] = '\0';
+   if ( strspn(argv[1],"0123456789") == strlen(argv[1]) )
+   {
+     chainLen = (MT_INDEX) atol(argv[1]);
+     if (chainLen<1) chainLen = 1;
+   }
+   else strcpy(fileName,argv[1]); /* file name to open */
+   if (argc>2) repeatNum = atoi(argv[2]);
+   if (repeatNum<1) repeatNum = 1;
+}
+
+/* elapsed time in seconds from some fixed instant */
+double wallTime(void)
+{
+#ifdef _WIN32
+   return ( (double)clock() / (double)CLOCKS_PER_SEC );
+#else
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0 );
+#endif
+}
+
+/* ----------------------------------------------------------------------- */
+/*                 extractors with the recursive MT_IncludeNode            */
+/* ----------------------------------------------------------------------- */
+
+class RecStaticExtractorClass : public MT_StaticExtractorClass
+{
+   public:
+   RecStaticExtractorClass(MT_MultiTesselation m)
+   : MT_StaticExtractorClass(m)  {  }
+
+   protected:
+   int MT_IncludeNode (MT_INDEX n);
+};
+
+int RecStaticExtractorClass :: MT_IncludeNode (MT_INDEX n)
+{
+  MT_INDEX a; /* variable for arc */
+  MT_INDEX p; /* variable for parent node */
+
+  if (num_tiles+2>max_tile_num) return 0;
+  if (stat_enabled)  n_visited++;
+  a = mt->MT_FirstInArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    if (stat_enabled)  a_tested++;
+    p = mt->MT_ArcSource(a);
+    if (!MT_IsInSet(p))  
+    {  if (!MT_IncludeNode(p)) return 0;
+    }
+    a = mt->MT_NextInArc(n,a);
+  }
+  MT_AddToSet(n);
+  a = mt->MT_FirstInArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    A_front->MT_RemElem(a);
+    MT_RemTiles(a);
+    a = mt->MT_NextInArc(n,a);
+  }
+  a = mt->MT_FirstOutArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    A_front->MT_AddElem(a);
+    MT_AddTiles(a);
+    a = mt->MT_NextOutArc(n,a);
+  }
+  return 1;
+}
+
+class RecLocalExtractorClass : public MT_LocalExtractorClass
+{
+   public:
+   RecLocalExtractorClass(MT_MultiTesselation m)
+   : MT_LocalExtractorClass(m)  {  }
+
+   protected:
+   int MT_IncludeNode (MT_INDEX n);
+};
+
+int RecLocalExtractorClass :: MT_IncludeNode (MT_INDEX n)
+{
+  MT_INDEX a; /* variable for arc */
+  MT_INDEX p; /* variable for parent node */
+
+  if (stat_enabled)  n_visited++;
+  a = mt->MT_FirstInArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    if (stat_enabled)  a_tested++;
+    p = mt->MT_ArcSource(a);
+    if ((!MT_IsInSet(p)) && MT_FocusArc(a))  MT_IncludeNode(p);
+    a = mt->MT_NextInArc(n,a);
+  }
+  MT_AddToSet(n);
+  a = mt->MT_FirstInArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    if ( A_front->MT_IsInList(a) )
+    {
+      A_front->MT_RemElem(a);
+      MT_RemTiles(a);
+    }
+    a = mt->MT_NextInArc(n,a);
+  }
+  a = mt->MT_FirstOutArc(n);
+  while (a != MT_NULL_INDEX)
+  {
+    if (MT_FocusArc(a))
+    {
+      A_front->MT_AddElem(a);
+      MT_AddTiles(a);
+    }
+    a = mt->MT_NextOutArc(n,a);
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                          focus condition                                */
+/* ----------------------------------------------------------------------- */
+
+/* a tile is in the focus if its first vertex is in the left half of
+   the bounding box of the MT */
+class LeftHalfCondClass : public MT_CondClass
+{
+   float mid;
+
+   public:
+
+   LeftHalfCondClass(MT_MultiTesselation m)
+   {  mid = 0.5 * ( m->MT_MinCoord(0) + m->MT_MaxCoord(0) );  }
+
+   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+   {  return ( m->MT_VertexX(m->MT_TileVertex(t,0)) <= mid );  }
+};
+
+/* ----------------------------------------------------------------------- */
+/*                            input MT                                     */
+/* ----------------------------------------------------------------------- */
+
+/* build the synthetic MT with a chain of chainLen nodes */
+MT_MultiTesselation chainMT(void)
+{
+   MT_MultiTesselation m = new MT_MultiTesselationClass(2,2);
+   float c[3][2] = { {0.0,0.0}, {1.0,0.0}, {0.0,1.0} };
+   MT_INDEX v[3] = { 1, 2, 3 };
+   MT_INDEX drain = chainLen+2;  /* nodes of the chain are 2..chainLen+1 */
+   MT_INDEX a_num = 3*chainLen-1; /* one tile on each arc */
+   MT_INDEX a = 0, k;
+   int i;
+   if ( !( m->MT_SetVertexNum(3) && m->MT_SetTileNum(a_num) && 
+           m->MT_SetArcNum(a_num) && m->MT_SetNodeNum(drain) ) )
+      fatalError("Cannot allocate the MT");
+   for (i=0; i<3; i++) m->MT_AddVertex(v[i], c[i]);
+   for (k=chainLen+1; k>1; k--) /* arcs leaving the root */
+   {
+     a++; m->MT_AddArc(a, m->MT_Root(), k);
+     m->MT_AddTile(a, v); m->MT_AddTileArc(a, a);
+   }
+   for (k=2; k<=chainLen+1; k++) /* arcs leaving the nodes of the chain */
+   {
+     if (k<=chainLen)
+     {
+       a++; m->MT_AddArc(a, k, k+1);
+       m->MT_AddTile(a, v); m->MT_AddTileArc(a, a);
+     }
+     a++; m->MT_AddArc(a, k, drain);
+     m->MT_AddTile(a, v); m->MT_AddTileArc(a, a);
+   }
+   m->MT_ComputeBoundingBox();
+   printf("Synthetic MT, chain of %ld nodes\n", (long)chainLen);
+   return m;
+}
+
+/* read the MT from the file */
+MT_MultiTesselation readMT(void)
+{
+   MT_FileInfo info = new MT_FileInfoClass();
+   MT_MultiTesselation m;
+   if ( (!info->MT_Read(fileName)) || 
+        strcmp(info->MT_ClassKeyword(), "MT_MultiTesselation") )
+      fatalError("Not an MT file");
+   m = new MT_MultiTesselationClass(info->MT_VertexDim(),
+                                    info->MT_TileDim());
+   delete info;
+   if (!m->MT_Read(fileName)) fatalError("Cannot read MT");
+   printf("File %s\n", fileName);
+   return m;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                              extraction                                 */
+/* ----------------------------------------------------------------------- */
+
+/* extract repeatNum times, print the time and return the extracted
+   tiles (in an array to be deallocated) */
+MT_INDEX timeExtraction(char * what, MT_Extractor e, MT_INDEX ** t_arr)
+{
+   double start, sec;
+   MT_INDEX num, * t;
+   int r;
+   start = wallTime();
+   for (r=0; r<repeatNum; r++)  e->MT_ExtractTesselation();
+   sec = (wallTime() - start) / (double)repeatNum;
+   num = e->MT_ExtractedTiles(&t);
+   printf("%-12s %10.4f sec  %10ld tiles\n", what, sec, (long)num);
+   fflush(stdout);
+   (*t_arr) = (MT_INDEX *) malloc ( (num+1)*sizeof(MT_INDEX) );
+   if (!(*t_arr)) fatalError("Allocation failed");
+   memcpy(*t_arr, t, num*sizeof(MT_INDEX));
+   return num;
+}
+
+/* time the iterative and the recursive versions of an extractor */
+void compare(char * what, MT_Extractor e1, MT_Extractor e2,
+             MT_Cond flt, MT_Cond fcs)
+{
+   MT_INDEX n1, n2, * t1, * t2;
+   char line[MT_MAX_STRLEN];
+   e1->MT_SetFilter(flt); e2->MT_SetFilter(flt);
+   if (fcs) {  e1->MT_SetFocus(fcs); e2->MT_SetFocus(fcs);  }
+   sprintf(line, "%s", what);
+   n1 = timeExtraction(line, e1, &t1);
+   sprintf(line, "%s rec", what);
+   n2 = timeExtraction(line, e2, &t2);
+   if ( (n1!=n2) || memcmp(t1, t2, n1*sizeof(MT_INDEX)) )
+      printf("Different tiles extracted\n");
+   free(t1); free(t2);
+   delete e1; delete e2;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    MT_MultiTesselation m;
+    MT_Cond flt, fcs;
+    setOptions(argc,argv);
+    m = ( fileName[0] ? readMT() : chainMT() );
+    printf("%ld nodes, %ld arcs, %d repetitions\n", 
+           (long)m->MT_NodeNum(), (long)m->MT_ArcNum(), repeatNum);
+    fflush(stdout);
+    flt = new MT_FalseCondClass(); /* maximum resolution */
+    fcs = new LeftHalfCondClass(m);
+    compare((char *)"static", new MT_StaticExtractorClass(m), 
+            new RecStaticExtractorClass(m), flt, NULL);
+    compare((char *)"local", new MT_LocalExtractorClass(m), 
+            new RecLocalExtractorClass(m), flt, fcs);
+    delete flt; delete fcs; delete m;
+    return 0;
+}
+
+/* ----------------------------------------------------------------------- */
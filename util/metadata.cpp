@@ -25,7 +25,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 /* ----------------------------- stats.c ---------------------------------- */
 
-#include "mt_multi.h"
+#include "mt_info.h"
 
 /* ----------------------------------------------------------------------- */
 /*                         STATISTICS ON AN MT                             */
@@ -43,39 +43,6 @@ Read MT from file, write statistics to standard output.
 - maximum and mean number of new tiles of an internal node
 */
 
-/* ----------------------------------------------------------------------- */
-/*                         Auxiliary class                                 */
-/* ----------------------------------------------------------------------- */
-
-/*
-This class allows to read just the header of an MT file and to find
-out the dimensions of the MT tiles and of the embedding space.
-*/
-
-class CheckDimensionsClass : public MT_MultiTesselationClass
-{
-  protected:
-  
-  inline int MT_ReadBody(FILE * fd, int file_encoding) {  return 1; }
-  int MT_ReadClassAndParams(FILE * fd);
-  
-  public:
-  
-  /*
-  Constructor (just a dummy initialization of the superclass).
-  */
-  inline CheckDimensionsClass(void): MT_MultiTesselationClass(1,1) {}
-};
-
-int CheckDimensionsClass :: MT_ReadClassAndParams(FILE * fd)
-{ 
-  int vd, td;
-  if (!MT_SearchKeyword(fd, MT_ClassKeyword())) return 0;
-  if (fscanf(fd, "%d %d", &vd, &td)==2)
-  {   V_Dim = vd;  T_Dim = td;  }
-  return 1;
-}
-
 /* ----------------------------------------------------------------------- */
 /*                           global variables                              */
 /* ----------------------------------------------------------------------- */
@@ -109,27 +76,22 @@ void setOptions(int argc, char * argv[])
 /* load MT from file fileName */
 void loadMT(void)
 {
-   FILE *fd;
-   CheckDimensionsClass * chk;
+   MT_FileInfo info;
    
    printf("Loading MT from file %s...\n",fileName);
-   fd = fopen(fileName,"r");
-   if(!fd)
-       fatalError("Cannot open file");    
 
-   /* Use chk to read the MT dimensions, close and re-open input file */
-   chk = new CheckDimensionsClass();
-   chk->MT_Read(fd);
-   fclose(fd);
-   fd = fopen(fileName,"r");
+   /* Use info to read the MT dimensions, without reading the MT */
+   info = new MT_FileInfoClass();
+   if (!info->MT_Read(fileName))
+       fatalError("Cannot open file");    
 
    /* Create mt with the correct dimensions just read */
-   myMT = new MT_MultiTesselationClass(chk->MT_VertexDim(), chk->MT_TileDim());
+   myMT = new MT_MultiTesselationClass(info->MT_VertexDim(), info->MT_TileDim());
 
-   if (myMT->MT_Read(fd) != 1)
+   if (myMT->MT_Read(fileName) != 1)
        fatalError("Cannot read MT from given file");
    printf("...MT loaded\n");
-   delete chk;
+   delete info;
 }
 
 void statMT(void)
@@ -0,0 +1,308 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+/* ---------------------------- poolbench.c ------------------------------ */
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+#include "mt_extra.h"
+#include "mt_info.h"
+
+/* ----------------------------------------------------------------------- */
+/*             STRESS TEST FOR MANY EXTRACTIONS ON A SHARED MT             */
+/* ----------------------------------------------------------------------- */
+
+/*
+A tile server runs the extractions requested by many clients on one MT.
+This program simulates it: each request extracts the tesselation at 
+maximum resolution inside a small box (1/8 of the bounding box of the
+MT on each of the first two coordinates), placed at a pseudo-random
+position depending on the request number.
+
+The requests are first run in sequence with one local extractor, as a
+reference. Then, on the MT shared through a pool of extractors 
+(class MT_ExtractorPoolClass), the program:
+- takes one extractor from the pool for each request, so that all the
+  requests are open at the same time, runs the extractions on several
+  threads, and gives the extractors back;
+- runs the requests again on several threads, each one taking an
+  extractor from the pool and giving it back after the extraction.
+Each extraction is checked against the reference. The program prints
+the elapsed times, the number of extractors created by the pool, and 
+the memory used by the extractors, compared with the one of the arrays
+allocated by local extractors.
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                           global variables                              */
+/* ----------------------------------------------------------------------- */
+
+char fileName[255];      /* file to be read */
+int requestNum = 512;    /* number of requests */
+int threadNum = 0;       /* number of threads, 0 = as many as processors */
+
+MT_MultiTesselation mt;  /* the shared MT */
+MT_Cond filter;          /* resolution filter of all requests */
+MT_Cond * focus;         /* focus condition of each request */
+MT_INDEX * refNum;       /* number of tiles extracted by each request */
+MT_INDEX * refSum;       /* sum of the indexes of such tiles */
+int errorNum = 0;        /* number of wrong extractions */
+MT_Mutex errorLock;      /* mutex protecting errorNum */
+
+MT_ExtractorPool pool;   /* pool of extractors on mt */
+MT_SparseExtractor * open; /* extractors taken for all requests */
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* termination due to error */
+void fatalError(char *message)
+{
+    fprintf(stderr, "Fatal error: %s\n", message);
+    exit(1);
+}
+
+/* management of command line options */
+void setOptions(int argc, char * argv[])
+{
+   if (argc==1) /* no command line options */
+   {
+     fprintf(stderr,"Usage: %s XXX [N [T]]\n",argv[0]);
+     fprintf(stderr,"Run N extraction requests (default 512) on the MT in ");
+     fprintf(stderr,"file XXX shared by T threads\n");
+     fprintf(stderr,"(default as many as processors)\n");
+     exit(1);
+   }
+   strcpy(fileName,argv[1]); /* file name to open */
+   if (argc>2) requestNum = atoi(argv[2]);
+   if (requestNum<1) requestNum = 1;
+   if (argc>3) threadNum = atoi(argv[3]);
+}
+
+/* elapsed time in seconds from some fixed instant */
+double wallTime(void)
+{
+#ifdef _WIN32
+   return ( (double)clock() / (double)CLOCKS_PER_SEC );
+#else
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0 );
+#endif
+}
+
+/* ----------------------------------------------------------------------- */
+/*                          focus condition                                */
+/* ----------------------------------------------------------------------- */
+
+/* a tile is in the focus if the box of its vertices, on the first two
+   coordinates, intersects a given box; evaluating it does not change
+   the condition, thus it can be used by several threads */
+class WindowCondClass : public MT_CondClass
+{
+   float min_x, min_y, max_x, max_y;
+
+   public:
+
+   WindowCondClass(float x1, float y1, float x2, float y2)
+   {  min_x = x1; min_y = y1; max_x = x2; max_y = y2;  }
+
+   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+   {
+      int i, in_x1 = 0, in_x2 = 0, in_y1 = 0, in_y2 = 0;
+      for (i=0; i<m->MT_NumTileVertices(); i++)
+      {
+        MT_INDEX v = m->MT_TileVertex(t,i);
+        if (m->MT_VertexX(v) >= min_x) in_x1 = 1;
+        if (m->MT_VertexX(v) <= max_x) in_x2 = 1;
+        if (m->MT_VertexY(v) >= min_y) in_y1 = 1;
+        if (m->MT_VertexY(v) <= max_y) in_y2 = 1;
+      }
+      return ( in_x1 && in_x2 && in_y1 && in_y2 );
+   }
+};
+
+/* create the focus condition of request r */
+MT_Cond requestFocus(int r)
+{
+   unsigned long s = 12345 + 7919 * (unsigned long)r; /* pseudo-random */
+   float dx = ( mt->MT_MaxCoord(0) - mt->MT_MinCoord(0) ) / 8.0;
+   float dy = ( mt->MT_MaxCoord(1) - mt->MT_MinCoord(1) ) / 8.0;
+   float x, y;
+   s = (s * 1103515245 + 12345) & 0x7fffffff;
+   x = mt->MT_MinCoord(0) + 7.0 * dx * (float)(s % 1000) / 1000.0;
+   s = (s * 1103515245 + 12345) & 0x7fffffff;
+   y = mt->MT_MinCoord(1) + 7.0 * dy * (float)(s % 1000) / 1000.0;
+   return new WindowCondClass(x, y, x+dx, y+dy);
+}
+
+/* ----------------------------------------------------------------------- */
+/*                            input MT                                     */
+/* ----------------------------------------------------------------------- */
+
+/* read the MT from the file */
+MT_MultiTesselation readMT(void)
+{
+   MT_FileInfo info = new MT_FileInfoClass();
+   MT_MultiTesselation m;
+   if ( (!info->MT_Read(fileName)) || 
+        strcmp(info->MT_ClassKeyword(), "MT_MultiTesselation") )
+      fatalError("Not an MT file");
+   m = new MT_MultiTesselationClass(info->MT_VertexDim(),
+                                    info->MT_TileDim());
+   delete info;
+   if (!m->MT_Read(fileName)) fatalError("Cannot read MT");
+   printf("File %s\n", fileName);
+   return m;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                              extraction                                 */
+/* ----------------------------------------------------------------------- */
+
+/* extract request r with extractor e, and return the sum of the indexes
+   of the extracted tiles */
+MT_INDEX extract(MT_Extractor e, int r, MT_INDEX * num)
+{
+   MT_INDEX * t, sum = 0;
+   MT_INDEX i;
+   e->MT_SetFilter(filter);
+   e->MT_SetFocus(focus[r]);
+   e->MT_ExtractTesselation();
+   (*num) = e->MT_ExtractedTiles(&t);
+   for (i=0; i<(*num); i++)  sum += t[i];
+   return sum;
+}
+
+/* check request r extracted by e against the reference */
+void check(MT_Extractor e, int r)
+{
+   MT_INDEX num, sum;
+   sum = extract(e, r, &num);
+   if ( (num != refNum[r]) || (sum != refSum[r]) )
+   {
+     MT_LockMutex(errorLock);
+     errorNum++;
+     MT_UnlockMutex(errorLock);
+     fprintf(stderr, "Request %d: different tiles extracted\n", r);
+   }
+}
+
+/* job extracting request r with the extractor taken for it */
+void openJob(void * data, int r)
+{  check(open[r], r);  }
+
+/* job taking an extractor, extracting request r and giving it back */
+void pooledJob(void * data, int r)
+{
+   MT_SparseExtractor e = pool->MT_Acquire();
+   if (!e) fatalError("Cannot take an extractor");
+   check(e, r);
+   pool->MT_Release(e);
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    MT_LocalExtractor ref;
+    double start, sec;
+    long mem, dense;
+    int r;
+
+    setOptions(argc,argv);
+    MT_SetThreadNum(threadNum);
+    mt = readMT();
+    printf("%ld nodes, %ld arcs, %d requests, %d threads\n", 
+           (long)mt->MT_NodeNum(), (long)mt->MT_ArcNum(), requestNum,
+           MT_TheThreadNum());
+    fflush(stdout);
+    filter = new MT_FalseCondClass(); /* maximum resolution */
+    focus = (MT_Cond *) malloc ( requestNum * sizeof(MT_Cond) );
+    refNum = (MT_INDEX *) malloc ( requestNum * sizeof(MT_INDEX) );
+    refSum = (MT_INDEX *) malloc ( requestNum * sizeof(MT_INDEX) );
+    open = (MT_SparseExtractor *) 
+           malloc ( requestNum * sizeof(MT_SparseExtractor) );
+    errorLock = MT_NewMutex();
+    if ( !(focus && refNum && refSum && open && errorLock) )
+       fatalError("Allocation failed");
+    for (r=0; r<requestNum; r++)  focus[r] = requestFocus(r);
+
+    /* reference: one local extractor, in sequence */
+    ref = new MT_LocalExtractorClass(mt);
+    start = wallTime();
+    for (r=0; r<requestNum; r++)  refSum[r] = extract(ref, r, &refNum[r]);
+    sec = wallTime() - start;
+    delete ref;
+    printf("%-12s %10.4f sec\n", "sequential", sec);
+
+    /* the arrays of a local extractor */
+    dense = (long)(3*(mt->MT_NodeNum()+1)) * (long)sizeof(unsigned int) +
+            (long)(4*(mt->MT_ArcNum()+1)) * (long)sizeof(MT_INDEX);
+
+    pool = new MT_ExtractorPoolClass(mt);
+    if (!pool->MT_IsGood())  fatalError("Cannot share the MT");
+
+    /* all requests open at the same time */
+    for (r=0; r<requestNum; r++)
+    {
+      open[r] = pool->MT_Acquire();
+      if (!open[r]) fatalError("Cannot take an extractor");
+    }
+    start = wallTime();
+    MT_RunJobs(requestNum, openJob, NULL);
+    sec = wallTime() - start;
+    mem = 0;
+    for (r=0; r<requestNum; r++)
+    {
+      mem += open[r]->MT_StateMemory();
+      pool->MT_Release(open[r]);
+    }
+    printf("%-12s %10.4f sec  %d extractors  %10ld bytes (local: %ld)\n", 
+           "all open", sec, pool->MT_CreatedNum(), mem, dense*requestNum);
+
+    /* requests taking an extractor from the pool */
+    start = wallTime();
+    MT_RunJobs(requestNum, pooledJob, NULL);
+    sec = wallTime() - start;
+    printf("%-12s %10.4f sec  %d extractors\n", 
+           "pooled", sec, pool->MT_CreatedNum());
+
+    if (errorNum)  printf("%d wrong extractions\n", errorNum);
+    else printf("All extractions correct\n");
+    delete pool;
+    for (r=0; r<requestNum; r++)  delete (WindowCondClass *) focus[r];
+    free(focus); free(refNum); free(refSum); free(open);
+    MT_DeleteMutex(errorLock);
+    delete filter; delete mt;
+    return ( errorNum ? 1 : 0 );
+}
+
+/* ----------------------------------------------------------------------- */
@@ -0,0 +1,229 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ---------------------------- readbench.c ------------------------------ */
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+#include "mt_multi.h"
+#include "mt_float.h"
+#include "mt_int.h"
+#include "mt_thrd.h"
+
+/* ----------------------------------------------------------------------- */
+/*                   BENCHMARK FOR READING ASCII MT FILES                  */
+/* ----------------------------------------------------------------------- */
+
+/*
+Read a file several times and print the throughput (in MB per second) of:
+- plain reading of the file in large blocks, which is an upper bound
+  given by the disk (or by the file cache);
+- reading the numbers in the body one by one with fscanf, as the MT
+  library did before the ASCII scanner of MT_PersistentClass was
+  introduced;
+- reading the object with MT_Read, using one thread and using the 
+  threads given on the command line (default: as many as processors).
+Times are elapsed times, not processor times.
+The file may contain an MT, a float table, a float vector table or
+an int table (e.g., demo/data_demo1/bunny.err, demo/data_demo1/bunny.nrm,
+demo/data_demo2/marcy200.err).
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                           global variables                              */
+/* ----------------------------------------------------------------------- */
+
+char fileName[255]; /* file to be read */
+int repeatNum = 5;  /* number of times each test is repeated */
+int threadNum = 0;  /* threads for reading, 0 = as many as processors */
+long fileSize;      /* size of the file in bytes */
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* termination due to error */
+void fatalError(char *message)
+{
+    fprintf(stderr, "Fatal error: %s\n", message);
+    exit(1);
+}
+
+/* management of command line options */
+void setOptions(int argc, char * argv[])
+{
+   if (argc==1) /* no command line options */
+   {
+     fprintf(stderr,"Usage: %s XXX [N [T]]\n",argv[0]);
+     fprintf(stderr,"Measure read throughput of the file XXX, ");
+     fprintf(stderr,"repeating each test N times (default 5),\n");
+     fprintf(stderr,"reading the object with T threads ");
+     fprintf(stderr,"(default as many as processors)\n");
+     exit(1);
+   }
+   strcpy(fileName,argv[1]); /* file name to open */
+   if (argc>2) repeatNum = atoi(argv[2]);
+   if (repeatNum<1) repeatNum = 1;
+   if (argc>3) threadNum = atoi(argv[3]);
+}
+
+/* elapsed time in seconds from some fixed instant */
+double wallTime(void)
+{
+#ifdef _WIN32
+   return ( (double)clock() / (double)CLOCKS_PER_SEC );
+#else
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0 );
+#endif
+}
+
+/* print throughput given the time used by all repetitions */
+void printRate(char * what, double total)
+{
+   double sec = total / (double)repeatNum;
+   if (sec>0.0)
+      printf("%-12s %10.4f sec  %10.2f MB/sec\n", what, sec,
+             (double)fileSize / 1048576.0 / sec);
+   else
+      printf("%-12s %10.4f sec  (too fast to be measured)\n", what, sec);
+}
+
+/* read the whole file in large blocks */
+double rawRead(void)
+{
+   char * buf = (char *) malloc (MT_READ_BUFFER);
+   double start = wallTime();
+   int r;
+   FILE * fd;
+   fileSize = 0;
+   if (!buf) fatalError("Cannot allocate buffer");
+   for (r=0; r<repeatNum; r++)
+   {
+     size_t n;
+     fd = fopen(fileName,"r");
+     if (!fd) fatalError("Cannot open file");
+     fileSize = 0;
+     while ( (n = fread(buf, 1, MT_READ_BUFFER, fd)) > 0 ) fileSize += n;
+     fclose(fd);
+   }
+   free(buf);
+   return (wallTime() - start);
+}
+
+/* read all numbers after the header with fscanf */
+double fscanfRead(void)
+{
+   double start = wallTime();
+   int r, k = 0;
+   float f;
+   char line[MT_MAX_STRLEN];
+   FILE * fd;
+   for (r=0; r<repeatNum; r++)
+   {
+     fd = fopen(fileName,"r");
+     if (!fd) fatalError("Cannot open file");
+     setvbuf(fd, NULL, _IOFBF, MT_READ_BUFFER);
+     /* skip the header up to the line of the encoding */
+     while ( fgets(line, MT_MAX_STRLEN, fd) &&
+             strncmp(line, MT_ENCODE_KW, strlen(MT_ENCODE_KW)) );
+     while (fscanf(fd, "%f", &f) == 1) k++;
+     fclose(fd);
+   }
+   if (k==0) fatalError("No number read with fscanf");
+   return (wallTime() - start);
+}
+
+/* read the file as an MT persistent object with n threads */
+double objectRead(MT_Persistent obj, int n)
+{
+   double start;
+   int r;
+   MT_SetThreadNum(n);
+   start = wallTime();
+   for (r=0; r<repeatNum; r++)
+   {
+     if (!obj->MT_Read(fileName)) fatalError("Cannot read object");
+   }
+   return (wallTime() - start);
+}
+
+/* create an object of the class stored in the file */
+MT_Persistent createObject(void)
+{
+   FILE * fd = fopen(fileName,"r");
+   char kw[MT_MAX_STRLEN];
+   int a = 0, b = 0;
+   MT_Persistent obj = NULL;
+   if (!fd) fatalError("Cannot open file");
+   if (fscanf(fd, "%99s", kw)!=1) fatalError("Not an MT file");
+   if (strcmp(kw, MT_FILE_KW)) fatalError("Not an MT file");
+   if (fscanf(fd, "%99s", kw)!=1) fatalError("Not an MT file");
+   fscanf(fd, "%d %d", &a, &b);
+   fclose(fd);
+   if (!strcmp(kw, "MT_MultiTesselation"))
+      obj = new MT_MultiTesselationClass(a, b-1);
+   else if (!strcmp(kw, "MT_TileSet"))
+      obj = new MT_TileSetClass(a, b-1);
+   else if (!strcmp(kw, "MT_FloatTable"))
+      obj = new MT_FloatTableClass();
+   else if (!strcmp(kw, "MT_FloatVectorTable"))
+      obj = new MT_FloatVectorTableClass(a);
+   else if (!strcmp(kw, "MT_IntTable"))
+      obj = new MT_IntTableClass();
+   else if (!strcmp(kw, "MT_IntVectorTable"))
+      obj = new MT_IntVectorTableClass(a);
+   else fatalError("Unsupported class of object");
+   printf("File %s, class %s\n", fileName, kw);
+   return obj;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    MT_Persistent obj;
+    double t;
+    char what[MT_MAX_STRLEN];
+    setOptions(argc,argv);
+    obj = createObject();
+    t = rawRead();
+    printf("%ld bytes, %d repetitions\n", fileSize, repeatNum);
+    printRate((char *)"raw read", t);
+    printRate((char *)"fscanf", fscanfRead());
+    printRate((char *)"MT_Read", objectRead(obj, 1));
+    t = objectRead(obj, threadNum);
+    sprintf(what, "MT_Read x%d", MT_TheThreadNum());
+    printRate(what, t);
+    return 0;
+}
+
+/* ----------------------------------------------------------------------- */
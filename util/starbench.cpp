@@ -0,0 +1,372 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+
+/* ---------------------------- starbench.c ------------------------------ */
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+#include "mt_extra.h"
+#include "mt_info.h"
+
+/* ----------------------------------------------------------------------- */
+/*                 CHECK OF THE VERTEX STARS OF EXTRACTORS                 */
+/* ----------------------------------------------------------------------- */
+
+/*
+This program checks the vertex stars maintained by the extractors 
+(see MT_SetVertexStars in MT_ExtractorClass), and measures their cost.
+Each request extracts the tesselation at maximum resolution inside a 
+small box (1/8 of the bounding box of the MT on each of the first two
+coordinates), placed at a pseudo-random position depending on the 
+request number. Consecutive requests move the box, thus dynamic 
+extractors update the current tesselation from one request to the next.
+
+The requests are run with a dynamic extractor, a local dynamic 
+extractor, a parallel extractor and a local extractor with fixed 
+conditions, each one without and with adjacency. Every extractor runs 
+all the requests twice: first without, then with vertex stars.
+After each request with vertex stars, the program recounts the stars 
+from the extracted tiles, and checks that:
+- every vertex of an extracted tile has a star, and the stars contain
+  the extracted tiles incident at their vertex;
+- the tiles in the star of a vertex are incident at it;
+- the size of each star is the number of extracted tiles incident at 
+  the vertex (only at least such number for the local dynamic 
+  extractor, whose current front also contains tiles refined in the 
+  last requests and not reported as extracted).
+The program prints the time of the requests without and with vertex
+stars (excluding the check), and the number of errors.
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                           global variables                              */
+/* ----------------------------------------------------------------------- */
+
+char fileName[255];      /* file to be read */
+int requestNum = 128;    /* number of requests */
+
+MT_MultiTesselation mt;  /* the MT */
+MT_FalseCond filter;     /* resolution filter of all requests */
+class WindowCondClass ** focus; /* focus condition of each request */
+int * count;             /* number of tiles incident at each star vertex */
+int errorNum = 0;        /* number of errors found in the stars */
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* termination due to error */
+void fatalError(char *message)
+{
+    fprintf(stderr, "Fatal error: %s\n", message);
+    exit(1);
+}
+
+/* management of command line options */
+void setOptions(int argc, char * argv[])
+{
+   if (argc==1) /* no command line options */
+   {
+     fprintf(stderr,"Usage: %s XXX [N]\n",argv[0]);
+     fprintf(stderr,"Check the vertex stars of the extractors on N ");
+     fprintf(stderr,"requests (default 128) on the MT in file XXX\n");
+     exit(1);
+   }
+   strcpy(fileName,argv[1]); /* file name to open */
+   if (argc>2) requestNum = atoi(argv[2]);
+   if (requestNum<1) requestNum = 1;
+}
+
+/* elapsed time in seconds from some fixed instant */
+double wallTime(void)
+{
+#ifdef _WIN32
+   return ( (double)clock() / (double)CLOCKS_PER_SEC );
+#else
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0 );
+#endif
+}
+
+/* ----------------------------------------------------------------------- */
+/*                          focus condition                                */
+/* ----------------------------------------------------------------------- */
+
+/* a tile is in the focus if the box of its vertices, on the first two
+   coordinates, intersects a given box */
+class WindowCondClass : public MT_CondClass
+{
+   float min_x, min_y, max_x, max_y;
+
+   public:
+
+   WindowCondClass(float x1, float y1, float x2, float y2)
+   {  min_x = x1; min_y = y1; max_x = x2; max_y = y2;  }
+
+   int MT_EvalCond(MT_MultiTesselation m, MT_INDEX t, int flag)
+   {
+      int i, in_x1 = 0, in_x2 = 0, in_y1 = 0, in_y2 = 0;
+      for (i=0; i<m->MT_NumTileVertices(); i++)
+      {
+        MT_INDEX v = m->MT_TileVertex(t,i);
+        if (m->MT_VertexX(v) >= min_x) in_x1 = 1;
+        if (m->MT_VertexX(v) <= max_x) in_x2 = 1;
+        if (m->MT_VertexY(v) >= min_y) in_y1 = 1;
+        if (m->MT_VertexY(v) <= max_y) in_y2 = 1;
+      }
+      return ( in_x1 && in_x2 && in_y1 && in_y2 );
+   }
+};
+
+/* create the focus condition of request r */
+WindowCondClass * requestFocus(int r)
+{
+   unsigned long s = 12345 + 7919 * (unsigned long)r; /* pseudo-random */
+   float dx = ( mt->MT_MaxCoord(0) - mt->MT_MinCoord(0) ) / 8.0;
+   float dy = ( mt->MT_MaxCoord(1) - mt->MT_MinCoord(1) ) / 8.0;
+   float x, y;
+   s = (s * 1103515245 + 12345) & 0x7fffffff;
+   x = mt->MT_MinCoord(0) + 7.0 * dx * (float)(s % 1000) / 1000.0;
+   s = (s * 1103515245 + 12345) & 0x7fffffff;
+   y = mt->MT_MinCoord(1) + 7.0 * dy * (float)(s % 1000) / 1000.0;
+   return new WindowCondClass(x, y, x+dx, y+dy);
+}
+
+/* ----------------------------------------------------------------------- */
+/*                            input MT                                     */
+/* ----------------------------------------------------------------------- */
+
+/* read the MT from the file */
+MT_MultiTesselation readMT(void)
+{
+   MT_FileInfo info = new MT_FileInfoClass();
+   MT_MultiTesselation m;
+   if ( (!info->MT_Read(fileName)) || 
+        strcmp(info->MT_ClassKeyword(), "MT_MultiTesselation") )
+      fatalError("Not an MT file");
+   m = new MT_MultiTesselationClass(info->MT_VertexDim(),
+                                    info->MT_TileDim());
+   delete info;
+   if (!m->MT_Read(fileName)) fatalError("Cannot read MT");
+   printf("File %s\n", fileName);
+   return m;
+}
+
+/* ----------------------------------------------------------------------- */
+/*                              extractors                                 */
+/* ----------------------------------------------------------------------- */
+
+/* local extractor with the conditions of the requests */
+typedef MT_FixedLocalExtractorClass<MT_FalseCondClass,WindowCondClass,3>
+        FixedExtractorClass;
+
+#define DYNAMIC_EXTR    0
+#define LOCAL_DYN_EXTR  1
+#define PARALLEL_EXTR   2
+#define FIXED_EXTR      3
+#define EXTR_KINDS      4
+
+char * kindName[EXTR_KINDS] = 
+{ (char *)"dynamic", (char *)"local dyn.", (char *)"parallel", 
+  (char *)"fixed local" };
+
+/* create an extractor of a kind */
+MT_Extractor newExtractor(int kind, int topo)
+{
+   switch (kind)
+   {
+     case DYNAMIC_EXTR:   return new MT_DynamicExtractorClass(mt,topo);
+     case LOCAL_DYN_EXTR: return new MT_LocalDynamicExtractorClass(mt,topo);
+     case PARALLEL_EXTR:  return new MT_ParallelExtractorClass(mt,topo);
+   }
+   return new FixedExtractorClass(mt,filter,NULL,topo);
+}
+
+/* extract request r with extractor e of a kind */
+void extract(MT_Extractor e, int kind, int r)
+{
+   if (kind == FIXED_EXTR)
+   {  /* through the functions of the template */
+      ((FixedExtractorClass *)e)->MT_SetFilter(filter);
+      ((FixedExtractorClass *)e)->MT_SetFocus(focus[r]);
+   }
+   else
+   {
+      e->MT_SetFilter(filter);
+      e->MT_SetFocus(focus[r]);
+   }
+   e->MT_ExtractTesselation();
+}
+
+/* ----------------------------------------------------------------------- */
+/*                              check                                      */
+/* ----------------------------------------------------------------------- */
+
+/* report an error in the stars of request r */
+void starError(int r, char * message, MT_INDEX v)
+{
+   errorNum++;
+   if (errorNum<=10)
+      fprintf(stderr, "Request %d, vertex %ld: %s\n", r, (long)v, message);
+}
+
+/* return 1 if vertex v is a vertex of tile t */
+int incident(MT_INDEX t, MT_INDEX v)
+{
+   int j;
+   for (j=0; j<mt->MT_NumTileVertices(); j++)
+      if (mt->MT_TileVertex(t,j) == v) return 1;
+   return 0;
+}
+
+/* return 1 if tile t is in the star of vertex v */
+int inStar(MT_Extractor e, MT_INDEX v, MT_INDEX t)
+{
+   MT_INDEX * s = e->MT_VertexStar(v);
+   int i, n = e->MT_VertexStarSize(v);
+   for (i=0; i<n; i++)  if (s[i] == t) return 1;
+   return 0;
+}
+
+/* check the stars after request r extracted by e; if exact, the stars 
+   must contain just the extracted tiles */
+void check(MT_Extractor e, int r, int exact)
+{
+   MT_INDEX * t;
+   MT_INDEX * s;
+   MT_INDEX n, i, k, v;
+   int j, size, dim = mt->MT_NumTileVertices();
+
+   if (!e->MT_VertexStarsEnabled())
+   {  starError(r, (char *)"vertex stars disabled", MT_NULL_INDEX);
+      return;
+   }
+   count = (int *) realloc ( count, 
+                             (e->MT_StarVertexNum()+1) * sizeof(int) );
+   if (!count)  fatalError("Allocation failed");
+   for (k=0; k<=e->MT_StarVertexNum(); k++)  count[k] = 0;
+
+   /* recount the stars from all the extracted tiles */
+   n = e->MT_AllExtractedTiles(&t);
+   for (i=0; i<n; i++)
+   for (j=0; j<dim; j++)
+   {
+     v = mt->MT_TileVertex(t[i],j);
+     k = e->MT_StarPosition(v);
+     if (k == MT_NULL_INDEX)  starError(r, (char *)"no star", v);
+     else count[k]++;
+   }
+
+   /* compare the stars with the recount */
+   for (k=1; k<=e->MT_StarVertexNum(); k++)
+   {
+     v = e->MT_StarVertex(k);
+     if (e->MT_StarPosition(v) != k)
+        starError(r, (char *)"wrong position", v);
+     size = e->MT_VertexStarSize(v);
+     if ( exact ? (size != count[k]) : (size < count[k]) )
+        starError(r, (char *)"wrong star size", v);
+     s = e->MT_VertexStar(v);
+     for (j=0; j<size; j++)
+     {
+       if (!incident(s[j],v))
+          starError(r, (char *)"tile not incident at vertex", v);
+     }
+   }
+
+   /* the extracted tiles are in the stars of their vertices */
+   n = e->MT_ExtractedTiles(&t);
+   for (i=0; i<n; i++)
+   for (j=0; j<dim; j++)
+   {
+     v = mt->MT_TileVertex(t[i],j);
+     if ( e->MT_StarPosition(v) && !inStar(e,v,t[i]) )
+        starError(r, (char *)"extracted tile not in star", v);
+   }
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    MT_Extractor e;
+    double start, sec, star_sec;
+    int r, kind, topo;
+
+    setOptions(argc,argv);
+    mt = readMT();
+    printf("%ld nodes, %ld arcs, %d requests\n", 
+           (long)mt->MT_NodeNum(), (long)mt->MT_ArcNum(), requestNum);
+    printf("%-12s %4s %12s %12s\n", "extractor", "adj", 
+           "no stars", "stars");
+    fflush(stdout);
+    filter = new MT_FalseCondClass(); /* maximum resolution */
+    focus = (WindowCondClass **) 
+            malloc ( requestNum * sizeof(WindowCondClass *) );
+    if (!focus)  fatalError("Allocation failed");
+    for (r=0; r<requestNum; r++)  focus[r] = requestFocus(r);
+
+    for (kind=0; kind<EXTR_KINDS; kind++)
+    for (topo=0; topo<2; topo++)
+    {
+      e = newExtractor(kind, topo ? MT_ADJ_ENABLE : MT_ADJ_DISABLE);
+
+      /* without vertex stars */
+      start = wallTime();
+      for (r=0; r<requestNum; r++)  extract(e, kind, r);
+      sec = wallTime() - start;
+
+      /* with vertex stars, excluding the time of the check */
+      if (!e->MT_SetVertexStars(1))  fatalError("Cannot set vertex stars");
+      star_sec = 0.0;
+      for (r=0; r<requestNum; r++)
+      {
+        start = wallTime();
+        extract(e, kind, r);
+        star_sec += wallTime() - start;
+        check(e, r, (kind != LOCAL_DYN_EXTR));
+      }
+      printf("%-12s %4s %8.4f sec %8.4f sec\n", kindName[kind],
+             (topo ? "yes" : "no"), sec, star_sec);
+      fflush(stdout);
+      delete e;
+    }
+
+    if (errorNum)  printf("%d errors in the vertex stars\n", errorNum);
+    else printf("All vertex stars correct\n");
+    for (r=0; r<requestNum; r++)  delete focus[r];
+    free(focus); 
+    if (count) free(count);
+    delete filter; delete mt;
+    return ( errorNum ? 1 : 0 );
+}
+
+/* ----------------------------------------------------------------------- */
@@ -0,0 +1,225 @@
+/*****************************************************************************
+The Multi-Tesselation (MT) version 1.0, 1999.
+A dimension-independent package for the representation and manipulation of
+spatial objects as simplicial complexes at multiple resolutions.
+
+Copyright (C) 1999 DISI - University of Genova, Italy.
+Group of Geometric Modeling and Computer Graphics DISI.
+Program written by Paola Magillo <magillo@disi.unige.it>.
+DISI - University of Genova, Via Dodecaneso 35, 16146 Genova - ITALY.
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+*****************************************************************************/
+/* ---------------------------- writebench.c ----------------------------- */
+
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+#include "mt_multi.h"
+#include "mt_float.h"
+#include "mt_int.h"
+
+/* ----------------------------------------------------------------------- */
+/*                   BENCHMARK FOR WRITING MT FILES                        */
+/* ----------------------------------------------------------------------- */
+
+/*
+Read an object from a file, then write it several times in the ascii 
+and in the binary encoding and print the time of:
+- writing it with MT_Write;
+- writing it in the background with MT_StartWrite, and waiting for the
+  completion with MT_WaitWrite;
+- writing it in the background with MT_StartWrite, and destroying the 
+  object at once, without waiting (the destructor must wait).
+Times are elapsed times, not processor times. Check that the files 
+written in the background are equal to the one written by MT_Write.
+The file may contain an MT, a float table, a float vector table or
+an int table.
+*/
+
+/* ----------------------------------------------------------------------- */
+/*                           global variables                              */
+/* ----------------------------------------------------------------------- */
+
+char fileName[255]; /* file to be read */
+int repeatNum = 5;  /* number of times each test is repeated */
+int errorNum = 0;   /* number of files found different */
+
+/* names of the files written by the tests */
+char * refName = (char *)"writebench.ref";
+char * outName = (char *)"writebench.out";
+
+/* ----------------------------------------------------------------------- */
+/*                         auxiliary functions                             */
+/* ----------------------------------------------------------------------- */
+
+/* termination due to error */
+void fatalError(char *message)
+{
+    fprintf(stderr, "Fatal error: %s\n", message);
+    exit(1);
+}
+
+/* management of command line options */
+void setOptions(int argc, char * argv[])
+{
+   if (argc==1) /* no command line options */
+   {
+     fprintf(stderr,"Usage: %s XXX [N]\n",argv[0]);
+     fprintf(stderr,"Measure the time of writing the object in file XXX, ");
+     fprintf(stderr,"repeating each test N times (default 5)\n");
+     exit(1);
+   }
+   strcpy(fileName,argv[1]); /* file name to open */
+   if (argc>2) repeatNum = atoi(argv[2]);
+   if (repeatNum<1) repeatNum = 1;
+}
+
+/* elapsed time in seconds from some fixed instant */
+double wallTime(void)
+{
+#ifdef _WIN32
+   return ( (double)clock() / (double)CLOCKS_PER_SEC );
+#else
+   struct timeval tv;
+   gettimeofday(&tv, NULL);
+   return ( (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0 );
+#endif
+}
+
+/* print the time of one repetition given the time of all of them */
+void printTime(char * what, double total)
+{
+   printf("%-24s %10.4f sec\n", what, total / (double)repeatNum);
+}
+
+/* return 1 if the two files have the same contents, 0 otherwise */
+int sameFiles(char * name1, char * name2)
+{
+   FILE * fd1 = fopen(name1,"rb");
+   FILE * fd2 = fopen(name2,"rb");
+   int c1 = 0, c2 = 0;
+   if (fd1 && fd2)
+   {  do  {  c1 = getc(fd1);  c2 = getc(fd2);  }
+      while ( (c1==c2) && (c1!=EOF) );
+   }
+   if (fd1) fclose(fd1);
+   if (fd2) fclose(fd2);
+   return ( fd1 && fd2 && (c1==c2) );
+}
+
+/* check the file written in the background against the reference */
+void checkFile(char * what)
+{
+   if (!sameFiles(refName, outName))
+   {  printf("%s: the file written in the background is different\n", what);
+      errorNum++;
+   }
+}
+
+/* create an object of the class stored in the file, and read it */
+MT_Persistent createObject(void)
+{
+   FILE * fd = fopen(fileName,"r");
+   char kw[MT_MAX_STRLEN];
+   int a = 0, b = 0;
+   MT_Persistent obj = NULL;
+   if (!fd) fatalError("Cannot open file");
+   if (fscanf(fd, "%99s", kw)!=1) fatalError("Not an MT file");
+   if (strcmp(kw, MT_FILE_KW)) fatalError("Not an MT file");
+   if (fscanf(fd, "%99s", kw)!=1) fatalError("Not an MT file");
+   fscanf(fd, "%d %d", &a, &b);
+   fclose(fd);
+   if (!strcmp(kw, "MT_MultiTesselation"))
+      obj = new MT_MultiTesselationClass(a, b-1);
+   else if (!strcmp(kw, "MT_TileSet"))
+      obj = new MT_TileSetClass(a, b-1);
+   else if (!strcmp(kw, "MT_FloatTable"))
+      obj = new MT_FloatTableClass();
+   else if (!strcmp(kw, "MT_FloatVectorTable"))
+      obj = new MT_FloatVectorTableClass(a);
+   else if (!strcmp(kw, "MT_IntTable"))
+      obj = new MT_IntTableClass();
+   else if (!strcmp(kw, "MT_IntVectorTable"))
+      obj = new MT_IntVectorTableClass(a);
+   else fatalError("Unsupported class of object");
+   if (!obj->MT_Read(fileName)) fatalError("Cannot read object");
+   return obj;
+}
+
+/* run the three tests for an encoding */
+void writeTests(MT_Persistent obj, int encoding, char * name)
+{
+   double start, total;
+   char what[MT_MAX_STRLEN];
+   int r;
+   /* write with MT_Write */
+   start = wallTime();
+   for (r=0; r<repeatNum; r++)
+   {
+     if (!obj->MT_Write(refName, encoding)) fatalError("Cannot write file");
+   }
+   sprintf(what, "%s MT_Write", name);
+   printTime(what, wallTime() - start);
+   /* write in the background and wait */
+   start = wallTime();
+   for (r=0; r<repeatNum; r++)
+   {
+     if (!obj->MT_StartWrite(outName, encoding)) 
+        fatalError("Cannot write file");
+     if (!obj->MT_WaitWrite()) fatalError("Cannot write file");
+   }
+   sprintf(what, "%s MT_StartWrite", name);
+   printTime(what, wallTime() - start);
+   checkFile(what);
+   /* write in the background and destroy the object at once, the 
+      destructor waits for the completion */
+   sprintf(what, "%s delete", name);
+   total = 0.0;
+   for (r=0; r<repeatNum; r++)
+   {
+     MT_Persistent tmp = createObject();
+     start = wallTime();
+     if (!tmp->MT_StartWrite(outName, encoding)) 
+        fatalError("Cannot write file");
+     delete tmp;
+     total += wallTime() - start;
+     checkFile(what);
+   }
+   printTime(what, total);
+}
+
+/* ----------------------------------------------------------------------- */
+/*                                    MAIN                                 */
+/* ----------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    MT_Persistent obj;
+    setOptions(argc,argv);
+    obj = createObject();
+    printf("File %s, %d repetitions\n", fileName, repeatNum);
+    writeTests(obj, MT_ASCII_ENCODING, (char *)"ascii");
+    writeTests(obj, MT_BINARY_ENCODING, (char *)"binary");
+    delete obj;
+    remove(refName);
+    remove(outName);
+    printf("%d files different\n", errorNum);
+    return ( errorNum ? 1 : 0 );
+}
+
+/* ----------------------------------------------------------------------- */